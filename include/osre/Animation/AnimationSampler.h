@@ -0,0 +1,130 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Animation/AnimatorBase.h>
+
+namespace OSRE {
+namespace Animation {
+
+class CompressedClip;
+
+/// @brief  The local transform of one bone.
+struct BoneTransform {
+    glm::vec3 mTranslation;
+    glm::quat mRotation;
+    glm::vec3 mScale;
+
+    BoneTransform() : mTranslation(0.0f), mRotation(1.0f, 0.0f, 0.0f, 0.0f), mScale(1.0f) {}
+
+    /// @brief  Returns the transform as a matrix.
+    glm::mat4 toMatrix() const;
+};
+
+/// @brief  A pose stores one local transform per bone of a skeleton.
+using Pose = cppcore::TArray<BoneTransform>;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class samples an animation track into a pose of a skeleton.
+///
+/// The node animations are bound to the bones by name once. For each node animation the index of
+/// the last used key is cached, so forward playback finds the next keys in O(1). When the time
+/// jumps backwards the search starts again at the first key. Compressed clips use uniform keys,
+/// so they are sampled without any cache.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT AnimationSampler {
+public:
+    /// @brief  The default class constructor.
+    AnimationSampler();
+
+    /// @brief  The class destructor.
+    ~AnimationSampler() = default;
+
+    /// @brief  Will bind a track to a skeleton.
+    /// @param  track       [in] The animation track, nullptr to unbind.
+    /// @param  skeleton    [in] The skeleton.
+    void bind(const AnimationTrack *track, const Skeleton &skeleton);
+
+    /// @brief  Will bind a compressed clip to a skeleton.
+    /// @param  clip        [in] The compressed clip, nullptr to unbind.
+    /// @param  skeleton    [in] The skeleton.
+    void bind(const CompressedClip *clip, const Skeleton &skeleton);
+
+    /// @brief  Will sample the track. Bones without a node animation get their bind transform.
+    /// @param  timeInSeconds   [in] The time in seconds.
+    /// @param  loop        [in] true to wrap the time into the duration of the track.
+    /// @param  pose        [out] The sampled pose.
+    void sample(d32 timeInSeconds, bool loop, Pose &pose);
+
+    /// @brief  Will reset the cached key indices.
+    void reset();
+
+    /// @brief  Returns the bound track.
+    const AnimationTrack *getTrack() const;
+
+    /// @brief  Returns the bound compressed clip.
+    const CompressedClip *getClip() const;
+
+    /// @brief  Returns the duration of the bound track in seconds.
+    d32 getDurationInSeconds() const;
+
+    /// @brief  Will store the bind transforms of all bones in the pose.
+    /// @param  skeleton    [in] The skeleton.
+    /// @param  pose        [out] The bind pose.
+    static void getBindPose(const Skeleton &skeleton, Pose &pose);
+
+    /// @brief  Will blend two poses, translations and scalings are interpolated linearly, the
+    /// rotations by a normalized lerp along the shortest arc.
+    /// @param  a           [in] The first pose.
+    /// @param  b           [in] The second pose.
+    /// @param  weight      [in] The weight of the second pose, between 0 and 1.
+    /// @param  out         [out] The blended pose, may be one of the inputs.
+    static void blend(const Pose &a, const Pose &b, f32 weight, Pose &out);
+
+private:
+    struct KeyCache {
+        ui32 mPosition;
+        ui32 mRotation;
+        ui32 mScaling;
+    };
+
+    const AnimationTrack *mTrack;
+    const CompressedClip *mClip;
+    cppcore::TArray<i32> mChannelToBone;
+    cppcore::TArray<KeyCache> mKeyCache;
+    Pose mBindPose;
+    d32 mLastTime;
+};
+
+inline const AnimationTrack *AnimationSampler::getTrack() const {
+    return mTrack;
+}
+
+inline const CompressedClip *AnimationSampler::getClip() const {
+    return mClip;
+}
+
+} // Namespace Animation
+} // Namespace OSRE
@@ -50,33 +50,60 @@ struct OSRE_EXPORT VertexWeight {
     }
 };
 
+/// @brief  A bone, the vertex weights are stored per vertex in the skin ( @see Skin ).
 struct OSRE_EXPORT Bone {
-    using VertexWeightArray = cppcore::TArray<VertexWeight>;
-
     i32 mParent;
     String mName;
-    VertexWeightArray m_vertexWeights;
     glm::mat4 m_offsetMatrix;
+    glm::mat4 mLocalTransform;  ///< The local bind transform of the bone node.
 
     /// @brief The default constructor.
-    Bone() : mParent(-1), mName(), m_vertexWeights(), m_offsetMatrix() {}
+    Bone() : mParent(-1), mName(), m_offsetMatrix(1.0f), mLocalTransform(1.0f) {}
 
     ///	@brief The default destructor, default implementation.
     ~Bone() = default;
 };
 
+/// @brief  The bone table of a mesh. Parents are always stored before their children.
 struct OSRE_EXPORT Skeleton {
-    using BoneArray = cppcore::TArray<Bone *>;
+    using BoneArray = cppcore::TArray<Bone>;
 
     String mName;
     i32 mRootBone;
     BoneArray mBones;
+    glm::mat4 mRootTransform;   ///< The global transform of the parent node of the root bones.
+    glm::mat4 mGlobalInverse;   ///< The inverse transform of the scene root.
 
     /// @brief The default constructor.
-    Skeleton() : mName(), mRootBone(-1), mBones(){}
+    Skeleton() : mName(), mRootBone(-1), mBones(), mRootTransform(1.0f), mGlobalInverse(1.0f) {}
 
     ///	@brief The default destructor, default implementation.
     ~Skeleton() = default;
+
+    /// @brief  Returns the index of a bone or -1, if the name is unknown.
+    i32 findBone(const String &name) const {
+        for (size_t i = 0; i < mBones.size(); ++i) {
+            if (mBones[i].mName == name) {
+                return static_cast<i32>(i);
+            }
+        }
+        return -1;
+    }
+};
+
+/// @brief  The maximal number of bones influencing one vertex.
+static constexpr ui32 MaxBonesPerVertex = 4;
+
+/// @brief  The bone influences of one vertex, unused slots have a weight of 0.
+struct SkinVertex {
+    ui16 mBones[MaxBonesPerVertex];
+    f32 mWeights[MaxBonesPerVertex];
+};
+
+/// @brief  The skinning data of one mesh, the vertices are parallel to the vertex buffer.
+struct OSRE_EXPORT Skin {
+    Skeleton mSkeleton;
+    cppcore::TArray<SkinVertex> mVertices;
 };
 
 struct VectorKey {
@@ -84,6 +111,7 @@ struct VectorKey {
     d32 mTime;
 };
 
+/// @brief  A rotation key, the quaternion is stored as ( x|y|z|w ).
 struct RotationKey {
     glm::vec4 mQuad;
     d32 mTime;
@@ -92,7 +120,9 @@ struct RotationKey {
 using VectorKeyArray = ::cppcore::TArray<VectorKey>;
 using RotationKeyArray = ::cppcore::TArray<RotationKey>;
 
+/// @brief  The keys of one animated node, the times are in ticks.
 struct NodeAnimation {
+    String mName;
     VectorKeyArray mPositions;
     VectorKeyArray mScalings;
     RotationKeyArray mRotations;
@@ -102,7 +132,9 @@ struct AnimationTrack {
     String mName;
     double mDuration;
     double mTicksPerSecond;
-    cppcore::TArray<NodeAnimation *> mNodeAnimations;
+    cppcore::TArray<NodeAnimation> mNodeAnimations;
+
+    AnimationTrack() : mName(), mDuration(0.0), mTicksPerSecond(0.0), mNodeAnimations() {}
 };
 
 template <class T>
@@ -0,0 +1,166 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Animation/AnimationSampler.h>
+
+namespace OSRE {
+namespace Animation {
+
+/// @brief  The settings for the clip compression.
+struct CompressionSettings {
+    f32 mSampleRate;            ///< The uniform key rate in frames per second.
+    f32 mPositionTolerance;     ///< The maximal position error in world units.
+    f32 mRotationTolerance;     ///< The maximal error per quaternion component.
+    f32 mScaleTolerance;        ///< The maximal scaling error.
+
+    CompressionSettings() :
+            mSampleRate(30.0f), mPositionTolerance(0.001f), mRotationTolerance(0.0005f), mScaleTolerance(0.001f) {
+        // empty
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class stores a compressed animation track.
+///
+/// The track is resampled at a uniform rate, so no key times are stored. Constant curves are
+/// stored once in full precision, all other curves use the largest key step ( 1 - 16 frames ),
+/// which stays inside of the error tolerance. Positions and scalings are quantized to 16 bit
+/// per component inside of the range of the curve, rotations are stored as the smallest three
+/// components with 15 bit each. All keys use three 16 bit values.
+///
+/// The keys are stored in blocks of BlockFrames frames. Inside of a block each curve is stored
+/// contiguously, the first key of the next block is repeated at the end. So sampling touches one
+/// block only and decodes the keys directly from it, without any intermediate buffers.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT CompressedClip {
+public:
+    /// @brief  The number of frames per block.
+    static constexpr ui32 BlockFrames = 16;
+
+    /// @brief  The number of 16 bit values per key.
+    static constexpr ui32 KeySize = 3;
+
+    /// @brief  The curve types of a channel.
+    enum CurveType {
+        PositionCurve = 0,
+        RotationCurve,
+        ScalingCurve,
+        NumCurveTypes
+    };
+
+    /// @brief  The default class constructor.
+    CompressedClip();
+
+    /// @brief  The class destructor.
+    ~CompressedClip() = default;
+
+    /// @brief  Will compress a track.
+    /// @param  track       [in] The track to compress.
+    /// @param  settings    [in] The compression settings.
+    /// @param  clip        [out] The compressed clip.
+    /// @return true if successful, false in case of an error.
+    static bool compress(const AnimationTrack &track, const CompressionSettings &settings, CompressedClip &clip);
+
+    /// @brief  Will sample the clip into a pose. Bones without a channel will not be touched.
+    /// @param  timeInSeconds   [in] The time in seconds.
+    /// @param  loop        [in] true to wrap the time into the duration.
+    /// @param  channelToBone   [in] The bone index per channel, -1 for unused channels.
+    /// @param  pose        [inout] The pose.
+    void sample(d32 timeInSeconds, bool loop, const cppcore::TArray<i32> &channelToBone, Pose &pose) const;
+
+    /// @brief  Will decompress the clip into a track with one key per frame.
+    /// @param  track       [out] The track.
+    void decompress(AnimationTrack &track) const;
+
+    /// @brief  Returns the name of the clip.
+    const String &getName() const;
+
+    /// @brief  Returns the duration in seconds.
+    d32 getDurationInSeconds() const;
+
+    /// @brief  Returns the number of uniform frames.
+    ui32 getNumFrames() const;
+
+    /// @brief  Returns the number of channels.
+    size_t getNumChannels() const;
+
+    /// @brief  Returns the node name of a channel.
+    const String &getChannelName(size_t index) const;
+
+    /// @brief  Returns the number of bytes used by the keys and the curve descriptions.
+    size_t getMemorySize() const;
+
+    /// @brief  Returns the number of bytes used by the keys of an uncompressed track.
+    static size_t getMemorySize(const AnimationTrack &track);
+
+private:
+    struct Curve {
+        i32 mChannel;
+        CurveType mType;
+        ui32 mStride;
+        ui32 mOffset;
+        glm::vec3 mMin;
+        glm::vec3 mExtent;
+    };
+
+    struct Channel {
+        String mName;
+        bool mHasCurve[NumCurveTypes];
+        i32 mCurve[NumCurveTypes];
+        glm::vec4 mConstant[NumCurveTypes];
+    };
+
+    void sampleChannel(const Channel &channel, ui32 block, f32 localFrame, BoneTransform &transform) const;
+
+private:
+    String mName;
+    f32 mSampleRate;
+    ui32 mNumFrames;
+    ui32 mNumBlocks;
+    ui32 mBlockSize;
+    cppcore::TArray<Channel> mChannels;
+    cppcore::TArray<Curve> mCurves;
+    cppcore::TArray<ui16> mData;
+};
+
+inline const String &CompressedClip::getName() const {
+    return mName;
+}
+
+inline ui32 CompressedClip::getNumFrames() const {
+    return mNumFrames;
+}
+
+inline size_t CompressedClip::getNumChannels() const {
+    return mChannels.size();
+}
+
+inline const String &CompressedClip::getChannelName(size_t index) const {
+    return mChannels[index].mName;
+}
+
+} // Namespace Animation
+} // Namespace OSRE
@@ -0,0 +1,139 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Animation/Skinning.h>
+#include <osre/RenderBackend/RenderCommon.h>
+
+namespace OSRE {
+
+namespace RenderBackend {
+    class Mesh;
+    class RenderBackendService;
+}
+
+namespace Animation {
+
+/// @brief  Describes where the vertices will be skinned.
+enum class SkinningMode {
+    Cpu = 0,    ///< The vertex buffer will be skinned on the CPU and updated.
+    Gpu         ///< The bone palette will be uploaded as the uniform array BonePalette.
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class plays skeletal animations on a skinned mesh. It samples the active track,
+/// cross-fades to a new track, computes the bone palette and skins the mesh.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT SkeletalAnimator {
+public:
+    /// @brief  The class constructor.
+    /// @param  skin        [in] The skin of the mesh.
+    /// @param  mesh        [in] The mesh to animate, CPU skinning needs render vertices.
+    SkeletalAnimator(const Skin *skin, RenderBackend::Mesh *mesh);
+
+    /// @brief  The class destructor.
+    ~SkeletalAnimator() = default;
+
+    /// @brief  Will set the skinning mode, CPU by default.
+    /// @param  mode        [in] The new mode.
+    void setSkinningMode(SkinningMode mode);
+
+    /// @brief  Returns the skinning mode.
+    SkinningMode getSkinningMode() const;
+
+    /// @brief  Will start a track immediately.
+    /// @param  track       [in] The track to play.
+    /// @param  loop        [in] true to loop the track.
+    void play(const AnimationTrack *track, bool loop);
+
+    /// @brief  Will start a compressed clip immediately.
+    /// @param  clip        [in] The clip to play.
+    /// @param  loop        [in] true to loop the clip.
+    void play(const CompressedClip *clip, bool loop);
+
+    /// @brief  Will blend from the current track to a new one.
+    /// @param  track       [in] The track to play.
+    /// @param  duration    [in] The blend duration in seconds.
+    /// @param  loop        [in] true to loop the track.
+    void crossFade(const AnimationTrack *track, f32 duration, bool loop);
+
+    /// @brief  Will blend from the current track to a compressed clip.
+    /// @param  clip        [in] The clip to play.
+    /// @param  duration    [in] The blend duration in seconds.
+    /// @param  loop        [in] true to loop the clip.
+    void crossFade(const CompressedClip *clip, f32 duration, bool loop);
+
+    /// @brief  Will advance the time, sample the pose, compute the palette and skin on the CPU.
+    /// @param  dt          [in] The time step.
+    void update(Time dt);
+
+    /// @brief  Will submit the result to the current render batch, either the skinned vertices or
+    /// the bone palette.
+    /// @param  rbSrv       [in] The render backend.
+    void submit(RenderBackend::RenderBackendService *rbSrv);
+
+    /// @brief  Returns the current pose.
+    const Pose &getPose() const;
+
+    /// @brief  Returns the current bone palette.
+    const BonePalette &getPalette() const;
+
+private:
+    bool beginFade(f32 duration);
+
+    struct Layer {
+        AnimationSampler mSampler;
+        d32 mTime;
+        bool mLoop;
+    };
+
+    const Skin *mSkin;
+    RenderBackend::Mesh *mMesh;
+    SkinningMode mMode;
+    Layer mLayers[2];
+    ui32 mActive;
+    f32 mFadeTime;
+    f32 mFadeDuration;
+    Pose mPose;
+    Pose mFadePose;
+    BonePalette mPalette;
+    cppcore::TArray<RenderBackend::RenderVert> mBindVertices;
+    bool mVerticesDirty;
+};
+
+inline SkinningMode SkeletalAnimator::getSkinningMode() const {
+    return mMode;
+}
+
+inline const Pose &SkeletalAnimator::getPose() const {
+    return mPose;
+}
+
+inline const BonePalette &SkeletalAnimator::getPalette() const {
+    return mPalette;
+}
+
+} // Namespace Animation
+} // Namespace OSRE
@@ -0,0 +1,72 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Animation/AnimationSampler.h>
+
+namespace OSRE {
+
+namespace RenderBackend {
+    struct RenderVert;
+}
+
+namespace Animation {
+
+/// @brief  The bone palette, one skinning matrix per bone.
+using BonePalette = cppcore::TArray<glm::mat4>;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements the bone palette generation and the CPU skinning. Each vertex is
+/// transformed by the weighted sum of up to four palette matrices using SSE, large meshes are
+/// split into batches for the worker pool.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT Skinning {
+public:
+    /// Meshes with more vertices than this will be skinned by the worker threads.
+    static constexpr size_t ParallelThreshold = 4 * 1024;
+
+    /// @brief  Will compute the skinning matrices of a pose.
+    /// @param  skeleton    [in] The skeleton, parents are stored before their children.
+    /// @param  pose        [in] The local transforms of the bones.
+    /// @param  palette     [out] The skinning matrices.
+    static void computePalette(const Skeleton &skeleton, const Pose &pose, BonePalette &palette);
+
+    /// @brief  Will skin the positions and normals of the vertices, all other attributes of the
+    /// destination vertices will not be touched.
+    /// @param  skin        [in] The skin, the skin vertices are parallel to the vertices.
+    /// @param  palette     [in] The skinning matrices.
+    /// @param  src         [in] The vertices in bind pose.
+    /// @param  dst         [out] The skinned vertices.
+    /// @param  numVertices [in] The number of vertices.
+    static void skin(const Skin &skin, const BonePalette &palette, const RenderBackend::RenderVert *src,
+            RenderBackend::RenderVert *dst, size_t numVertices);
+
+    /// @brief  Same as skin, but for a range of vertices and in the calling thread only.
+    static void skinRange(const Skin &skin, const BonePalette &palette, const RenderBackend::RenderVert *src,
+            RenderBackend::RenderVert *dst, size_t begin, size_t end);
+};
+
+} // Namespace Animation
+} // Namespace OSRE
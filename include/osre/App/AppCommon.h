@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include <osre/Common/osre_common.h>
+#include <osre/Common/TSlotMap.h>
 #include <cppcore/Common/TBitField.h>
 
 // Forward declarations ---------------------------------------------------------------------------
@@ -50,6 +51,9 @@ class KeyboardEventListener;
 
 template<class T> class TAbstractCtrlBase;
 
+/// @brief  The generational handle of an entity, stale handles will not resolve.
+using EntityHandle = Common::SlotHandle;
+
 /// @brief  Describes the requested render API for the backend.
 enum class RenderBackendType {
     OpenGLRenderBackend = 0,    ///< OpenGL render API.
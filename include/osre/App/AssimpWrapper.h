@@ -83,6 +83,12 @@ public:
     /// @brief Name to animation track relation alias.
     using AnimationMap = std::map<const char*, Animation::AnimationTrack*>;
 
+    /// @brief Alias for the skins, parallel to the imported meshes.
+    using SkinArray = cppcore::TArray<Animation::Skin*>;
+
+    /// @brief Alias for the imported animation tracks.
+    using AnimationTrackArray = cppcore::TArray<Animation::AnimationTrack*>;
+
     /// @brief The class constructor.
     /// @param ids      The id container.
     /// @param world    The world to put the imported entity in.
@@ -108,18 +114,37 @@ public:
 
     const aiScene *getScene() const;
 
+    /// @brief  Enables the conversion into quantized render vertices, disabled by default.
+    /// @param  enabled     true to quantize all imported meshes.
+    void setQuantizeVertices(bool enabled);
+
+    /// @brief  Returns true, if imported meshes will be quantized.
+    /// @return The quantization state.
+    bool getQuantizeVertices() const;
+
+    /// @brief  Will return the skins of the imported meshes, the array is parallel to the meshes
+    /// of the render component. Meshes without bones have no skin. The caller takes the ownership.
+    /// @return The skins.
+    const SkinArray &getSkins() const;
+
+    /// @brief  Will return the imported animation tracks. The caller takes the ownership.
+    /// @return The animation tracks.
+    const AnimationTrackArray &getAnimationTracks() const;
+
 protected:
     Entity *convertScene();
     void importMeshes( aiMesh **meshes, ui32 numMeshes );
 	//void importBones(aiMesh* mesh);
     void importNode( aiNode *node, TransformComponent *parent );
     void importMaterial( aiMaterial *material );
+    void importSkin(const cppcore::TArray<size_t> &meshIndices, size_t numVertices, Animation::Skin &skin);
     void importSkeletons(aiSkeleton *skeletons, size_t numSkeletons);
     void importAnimation(aiAnimation *animation, Animation::AnimationTrack &currentAnimationTrack, AnimationMap &animLookup);
     void optimizeVertexBuffer();
 
 private:
     Assimp::Importer *mImporter;
+    bool mQuantizeVertices;
     struct AssetContext {
         const aiScene *mScene;
         RenderBackend::MeshArray mMeshArray;
@@ -132,6 +157,8 @@ private:
         String mRoot;
         String mAbsPathWithFile;
         Bone2NodeMap mBone2NodeMap;
+        SkinArray mSkinArray;
+        AnimationTrackArray mAnimationTracks;
         ui32 mNumVertices;
         ui32 mNumTriangles;
         
@@ -144,5 +171,21 @@ private:
     AssetContext mAssetContext;
 };
 
+inline void AssimpWrapper::setQuantizeVertices(bool enabled) {
+    mQuantizeVertices = enabled;
+}
+
+inline bool AssimpWrapper::getQuantizeVertices() const {
+    return mQuantizeVertices;
+}
+
+inline const AssimpWrapper::SkinArray &AssimpWrapper::getSkins() const {
+    return mAssetContext.mSkinArray;
+}
+
+inline const AssimpWrapper::AnimationTrackArray &AssimpWrapper::getAnimationTracks() const {
+    return mAssetContext.mAnimationTracks;
+}
+
 } // Namespace Assets
 } // Namespace OSRE
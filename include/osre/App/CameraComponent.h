@@ -40,6 +40,25 @@ enum class CameraModel {
     InvalidModel
 };
 
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  The camera data, stored by value in the camera pool of the registry.
+//-------------------------------------------------------------------------------------------------
+struct OSRE_EXPORT CameraState {
+    CameraModel mCameraModel;
+    f32 mFov;
+    TResolution<f32> mResolution;
+    f32 mNear, mFar;
+    f32 mAspectRatio;
+    f32 mLeft, mRight, mTop, mBottom;
+    glm::vec3 mEye, mCenter, mUp;
+    glm::mat4 mView, mProjection;
+
+    /// @brief  The default class constructor.
+    CameraState();
+};
+
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
@@ -143,56 +162,57 @@ public:
     /// @brief
     const glm::vec3 &getUp() const;
 
+    /// @brief  Will compute the view and the projection matrix of the camera data.
+    /// @param  data    [inout] The camera data.
+    static void updateMatrices(CameraState &data);
+
 protected:
     bool onUpdate(Time dt) override;
     bool onRender(RenderBackend::RenderBackendService *renderBackendSrv) override;
+    void onAttach(ComponentRegistry &registry, ui32 slot) override;
+    void onDetach(ComponentRegistry &registry, ui32 slot) override;
+    CameraState &getData();
+    const CameraState &getData() const;
 
 private:
     bool mRecalculateRequested;
-    CameraModel mCameraModel;
-    f32 m_fov;
-    TResolution<f32> mResolution;
-    f32 m_near, m_far;
-    f32 m_aspectRatio;
-    f32 m_left, m_right, m_top, m_bottom;
-    glm::vec3 m_eye, m_center, m_up;
-    glm::mat4 m_view, m_projection;
+    CameraState mData;
 };
 
 inline CameraModel Camera::getCameraModel() const {
-    return mCameraModel;
+    return getData().mCameraModel;
 }
 
 inline void Camera::setEyePos(const glm::vec3 &eyePosistion) {
-    m_eye = eyePosistion;
+    getData().mEye = eyePosistion;
 }
 
 inline f32 Camera::getFov() const {
-    return m_fov;
+    return getData().mFov;
 }
 
 inline f32 Camera::getAspectRatio() const {
-    return m_aspectRatio;
+    return getData().mAspectRatio;
 }
 
 inline f32 Camera::getNear() const {
-    return m_near;
+    return getData().mNear;
 }
 
 inline f32 Camera::getFar() const {
-    return m_far;
+    return getData().mFar;
 }
 
 inline const glm::vec3 &Camera::getEye() const {
-    return m_eye;
+    return getData().mEye;
 }
 
 inline const glm::vec3 &Camera::getCenter() const {
-    return m_center;
+    return getData().mCenter;
 }
 
 inline const glm::vec3 &Camera::getUp() const {
-    return m_up;
+    return getData().mUp;
 }
 
 } // Namespace App
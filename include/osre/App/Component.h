@@ -41,6 +41,7 @@ namespace App {
 
 class Entity;
 class TransformComponent;
+class ComponentRegistry;
 
 ///	@brief This enum describes the component type.
 enum class ComponentType {
@@ -59,8 +60,8 @@ enum class ComponentType {
 //-------------------------------------------------------------------------------------------------
 class OSRE_EXPORT Component {
 public:
-    /// @brief The default class destructor.
-    virtual ~Component() = default;
+    /// @brief The class destructor, will remove the component from the pools of its registry.
+    virtual ~Component();
 
     /// @brief The update callback
     /// @param[in] timeSlice The time slice
@@ -83,6 +84,10 @@ public:
     /// @return The type as the index.
     static size_t getIndex(ComponentType type);
 
+    /// @brief  Returns true, if the data of the component is stored in the pools of a registry.
+    /// @return true, if pooled.
+    bool isPooled() const;
+
 protected:
     /// @brief The class constructor.
     /// @param[in] owner  The component type.
@@ -99,9 +104,31 @@ protected:
     /// @return 
     virtual bool onRender(RenderBackend::RenderBackendService *renderBackendSrv) = 0;
 
+    /// @brief  Will be called, when the component was added to a registry. Components with pooled
+    /// data move it into the pool of the slot and access it there from now on.
+    /// @param  registry    [in] The registry.
+    /// @param  slot        [in] The entity slot.
+    virtual void onAttach(ComponentRegistry &registry, ui32 slot);
+
+    /// @brief  Will be called, before the component will be removed from a registry. Pooled data
+    /// will be copied back into the component.
+    /// @param  registry    [in] The registry.
+    /// @param  slot        [in] The entity slot.
+    virtual void onDetach(ComponentRegistry &registry, ui32 slot);
+
+    /// @brief  Returns the registry, which stores the data, or nullptr.
+    ComponentRegistry *getRegistry() const;
+
+    /// @brief  Returns the entity slot in the registry.
+    ui32 getSlot() const;
+
 private:
+    friend class ComponentRegistry;
+
     Entity *m_owner;
     ComponentType mType;
+    ComponentRegistry *mRegistry;
+    ui32 mSlot;
 };
 
 inline Entity *Component::getOwner() const {
@@ -116,6 +143,31 @@ inline size_t Component::getIndex( ComponentType type ) {
     return static_cast<size_t>(type);
 }
 
+inline bool Component::isPooled() const {
+    return nullptr != mRegistry;
+}
+
+inline ComponentRegistry *Component::getRegistry() const {
+    return mRegistry;
+}
+
+inline ui32 Component::getSlot() const {
+    return mSlot;
+}
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  The render data of an entity, stored by value in the render pool of the registry. The
+/// material of a mesh is referenced by the mesh itself.
+//-------------------------------------------------------------------------------------------------
+struct RenderData {
+    RenderBackend::MeshArray mMeshes;   ///< All static meshes.
+    size_t mNumSubmitted;               ///< The meshes in front are already submitted.
+
+    RenderData() : mMeshes(), mNumSubmitted(0) {}
+};
+
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
@@ -151,12 +203,21 @@ public:
     /// @param array 
     void addStaticMeshArray(const RenderBackend::MeshArray &array);
 
+    /// @brief  Will submit all meshes, which were not submitted before.
+    /// @param  data        [in] The render data.
+    /// @param  rbSrv       [in] The render backend service.
+    static void submitMeshes(RenderData &data, RenderBackend::RenderBackendService *rbSrv);
+
 protected:
     bool onUpdate(Time dt) override;
     bool onRender(RenderBackend::RenderBackendService *rbSrv) override;
+    void onAttach(ComponentRegistry &registry, ui32 slot) override;
+    void onDetach(ComponentRegistry &registry, ui32 slot) override;
+    RenderData &getData();
+    const RenderData &getData() const;
 
 private:
-    cppcore::TArray<RenderBackend::Mesh*> m_newGeo;
+    RenderData mData;
 };
 
 //-------------------------------------------------------------------------------------------------
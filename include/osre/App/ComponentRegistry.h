@@ -0,0 +1,225 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/App/Component.h>
+#include <osre/App/CameraComponent.h>
+#include <osre/Common/TAABB.h>
+#include <osre/Common/TSparseSet.h>
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace App {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class stores the transformation data of the pooled transform components. Each
+/// field has its own densely packed array, the arrays are keyed by the entity slot.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT TransformPool {
+public:
+    static constexpr ui32 InvalidIndex = 0xffffffff;
+
+    /// @brief  The state flags of a transformation.
+    enum Flags : uc8 {
+        LocalDirty = 1,     ///< The local matrix needs to be composed.
+        WorldDirty = 2,     ///< The world matrix needs to be recomputed.
+        WorldMoved = 4,     ///< The world matrix has changed and was not collected yet.
+        HasParent = 8       ///< The node has a parent, so it is updated by its hierarchy.
+    };
+
+    /// @brief  The default class constructor.
+    TransformPool();
+
+    /// @brief  The class destructor.
+    ~TransformPool() = default;
+
+    /// @brief  Will add an identity transformation for a slot.
+    /// @param  slot    [in] The entity slot.
+    /// @return The dense index.
+    ui32 add(ui32 slot);
+
+    /// @brief  Will remove the transformation of a slot, the last one will be moved into the gap.
+    /// @param  slot    [in] The entity slot.
+    /// @return true, if the slot was found.
+    bool remove(ui32 slot);
+
+    /// @brief  Returns the dense index of a slot or InvalidIndex.
+    ui32 indexOf(ui32 slot) const;
+
+    /// @brief  Returns the number of stored transformations.
+    size_t size() const;
+
+    cppcore::TArray<ui32> mSlots;               ///< The slot of each entry.
+    cppcore::TArray<glm::vec3> mTranslation;    ///< The local translation.
+    cppcore::TArray<glm::quat> mRotation;       ///< The local rotation.
+    cppcore::TArray<glm::vec3> mScale;          ///< The local scaling.
+    cppcore::TArray<glm::mat4> mLocal;          ///< The composed local matrix.
+    cppcore::TArray<glm::mat4> mWorld;          ///< The world matrix.
+    cppcore::TArray<uc8> mFlags;                ///< The state flags.
+
+private:
+    cppcore::TArray<ui32> mSparse;
+};
+
+inline ui32 TransformPool::indexOf(ui32 slot) const {
+    return slot < mSparse.size() ? mSparse[slot] : InvalidIndex;
+}
+
+inline size_t TransformPool::size() const {
+    return mSlots.size();
+}
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class stores the components of all entities of a world, keyed by the entity slot.
+/// The hot data of the components is stored by value: transformations, boxes, render and camera
+/// data have pools of their own, so the systems of the world iterate over plain arrays. The
+/// components themselves are facades, which access their data in the pools by their slot. The
+/// component pointers are kept per type to resolve the component of a slot.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT ComponentRegistry {
+public:
+    static constexpr ui32 InvalidSlot = 0xffffffff;
+    using ComponentPool = Common::TSparseSet<Component*>;
+    using RenderPool = Common::TSparseSet<RenderData>;
+    using CameraPool = Common::TSparseSet<CameraState>;
+
+    /// @brief  The default class constructor.
+    ComponentRegistry();
+
+    /// @brief  The class destructor, the data of all components will be copied back.
+    ~ComponentRegistry();
+
+    /// @brief  Will allocate a new entity slot.
+    /// @return The slot.
+    ui32 allocSlot();
+
+    /// @brief  Will remove all components of a slot and release it.
+    /// @param  slot        [in] The slot to release.
+    void releaseSlot(ui32 slot);
+
+    /// @brief  Will add a component, its data will be moved into the pool of its type.
+    /// @param  slot        [in] The entity slot.
+    /// @param  component   [in] The component.
+    void addComponent(ui32 slot, Component *component);
+
+    /// @brief  Will remove a component, its data will be copied back into the component.
+    /// @param  slot        [in] The entity slot.
+    /// @param  type        [in] The component type.
+    void removeComponent(ui32 slot, ComponentType type);
+
+    /// @brief  Returns the component of a slot or nullptr.
+    Component *getComponent(ui32 slot, ComponentType type) const;
+
+    /// @brief  Returns the pool of a component type.
+    const ComponentPool &getPool(ComponentType type) const;
+
+    /// @brief  Returns the number of components of a type.
+    size_t getNumComponents(ComponentType type) const;
+
+    /// @brief  Returns the number of slots ever allocated, all slots are smaller than this.
+    ui32 getSlotCapacity() const;
+
+    /// @brief  Will call the functor for each component of a type in pool order.
+    /// @param  type        [in] The component type.
+    /// @param  func        [in] The functor, called with the slot and the component.
+    template<class TFunc>
+    void forEach(ComponentType type, TFunc func) const;
+
+    /// @brief  Returns the transformations of the transform components.
+    TransformPool &getTransforms();
+
+    /// @brief  Returns the render data of the render components.
+    RenderPool &getRenderPool();
+
+    /// @brief  Returns the camera data of the camera components.
+    CameraPool &getCameras();
+
+    /// @brief  Returns the box of a slot in entity space.
+    Common::AABB &getLocalBounds(ui32 slot);
+
+    /// @brief  Returns the box of a slot in world space.
+    Common::AABB &getWorldBounds(ui32 slot);
+
+private:
+    void removeData(ui32 slot, ComponentType type);
+
+private:
+    ComponentPool mPools[static_cast<size_t>(ComponentType::MaxNumComponents)];
+    TransformPool mTransforms;
+    RenderPool mRenderPool;
+    CameraPool mCameras;
+    cppcore::TArray<Common::AABB> mLocalBounds;
+    cppcore::TArray<Common::AABB> mWorldBounds;
+    cppcore::TArray<ui32> mFreeSlots;
+    ui32 mNextSlot;
+};
+
+inline const ComponentRegistry::ComponentPool &ComponentRegistry::getPool(ComponentType type) const {
+    return mPools[Component::getIndex(type)];
+}
+
+inline size_t ComponentRegistry::getNumComponents(ComponentType type) const {
+    return getPool(type).size();
+}
+
+inline ui32 ComponentRegistry::getSlotCapacity() const {
+    return mNextSlot;
+}
+
+template<class TFunc>
+inline void ComponentRegistry::forEach(ComponentType type, TFunc func) const {
+    const ComponentPool &pool = getPool(type);
+    for (size_t i = 0; i < pool.size(); ++i) {
+        func(pool.getKeyAt(i), pool.getAt(i));
+    }
+}
+
+inline TransformPool &ComponentRegistry::getTransforms() {
+    return mTransforms;
+}
+
+inline ComponentRegistry::RenderPool &ComponentRegistry::getRenderPool() {
+    return mRenderPool;
+}
+
+inline ComponentRegistry::CameraPool &ComponentRegistry::getCameras() {
+    return mCameras;
+}
+
+inline Common::AABB &ComponentRegistry::getLocalBounds(ui32 slot) {
+    osre_assert(slot < mLocalBounds.size());
+    return mLocalBounds[slot];
+}
+
+inline Common::AABB &ComponentRegistry::getWorldBounds(ui32 slot) {
+    osre_assert(slot < mWorldBounds.size());
+    return mWorldBounds[slot];
+}
+
+} // namespace App
+} // namespace OSRE
@@ -59,17 +59,25 @@ public:
     ~Entity() override;
     void setBehaviourControl(AbstractBehaviour *behaviour );
     void setNode( TransformComponent *node );
+    /// @brief  Returns the node, which places the entity, the transform component if no node was set.
     TransformComponent *getNode() const;
     bool update( Time dt );
+    void updateBehaviour(Time dt);
     bool render( RenderBackend::RenderBackendService *rbSrv );
     Component *createComponent(ComponentType type);
     Component *getComponent(ComponentType type) const;
     void setAABB( const Common::AABB &aabb );
     const Common::AABB &getAABB() const;
+    void setOccluder(bool occluder);
+    bool isOccluder() const;
+    ui32 getSlot() const;
+    EntityHandle getHandle() const;
     void serialize(IO::Stream *stream);
     void deserialize(IO::Stream *stream);
 
 private:
+    friend class World;
+
     AbstractBehaviour *m_behaviour;
     RenderComponent *m_renderComponent;
     using ComponentArray = cppcore::TArray<Component*>;
@@ -78,7 +86,26 @@ private:
     Common::Ids &mIds;
     Common::AABB m_aabb;
     World *mOwner;
+    bool mOccluder;
+    ui32 mSlot;
+    EntityHandle mHandle;
 };
 
+inline void Entity::setOccluder(bool occluder) {
+    mOccluder = occluder;
+}
+
+inline bool Entity::isOccluder() const {
+    return mOccluder;
+}
+
+inline ui32 Entity::getSlot() const {
+    return mSlot;
+}
+
+inline EntityHandle Entity::getHandle() const {
+    return mHandle;
+}
+
 } // Namespace App
 } // Namespace OSRE
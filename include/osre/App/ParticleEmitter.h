@@ -26,9 +26,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Common/TAABB.h>
 #include <osre/Common/BaseMath.h>
 
-#include <GL/glew.h>
-#include <GL/gl.h>
-
 namespace OSRE {
 
 // Forward declarations ---------------------------------------------------------------------------
@@ -41,27 +38,120 @@ namespace App {
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
-///	@brief	This class offers some system-specific functions.
+///	@brief	This class implements a point particle emitter.
+///
+/// The particles are stored as structure of arrays and integrated with SSE, four particles per
+/// step. Emitters with many particles are updated by the worker pool. Alive particles are kept
+/// densely packed at the front of the arrays, dead ones will be replaced by the last alive one.
+/// The positions are written directly into the streaming vertex buffer of the point mesh, its
+/// draw count follows the number of alive particles.
 //-------------------------------------------------------------------------------------------------
 class OSRE_EXPORT ParticleEmitter {
 public:
+    /// @brief  The lifetime of particles, which will live forever.
+    static constexpr f32 Infinite = 0.0f;
+
+    /// @brief  The class constructor.
+    /// @param  rbSrv       [in] The render backend, can be nullptr for simulation only.
     ParticleEmitter( RenderBackend::RenderBackendService *rbSrv );
+
+    /// @brief  The class destructor.
     ~ParticleEmitter();
+
+    /// @brief  Will allocate the particle storage and the point mesh and emit all particles.
+    /// @param  numPoints   [in] The maximal number of particles.
     void init( ui32 numPoints );
+
+    /// @brief  Will spawn, integrate and kill particles and write the vertex buffer.
+    /// @param  tick        [in] The time step in seconds.
     void update( d32 tick );
+
+    /// @brief  Particles leaving the bounds will be killed.
+    /// @param  bounds      [in] The bounds.
     void setBounds(const Common::AABB& bounds);
+
+    /// @brief  Will set the number of particles spawned per second, 0 by default.
+    /// @param  particlesPerSecond  [in] The spawn rate.
+    void setSpawnRate(f32 particlesPerSecond);
+
+    /// @brief  Will set the range of the particle lifetime in seconds, Infinite by default.
+    /// @param  minLifetime [in] The minimal lifetime.
+    /// @param  maxLifetime [in] The maximal lifetime.
+    void setLifetime(f32 minLifetime, f32 maxLifetime);
+
+    /// @brief  Will set the box in which new particles will be placed.
+    /// @param  min         [in] The minimum of the box.
+    /// @param  max         [in] The maximum of the box.
+    void setSpawnVolume(const glm::vec3 &min, const glm::vec3 &max);
+
+    /// @brief  Will set the range of the initial particle velocity.
+    /// @param  min         [in] The minimal velocity per axis.
+    /// @param  max         [in] The maximal velocity per axis.
+    void setVelocity(const glm::vec3 &min, const glm::vec3 &max);
+
+    /// @brief  Will set the constant acceleration, for instance the gravity.
+    /// @param  acceleration    [in] The acceleration.
+    void setAcceleration(const glm::vec3 &acceleration);
+
+    /// @brief  Will reseed the random generator of the emitter.
+    /// @param  seed        [in] The new seed, 0 is not allowed.
+    void setSeed(ui32 seed);
+
+    /// @brief  Will spawn new particles, as long as the capacity is not reached.
+    /// @param  count       [in] The number of particles to spawn.
+    /// @return The number of spawned particles.
+    ui32 emit(ui32 count);
+
+    /// @brief  Returns the number of alive particles.
+    ui32 getNumAlive() const;
+
+    /// @brief  Returns the maximal number of particles.
+    ui32 getCapacity() const;
+
+    /// @brief  Returns the position of an alive particle.
+    glm::vec3 getPosition(ui32 index) const;
+
+    /// @brief  Returns the point mesh.
     RenderBackend::Mesh* getMesh() const;
 
+private:
+    void integrate(size_t begin, size_t end, f32 dt);
+    void killDead();
+    void writeVertices(size_t begin, size_t end);
+    void copyParticle(ui32 from, ui32 to);
+    f32 nextRandom(f32 min, f32 max);
+
 private:
     RenderBackend::RenderBackendService *m_rbSrv;
     ui32 m_numPoints;
-    glm::vec3 *m_col;
-    glm::vec3 *m_pos;
-    GLushort *m_pt_indices;
+    ui32 mNumAlive;
+    cppcore::TArray<f32> mPosX, mPosY, mPosZ;
+    cppcore::TArray<f32> mVelX, mVelY, mVelZ;
+    cppcore::TArray<f32> mColR, mColG, mColB;
+    cppcore::TArray<f32> mAge, mLifetime;
     RenderBackend::Mesh *m_ptGeo;
     bool mUseBounds;
     Common::AABB mBounds;
+    f32 mSpawnRate;
+    f32 mSpawnAccumulator;
+    f32 mMinLifetime, mMaxLifetime;
+    glm::vec3 mSpawnMin, mSpawnMax;
+    glm::vec3 mVelocityMin, mVelocityMax;
+    glm::vec3 mAcceleration;
+    ui32 mRandomState;
 };
 
+inline ui32 ParticleEmitter::getNumAlive() const {
+    return mNumAlive;
+}
+
+inline ui32 ParticleEmitter::getCapacity() const {
+    return m_numPoints;
+}
+
+inline glm::vec3 ParticleEmitter::getPosition(ui32 index) const {
+    return glm::vec3(mPosX[index], mPosY[index], mPosZ[index]);
+}
+
 } // Namespace App
 } // Namespace OSRE
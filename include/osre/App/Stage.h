@@ -94,10 +94,19 @@ public:
         return mRenderWorlds.isEmpty();
     }
 
-    /// @brief  Will update the world.
+    /// @brief  Will update all active worlds. When all worlds are updated the call returns, so it
+    /// works as a barrier before render is called.
     /// @param  dt      [in] The current delta time-tick.
     void update(Time dt);
 
+    /// @brief  Will enable or disable the concurrent update of the active worlds, disabled by default.
+    /// @param  enabled [in] true to update the worlds in parallel.
+    void setParallelUpdate(bool enabled);
+
+    /// @brief  Returns true, if the worlds are updated in parallel.
+    /// @return The parallel update state.
+    bool isParallelUpdateEnabled() const;
+
     /// @brief  Will render the world-
     /// @param  rbService   [in] The renderbackend.
     void render(RenderBackend::RenderBackendService *rbService);
@@ -105,7 +114,16 @@ public:
 private:
     WorldArray mWorlds;
     WorldArray mRenderWorlds;
+    bool mParallelUpdate;
 };
 
+inline void Stage::setParallelUpdate(bool enabled) {
+    mParallelUpdate = enabled;
+}
+
+inline bool Stage::isParallelUpdateEnabled() const {
+    return mParallelUpdate;
+}
+
 } // namespace App
 } // namespace OSRE
@@ -33,6 +33,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <cppcore/Container/TArray.h>
 #include <cppcore/Container/THashMap.h>
 
+#include <atomic>
+
 namespace OSRE {
 
 // Forward declarations ---------------------------------------------------------------------------
@@ -91,21 +93,97 @@ public:
     virtual void setActive(bool isActive);
     virtual bool isActive() const;
 
+    /// @brief  Will translate the node in its local frame.
+    /// @param  pos     [in] The translation.
     void translate(const glm::vec3 &pos);
+
+    /// @brief  Will scale the node.
+    /// @param  pos     [in] The scaling factors.
     void scale(const glm::vec3 &pos);
+
+    /// @brief  Will rotate the node around an axis of its local frame.
+    /// @param  angle   [in] The angle in radians.
+    /// @param  axis    [in] The rotation axis.
     void rotate(f32 angle, const glm::vec3 &axis);
-    void setRotation(glm::quat &rotation);
+
+    /// @brief  Will set the local translation.
+    void setTranslation(const glm::vec3 &translation);
+
+    /// @brief  Returns the local translation.
+    const glm::vec3 &getTranslation() const;
+
+    /// @brief  Will set the local rotation.
+    void setRotation(const glm::quat &rotation);
+
+    /// @brief  Returns the local rotation.
+    const glm::quat &getRotation() const;
+
+    /// @brief  Will set the local scaling.
+    void setScale(const glm::vec3 &scale);
+
+    /// @brief  Returns the local scaling.
+    const glm::vec3 &getScale() const;
+
+    /// @brief  Will set the local transformation, the matrix will be decomposed.
+    /// @param  m       [in] The local transformation matrix.
     void setTransformationMatrix(const glm::mat4 &m);
+
+    /// @brief  Returns the local transformation matrix, composed on demand.
+    /// @return The local transformation matrix.
     const glm::mat4 &getTransformationMatrix() const;
-    glm::mat4 getWorlTransformMatrix();
+
+    /// @brief  Returns the world transformation matrix. It is cached and only recomputed when
+    /// the node or one of its parents was changed.
+    /// @return The world transformation matrix.
+    const glm::mat4 &getWorlTransformMatrix();
+
+    /// @brief  Will update the world transformations of this node and all dirty children.
+    /// @param  moved   [out] Optional, will receive all nodes whose world transformation has
+    /// changed since they were collected the last time. Without it the nodes stay marked.
+    void updateWorldTransforms(NodeArray *moved = nullptr);
+
+    /// @brief  Returns true, if the world transformation needs to be recomputed.
+    bool isWorldTransformDirty() const;
+
+    /// @brief  Returns true, if the node or one of its children needs an update or was moved
+    /// without being collected.
+    bool needsTransformUpdate() const;
+
+    /// @brief  Returns a counter, which changes whenever a node was created, destroyed or
+    /// reparented. Allows to cache the roots of the hierarchies.
+    /// @return The hierarchy version.
+    static ui32 getHierarchyVersion();
 
     void addMeshReference(size_t entityMeshIdx);
     size_t getNumMeshReferences() const;
     size_t getMeshReferenceAt(size_t index) const;
 
+    /// @brief  Will compose the local transformation matrix.
+    /// @param  translation [in] The translation.
+    /// @param  rotation    [in] The rotation.
+    /// @param  scale       [in] The scaling.
+    /// @return The local transformation matrix.
+    static glm::mat4 composeMatrix(const glm::vec3 &translation, const glm::quat &rotation, const glm::vec3 &scale);
+
 protected:
+    /// @brief  The transformation data of the node, stored in the transform pool when pooled.
+    struct State {
+        glm::vec3 &mTranslation;
+        glm::quat &mRotation;
+        glm::vec3 &mScale;
+        glm::mat4 &mLocalTransform;
+        glm::mat4 &mWorldTransform;
+        uc8 &mFlags;
+    };
+
     bool onUpdate(Time dt) override;
     bool onRender(RenderBackend::RenderBackendService *rbSrv) override;
+    void onAttach(ComponentRegistry &registry, ui32 slot) override;
+    void onDetach(ComponentRegistry &registry, ui32 slot) override;
+    State getState() const;
+    void setLocalDirty();
+    void setWorldDirty();
+    void setChildDirty();
 
 private:
     NodeArray mChildren;
@@ -113,8 +191,13 @@ private:
     MeshReferenceArray mMeshRefererenceArray;
     bool mIsActive;
     Common::Ids *mIds;
+    glm::vec3 mTranslation;
+    glm::quat mRotation;
+    glm::vec3 mScale;
     glm::mat4 mLocalTransform;
     glm::mat4 mWorldTransform;
+    uc8 mFlags;
+    std::atomic<bool> mChildDirty;
 };
 
 inline void TransformComponent::setActive(bool isActive) {
@@ -125,5 +208,17 @@ inline bool TransformComponent::isActive() const {
     return mIsActive;
 }
 
+inline const glm::vec3 &TransformComponent::getTranslation() const {
+    return getState().mTranslation;
+}
+
+inline const glm::quat &TransformComponent::getRotation() const {
+    return getState().mRotation;
+}
+
+inline const glm::vec3 &TransformComponent::getScale() const {
+    return getState().mScale;
+}
+
 } // Namespace App
 } // namespace OSRE
@@ -23,12 +23,18 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include <osre/App/AppCommon.h>
+#include <osre/App/ComponentRegistry.h>
 #include <osre/Scene/SceneCommon.h>
 #include <osre/Common/Object.h>
 #include <osre/Common/Ids.h>
+#include <osre/Common/Frustum.h>
+#include <osre/Common/BoundingVolumeTree.h>
+#include <osre/Common/OcclusionBuffer.h>
 #include <cppcore/Container/TArray.h>
 #include <cppcore/Container/THashMap.h>
 
+#include <mutex>
+
 namespace OSRE {
 namespace App {
 
@@ -46,6 +52,13 @@ class Entity;
 //-------------------------------------------------------------------------------------------------
 class OSRE_EXPORT World : public Common::Object {
 public:
+    /// @brief  Describes how the entities will be updated.
+    enum class UpdateMode {
+        Serial,                 ///< All entities are updated in order by the calling thread.
+        Parallel,               ///< Behaviours and components are updated by the worker pool.
+        ParallelDeterministic   ///< Behaviours are updated in order, components in parallel.
+    };
+
     /// @brief  The class constructor with the name and the requested render-mode.
     /// @param  worldName   [in] The world name.
     /// @param  renderMode  [in] The requested render mode. @see RenderMode
@@ -54,27 +67,49 @@ public:
     /// @brief  The class destructor.
     ~World() override;
 
-    /// @brief Will add a new entity.
+    /// @brief Will add a new entity, the entity will get a new handle.
     /// @param entity   The entity to add.
     void addEntity(Entity *entity);
     
-    /// @brief Will remove the entity from the world.
+    /// @brief Will remove the entity from the world, the handle of the entity gets stale.
     /// @param entity   The entity to remove.
     bool removeEntity(Entity *entity);
 
+    /// @brief Will mark the bounds of an entity as changed, its proxy in the spatial index will be
+    /// refit by the next update. Moved nodes are detected by the update itself.
+    /// @param entity   The entity with the changed box or node.
+    void invalidateBounds(Entity *entity);
+
     /// @brief Will search, if the entity is already part of the world instance.
     /// @param[in] name  The entity name to look for.
     /// @return A pointer showing ot the entity or nullptr, if nothing was found.
     Entity *findEntity(const String &name);
 
+    /// @brief Will return the entity of a handle.
+    /// @param[in] handle   The entity handle.
+    /// @return The entity or nullptr, if the handle is stale.
+    Entity *getEntity(EntityHandle handle) const;
+
+    /// @brief Will rename an entity and update the name index. Entities of the world shall be
+    /// renamed by this method only, otherwise they cannot be found by their new name.
+    /// @param[in] entity   The entity to rename.
+    /// @param[in] name     The new name.
+    /// @return true if successful, false in case of an error.
+    bool renameEntity(Entity *entity, const String &name);
+
+    /// @brief Returns the number of entities.
+    /// @return The number of entities.
+    size_t getNumEntities() const;
+
     /// @brief Will set the new active camera.
     /// @param[in] camera   The new camera.
     /// @return true if successful, false in case of an error.
     bool setActiveCamera(Camera *camera);
     
-    /// @brief 
-    /// @param name 
-    /// @return 
+    /// @brief Will look up an entity by its name using the name index. If more than one entity
+    /// has this name, the first added one will be returned.
+    /// @param name     The entity name.
+    /// @return The entity or nullptr, if nothing was found.
     Entity *getEntityByName( const String &name ) const;
 
     ///	@brief
@@ -88,10 +123,27 @@ public:
     /// @return 
     TransformComponent *getRootNode() const;
 
-    /// @brief  Will update the world.
+    /// @brief  Will update the world, same as updateActiveCamera followed by updateEntities.
     /// @param  dt      [in] The current delta time-tick.
     void update( Time dt );
 
+    /// @brief  Will update the active camera only.
+    /// @param  dt      [in] The current delta time-tick.
+    void updateActiveCamera(Time dt);
+
+    /// @brief  Will update all entities. In the parallel modes all work is finished when the call
+    /// returns, so it works as a barrier before render is called.
+    /// @param  dt      [in] The current delta time-tick.
+    void updateEntities(Time dt);
+
+    /// @brief  Will set the update mode, serial by default.
+    /// @param  mode    [in] The new update mode.
+    void setUpdateMode(UpdateMode mode);
+
+    /// @brief  Returns the update mode.
+    /// @return The update mode.
+    UpdateMode getUpdateMode() const;
+
     /// @brief  Will render the world-
     /// @param  rbService   [in] The renderbackend.
     void render( RenderBackend::RenderBackendService *rbService );
@@ -99,17 +151,129 @@ public:
     /// @brief  Will return the id container.
     /// @return The Id container.    
     Common::Ids &getIds();
-    
+
+    /// @brief  Will return the component pools of all entities.
+    /// @return The component registry.
+    ComponentRegistry &getComponentRegistry();
+
+    /// @brief  Will enable or disable the frustum culling of entities, enabled by default.
+    /// @param  enabled     [in] true to enable culling.
+    void setFrustumCulling(bool enabled);
+
+    /// @brief  Returns true, if frustum culling is enabled.
+    /// @return The culling state.
+    bool isFrustumCullingEnabled() const;
+
+    /// @brief  Returns the number of entities submitted during the last render call.
+    /// @return The number of visible entities.
+    ui32 getNumVisibleEntities() const;
+
+    /// @brief  Returns the number of entities culled during the last render call.
+    /// @return The number of culled entities.
+    ui32 getNumCulledEntities() const;
+
+    /// @brief  Returns the number of entities refit in the spatial index during the last update.
+    /// @return The number of refit entities.
+    ui32 getNumRefitEntities() const;
+
+    /// @brief  Will enable or disable the occlusion culling, disabled by default.
+    /// Entities marked as occluders ( @see Entity::setOccluder ) are rasterized into a software
+    /// depth buffer, all other entities will be tested against it.
+    /// @param  enabled     [in] true to enable occlusion culling.
+    void setOcclusionCulling(bool enabled);
+
+    /// @brief  Returns true, if occlusion culling is enabled.
+    /// @return The occlusion culling state.
+    bool isOcclusionCullingEnabled() const;
+
+    /// @brief  Returns the number of entities hidden by occluders during the last render call.
+    /// @return The number of occluded entities.
+    ui32 getNumOccludedEntities() const;
+
+    /// @brief  Will collect all entities inside the frustum.
+    /// @param  frustum     [in] The frustum.
+    /// @param  entities    [out] The found entities.
+    void queryEntities(const Common::Frustum &frustum, cppcore::TArray<Entity*> &entities) const;
+
+    /// @brief  Will collect all entities overlapping the box.
+    /// @param  aabb        [in] The box in world space.
+    /// @param  entities    [out] The found entities.
+    void queryEntities(const Common::AABB &aabb, cppcore::TArray<Entity*> &entities) const;
+
+    /// @brief  Will collect all entities overlapping the sphere.
+    /// @param  center      [in] The center of the sphere in world space.
+    /// @param  radius      [in] The radius of the sphere.
+    /// @param  entities    [out] The found entities.
+    void queryEntities(const glm::vec3 &center, f32 radius, cppcore::TArray<Entity*> &entities) const;
+
+    /// @brief  Will return the nearest entity hit by the ray.
+    /// @param  ray         [in] The ray in world space.
+    /// @param  maxDistance [in] The maximal distance.
+    /// @return The nearest entity or nullptr, if nothing was hit.
+    Entity *pick(const Common::Ray &ray, f32 maxDistance) const;
+
 protected:
     void updateBoundingTrees();
+    void updateSpatialIndex();
+    void cullEntities();
+    void updateBehaviours(Time dt);
+    void updateCameras();
+    void updateTransformRoots();
+    void updatePooledTransforms();
+    void updateTransforms();
+    void invalidateSlot(ui32 slot);
+    void markForRefit(size_t index);
+    void renderMeshes(RenderBackend::RenderBackendService *rbSrv);
+    void cullOccludedEntities(const Common::Frustum &frustum, const glm::mat4 &viewProjection);
+    static void toEntities(const cppcore::TArray<void*> &data, cppcore::TArray<Entity*> &entities);
+    void addToNameIndex(EntityHandle handle);
+    void removeFromNameIndex(EntityHandle handle);
 
 private:
+    struct EntityRecord {
+        ui32 mIndex;                ///< The index in mEntities.
+        HashId mNameHash;           ///< The hash of the entity name.
+        EntityHandle mNextByName;   ///< The next entity with the same name hash.
+        EntityHandle mLastByName;   ///< The last entity with the same name hash, valid in the first one.
+
+        EntityRecord() : mIndex(0), mNameHash(0), mNextByName(), mLastByName() {}
+    };
+
+    using NameIndex = cppcore::THashMap<HashId, ui32>;
+
     cppcore::TArray<Entity*> mEntities;
+    Common::TSlotMap<EntityRecord> mEntityRecords;
+    NameIndex mNameIndex;
     Camera *mActiveCamera;
     TransformComponent *mRoot;
     Common::Ids mIds;
+    ComponentRegistry mComponentRegistry;
+    cppcore::TArray<uc8> mVisibleSlots;
     RenderBackend::Pipeline *mPipeline;
     bool mDirtry;
+    UpdateMode mUpdateMode;
+    cppcore::TArray<TransformComponent*> mTransformRoots;
+    cppcore::TArray<TransformComponent*> mDirtyTransformRoots;
+    cppcore::TArray<TransformComponent*> mMovedNodes;
+    std::mutex mMovedNodesLock;
+    ui32 mTransformRootsVersion;
+    bool mTransformRootsDirty;
+    bool mFrustumCulling;
+    ui32 mNumVisible;
+    ui32 mNumCulled;
+    Common::BoundingVolumeTree mSpatialIndex;
+    cppcore::TArray<i32> mProxies;
+    cppcore::TArray<uc8> mRefitFlags;
+    cppcore::TArray<EntityHandle> mRefitEntities;
+    cppcore::TArray<EntityHandle> mSlotHandles;
+    ui32 mNumRefit;
+    cppcore::TArray<Entity*> mVisibleEntities;
+    struct OccluderGeometry;
+    cppcore::TArray<OccluderGeometry*> mOccluderGeometry;
+    Common::OcclusionBuffer mOcclusionBuffer;
+    cppcore::TArray<uc8> mOcclusionResult;
+    bool mOcclusionCulling;
+    ui32 mNumOccluded;
 };
 
 inline TransformComponent *World::getRootNode() const {
@@ -120,10 +284,58 @@ inline void World::getEntityArray(cppcore::TArray<Entity *> &entities) {
     entities = mEntities;
 }
 
+inline size_t World::getNumEntities() const {
+    return mEntities.size();
+}
+
 inline Common::Ids &World::getIds() {
     return mIds;
 }
 
+inline ComponentRegistry &World::getComponentRegistry() {
+    return mComponentRegistry;
+}
+
+inline void World::setUpdateMode(UpdateMode mode) {
+    mUpdateMode = mode;
+}
+
+inline World::UpdateMode World::getUpdateMode() const {
+    return mUpdateMode;
+}
+
+inline void World::setFrustumCulling(bool enabled) {
+    mFrustumCulling = enabled;
+}
+
+inline bool World::isFrustumCullingEnabled() const {
+    return mFrustumCulling;
+}
+
+inline ui32 World::getNumVisibleEntities() const {
+    return mNumVisible;
+}
+
+inline ui32 World::getNumCulledEntities() const {
+    return mNumCulled;
+}
+
+inline ui32 World::getNumRefitEntities() const {
+    return mNumRefit;
+}
+
+inline void World::setOcclusionCulling(bool enabled) {
+    mOcclusionCulling = enabled;
+}
+
+inline bool World::isOcclusionCullingEnabled() const {
+    return mOcclusionCulling;
+}
+
+inline ui32 World::getNumOccludedEntities() const {
+    return mNumOccluded;
+}
+
 } // Namespace App
 } // Namespace OSRE
 
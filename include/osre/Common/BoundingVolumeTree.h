@@ -0,0 +1,165 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+#include <osre/Common/TAABB.h>
+#include <osre/Common/TRay.h>
+#include <osre/Common/Frustum.h>
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace Common {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a dynamic bounding volume hierarchy. Every proxy is stored with
+/// a fattened box, so small movements will not touch the tree. When a proxy leaves its fat box
+/// it will be reinserted at the cheapest position and the tree is rebalanced by rotations.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT BoundingVolumeTree {
+public:
+    static constexpr i32 InvalidProxy = -1;
+
+    /// @brief  Describes the nearest hit of a ray query.
+    struct RayHit {
+        void *mUserData;
+        f32 mDistance;
+    };
+
+    /// @brief  The class constructor.
+    /// @param  margin  [in] The margin used to fatten the proxy boxes.
+    explicit BoundingVolumeTree(f32 margin = 0.1f);
+
+    /// @brief  The class destructor.
+    ~BoundingVolumeTree() = default;
+
+    /// @brief  Will create a new proxy.
+    /// @param  aabb        [in] The bounding box of the proxy.
+    /// @param  userData    [in] The user data returned by the queries.
+    /// @return The proxy id.
+    i32 createProxy(const AABB &aabb, void *userData);
+
+    /// @brief  Will destroy a proxy.
+    /// @param  proxyId     [in] The proxy id.
+    void destroyProxy(i32 proxyId);
+
+    /// @brief  Will update the box of a proxy.
+    /// @param  proxyId     [in] The proxy id.
+    /// @param  aabb        [in] The new bounding box.
+    /// @return true, if the proxy was reinserted.
+    bool moveProxy(i32 proxyId, const AABB &aabb);
+
+    /// @brief  Returns the user data of a proxy.
+    void *getUserData(i32 proxyId) const;
+
+    /// @brief  Returns the fattened box of a proxy.
+    const AABB &getFatAABB(i32 proxyId) const;
+
+    /// @brief  Will collect all proxies overlapping the box.
+    void query(const AABB &aabb, cppcore::TArray<void*> &result) const;
+
+    /// @brief  Will collect all proxies inside the frustum.
+    void query(const Frustum &frustum, cppcore::TArray<void*> &result) const;
+
+    /// @brief  Will collect all proxies overlapping the sphere.
+    void query(const glm::vec3 &center, f32 radius, cppcore::TArray<void*> &result) const;
+
+    /// @brief  Will look for the nearest proxy hit by the ray.
+    /// @param  ray         [in] The ray.
+    /// @param  maxDistance [in] The maximal distance along the ray.
+    /// @param  hit         [out] The nearest hit.
+    /// @return true, if a proxy was hit.
+    bool raycast(const Ray &ray, f32 maxDistance, RayHit &hit) const;
+
+    /// @brief  Returns the number of proxies.
+    size_t getNumProxies() const;
+
+    /// @brief  Returns the height of the tree, 0 for a single leaf.
+    i32 getHeight() const;
+
+    /// @brief  Will remove all proxies.
+    void clear();
+
+    /// @brief  Will check the tree structure, used for debugging.
+    /// @return true, if the tree is consistent.
+    bool validate() const;
+
+private:
+    struct Node {
+        AABB mFat;
+        AABB mTight;
+        void *mUserData;
+        i32 mParent;
+        i32 mChild1;
+        i32 mChild2;
+        i32 mHeight;
+
+        bool isLeaf() const {
+            return InvalidProxy == mChild1;
+        }
+    };
+
+    i32 allocateNode();
+    void freeNode(i32 index);
+    void insertLeaf(i32 leaf);
+    void removeLeaf(i32 leaf);
+    i32 balance(i32 index);
+    void refit(i32 index);
+    void collectLeaves(i32 index, cppcore::TArray<void*> &result) const;
+    bool validate(i32 index) const;
+
+private:
+    cppcore::TArray<Node> mNodes;
+    i32 mRoot;
+    i32 mFreeList;
+    size_t mNumProxies;
+    f32 mMargin;
+};
+
+inline void *BoundingVolumeTree::getUserData(i32 proxyId) const {
+    osre_assert(proxyId >= 0 && static_cast<size_t>(proxyId) < mNodes.size());
+    return mNodes[proxyId].mUserData;
+}
+
+inline const AABB &BoundingVolumeTree::getFatAABB(i32 proxyId) const {
+    osre_assert(proxyId >= 0 && static_cast<size_t>(proxyId) < mNodes.size());
+    return mNodes[proxyId].mFat;
+}
+
+inline size_t BoundingVolumeTree::getNumProxies() const {
+    return mNumProxies;
+}
+
+inline i32 BoundingVolumeTree::getHeight() const {
+    if (InvalidProxy == mRoot) {
+        return 0;
+    }
+
+    return mNodes[mRoot].mHeight;
+}
+
+} // namespace Common
+} // namespace OSRE
@@ -24,11 +24,42 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <osre/Common/osre_common.h>
 #include <osre/Common/glm_common.h>
+#include <osre/Common/TAABB.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include <cppcore/Container/TArray.h>
 
 namespace OSRE {
 namespace Common {
 
-class Frustum {
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This struct stores a batch of bounding boxes in a structure-of-arrays layout, so many
+/// boxes can be tested against a frustum at once.
+//-------------------------------------------------------------------------------------------------
+struct OSRE_EXPORT AABBBatch {
+    cppcore::TArray<f32> mMinX, mMinY, mMinZ;
+    cppcore::TArray<f32> mMaxX, mMaxY, mMaxZ;
+
+    /// @brief  Will add a new box.
+    /// @param  aabb    [in] The box to add.
+    void add(const AABB &aabb);
+
+    /// @brief  Returns the number of stored boxes.
+    size_t size() const;
+
+    /// @brief  Will remove all boxes, the memory will be kept.
+    void clear();
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class describes a view frustum by its six planes. The plane normals point into
+/// the frustum and are normalized, so the plane equation returns the signed distance.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT Frustum {
 public:
     enum {
         Top = 0,
@@ -36,24 +67,33 @@ public:
         Left,
         Right,
         NearP, 
-        FarP
+        FarP,
+        NumPlanes
     };
 
     Frustum();
     ~Frustum() = default;
-    bool isIn(glm::vec3 &point);
+    bool isIn(const glm::vec3 &point) const;
+    bool isIn(const AABB &aabb) const;
+    bool isIn(const glm::vec3 &center, f32 radius) const;
+    void cullBatch(const AABBBatch &batch, cppcore::TArray<uc8> &visible) const;
     void extractFrom(const glm::mat4 &vp);
+    const glm::vec4 &getPlane(size_t index) const;
     void clear();
 
 private:
-    glm::vec4 mPlanes[6];
+    glm::vec4 mPlanes[NumPlanes];
 };
 
+inline size_t AABBBatch::size() const {
+    return mMinX.size();
+}
+
 inline Frustum::Frustum() {
     clear();
 }
 
-inline bool Frustum::isIn( glm::vec3 &point ) {
+inline bool Frustum::isIn(const glm::vec3 &point) const {
     bool in = true;
     for (auto & plane : mPlanes) {
         const f32 d = plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w;
@@ -66,18 +106,56 @@ inline bool Frustum::isIn( glm::vec3 &point ) {
     return in;
 }
 
+inline bool Frustum::isIn(const AABB &aabb) const {
+    const glm::vec3 center = (aabb.getMin() + aabb.getMax()) * 0.5f;
+    const glm::vec3 extent = (aabb.getMax() - aabb.getMin()) * 0.5f;
+    for (auto &plane : mPlanes) {
+        const f32 d = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+        const f32 r = glm::abs(plane.x) * extent.x + glm::abs(plane.y) * extent.y + glm::abs(plane.z) * extent.z;
+        if (d + r < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+inline bool Frustum::isIn(const glm::vec3 &center, f32 radius) const {
+    for (auto &plane : mPlanes) {
+        const f32 d = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+        if (d < -radius) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 inline void Frustum::extractFrom(const glm::mat4 &vp) {
     glm::vec4 rowX = glm::row(vp, 0);
     glm::vec4 rowY = glm::row(vp, 1);
     glm::vec4 rowZ = glm::row(vp, 2);
     glm::vec4 rowW = glm::row(vp, 3);
 
-    mPlanes[0] = normalize(rowW + rowX);
-    mPlanes[1] = normalize(rowW - rowX);
-    mPlanes[2] = normalize(rowW + rowY);
-    mPlanes[3] = normalize(rowW - rowY);
-    mPlanes[4] = normalize(rowW + rowZ);
-    mPlanes[5] = normalize(rowW - rowZ);
+    mPlanes[Left] = rowW + rowX;
+    mPlanes[Right] = rowW - rowX;
+    mPlanes[Bottom] = rowW + rowY;
+    mPlanes[Top] = rowW - rowY;
+    mPlanes[NearP] = rowW + rowZ;
+    mPlanes[FarP] = rowW - rowZ;
+
+    // Normalize by the length of the normal to get distances
+    for (auto &plane : mPlanes) {
+        const f32 len = glm::length(glm::vec3(plane));
+        if (len > 0.0f) {
+            plane /= len;
+        }
+    }
+}
+
+inline const glm::vec4 &Frustum::getPlane(size_t index) const {
+    osre_assert(index < NumPlanes);
+    return mPlanes[index];
 }
 
 inline void Frustum::clear() {
@@ -0,0 +1,68 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+#include <osre/Common/TAABB.h>
+
+namespace OSRE {
+namespace Common {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements the min / max reduction over vertex positions, which is used to
+/// compute bounding boxes.
+///
+/// The positions are expected as three floats at the start of each vertex, vertices are stride
+/// bytes apart. The SIMD path is selected at compile time ( AVX, SSE2 or scalar ).
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT MinMaxKernel {
+public:
+    /// Meshes with more vertices than this will be split up on the worker threads.
+    static constexpr size_t ParallelThreshold = 64 * 1024;
+
+    /// @brief  Computes min / max with the best available SIMD path.
+    /// @param  data        [in] The vertex data.
+    /// @param  numVertices [in] The number of vertices.
+    /// @param  stride      [in] The distance between two vertices in bytes, at least 12.
+    /// @param  min         [inout] The minimum, will only get smaller.
+    /// @param  max         [inout] The maximum, will only get bigger.
+    static void compute(const void *data, size_t numVertices, size_t stride, glm::vec3 &min, glm::vec3 &max);
+
+    /// @brief  The scalar reference implementation.
+    static void computeScalar(const void *data, size_t numVertices, size_t stride, glm::vec3 &min, glm::vec3 &max);
+
+    /// @brief  Like compute, big buffers will be split up and reduced on the worker threads.
+    static void computeParallel(const void *data, size_t numVertices, size_t stride, glm::vec3 &min, glm::vec3 &max);
+
+    /// @brief  Will merge all positions into the bounding box.
+    /// @param  aabb        [inout] The bounding box.
+    /// @param  data        [in] The vertex data.
+    /// @param  numVertices [in] The number of vertices.
+    /// @param  stride      [in] The distance between two vertices in bytes.
+    static void merge(AABB &aabb, const void *data, size_t numVertices, size_t stride);
+};
+
+} // Namespace Common
+} // Namespace OSRE
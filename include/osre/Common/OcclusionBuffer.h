@@ -0,0 +1,134 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+#include <osre/Common/glm_common.h>
+#include <osre/Common/TAABB.h>
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace Common {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a small software depth buffer for occlusion culling.
+///
+/// Occluder triangles are rasterized on the CPU with SSE coverage masks, the rows are split into
+/// tile bands which are rasterized by the worker threads. For each tile the farthest depth is
+/// stored as well, so most bounding box tests can be answered without touching the pixels.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT OcclusionBuffer {
+public:
+    static constexpr ui32 TileWidth = 8;
+    static constexpr ui32 TileHeight = 8;
+
+    /// @brief  The class constructor.
+    /// @param  width   [in] The width in pixel, will be rounded up to the tile width.
+    /// @param  height  [in] The height in pixel, will be rounded up to the tile height.
+    OcclusionBuffer(ui32 width = 256, ui32 height = 128);
+
+    /// @brief  The class destructor.
+    ~OcclusionBuffer() = default;
+
+    /// @brief  Will resize the buffer, all content will be cleared.
+    /// @param  width   [in] The new width.
+    /// @param  height  [in] The new height.
+    void resize(ui32 width, ui32 height);
+
+    /// @brief  Will clear the buffer and set the view-projection matrix for the next frame.
+    /// @param  viewProjection  [in] The view-projection matrix.
+    void beginFrame(const glm::mat4 &viewProjection);
+
+    /// @brief  Will add an indexed triangle list as an occluder.
+    /// @param  positions       [in] The vertex positions in model space.
+    /// @param  numPositions    [in] The number of positions.
+    /// @param  indices         [in] The triangle indices.
+    /// @param  numIndices      [in] The number of indices.
+    /// @param  model           [in] The model matrix.
+    void addOccluder(const glm::vec3 *positions, size_t numPositions, const ui32 *indices,
+            size_t numIndices, const glm::mat4 &model);
+
+    /// @brief  Will rasterize all added occluders.
+    void rasterize();
+
+    /// @brief  Will test a world-space box against the rasterized occluders.
+    /// @param  aabb    [in] The box to test.
+    /// @return false, if the box is fully hidden, true if not.
+    bool isVisible(const AABB &aabb) const;
+
+    /// @brief  Returns the depth of a pixel.
+    f32 getDepth(ui32 x, ui32 y) const;
+
+    /// @brief  Returns the width in pixel.
+    ui32 getWidth() const;
+
+    /// @brief  Returns the height in pixel.
+    ui32 getHeight() const;
+
+    /// @brief  Returns the number of occluder triangles after clipping.
+    size_t getNumTriangles() const;
+
+private:
+    struct ScreenTriangle {
+        f32 mEdgeA[3], mEdgeB[3], mEdgeC[3];
+        f32 mZA, mZB, mZC;
+        i32 mMinX, mMaxX, mMinY, mMaxY;
+    };
+
+    void clipTriangle(const glm::vec4 &c0, const glm::vec4 &c1, const glm::vec4 &c2);
+    void setupTriangle(const glm::vec4 &c0, const glm::vec4 &c1, const glm::vec4 &c2);
+    void rasterizeBand(ui32 tileRow);
+
+private:
+    ui32 mWidth;
+    ui32 mHeight;
+    ui32 mNumTilesX;
+    ui32 mNumTilesY;
+    glm::mat4 mViewProjection;
+    cppcore::TArray<f32> mDepth;
+    cppcore::TArray<f32> mTileMax;
+    cppcore::TArray<ScreenTriangle> mTriangles;
+    cppcore::TArray<glm::vec4> mClipVertices;
+};
+
+inline f32 OcclusionBuffer::getDepth(ui32 x, ui32 y) const {
+    return mDepth[y * mWidth + x];
+}
+
+inline ui32 OcclusionBuffer::getWidth() const {
+    return mWidth;
+}
+
+inline ui32 OcclusionBuffer::getHeight() const {
+    return mHeight;
+}
+
+inline size_t OcclusionBuffer::getNumTriangles() const {
+    return mTriangles.size();
+}
+
+} // namespace Common
+} // namespace OSRE
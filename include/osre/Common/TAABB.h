@@ -51,6 +51,8 @@ public:
     f32 getDiameter() const;
     glm::vec3 getCenter() const;
     bool isIn(const glm::vec3 &pt) const;
+    bool isValid() const;
+    AABB transform(const glm::mat4 &m) const;
     bool operator==(const AABB &rhs) const;
     bool operator!=(const AABB &rhs) const;
 
@@ -159,6 +161,23 @@ inline bool AABB::isIn(const glm::vec3 &pt) const {
     return true;
 }
 
+inline bool AABB::isValid() const {
+    return m_min.x <= m_max.x && m_min.y <= m_max.y && m_min.z <= m_max.z;
+}
+
+inline AABB AABB::transform(const glm::mat4 &m) const {
+    // Transform the center and project the extents onto the new axes
+    const glm::vec3 center = getCenter();
+    const glm::vec3 extent = (m_max - m_min) * 0.5f;
+    const glm::vec3 newCenter = glm::vec3(m * glm::vec4(center, 1.0f));
+    glm::vec3 newExtent;
+    for (i32 i = 0; i < 3; ++i) {
+        newExtent[i] = glm::abs(m[0][i]) * extent.x + glm::abs(m[1][i]) * extent.y + glm::abs(m[2][i]) * extent.z;
+    }
+
+    return AABB(newCenter - newExtent, newCenter + newExtent);
+}
+
 inline bool AABB::operator == (const AABB &rhs) const {
     return (m_max == rhs.m_max && m_min == rhs.m_min);
 }
@@ -0,0 +1,265 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace Common {
+
+/// @brief  A generational 32-bit handle, the lower bits store the slot index, the upper bits the
+/// generation of the slot. A handle with the value 0 is invalid.
+struct SlotHandle {
+    static constexpr ui32 IndexBits = 20;
+    static constexpr ui32 IndexMask = (1u << IndexBits) - 1u;
+    static constexpr ui32 MaxGeneration = (1u << (32u - IndexBits)) - 1u;
+
+    ui32 mValue;
+
+    SlotHandle() :
+            mValue(0) {
+        // empty
+    }
+
+    SlotHandle(ui32 index, ui32 generation) :
+            mValue((generation << IndexBits) | (index & IndexMask)) {
+        // empty
+    }
+
+    ui32 getIndex() const {
+        return mValue & IndexMask;
+    }
+
+    ui32 getGeneration() const {
+        return mValue >> IndexBits;
+    }
+
+    bool isValid() const {
+        return 0 != mValue;
+    }
+
+    bool operator == (const SlotHandle &rhs) const {
+        return mValue == rhs.mValue;
+    }
+
+    bool operator != (const SlotHandle &rhs) const {
+        return !(*this == rhs);
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This template class implements a slot map. Each value is addressed by a generational
+/// handle, add, remove and lookup are O(1). When a value gets removed the generation of its slot
+/// will be increased, so stale handles will not resolve anymore. Free slots are reused in FIFO
+/// order once enough of them are available, so a slot index will not be reused immediately.
+//-------------------------------------------------------------------------------------------------
+template<class T>
+class TSlotMap {
+public:
+    /// @brief  The number of free slots to keep before a free slot gets reused.
+    static constexpr ui32 MinFreeSlots = 64;
+
+    /// @brief  The default class constructor.
+    TSlotMap();
+
+    /// @brief  The class destructor.
+    ~TSlotMap() = default;
+
+    /// @brief  Will add a new value.
+    /// @param  value   [in] The value.
+    /// @return The handle of the new value or an invalid handle, if all slots are in use.
+    SlotHandle add(const T &value);
+
+    /// @brief  Will remove the value of a handle, the handle gets stale.
+    /// @param  handle  [in] The handle.
+    /// @return true, if the handle was valid.
+    bool remove(SlotHandle handle);
+
+    /// @brief  Returns true, if the handle addresses a stored value.
+    bool contains(SlotHandle handle) const;
+
+    /// @brief  Returns a pointer to the value of the handle or nullptr, if the handle is stale.
+    T *find(SlotHandle handle);
+
+    /// @brief  Returns a pointer to the value of the handle or nullptr, if the handle is stale.
+    const T *find(SlotHandle handle) const;
+
+    /// @brief  Returns the number of stored values.
+    size_t size() const;
+
+    /// @brief  Returns true, if no value is stored.
+    bool isEmpty() const;
+
+    /// @brief  Returns the number of allocated slots.
+    size_t getCapacity() const;
+
+    /// @brief  Will remove all values, all handles get stale.
+    void clear();
+
+private:
+    static constexpr ui32 InvalidSlot = 0xffffffff;
+
+    struct Slot {
+        ui32 mGeneration;
+        ui32 mNextFree;
+        bool mUsed;
+        T mValue;
+    };
+
+    void pushFree(ui32 index);
+
+private:
+    cppcore::TArray<Slot> mSlots;
+    ui32 mFreeHead;
+    ui32 mFreeTail;
+    ui32 mNumFree;
+};
+
+template<class T>
+inline TSlotMap<T>::TSlotMap() :
+        mSlots(),
+        mFreeHead(InvalidSlot),
+        mFreeTail(InvalidSlot),
+        mNumFree(0) {
+    // empty
+}
+
+template<class T>
+inline SlotHandle TSlotMap<T>::add(const T &value) {
+    ui32 index = InvalidSlot;
+    if (mNumFree > MinFreeSlots || mSlots.size() == SlotHandle::IndexMask) {
+        if (0 == mNumFree) {
+            return SlotHandle();
+        }
+        index = mFreeHead;
+        mFreeHead = mSlots[index].mNextFree;
+        if (InvalidSlot == mFreeHead) {
+            mFreeTail = InvalidSlot;
+        }
+        --mNumFree;
+    } else {
+        index = static_cast<ui32>(mSlots.size());
+        Slot slot;
+        slot.mGeneration = 1;
+        slot.mNextFree = InvalidSlot;
+        slot.mUsed = false;
+        mSlots.add(slot);
+    }
+    osre_assert(InvalidSlot != index);
+
+    Slot &slot = mSlots[index];
+    slot.mNextFree = InvalidSlot;
+    slot.mUsed = true;
+    slot.mValue = value;
+
+    return SlotHandle(index, slot.mGeneration);
+}
+
+template<class T>
+inline bool TSlotMap<T>::remove(SlotHandle handle) {
+    if (!contains(handle)) {
+        return false;
+    }
+
+    const ui32 index = handle.getIndex();
+    Slot &slot = mSlots[index];
+    slot.mUsed = false;
+    slot.mValue = T();
+    slot.mGeneration = (slot.mGeneration == SlotHandle::MaxGeneration) ? 1 : slot.mGeneration + 1;
+    pushFree(index);
+
+    return true;
+}
+
+template<class T>
+inline bool TSlotMap<T>::contains(SlotHandle handle) const {
+    const ui32 index = handle.getIndex();
+    if (index >= mSlots.size()) {
+        return false;
+    }
+
+    const Slot &slot = mSlots[index];
+    return slot.mUsed && slot.mGeneration == handle.getGeneration();
+}
+
+template<class T>
+inline T *TSlotMap<T>::find(SlotHandle handle) {
+    if (!contains(handle)) {
+        return nullptr;
+    }
+
+    return &mSlots[handle.getIndex()].mValue;
+}
+
+template<class T>
+inline const T *TSlotMap<T>::find(SlotHandle handle) const {
+    if (!contains(handle)) {
+        return nullptr;
+    }
+
+    return &mSlots[handle.getIndex()].mValue;
+}
+
+template<class T>
+inline size_t TSlotMap<T>::size() const {
+    return mSlots.size() - mNumFree;
+}
+
+template<class T>
+inline bool TSlotMap<T>::isEmpty() const {
+    return 0 == size();
+}
+
+template<class T>
+inline size_t TSlotMap<T>::getCapacity() const {
+    return mSlots.size();
+}
+
+template<class T>
+inline void TSlotMap<T>::clear() {
+    for (size_t i = 0; i < mSlots.size(); ++i) {
+        if (mSlots[i].mUsed) {
+            remove(SlotHandle(static_cast<ui32>(i), mSlots[i].mGeneration));
+        }
+    }
+}
+
+template<class T>
+inline void TSlotMap<T>::pushFree(ui32 index) {
+    mSlots[index].mNextFree = InvalidSlot;
+    if (InvalidSlot == mFreeTail) {
+        mFreeHead = index;
+    } else {
+        mSlots[mFreeTail].mNextFree = index;
+    }
+    mFreeTail = index;
+    ++mNumFree;
+}
+
+} // namespace Common
+} // namespace OSRE
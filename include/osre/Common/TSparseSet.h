@@ -0,0 +1,201 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace Common {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This template class implements a sparse set. Values are stored densely packed, so an
+/// iteration over all values touches contiguous memory only. The keys are mapped to the dense
+/// index by a sparse lookup array, add, remove and lookup are O(1).
+//-------------------------------------------------------------------------------------------------
+template<class T>
+class TSparseSet {
+public:
+    static constexpr ui32 InvalidIndex = 0xffffffff;
+
+    /// @brief  The default class constructor.
+    TSparseSet();
+
+    /// @brief  The class destructor.
+    ~TSparseSet() = default;
+
+    /// @brief  Will add a new value, an existing value for the key will be replaced.
+    /// @param  key     [in] The key.
+    /// @param  value   [in] The value.
+    void add(ui32 key, const T &value);
+
+    /// @brief  Will remove the value of a key, the last value will be moved into the gap.
+    /// @param  key     [in] The key.
+    /// @return true, if the key was found.
+    bool remove(ui32 key);
+
+    /// @brief  Returns true, if the key is stored.
+    bool contains(ui32 key) const;
+
+    /// @brief  Returns a pointer to the value of a key or nullptr.
+    T *find(ui32 key);
+
+    /// @brief  Returns a pointer to the value of a key or nullptr.
+    const T *find(ui32 key) const;
+
+    /// @brief  Returns the number of stored values.
+    size_t size() const;
+
+    /// @brief  Returns true, if no value is stored.
+    bool isEmpty() const;
+
+    /// @brief  Returns the key of the value at the dense index.
+    ui32 getKeyAt(size_t index) const;
+
+    /// @brief  Returns the value at the dense index.
+    T &getAt(size_t index);
+
+    /// @brief  Returns the value at the dense index.
+    const T &getAt(size_t index) const;
+
+    /// @brief  Will remove all values.
+    void clear();
+
+private:
+    cppcore::TArray<ui32> mSparse;
+    cppcore::TArray<ui32> mKeys;
+    cppcore::TArray<T> mValues;
+};
+
+template<class T>
+inline TSparseSet<T>::TSparseSet() :
+        mSparse(),
+        mKeys(),
+        mValues() {
+    // empty
+}
+
+template<class T>
+inline void TSparseSet<T>::add(ui32 key, const T &value) {
+    if (key >= mSparse.size()) {
+        const size_t oldSize = mSparse.size();
+        mSparse.resize(key + 1);
+        for (size_t i = oldSize; i < mSparse.size(); ++i) {
+            mSparse[i] = InvalidIndex;
+        }
+    }
+
+    if (InvalidIndex != mSparse[key]) {
+        mValues[mSparse[key]] = value;
+        return;
+    }
+
+    mSparse[key] = static_cast<ui32>(mValues.size());
+    mKeys.add(key);
+    mValues.add(value);
+}
+
+template<class T>
+inline bool TSparseSet<T>::remove(ui32 key) {
+    if (!contains(key)) {
+        return false;
+    }
+
+    const ui32 index = mSparse[key];
+    const ui32 last = static_cast<ui32>(mValues.size() - 1);
+    if (index != last) {
+        mValues[index] = mValues[last];
+        mKeys[index] = mKeys[last];
+        mSparse[mKeys[index]] = index;
+    }
+    mValues.removeBack();
+    mKeys.removeBack();
+    mSparse[key] = InvalidIndex;
+
+    return true;
+}
+
+template<class T>
+inline bool TSparseSet<T>::contains(ui32 key) const {
+    return key < mSparse.size() && InvalidIndex != mSparse[key];
+}
+
+template<class T>
+inline T *TSparseSet<T>::find(ui32 key) {
+    if (!contains(key)) {
+        return nullptr;
+    }
+
+    return &mValues[mSparse[key]];
+}
+
+template<class T>
+inline const T *TSparseSet<T>::find(ui32 key) const {
+    if (!contains(key)) {
+        return nullptr;
+    }
+
+    return &mValues[mSparse[key]];
+}
+
+template<class T>
+inline size_t TSparseSet<T>::size() const {
+    return mValues.size();
+}
+
+template<class T>
+inline bool TSparseSet<T>::isEmpty() const {
+    return mValues.isEmpty();
+}
+
+template<class T>
+inline ui32 TSparseSet<T>::getKeyAt(size_t index) const {
+    osre_assert(index < mKeys.size());
+    return mKeys[index];
+}
+
+template<class T>
+inline T &TSparseSet<T>::getAt(size_t index) {
+    osre_assert(index < mValues.size());
+    return mValues[index];
+}
+
+template<class T>
+inline const T &TSparseSet<T>::getAt(size_t index) const {
+    osre_assert(index < mValues.size());
+    return mValues[index];
+}
+
+template<class T>
+inline void TSparseSet<T>::clear() {
+    mSparse.clear();
+    mKeys.clear();
+    mValues.clear();
+}
+
+} // namespace Common
+} // namespace OSRE
@@ -79,6 +79,10 @@ public:
     /// @return The working directory.
     virtual String getWorkingDirectory() = 0;
 
+    /// @brief  Returns true, if streams of the file system can be read from several threads at once.
+    /// @return true, if concurrent reads are supported.
+    virtual bool supportsConcurrentReads() const;
+
 public:
     ///	@brief	Adds an ownership.
     void get();
@@ -109,6 +113,11 @@ AbstractFileSystem::~AbstractFileSystem() {
     // empty
 }
 
+inline
+bool AbstractFileSystem::supportsConcurrentReads() const {
+    return false;
+}
+
 inline
 void AbstractFileSystem::get() {
     ++m_numberOfRefs;
@@ -0,0 +1,213 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/IO/IOCommon.h>
+#include <osre/IO/Uri.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OSRE {
+namespace IO {
+
+// Forward declarations
+class AbstractFileSystem;
+
+/// @brief  The id of an asynchronous read request.
+using AsyncIORequestId = ui64;
+
+/// @brief  Marks an invalid request id.
+static constexpr AsyncIORequestId InvalidAsyncIORequestId = 0;
+
+/// @brief  The priority of a read request, requests with a higher priority are read first.
+enum class AsyncIOPriority : ui32 {
+    Low = 0,        ///< Background streaming.
+    Normal,         ///< Default priority.
+    High,           ///< Data which is needed for the next frames.
+    NumPriorities   ///< The number of priorities.
+};
+
+/// @brief  The state of a read request.
+enum class AsyncIOStatus {
+    Pending,        ///< The request is waiting for an IO thread.
+    Running,        ///< The request is being read.
+    Completed,      ///< The data was read.
+    Failed,         ///< The file could not be opened or read.
+    Cancelled       ///< The request was cancelled.
+};
+
+///	@brief  The result of a read request, which will be passed to the completion callback.
+struct AsyncIOResult {
+    AsyncIORequestId mId;   ///< The request id.
+    AsyncIOStatus mStatus;  ///< The final state.
+    Uri mUri;               ///< The read file.
+    const uc8 *mData;       ///< The data, only valid during the callback.
+    size_t mSize;           ///< The number of read bytes.
+
+    AsyncIOResult() :
+            mId(InvalidAsyncIORequestId), mStatus(AsyncIOStatus::Pending), mUri(), mData(nullptr), mSize(0) {
+        // empty
+    }
+};
+
+/// @brief  The completion callback.
+using AsyncIOCallback = std::function<void(const AsyncIOResult &result)>;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a thread-safe pool of read buffers.
+///
+/// Buffers are kept in power-of-two size classes, released buffers will be reused by the next
+/// request of the same class.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT IOBufferPool {
+public:
+    /// @brief  The smallest size class in bytes.
+    static constexpr size_t MinBufferSize = 4096;
+
+    /// @brief  The maximal number of free buffers per size class.
+    static constexpr size_t MaxFreeBuffersPerClass = 4;
+
+    /// @brief  The class constructor.
+    IOBufferPool();
+
+    /// @brief  The class destructor, will free all buffers.
+    ~IOBufferPool();
+
+    /// @brief  Returns a buffer with at least the requested size.
+    /// @param  size        [in] The size in bytes.
+    /// @param  capacity    [out] The real size of the buffer.
+    /// @return The buffer.
+    uc8 *acquire(size_t size, size_t &capacity);
+
+    /// @brief  Will return a buffer into the pool.
+    /// @param  buffer      [in] The buffer.
+    /// @param  capacity    [in] The capacity returned by acquire.
+    void release(uc8 *buffer, size_t capacity);
+
+    /// @brief  Returns the number of free buffers.
+    size_t getNumFreeBuffers() const;
+
+    OSRE_NON_COPYABLE(IOBufferPool)
+
+private:
+    mutable std::mutex mLock;
+    std::map<size_t, std::vector<uc8 *>> mFreeBuffers;
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a prioritized queue of asynchronous read requests.
+///
+/// The requests are read by a small set of own IO threads, so blocking disk access will not stall
+/// the jobs of the shared thread pool. Local files are opened by the IO threads directly, other
+/// file systems are accessed one request at a time, because their streams share state. Finished
+/// requests are collected and their callbacks are called by dispatchCompleted, usually from the
+/// main thread once per frame.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT AsyncIOQueue {
+public:
+    /// @brief  The default number of IO threads.
+    static constexpr size_t DefaultNumThreads = 2;
+
+    /// @brief  The class constructor.
+    /// @param  numThreads  [in] The number of IO threads.
+    explicit AsyncIOQueue(size_t numThreads = DefaultNumThreads);
+
+    /// @brief  The class destructor, pending requests will be cancelled without callbacks.
+    ~AsyncIOQueue();
+
+    /// @brief  Will enqueue a read request.
+    /// @param  uri         [in] The file to read.
+    /// @param  fileSystem  [in] The file system for non-local files, may be nullptr for local files.
+    /// @param  callback    [in] The completion callback.
+    /// @param  priority    [in] The priority.
+    /// @param  offset      [in] The offset of the first byte to read.
+    /// @param  size        [in] The number of bytes to read, 0 to read until the end of the file.
+    /// @return The request id.
+    AsyncIORequestId read(const Uri &uri, AbstractFileSystem *fileSystem, const AsyncIOCallback &callback,
+            AsyncIOPriority priority = AsyncIOPriority::Normal, size_t offset = 0, size_t size = 0);
+
+    /// @brief  Will cancel a request, the callback will be called with the cancelled state.
+    /// @param  id          [in] The request id.
+    /// @return true, if the request was not finished before.
+    bool cancel(AsyncIORequestId id);
+
+    /// @brief  Returns the state of a request, finished requests are known until they were dispatched.
+    /// @param  id          [in] The request id.
+    /// @param  status      [out] The state.
+    /// @return true, if the request is known.
+    bool getStatus(AsyncIORequestId id, AsyncIOStatus &status) const;
+
+    /// @brief  Will block until a request is finished.
+    /// @param  id          [in] The request id.
+    void wait(AsyncIORequestId id);
+
+    /// @brief  Will call the callbacks of all finished requests in the calling thread.
+    /// @return The number of dispatched requests.
+    size_t dispatchCompleted();
+
+    /// @brief  Returns the number of requests which are not dispatched yet.
+    size_t getNumRequests() const;
+
+    /// @brief  Returns the buffer pool.
+    IOBufferPool &getBufferPool();
+
+    OSRE_NON_COPYABLE(AsyncIOQueue)
+
+private:
+    struct Request;
+
+    void workerLoop();
+    Request *dequeue();
+    void execute(Request *request);
+    void finish(Request *request, AsyncIOStatus status);
+
+private:
+    std::vector<std::thread> mThreads;
+    std::deque<Request *> mPending[static_cast<size_t>(AsyncIOPriority::NumPriorities)];
+    std::map<AsyncIORequestId, Request *> mRequests;
+    std::vector<Request *> mFinished;
+    mutable std::mutex mLock;
+    std::condition_variable mRequestAvailable;
+    std::condition_variable mRequestFinished;
+    std::mutex mFileSystemLock;
+    IOBufferPool mBufferPool;
+    AsyncIORequestId mNextId;
+    bool mRunning;
+};
+
+inline IOBufferPool &AsyncIOQueue::getBufferPool() {
+    return mBufferPool;
+}
+
+} // Namespace IO
+} // Namespace OSRE
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/IO/IOCommon.h>
 #include <osre/Common/AbstractService.h>
 #include <osre/IO/Stream.h>
+#include <osre/IO/AsyncIOQueue.h>
 
 #include <map>
 
@@ -94,6 +95,25 @@ public:
     /// @param  file        [in] The Uri with the file location.
     /// @return true, if the file exists.
     bool fileExists( const Uri &file ) const;
+
+    /// @brief  Will enqueue an asynchronous read request, the corresponding file system will be used.
+    /// @param  file        [in] The file name as an Uri.
+    /// @param  callback    [in] The completion callback, will be called in onUpdate.
+    /// @param  priority    [in] The request priority.
+    /// @param  offset      [in] The offset to start reading from.
+    /// @param  size        [in] The number of bytes to read, 0 for the rest of the file.
+    /// @return The request id or InvalidAsyncIORequestId in case of an error.
+    AsyncIORequestId readAsync( const Uri &file, const AsyncIOCallback &callback,
+            AsyncIOPriority priority = AsyncIOPriority::Normal, size_t offset = 0, size_t size = 0 );
+
+    /// @brief  Will cancel an asynchronous read request.
+    /// @param  id          [in] The request id.
+    /// @return true, if the request will be cancelled.
+    bool cancelAsync( AsyncIORequestId id );
+
+    /// @brief  Returns the asynchronous request queue, will be created on first usage.
+    /// @return The request queue.
+    AsyncIOQueue *getAsyncQueue();
     
     /// @brief  Will create a new instance.
     /// @return The new created instance.
@@ -102,6 +122,7 @@ public:
 private:
     using MountedMap = std::map<String, AbstractFileSystem*> ;
     MountedMap m_mountedMap;
+    AsyncIOQueue *m_asyncQueue;
 };
 
 } // Namespace IO
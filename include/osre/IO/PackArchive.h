@@ -0,0 +1,127 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/IO/IOCommon.h>
+
+#include <vector>
+
+namespace OSRE {
+namespace IO {
+
+/// @brief  The file layout of an OSRE pack, all values are stored little-endian.
+///
+/// | PackHeader | PackEntry table, sorted by path hash | path names | page aligned file data |
+static constexpr c8 PackMagic[4] = { 'O', 'P', 'A', 'K' };
+static constexpr ui32 PackVersion = 1;
+static constexpr ui32 PackAlignment = 4096;
+static constexpr ui16 PackEntryCompressed = 1;
+
+/// @brief  The header at the beginning of a pack file.
+struct PackHeader {
+    c8 mMagic[4];           ///< The magic, see PackMagic.
+    ui32 mVersion;          ///< The format version.
+    ui32 mNumEntries;       ///< The number of entries in the table.
+    ui32 mAlignment;        ///< The alignment of the file data.
+    ui64 mTableOffset;      ///< The offset of the entry table.
+    ui64 mNamesOffset;      ///< The offset of the path names.
+    ui64 mNamesSize;        ///< The size of the path names in bytes.
+    ui64 mDataOffset;       ///< The offset of the first file.
+};
+
+/// @brief  One entry of the table, the table is sorted by the path hash.
+struct PackEntry {
+    ui64 mPathHash;         ///< The hash of the path, see hashPackPath.
+    ui64 mOffset;           ///< The offset of the file data, aligned by mAlignment.
+    ui64 mSize;             ///< The stored size in bytes.
+    ui64 mUncompressedSize; ///< The size after decompression in bytes.
+    ui32 mNameOffset;       ///< The offset of the path in the path names.
+    ui16 mNameLength;       ///< The length of the path without the terminating zero.
+    ui16 mFlags;            ///< PackEntryCompressed for zlib compressed entries.
+};
+
+static_assert(sizeof(PackHeader) == 48, "Unexpected pack header size.");
+static_assert(sizeof(PackEntry) == 40, "Unexpected pack entry size.");
+
+/// @brief  Will return the hash of a path inside of a pack (FNV-1a, 64 bit).
+/// @param  path    [in] The path.
+/// @return The hash.
+OSRE_EXPORT ui64 hashPackPath(const String &path);
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief	This class writes OSRE pack files.
+///
+/// The written file only depends on the added paths and their content, the order of the add
+/// calls does not matter.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT PackWriter {
+public:
+    /// @brief  The default class constructor.
+    PackWriter();
+
+    /// @brief  The class destructor.
+    ~PackWriter();
+
+    /// @brief  Will add a file from memory.
+    /// @param  path        [in] The path inside of the pack.
+    /// @param  data        [in] The file content.
+    /// @param  size        [in] The size of the content in bytes.
+    /// @param  compress    [in] true for zlib compression, stored uncompressed if it does not shrink.
+    /// @return false, if the path is invalid or already added.
+    bool addFile(const String &path, const uc8 *data, size_t size, bool compress);
+
+    /// @brief  Will add a file from disc.
+    /// @param  path        [in] The path inside of the pack.
+    /// @param  file        [in] The file to add.
+    /// @param  compress    [in] true for zlib compression, stored uncompressed if it does not shrink.
+    /// @return false, if the file cannot be read or the path is invalid or already added.
+    bool addFile(const String &path, const Uri &file, bool compress);
+
+    /// @brief  Returns the number of added files.
+    /// @return The number of files.
+    size_t getNumFiles() const;
+
+    /// @brief  Will write the pack file.
+    /// @param  pack        [in] The pack file to write.
+    /// @return true, if the pack was written.
+    bool write(const Uri &pack) const;
+
+    /// @brief  Will remove all added files.
+    void clear();
+
+    OSRE_NON_COPYABLE(PackWriter)
+
+private:
+    struct File {
+        String mPath;
+        std::vector<uc8> mData;
+        ui64 mUncompressedSize;
+        bool mCompressed;
+    };
+    std::vector<File> mFiles;
+};
+
+} // Namespace IO
+} // Namespace OSRE
@@ -94,6 +94,16 @@ public:
     /// @return true, if map operation is supported.
     virtual bool canBeMapped() const;
 
+    /// @brief  Returns the content of a mapped stream without a copy.
+    /// @return The pointer to the content, nullptr if the stream is not mapped.
+    virtual const uc8 *getMappedData() const;
+
+    /// @brief  Returns a read-only view into the content of a mapped stream.
+    /// @param  offset          [in] The offset of the view in bytes.
+    /// @param  size            [in] The size of the view in bytes.
+    /// @return The pointer to the view, nullptr if the stream is not mapped or the range is invalid.
+    virtual const uc8 *getView(size_t offset, size_t size) const;
+
     /// @brief  Set the current request mode.
     /// @param  accessMode      [in] The new access mode.
     virtual void setAccessMode( AccessMode accessMode );
@@ -0,0 +1,139 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Profiling/ProfilingCommon.h>
+
+namespace OSRE {
+namespace Profiling {
+
+/// @brief  The maximal number of passes with own counters per frame.
+static constexpr ui32 MaxRenderStatsPasses = 16;
+
+///	@brief  The counters of the render commands.
+struct OSRE_EXPORT RenderCounters {
+    ui32 mDrawCalls;            ///< The number of draw calls.
+    ui32 mInstances;            ///< The number of rendered instances.
+    ui64 mTriangles;            ///< The number of rendered triangles, all instances included.
+    ui32 mShaderBinds;          ///< The number of shader changes.
+    ui32 mTextureBinds;         ///< The number of texture binds.
+    ui32 mVertexArrayBinds;     ///< The number of vertex array changes.
+    ui32 mUniformUploads;       ///< The number of uniform uploads.
+    ui64 mBufferBytesUploaded;  ///< The number of bytes uploaded into buffers.
+
+    /// @brief  The default class constructor.
+    RenderCounters();
+
+    /// @brief  Will add the counters of another instance.
+    void add(const RenderCounters &rhs);
+
+    /// @brief  Will reset all counters.
+    void clear();
+};
+
+///	@brief  The render statistics of one frame.
+struct OSRE_EXPORT RenderStatsSnapshot {
+    ui64 mFrame;                                    ///< The frame number, starts with 1.
+    RenderCounters mTotal;                          ///< The counters of the whole frame.
+    ui32 mNumPasses;                                ///< The number of passes.
+    ui32 mPassIds[MaxRenderStatsPasses];            ///< The id of each pass.
+    RenderCounters mPasses[MaxRenderStatsPasses];   ///< The counters of each pass.
+    ui32 mSubmitCmds;                               ///< The number of committed frame submit commands.
+    ui64 mSubmitCmdBytes;                           ///< The payload of the frame submit commands in bytes.
+    ui64 mRenderThreadTime;                         ///< The CPU time of the render thread in microseconds.
+
+    /// @brief  The default class constructor.
+    RenderStatsSnapshot();
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class collects the render statistics of each frame.
+///
+/// The render backend records the counters from the render thread. At the end of each frame the
+/// counters will be published into the PerformanceCounterRegistry and into a snapshot, which can
+/// be queried from any thread. Work which is done between two frames, like uploads of a committed
+/// frame, will be accounted to the next frame.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT RenderStats {
+public:
+    /// @brief  Will register the counters at the PerformanceCounterRegistry.
+    static void registerCounters();
+
+    /// @brief  Will start a pass, all following commands will be accounted to it.
+    /// @param  passId      [in] The id of the pass.
+    static void beginPass(ui32 passId);
+
+    /// @brief  Will end the active pass.
+    static void endPass();
+
+    /// @brief  Will count a draw call.
+    /// @param  numInstances    [in] The number of instances.
+    /// @param  numTriangles    [in] The number of triangles of one instance.
+    static void addDrawCall(ui32 numInstances, ui64 numTriangles);
+
+    /// @brief  Will count a shader change.
+    static void addShaderBind();
+
+    /// @brief  Will count a texture bind.
+    static void addTextureBind();
+
+    /// @brief  Will count a vertex array change.
+    static void addVertexArrayBind();
+
+    /// @brief  Will count an uniform upload.
+    static void addUniformUpload();
+
+    /// @brief  Will count a buffer upload.
+    /// @param  numBytes    [in] The size of the upload in bytes.
+    static void addBufferUpload(size_t numBytes);
+
+    /// @brief  Will count a committed frame submit command.
+    /// @param  numBytes    [in] The payload of the command in bytes.
+    static void addSubmitCmd(size_t numBytes);
+
+    /// @brief  Will start to measure the CPU time of the render thread.
+    static void beginCpuTime();
+
+    /// @brief  Will stop to measure the CPU time of the render thread.
+    static void endCpuTime();
+
+    /// @brief  Will publish the counters of the frame and reset them.
+    static void endFrame();
+
+    /// @brief  Returns the statistics of the last finished frame, thread-safe.
+    /// @param  snapshot    [out] The statistics.
+    static void getSnapshot(RenderStatsSnapshot &snapshot);
+
+    /// @brief  Will write a snapshot as readable text, one line per counter group.
+    /// @param  snapshot    [in] The statistics.
+    /// @param  text        [out] The text.
+    static void toString(const RenderStatsSnapshot &snapshot, String &text);
+
+    /// @brief  Will reset all counters and the published snapshot.
+    static void reset();
+};
+
+} // Namespace Profiling
+} // Namespace OSRE
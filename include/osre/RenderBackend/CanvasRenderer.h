@@ -0,0 +1,175 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/RenderBackend/RenderCommon.h>
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+class Material;
+class Mesh;
+class RenderBackendService;
+class SpriteAtlas;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements an immediate mode 2D renderer for sprites and the ui.
+///
+/// Rects, lines, textured quads and sprites will be collected as quads in one vertex cache. On
+/// render the quads will be sorted by layer and texture, quads using the same texture in a row
+/// will be written into one streaming mesh, so each run needs one draw call only. Each draw slot
+/// owns one mesh, its material will be rebound when the texture of the slot changes. Layers are drawn
+/// from low to high, the order of quads with different textures in the same layer is undefined.
+/// Coordinates are given in pixels, the origin is the lower left corner of the viewport. All
+/// primitives will be clipped against the clip rectangle on the CPU, lines by their center line.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT CanvasRenderer {
+public:
+    /// @brief  The maximal number of quads per draw call, larger runs will be split.
+    static constexpr ui32 BatchCapacity = 4096;
+
+    /// @brief  The class constructor.
+    /// @param  rbSrv       [in] The render backend service.
+    explicit CanvasRenderer(RenderBackendService *rbSrv);
+
+    /// @brief  The class destructor.
+    ~CanvasRenderer();
+
+    /// @brief  Will set the layer for the following primitives.
+    void setLayer(i32 layer);
+
+    /// @brief  Returns the active layer.
+    i32 getLayer() const;
+
+    /// @brief  Will set the color for the following primitives.
+    void setColor(const glm::vec3 &color);
+
+    /// @brief  Will set the clip rectangle for the following primitives.
+    void setClipRect(i32 x, i32 y, i32 w, i32 h);
+
+    /// @brief  Will disable clipping for the following primitives.
+    void resetClipRect();
+
+    /// @brief  Will draw a rectangle.
+    /// @param  x           [in] The left position.
+    /// @param  y           [in] The lower position.
+    /// @param  w           [in] The width.
+    /// @param  h           [in] The height.
+    /// @param  filled      [in] true for a filled rectangle, false for the outline only.
+    void drawRect(i32 x, i32 y, i32 w, i32 h, bool filled = true);
+
+    /// @brief  Will draw a line as a quad.
+    /// @param  x0, y0      [in] The start point.
+    /// @param  x1, y1      [in] The end point.
+    /// @param  thickness   [in] The line thickness in pixels.
+    void drawLine(i32 x0, i32 y0, i32 x1, i32 y1, f32 thickness = 1.0f);
+
+    /// @brief  Will draw a textured quad, the texture will be tinted by the active color.
+    /// @param  x, y, w, h  [in] The quad.
+    /// @param  texture     [in] The texture, must stay alive as long as the canvas uses it.
+    /// @param  uv0         [in] The lower left texture coordinate.
+    /// @param  uv1         [in] The upper right texture coordinate.
+    void drawTexturedQuad(i32 x, i32 y, i32 w, i32 h, Texture *texture,
+            const glm::vec2 &uv0 = glm::vec2(0.0f), const glm::vec2 &uv1 = glm::vec2(1.0f));
+
+    /// @brief  Will draw a sprite of an atlas.
+    /// @param  x, y        [in] The lower left corner.
+    /// @param  atlas       [in] The sprite atlas.
+    /// @param  name        [in] The sprite name.
+    /// @param  scale       [in] The scaling of the sprite size.
+    /// @return false if the sprite is not part of the atlas.
+    bool drawSprite(i32 x, i32 y, const SpriteAtlas &atlas, const String &name, f32 scale = 1.0f);
+
+    /// @brief  Will sort the collected quads, update the batches and clear the canvas.
+    void render();
+
+    /// @brief  Will drop all collected quads.
+    void clear();
+
+    /// @brief  Returns the number of collected quads.
+    size_t getNumQuads() const;
+
+    /// @brief  Returns the number of draw calls of the last render call.
+    ui32 getNumBatches() const;
+
+    /// @brief  Returns the name of the render batch of a draw call.
+    /// @param  slot        [in] The index of the draw call.
+    /// @return The name, valid as long as the canvas exists.
+    const c8 *getCanvasRenderBatchName(ui32 slot);
+
+private:
+    struct QuadCmd {
+        ui64 mKey;
+        ui32 mFirstVertex;
+    };
+
+    struct BatchMesh {
+        ui32 mTexture;
+        Mesh *mMesh;
+        ui32 mNumQuads;
+        bool mAdded;
+        bool mDirty;
+    };
+
+    ui32 getTextureSlot(Texture *texture);
+    void addQuad(const glm::vec2 &p0, const glm::vec2 &p1, const glm::vec2 &uv0, const glm::vec2 &uv1, ui32 texture);
+    void addQuad(const glm::vec2 corners[4], ui32 texture);
+    BatchMesh *getBatchMesh(ui32 slot, ui32 texture);
+    void writeBatch(BatchMesh *batch, const QuadCmd *cmds, ui32 numQuads);
+
+private:
+    RenderBackendService *mRbSrv;
+    UiVertexCache mVertexCache;
+    cppcore::TArray<QuadCmd> mQuads;
+    cppcore::TArray<Texture*> mTextures;
+    cppcore::TArray<Material*> mMaterials;
+    cppcore::TArray<BatchMesh*> mBatchMeshes;
+    cppcore::TArray<c8*> mBatchNames;
+    Texture *mWhiteTexture;
+    Texture *mLastTexture;
+    ui32 mLastTextureSlot;
+    i32 mLayer;
+    glm::vec3 mColor;
+    bool mClipping;
+    glm::vec2 mClipMin;
+    glm::vec2 mClipMax;
+    ui32 mNumBatches;
+};
+
+inline i32 CanvasRenderer::getLayer() const {
+    return mLayer;
+}
+
+inline size_t CanvasRenderer::getNumQuads() const {
+    return mQuads.size();
+}
+
+inline ui32 CanvasRenderer::getNumBatches() const {
+    return mNumBatches;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <cppcore/Container/TArray.h>
 #include <cppcore/Container/THashMap.h>
+#include <osre/RenderBackend/FontAtlas.h>
 #include <osre/RenderBackend/RenderCommon.h>
 #include <osre/RenderBackend/TransformMatrixBlock.h>
 #include <osre/Common/TAABB.h>
@@ -34,42 +35,115 @@ namespace RenderBackend {
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
-///	@brief
+///	@brief  This class implements an immediate mode renderer for debug overlays.
+///
+/// Lines, boxes, spheres and text will be collected during the frame. On flush the lines will be
+/// written into one streaming line list and the glyphs of all texts into one streaming triangle
+/// list, so each primitive type needs one draw call only. The streaming meshes have a fixed
+/// capacity, primitives beyond it will be dropped.
 //-------------------------------------------------------------------------------------------------
 class OSRE_EXPORT DbgRenderer {
-    struct DebugText;
-
 public:
-    void renderDbgText(ui32 x, ui32 y, guid id, const String &text);
-    void renderAABB(const glm::mat4 &transform, const Common::AABB &aabb);
-    void clear();
+    /// @brief  The default number of line vertices per frame.
+    static constexpr ui32 DefaultLineCapacity = 16384;
+
+    /// @brief  The default number of glyphs per frame.
+    static constexpr ui32 DefaultGlyphCapacity = 4096;
+
+    /// @brief  The default glyph size in pixels.
+    static constexpr f32 DefaultTextSize = 20.0f;
+
+    /// @brief  The number of segments per sphere circle.
+    static constexpr ui32 NumSphereSegments = 16;
+
+    /// @brief  Will queue a text in screen coordinates.
+    /// @param  x           [in] The left position in pixels.
+    /// @param  y           [in] The lower position in pixels.
+    /// @param  text        [in] The text, line breaks are supported.
+    /// @param  size        [in] The glyph size in pixels.
+    void renderDbgText(ui32 x, ui32 y, const String &text, f32 size = DefaultTextSize);
+
+    /// @brief  Will queue the render statistics of the last finished frame as text.
+    /// @param  x           [in] The left position in pixels.
+    /// @param  y           [in] The lower position in pixels.
+    /// @param  size        [in] The glyph size in pixels.
+    void renderStats(ui32 x, ui32 y, f32 size = DefaultTextSize);
+
+    /// @brief  Will queue the edges of a box.
+    /// @param  transform   [in] The model transform of the box.
+    /// @param  aabb        [in] The box in model space.
+    /// @param  color       [in] The line color.
+    void renderAABB(const glm::mat4 &transform, const Common::AABB &aabb, const glm::vec3 &color = glm::vec3(1.0f));
+
+    /// @brief  Will queue three circles around the axes of a sphere.
+    /// @param  center      [in] The center.
+    /// @param  radius      [in] The radius.
+    /// @param  color       [in] The line color.
+    void renderSphere(const glm::vec3 &center, f32 radius, const glm::vec3 &color = glm::vec3(1.0f));
+
+    /// @brief  Will queue a line.
     void addLine(const RenderBackend::ColorVert &v0, const RenderBackend::ColorVert &v1);
 
+    /// @brief  Will queue a line.
+    void addLine(const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &color);
+
+    /// @brief  Will set the camera matrices for the lines.
+    void setViewProjection(const glm::mat4 &view, const glm::mat4 &projection);
+
+    /// @brief  Will set the capacities of the streaming meshes, only possible before the first flush.
+    /// @param  numLineVertices [in] The number of line vertices.
+    /// @param  numGlyphs       [in] The number of glyphs.
+    void setCapacity(ui32 numLineVertices, ui32 numGlyphs);
+
+    /// @brief  Will write all queued primitives into the streaming meshes and clear the queues.
+    void flush();
+
+    /// @brief  Will drop all queued primitives.
+    void clear();
+
+    /// @brief  Returns the number of queued line vertices.
+    size_t getNumLineVertices() const;
+
+    /// @brief  Returns the number of queued glyphs.
+    size_t getNumGlyphs() const;
+
     static bool create(RenderBackend::RenderBackendService *rbSrv);
     static bool destroy();
     static DbgRenderer *getInstance();
     static const c8 *getDebugRenderBatchName();
+    static const c8 *getDebugTextRenderBatchName();
 
 private:
     DbgRenderer(RenderBackend::RenderBackendService *rbSrv);
     ~DbgRenderer();
-    DebugText *getDebugText(guid id) const;
+    void flushLines();
+    void flushText();
 
 private:
     static DbgRenderer *sInstance;
 
     RenderBackend::RenderBackendService *mRbSrv;
-    RenderBackend::TransformMatrixBlock mTransformMatrix;
-    RenderBackend::Mesh *mDebugMesh;
-    
-    struct DebugText {
-        RenderBackend::Mesh *mesh;
-        String text;
-    };
-
-    cppcore::TArray<DebugText*> mDebugTextMeshes;
-    ui16 mLastIndex;
+    RenderBackend::FontAtlas mFont;
+    cppcore::TArray<RenderBackend::ColorVert> mLineVertices;
+    cppcore::TArray<RenderBackend::RenderVert> mTextVertices;
+    RenderBackend::Mesh *mLineMesh;
+    RenderBackend::Mesh *mTextMesh;
+    ui32 mLineCapacity;
+    ui32 mGlyphCapacity;
+    ui32 mNumLineVerticesWritten;
+    ui32 mNumGlyphsWritten;
+    glm::mat4 mView;
+    glm::mat4 mProjection;
+    bool mMatricesDirty;
 };
 
+inline size_t DbgRenderer::getNumLineVertices() const {
+    return mLineVertices.size();
+}
+
+inline size_t DbgRenderer::getNumGlyphs() const {
+    return mTextVertices.size() / 4;
+}
+
 } // Namespace RenderBackend
 } // namespace OSRE
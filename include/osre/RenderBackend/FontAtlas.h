@@ -0,0 +1,158 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/RenderBackend/RenderCommon.h>
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+
+namespace IO {
+    class Uri;
+}
+
+namespace RenderBackend {
+
+class Material;
+
+/// @brief  The metrics of one glyph in pixels at the rasterized size, y points upwards.
+struct Glyph {
+    glm::vec2 mUv0;         ///< The lower left texture coordinate.
+    glm::vec2 mUv1;         ///< The upper right texture coordinate.
+    glm::vec2 mOffset;      ///< The lower left corner relative to the pen position on the base line.
+    glm::vec2 mSize;        ///< The size of the glyph quad, zero for blanks.
+    f32 mAdvance;           ///< The horizontal advance of the pen.
+
+    Glyph() : mUv0(0.0f), mUv1(0.0f), mOffset(0.0f), mSize(0.0f), mAdvance(0.0f) {}
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class stores the glyphs of one font in a texture atlas.
+///
+/// TrueType fonts will be rasterized once at load time into one atlas texture, the glyph metrics
+/// and the kerning table are cached. Fixed grid bitmap fonts like the build-in font can be used
+/// as well, they are monospaced and have no kerning. The text layout writes four vertices per
+/// visible glyph, the quad indices are ( 0, 2, 1 ) and ( 1, 2, 3 ).
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT FontAtlas {
+public:
+    /// @brief  The first character of the rasterized range of TrueType fonts.
+    static constexpr ui32 FirstChar = 32;
+
+    /// @brief  The number of rasterized characters of TrueType fonts.
+    static constexpr ui32 NumChars = 95;
+
+    /// @brief  The default atlas width and height in pixels.
+    static constexpr ui32 DefaultAtlasSize = 512;
+
+    /// @brief  The class constructor.
+    /// @param  name        [in] The font name, used for the texture and the material.
+    explicit FontAtlas(const String &name);
+
+    /// @brief  The class destructor.
+    ~FontAtlas();
+
+    /// @brief  Will rasterize a TrueType font into the atlas.
+    /// @param  data        [in] The font file data, only used during the call.
+    /// @param  size        [in] The size of the data in bytes.
+    /// @param  pixelHeight [in] The glyph height in pixels.
+    /// @param  atlasSize   [in] The atlas width and height in pixels.
+    /// @return true if successful, false if the font is invalid or does not fit into the atlas.
+    bool loadTrueType(const uc8 *data, size_t size, f32 pixelHeight, ui32 atlasSize = DefaultAtlasSize);
+
+    /// @brief  Will load and rasterize a TrueType font file.
+    /// @param  uri         [in] The font file.
+    /// @param  pixelHeight [in] The glyph height in pixels.
+    /// @param  atlasSize   [in] The atlas width and height in pixels.
+    /// @return true if successful, false in case of an error.
+    bool loadTrueType(const IO::Uri &uri, f32 pixelHeight, ui32 atlasSize = DefaultAtlasSize);
+
+    /// @brief  Will use a fixed grid bitmap font, the first cell contains character 0.
+    /// @param  uri         [in] The font texture.
+    /// @param  columns     [in] The number of columns.
+    /// @param  rows        [in] The number of rows.
+    /// @param  pixelHeight [in] The glyph height in pixels.
+    void createGrid(const IO::Uri &uri, ui32 columns, ui32 rows, f32 pixelHeight);
+
+    /// @brief  Returns the glyph of a character or nullptr, if it is not part of the font.
+    const Glyph *getGlyph(ui32 ch) const;
+
+    /// @brief  Returns the kerning between two characters in pixels.
+    f32 getKerning(ui32 first, ui32 second) const;
+
+    /// @brief  Will append four vertices per visible glyph.
+    /// @param  text        [in] The text, line breaks are supported.
+    /// @param  position    [in] The pen position on the base line of the first row.
+    /// @param  size        [in] The glyph height in pixels.
+    /// @param  color       [in] The vertex color.
+    /// @param  vertices    [inout] The vertex array.
+    /// @return The number of glyphs written.
+    ui32 layoutText(const String &text, const glm::vec2 &position, f32 size, const glm::vec3 &color,
+            cppcore::TArray<RenderVert> &vertices) const;
+
+    /// @brief  Returns the width of the longest row and the height of all rows in pixels.
+    glm::vec2 measureText(const String &text, f32 size) const;
+
+    /// @brief  Returns the rasterized glyph height in pixels.
+    f32 getPixelHeight() const;
+
+    /// @brief  Returns the distance between two base lines at the rasterized size.
+    f32 getLineHeight() const;
+
+    /// @brief  Returns the atlas texture of a TrueType font, nullptr for grid fonts.
+    Texture *getTexture() const;
+
+    /// @brief  Returns the text material, it will be created with the first call.
+    Material *getMaterial();
+
+private:
+    void reset();
+
+private:
+    String mName;
+    ui32 mFirstChar;
+    cppcore::TArray<Glyph> mGlyphs;
+    cppcore::TArray<f32> mKerning;
+    f32 mPixelHeight;
+    f32 mLineHeight;
+    Texture *mTexture;
+    TextureResource *mTextureResource;
+    Material *mMaterial;
+};
+
+inline f32 FontAtlas::getPixelHeight() const {
+    return mPixelHeight;
+}
+
+inline f32 FontAtlas::getLineHeight() const {
+    return mLineHeight;
+}
+
+inline Texture *FontAtlas::getTexture() const {
+    return mTexture;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -4,6 +4,7 @@
 #include <osre/IO/Uri.h>
 #include <cppcore/Container/TArray.h>
 #include <osre/RenderBackend/Shader.h>
+#include <osre/RenderBackend/PipelineState.h>
 
 namespace OSRE {
 namespace RenderBackend {
@@ -54,6 +55,7 @@ public:
     f32 mShineness;
     f32 mShinenessStrength;
     IO::Uri mUri;
+    PipelineStateId mPipelineState;
 
     Material(const String &name, const IO::Uri &uri);
     ~Material();
@@ -61,6 +63,9 @@ public:
     MaterialType getMaterialType() const;
     void createShader(ShaderSourceArray &shaders);
     Shader *getShader() const;
+    /// @brief  Cached materials are shared, use MaterialBuilder::makeUnique before changing it.
+    void setPipelineState(PipelineStateId id);
+    PipelineStateId getPipelineState() const;
 
     OSRE_NON_COPYABLE(Material)
 };
@@ -69,5 +74,13 @@ inline Shader *Material::getShader() const {
     return m_shader;
 }
 
+inline void Material::setPipelineState(PipelineStateId id) {
+    mPipelineState = id;
+}
+
+inline PipelineStateId Material::getPipelineState() const {
+    return mPipelineState;
+}
+
 } // namespace RenderBackend
 } // namespace OSRE
@@ -25,15 +25,41 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Scene/SceneCommon.h>
 #include <osre/RenderBackend/Material.h>
 #include <osre/RenderBackend/RenderCommon.h>
+#include <osre/RenderBackend/ShaderPermutation.h>
 #include <osre/Common/TResourceCache.h>
 
 namespace OSRE {
 namespace RenderBackend {
 
+/// @brief  The statistics of the material cache.
+struct MaterialCacheStats {
+    size_t mHits;           ///< Requests served by an already built material.
+    size_t mMisses;         ///< Requests which built a new material.
+    size_t mNumMaterials;   ///< The number of materials in the cache, unique ones included.
+
+    MaterialCacheStats() : mHits(0), mMisses(0), mNumMaterials(0) {}
+};
+
+/// @brief  The lighting parameters of a material, they are part of the content hash.
+struct MaterialParameters {
+    Color4 mColor[MaxMatColorType]; ///< The colors, indexed by MaterialColorType.
+    f32 mShineness;                 ///< The shininess.
+    f32 mShinenessStrength;         ///< The shininess strength.
+
+    MaterialParameters() : mColor(), mShineness(0.0f), mShinenessStrength(0.0f) {}
+};
+
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
 ///	@brief  This class takes care of all default materials.
+///
+/// Materials are cached by a hash of their content: the kind of material, the vertex type, the
+/// shader sources, the textures and the parameters. Requests with the same content share one material, the name
+/// only labels the material built first. Each returned material holds a reference, which can be
+/// given back by releaseMaterial. Materials will stay alive until destroy when not released.
+/// Shared materials must not be changed, call makeUnique before changing colors or the pipeline
+/// state.
 //-------------------------------------------------------------------------------------------------
 class OSRE_EXPORT MaterialBuilder {
 public:
@@ -55,6 +81,23 @@ public:
     /// @return The created instance will be returned.
     static RenderBackend::Material* createTexturedMaterial(const String& matName, RenderBackend::TextureResourceArray& texResArray, 
         RenderBackend::VertexType type );
+
+    /// @brief  Will create the texture material instance with its lighting parameters.
+    /// @param  matName      The name for the material.
+    /// @param  texResArray  The array with all textures to use.
+    /// @param  type         The vertex type.
+    /// @param  params       The colors and the shininess.
+    /// @return The created instance will be returned.
+    static RenderBackend::Material *createTexturedMaterial(const String &matName, RenderBackend::TextureResourceArray &texResArray,
+        RenderBackend::VertexType type, const MaterialParameters &params);
+
+    /// @brief  Will create the texture material instance for a texture created in memory.
+    /// @param  matName      The name for the material.
+    /// @param  texture      The texture, the owner must keep it alive as long as the material is used.
+    /// @param  type         The vertex type.
+    /// @return The created instance will be returned.
+    static RenderBackend::Material *createTexturedMaterial(const String &matName, RenderBackend::Texture *texture,
+        RenderBackend::VertexType type);
     
     /// @brief  Will create the texture material instance with your own shader code.
     /// @param  matName      The name for the material.
@@ -65,10 +108,41 @@ public:
     static RenderBackend::Material* createTexturedMaterial(const String& matName, RenderBackend::TextureResourceArray& texResArray, 
         const String& VsSrc, const String& FsSrc);
 
+    /// @brief  Will create the unlit material for 2D render vertices, the texture is tinted by the vertex color.
+    /// @param  matName      The name for the material.
+    /// @param  texture      The texture, the owner must keep it alive as long as the material is used.
+    /// @return The created instance will be returned.
+    static RenderBackend::Material *createCanvasMaterial(const String &matName, RenderBackend::Texture *texture);
+
     /// @brief  Will create the debug render text material.
     /// @return The instance of the material.
     static RenderBackend::Material *createDebugRenderTextMaterial();
 
+    /// @brief  Will give back a reference of a material, the last reference deletes the material.
+    /// @param  mat          The material returned by one of the create methods.
+    static void releaseMaterial(RenderBackend::Material *mat);
+
+    /// @brief  Will return a material, which is not shared and can be changed. A shared material
+    ///         will be copied, the reference of the caller moves to the copy.
+    /// @param  mat          The material returned by one of the create methods.
+    /// @return The unique material, give it back by releaseMaterial.
+    static RenderBackend::Material *makeUnique(RenderBackend::Material *mat);
+
+    /// @brief  Returns the number of references of a cached material.
+    /// @param  mat          The material.
+    /// @return The number of references, 0 if the material is not cached.
+    static ui32 getRefCount(const RenderBackend::Material *mat);
+
+    /// @brief  Returns a variant of the build-in shader for a vertex type.
+    /// @param  type         The vertex type.
+    /// @param  key          The variant key, unsupported features are ignored.
+    /// @return The variant or nullptr, if there is no build-in shader for the vertex type.
+    static const RenderBackend::ShaderVariant *getShaderVariant(RenderBackend::VertexType type, RenderBackend::ShaderVariantKey key);
+
+    /// @brief  Returns the hit and miss statistics of the material cache.
+    /// @return The statistics.
+    static MaterialCacheStats getCacheStats();
+
 private:
     /// @brief The default class constructor.
     MaterialBuilder() = default;
@@ -77,8 +151,7 @@ private:
     ~MaterialBuilder() = default;
 
 private:
-    using MaterialFactory = Common::TResourceFactory<RenderBackend::Material>;
-    using MaterialCache = Common::TResourceCache<MaterialFactory, RenderBackend::Material>;
+    struct MaterialCache;
     static MaterialCache *sMaterialCache;
 };
 
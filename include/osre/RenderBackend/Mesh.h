@@ -46,6 +46,7 @@ public:
     void setMaterial(Material *mat);
     Material *getMaterial() const;
     VertexType getVertexType() const;
+    void setVertexType(VertexType vertexType);
     IndexType getIndexType() const;
     const String &getName() const;
     void *mapVertexBuffer(size_t vbSize, BufferAccessType accessType);
@@ -61,6 +62,11 @@ public:
     void setModelMatrix(bool islocal, const glm::mat4 &model);
     bool isLocal() const;
     const glm::mat4 &getLocalMatrix() const;
+    void setDequantization(const glm::vec3 &offset, f32 scale);
+    bool isQuantized() const;
+    const glm::mat4 &getDequantizationMatrix() const;
+    void setNumActiveVertices(size_t numVertices);
+    size_t getActiveVertexBufferSize() const;
 
     template <class T>
     void attachVertices(T *vertices, size_t size) {
@@ -92,6 +98,7 @@ private:
     String mName;
     bool mLocalModelMatrix;
     glm::mat4 mModel;
+    glm::mat4 mDequantization;
     Material *mMaterial;
     VertexType mVertexType;
     BufferData *mVertexBuffer;
@@ -103,6 +110,7 @@ private:
     ::cppcore::TArray<uc8> mVertexData;
     ::cppcore::TArray<uc8> mIndexData;
     ui32 mLastIndex;
+    size_t mNumActiveVertices;
 };
 
 inline void Mesh::setMaterial(Material *mat) {
@@ -117,6 +125,10 @@ inline VertexType Mesh::getVertexType() const {
     return mVertexType;
 }
 
+inline void Mesh::setVertexType(VertexType vertexType) {
+    mVertexType = vertexType;
+}
+
 inline IndexType Mesh::getIndexType() const {
     return mIndexType;
 }
@@ -163,5 +175,32 @@ inline bool Mesh::isLocal() const {
     return mLocalModelMatrix;
 }
 
+inline bool Mesh::isQuantized() const {
+    return mVertexType == VertexType::QuantizedRenderVertex;
+}
+
+inline const glm::mat4 &Mesh::getDequantizationMatrix() const {
+    return mDequantization;
+}
+
+inline void Mesh::setNumActiveVertices(size_t numVertices) {
+    mNumActiveVertices = numVertices;
+}
+
+inline size_t Mesh::getActiveVertexBufferSize() const {
+    if (nullptr == mVertexBuffer) {
+        return 0;
+    }
+
+    // Only the active vertices will be uploaded on an update
+    const size_t size = mVertexBuffer->getSize();
+    const size_t vertexSize = getVertexSize(mVertexType);
+    if (0 == vertexSize || mNumActiveVertices >= size / vertexSize) {
+        return size;
+    }
+
+    return mNumActiveVertices * vertexSize;
+}
+
 } // Namespace RenderBackend
 } // Namespace OSRE
@@ -107,6 +107,21 @@ public:
     /// @param  text        [in] The updated text.
     static void updateTextBox( RenderBackend::Mesh *geo, f32 textSize, const String &text );
 
+    /// @brief  Will allocate a mesh for vertices which are rewritten every frame. No vertex will
+    /// be drawn at first.
+    /// @param  name        [in] The name for the mesh.
+    /// @param  type        [in] The vertex type, color or render vertices.
+    /// @param  numVertices [in] The capacity in vertices.
+    /// @param  primType    [in] Lines and points use one index per vertex, triangles two per quad.
+    /// @return The created mesh.
+    MeshBuilder &allocStreamingMesh(const String &name, RenderBackend::VertexType type, ui32 numVertices,
+            RenderBackend::PrimitiveType primType);
+
+    /// @brief  Will set the number of vertices of a streaming mesh, which will be uploaded and drawn.
+    /// @param  mesh        [inout] The streaming mesh.
+    /// @param  numVertices [in] The number of vertices written from the start of the buffer.
+    static void setNumStreamingVertices(RenderBackend::Mesh *mesh, size_t numVertices);
+
     ///	@brief  Allocates vertices into a buffer data.
     /// @param  type        [in] The vertex type to create.
     ///	@param  numVerts    [in] The number of vertices to create.
@@ -45,6 +45,19 @@ public:
     void addMesh( RenderBackend::Mesh *geo );
     const Common::AABB &getAABB() const;
 
+    /// @brief  Will convert the vertices of a render vertex mesh into quantized render vertices.
+    /// @param  mesh        [in] The mesh to convert.
+    /// @param  tangents    [in] Optional tangents, one per vertex, can be nullptr.
+    /// @return true, if the mesh was converted, false if not.
+    static bool quantize(RenderBackend::Mesh *mesh, const glm::vec3 *tangents = nullptr);
+
+    /// @brief  Will extract the triangles of a mesh as an indexed triangle list, used for occluders.
+    /// @param  mesh        [in] The mesh.
+    /// @param  positions   [out] The vertex positions, will be appended.
+    /// @param  indices     [out] The triangle indices, will be appended.
+    /// @return true, if triangles were found, false if not.
+    static bool getTriangles(RenderBackend::Mesh *mesh, cppcore::TArray<glm::vec3> &positions, cppcore::TArray<ui32> &indices);
+
 private:
     void handleMesh( RenderBackend::Mesh *mesh );
 
@@ -0,0 +1,148 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/RenderBackend/RenderStates.h>
+
+#include <memory>
+
+namespace OSRE {
+namespace RenderBackend {
+
+/// @brief  The id of a pipeline state object, the 32-bit hash of its states.
+using PipelineStateId = ui32;
+
+/// @brief  Marks an invalid pipeline state id.
+static constexpr PipelineStateId InvalidPipelineStateId = 0u;
+
+/// @brief  The sub-states of a pipeline state object.
+enum class PipelineSubState : ui32 {
+    Clear = 0,      ///< The clear state.
+    Depth,          ///< The depth state.
+    Transform,      ///< The transform state.
+    Polygon,        ///< The polygon state.
+    Blend,          ///< The blend state.
+    Cull,           ///< The cull state.
+    Sampler,        ///< The sampler state.
+    Stencil,        ///< The stencil state.
+    NumSubStates    ///< The number of sub-states.
+};
+
+static constexpr ui32 NumPipelineSubStates = static_cast<ui32>(PipelineSubState::NumSubStates);
+
+/// @brief  Will create a sort key, draw calls sorted by it are grouped by their pipeline state.
+/// @param  id          [in] The pipeline state id, stored in the upper 32 bits.
+/// @param  payload     [in] A key to sort the draw calls of one pipeline state, like a texture id.
+/// @return The sort key.
+constexpr ui64 makePipelineSortKey(PipelineStateId id, ui32 payload) {
+    return (static_cast<ui64>(id) << 32) | payload;
+}
+
+/// @brief  Returns the pipeline state id of a sort key.
+constexpr PipelineStateId getPipelineStateFromSortKey(ui64 key) {
+    return static_cast<PipelineStateId>(key >> 32);
+}
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class describes an immutable pipeline state object.
+///
+/// The hash of each sub-state is computed once, so a backend can find the sub-states which differ
+/// between two objects without comparing all of the fields.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT PipelineState {
+public:
+    /// @brief  Returns the id.
+    PipelineStateId getId() const;
+
+    /// @brief  Returns the states.
+    const RenderStates &getStates() const;
+
+    /// @brief  Returns the hash of a sub-state.
+    ui32 getSubStateHash(PipelineSubState subState) const;
+
+    /// @brief  Will compute the hashes of all sub-states.
+    /// @param  states      [in] The states.
+    /// @param  hashes      [out] One hash per sub-state.
+    static void computeSubStateHashes(const RenderStates &states, ui32 *hashes);
+
+    /// @brief  Will compute the id hash of the states.
+    /// @param  states      [in] The states.
+    /// @return The hash, never InvalidPipelineStateId.
+    static PipelineStateId computeHash(const RenderStates &states);
+
+    OSRE_NON_COPYABLE(PipelineState)
+
+private:
+    friend class PipelineStateRegistry;
+    friend struct std::default_delete<PipelineState>;
+
+    PipelineState(PipelineStateId id, const RenderStates &states);
+    ~PipelineState() = default;
+
+private:
+    PipelineStateId mId;
+    RenderStates mStates;
+    ui32 mSubStateHashes[NumPipelineSubStates];
+};
+
+inline PipelineStateId PipelineState::getId() const {
+    return mId;
+}
+
+inline const RenderStates &PipelineState::getStates() const {
+    return mStates;
+}
+
+inline ui32 PipelineState::getSubStateHash(PipelineSubState subState) const {
+    return mSubStateHashes[static_cast<ui32>(subState)];
+}
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class owns all pipeline state objects.
+///
+/// Objects are created once per distinct set of states and live until the process ends, so passes
+/// and backends can cache the ids. Creation and lookup are thread-safe, so passes can be set up in
+/// the application thread while the render thread applies them.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT PipelineStateRegistry {
+public:
+    /// @brief  Returns the id of the object for the states, the object will be created if needed.
+    /// @param  states      [in] The states.
+    /// @return The id.
+    static PipelineStateId create(const RenderStates &states);
+
+    /// @brief  Returns the object for an id.
+    /// @param  id          [in] The id.
+    /// @return The object or nullptr for an unknown id.
+    static const PipelineState *get(PipelineStateId id);
+
+    /// @brief  Returns the number of objects.
+    static size_t getNumStates();
+};
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -72,16 +72,37 @@ DECL_EVENT(OnCommitFrameEvent);
 DECL_EVENT(OnShutdownRequestEvent);
 DECL_EVENT(OnResizeEvent);
 
+///	@brief  The image formats of screenshots.
+enum class ScreenshotFormat {
+    Jpg = 0,    ///< JPEG, lossy.
+    Png,        ///< PNG, lossless.
+    Raw         ///< The RGB pixels, rows from top to bottom, without any header.
+};
+
+///	@brief  The screenshot requests.
+enum class ScreenshotMode {
+    Single = 0,     ///< Captures the next frame.
+    BeginSequence,  ///< Captures every frame until the sequence will be ended.
+    EndSequence     ///< Stops capturing frames.
+};
+
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
 ///	@brief  Will create a screenshot event.
+///
+/// The capture is asynchronous: the frame will be read back into a pixel buffer and written
+/// a few frames later by a worker thread. Sequences use the filename as a prefix, the frame
+/// number and the extension will be appended. A size of zero uses the viewport size.
 //-------------------------------------------------------------------------------------------------
 struct OSRE_EXPORT ScreenshotEventData : public Common::EventData {
-    ScreenshotEventData(String filename, ui32 w, ui32 h) : EventData(OnScreenshotEvent, nullptr), 
-            mFilename(filename), mWidth(w), mHeight(h) {}
+    ScreenshotEventData(String filename, ui32 w, ui32 h, ScreenshotFormat format = ScreenshotFormat::Jpg,
+            ScreenshotMode mode = ScreenshotMode::Single) : EventData(OnScreenshotEvent, nullptr),
+            mFilename(filename), mWidth(w), mHeight(h), mFormat(format), mMode(mode) {}
     String mFilename;
     ui32 mWidth, mHeight;
+    ScreenshotFormat mFormat;
+    ScreenshotMode mMode;
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -232,6 +253,19 @@ public:
 
     void syncRenderThread();
 
+    /// @brief  Will capture the next frame asynchronously.
+    /// @param  filename    [in] The image file.
+    /// @param  format      [in] The image format.
+    void takeScreenshot(const String &filename, ScreenshotFormat format = ScreenshotFormat::Png);
+
+    /// @brief  Will capture every frame until the sequence will be ended.
+    /// @param  prefix      [in] The filename prefix, the frame number and extension will be appended.
+    /// @param  format      [in] The image format.
+    void beginScreenshotSequence(const String &prefix, ScreenshotFormat format = ScreenshotFormat::Png);
+
+    /// @brief  Will stop capturing the frames.
+    void endScreenshotSequence();
+
     void setViewport(ui32 x, ui32 y, ui32 w, ui32 h);
 
     const Viewport &getViewport() const;
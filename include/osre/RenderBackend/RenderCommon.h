@@ -44,6 +44,7 @@ struct FrameBuffer;
 class Mesh;
 class Shader;
 class Pipeline;
+class Material;
 
 /// @brief An array to store meshes.
 using MeshArray = cppcore::TArray<RenderBackend::Mesh*>;
@@ -90,6 +91,7 @@ enum class VertexType {
     InvalidVetexType = -1,  ///< Marker for an invalid data type.
     ColorVertex = 0,        ///< A simple vertex consisting of position and color.
     RenderVertex,           ///< A render vertex with position, color, normals and texture coordinates.
+    QuantizedRenderVertex,  ///< A compressed render vertex, see QuantizedRenderVert.
     NumVertexTypes          ///< Number of enums.
 };
 
@@ -215,6 +217,11 @@ enum class VertexFormat : int {
     UByte4,                   ///< 4-component float (0.0f..255.0f) mapped to byte (0..255)
     Short2,                   ///< 2-component float (-32768.0f..+32767.0f) mapped to short (-32768..+32768)
     Short4,                   ///< 4-component float (-32768.0f..+32767.0f) mapped to short (-32768..+32768)
+    Half2,                    ///< 2-component half float, expanded to (x, y, 0, 1)
+    Half4,                    ///< 4-component half float
+    Short2N,                  ///< 2-component float (-1.0f..+1.0f) mapped to normalized short
+    Short4N,                  ///< 4-component float (-1.0f..+1.0f) mapped to normalized short
+    UByte4N,                  ///< 4-component float (0.0f..1.0f) mapped to normalized unsigned byte
     NumVertexFormats          ///< Number of enums.
 };
 
@@ -261,6 +268,28 @@ struct OSRE_EXPORT RenderVert {
     static const String *getAttributes();
 };
 
+/// @brief  This struct declares a compressed render vertex.
+///
+/// The position is stored as normalized shorts in the unit cube, use the dequantization transform
+/// of the mesh to get back to object space. Normal and tangent are octahedral-encoded, the color is
+/// stored as RGBA8 and the texture coordinates as half floats. This needs 24 bytes instead of 44.
+struct OSRE_EXPORT QuantizedRenderVert {
+    i16 position[4];    ///< The quantized position ( x|y|z|pad )
+    i16 normal[2];      ///< The octahedral-encoded normal vector
+    i16 tangent[2];     ///< The octahedral-encoded tangent vector
+    uc8 color0[4];      ///< The diffuse color ( r|g|b|a )
+    ui16 tex0[2];       ///< The texture coordinates as half floats ( u|v )
+
+    QuantizedRenderVert();
+    ~QuantizedRenderVert() = default;
+
+    /// @brief  Returns the number of attributes.
+    static size_t getNumAttributes();
+
+    /// @brief  Returns the attribute array.
+    static const String *getAttributes();
+};
+
 OSRE_EXPORT const String &getVertCompName(VertexAttribute attrib);
 
 struct OSRE_EXPORT UIVert {
@@ -305,6 +334,17 @@ inline size_t getVertexFormatSize(VertexFormat format) {
         case VertexFormat::Short4:
             size = sizeof(ui16) * 4;
             break;
+        case VertexFormat::Half2:
+        case VertexFormat::Short2N:
+            size = sizeof(ui16) * 2;
+            break;
+        case VertexFormat::Half4:
+        case VertexFormat::Short4N:
+            size = sizeof(ui16) * 4;
+            break;
+        case VertexFormat::UByte4N:
+            size = sizeof(uc8) * 4;
+            break;
         case VertexFormat::NumVertexFormats:
         case VertexFormat::InvalidVertexFormat:
             break;
@@ -316,6 +356,11 @@ inline size_t getVertexFormatSize(VertexFormat format) {
     return size;
 }
 
+///	@brief  Returns true, if the integer data of the format will be normalized to 0..1 or -1..1 on fetch.
+inline bool isVertexFormatNormalized(VertexFormat format) {
+    return format == VertexFormat::Short2N || format == VertexFormat::Short4N || format == VertexFormat::UByte4N;
+}
+
 /// @brief  This struct declares an extension description.
 struct ExtensionProperty {
     c8 m_extensionName[MaxEntNameLen];
@@ -797,6 +842,8 @@ struct FrameSubmitCmd {
     c8 *m_data;
     ::cppcore::TArray<MeshEntry*> m_newMeshes;
     ::cppcore::TArray<PassData*> m_updatedPasses;
+    ::cppcore::TArray<size_t> m_numIndices;
+    Material *m_material;
 
     FrameSubmitCmd() :
             m_meshId(999999),
@@ -805,7 +852,10 @@ struct FrameSubmitCmd {
             m_updateFlags(0),
             m_size(0),
             m_data(nullptr),
-            m_newMeshes() {
+            m_newMeshes(),
+            m_updatedPasses(),
+            m_numIndices(),
+            m_material(nullptr) {
         // empty
     }
 
@@ -919,12 +969,20 @@ struct Frame {
 
 /// @brief This struct is used to descripe a frame buffer data structure.
 struct FrameBuffer {
+    const c8 *m_name;           ///< The name, used by the backend to find the GPU framebuffer.
     i32 m_width;
     i32 m_height;
     i32 m_depth;
+    PixelFormatType m_format;   ///< The pixel format of the color attachment.
+    bool m_depthBuffer;         ///< true, if a depth attachment is used.
 
     FrameBuffer(i32 w, i32 h, i32 d) :
-            m_width(w), m_height(h), m_depth(d) {
+            m_name(nullptr), m_width(w), m_height(h), m_depth(d), m_format(PixelFormatType::R8G8B8), m_depthBuffer(true) {
+        // empty
+    }
+
+    FrameBuffer(const c8 *name, i32 w, i32 h, PixelFormatType format, bool depthBuffer) :
+            m_name(name), m_width(w), m_height(h), m_depth(0), m_format(format), m_depthBuffer(depthBuffer) {
         // empty
     }
 
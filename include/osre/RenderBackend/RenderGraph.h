@@ -0,0 +1,216 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/RenderBackend/RenderCommon.h>
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+// Forward declarations ---------------------------------------------------------------------------
+class Pipeline;
+class RenderPass;
+
+/// @brief  The handle of a pass or a resource in a render graph.
+using RenderGraphHandle = ui32;
+
+/// @brief  Marks an invalid render graph handle.
+static constexpr RenderGraphHandle InvalidRenderGraphHandle = 0xffffffffu;
+
+/// @brief  Describes a render target, targets with the same description can share memory.
+struct RenderTargetDesc {
+    ui32 mWidth;                ///< The width in pixels.
+    ui32 mHeight;               ///< The height in pixels.
+    PixelFormatType mFormat;    ///< The pixel format of the color attachment.
+    bool mDepthBuffer;          ///< true for an additional depth attachment.
+
+    RenderTargetDesc(ui32 w, ui32 h, PixelFormatType format, bool depthBuffer) :
+            mWidth(w), mHeight(h), mFormat(format), mDepthBuffer(depthBuffer) {}
+
+    /// @brief  Returns the pool key, equal descriptions will return the same key.
+    ui64 getKey() const;
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class pools framebuffers so transient render targets can be reused over frames.
+///
+/// The names of the pooled framebuffers stay stable, so the render backend will find the GPU
+/// framebuffer of a reused target again instead of creating a new one.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT RenderTargetPool {
+public:
+    /// @brief  The class constructor.
+    RenderTargetPool();
+
+    /// @brief  The class destructor.
+    ~RenderTargetPool();
+
+    /// @brief  Returns a free framebuffer for the description, a new one will be created if needed.
+    /// @param  desc        [in] The target description.
+    /// @return The framebuffer.
+    FrameBuffer *acquire(const RenderTargetDesc &desc);
+
+    /// @brief  Gives a framebuffer back to the pool.
+    /// @param  frameBuffer [in] The framebuffer from acquire.
+    void release(FrameBuffer *frameBuffer);
+
+    /// @brief  Returns the number of framebuffers owned by the pool.
+    size_t getNumTargets() const;
+
+    /// @brief  Returns the number of framebuffers currently in use.
+    size_t getNumTargetsInUse() const;
+
+    /// @brief  Will delete all framebuffers.
+    void clear();
+
+    RenderTargetPool(const RenderTargetPool &) = delete;
+    RenderTargetPool &operator=(const RenderTargetPool &) = delete;
+
+private:
+    struct Entry;
+
+    cppcore::TArray<Entry*> mEntries;
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class builds the passes of a pipeline from their declared reads and writes.
+///
+/// Each pass writes one target, the graph outputs are imported targets like the back buffer.
+/// On compile passes which do not contribute to an output are culled, the remaining ones are
+/// sorted by their dependencies and the transient targets are taken from the pool. Transient
+/// targets with the same description and without overlapping lifetimes share one framebuffer.
+/// Usage:
+/// @code
+///  RenderGraphHandle gbuffer = graph.createTarget("gbuffer", desc);
+///  RenderGraphHandle backBuffer = graph.importTarget("backbuffer", nullptr);
+///  RenderGraphHandle geoPass = graph.addPass(geoRenderPass);
+///  graph.write(geoPass, gbuffer);
+///  RenderGraphHandle lightPass = graph.addPass(lightRenderPass);
+///  graph.read(lightPass, gbuffer);
+///  graph.write(lightPass, backBuffer);
+///  if (graph.compile()) {
+///      graph.apply(pipeline);
+///  }
+///  ...
+///  graph.reset();
+/// @endcode
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT RenderGraph {
+public:
+    /// @brief  The class constructor.
+    /// @param  pool        [in] The pool for the transient targets.
+    explicit RenderGraph(RenderTargetPool *pool);
+
+    /// @brief  The class destructor, will give all transient targets back to the pool.
+    ~RenderGraph();
+
+    /// @brief  Will declare a transient target, the framebuffer will be assigned by compile.
+    /// @param  name        [in] The target name.
+    /// @param  desc        [in] The target description.
+    /// @return The resource handle.
+    RenderGraphHandle createTarget(const String &name, const RenderTargetDesc &desc);
+
+    /// @brief  Will declare an external target, imported targets are the outputs of the graph.
+    /// @param  name        [in] The target name.
+    /// @param  frameBuffer [in] The framebuffer, nullptr for the back buffer.
+    /// @return The resource handle.
+    RenderGraphHandle importTarget(const String &name, FrameBuffer *frameBuffer);
+
+    /// @brief  Will add a pass.
+    /// @param  pass        [in] The render pass, it will not be owned by the graph.
+    /// @return The pass handle.
+    RenderGraphHandle addPass(RenderPass *pass);
+
+    /// @brief  Declares that a pass reads a target. An imported target is read after the passes
+    ///         declared before, which write it.
+    /// @return false for invalid handles.
+    bool read(RenderGraphHandle pass, RenderGraphHandle resource);
+
+    /// @brief  Declares that a pass writes a target, each pass can write one target.
+    /// @return false for invalid handles or when the pass writes already another target.
+    bool write(RenderGraphHandle pass, RenderGraphHandle resource);
+
+    /// @brief  Marks a pass as never to be culled.
+    void setSideEffect(RenderGraphHandle pass);
+
+    /// @brief  Will cull, sort the passes and assign the framebuffers.
+    /// @return false in case of a dependency cycle.
+    bool compile();
+
+    /// @brief  Will add the sorted passes to the pipeline.
+    /// @param  pipeline    [in] The pipeline to fill.
+    void apply(Pipeline *pipeline) const;
+
+    /// @brief  Gives the transient targets back to the pool and removes all declarations.
+    void reset();
+
+    /// @brief  Returns the number of passes left after compile.
+    size_t getNumActivePasses() const;
+
+    /// @brief  Returns a pass in execution order.
+    RenderPass *getActivePass(size_t index) const;
+
+    /// @brief  Returns true, if the pass was culled by compile.
+    bool isCulled(RenderGraphHandle pass) const;
+
+    /// @brief  Returns the framebuffer assigned to a target.
+    FrameBuffer *getFrameBuffer(RenderGraphHandle resource) const;
+
+    /// @brief  Returns the number of pooled framebuffers used by the transient targets.
+    size_t getNumPhysicalTargets() const;
+
+    RenderGraph(const RenderGraph &) = delete;
+    RenderGraph &operator=(const RenderGraph &) = delete;
+
+private:
+    struct PassNode;
+    struct ResourceNode;
+
+    void cullPasses();
+    ui32 countImportedWriters(RenderGraphHandle resource, size_t pass) const;
+    bool sortPasses();
+    void allocateTargets();
+
+private:
+    RenderTargetPool *mPool;
+    cppcore::TArray<PassNode*> mPasses;
+    cppcore::TArray<ResourceNode*> mResources;
+    cppcore::TArray<ui32> mOrder;
+    cppcore::TArray<FrameBuffer*> mPhysicalTargets;
+};
+
+inline size_t RenderGraph::getNumActivePasses() const {
+    return mOrder.size();
+}
+
+inline size_t RenderGraph::getNumPhysicalTargets() const {
+    return mPhysicalTargets.size();
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
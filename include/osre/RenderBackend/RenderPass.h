@@ -23,12 +23,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include <osre/RenderBackend/RenderStates.h>
+#include <osre/RenderBackend/PipelineState.h>
 #include <cppcore/Container/TArray.h>
 
 namespace OSRE {
 namespace RenderBackend {
 
 class RenderPass;
+struct FrameBuffer;
 
 class OSRE_EXPORT RenderPassFactory {
 public:
@@ -70,6 +72,11 @@ public:
     const StencilState &getStencilState() const;
     RenderPass &setShader(Shader *shader);
     Shader *getShader() const;
+    RenderPass &setFrameBuffer(FrameBuffer *frameBuffer);
+    FrameBuffer *getFrameBuffer() const;
+    /// @brief  Returns the id of the pipeline state object for the states of the pass.
+    /// @return The id, the object will be created on the first call after a state change.
+    PipelineStateId getPipelineStateId() const;
     guid getId() const;
     static const c8 *getPassNameById(guid id);
     bool operator==(const RenderPass &rhs) const;
@@ -80,6 +87,8 @@ private:
     RenderTarget mRenderTarget;
     RenderStates mStates;
     Shader *mShader;
+    FrameBuffer *mFrameBuffer;
+    mutable PipelineStateId mPipelineStateId;
 };
 
 inline guid RenderPass::getId() const {
@@ -110,6 +110,18 @@ public:
     /// @return The assigned source or an empty string.
     const c8 *getSource(ShaderType type) const;
 
+    /// @brief  Will assign the program of a shader variant, shaders with the same program name share
+    ///         one compiled program in the backend.
+    /// @param  name     The program name.
+    /// @param  id       The small id of the variant.
+    void setProgram(const String &name, ui32 id);
+
+    /// @brief  Will return the program name, empty if no variant was assigned.
+    const String &getProgramName() const;
+
+    /// @brief  Will return the variant id, 0 if no variant was assigned.
+    ui32 getProgramId() const;
+
     /// @brief  Will return the type of a shader from its extension.
     /// @param  extension   The extension.
     /// @return The shader type.
@@ -130,8 +142,18 @@ private:
     StringArray mVertexAttributes;
     String m_src[MaxShaderTypes];
     CompileState m_compileState[MaxCompileState];
+    String mProgramName;
+    ui32 mProgramId;
 };
 
+inline const String &Shader::getProgramName() const {
+    return mProgramName;
+}
+
+inline ui32 Shader::getProgramId() const {
+    return mProgramId;
+}
+
 inline size_t Shader::getNumVertexAttributes() const {
     return mVertexAttributes.size();
 }
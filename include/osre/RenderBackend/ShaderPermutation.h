@@ -0,0 +1,144 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/RenderBackend/Shader.h>
+#include <map>
+
+namespace OSRE {
+namespace RenderBackend {
+
+/// @brief  The key of a shader variant, a bitmask of the enabled features.
+using ShaderVariantKey = ui32;
+
+/// @brief  The feature bits of a shader variant.
+namespace ShaderFeature {
+    static constexpr ShaderVariantKey None = 0u;                    ///< The base variant.
+    static constexpr ShaderVariantKey Skinning = 1u << 0;           ///< Vertices are skinned by a bone palette.
+    static constexpr ShaderVariantKey Instancing = 1u << 1;         ///< Per instance data is used.
+    static constexpr ShaderVariantKey Lighting = 1u << 2;           ///< Vertices are lit.
+    static constexpr ui32 TextureCountShift = 3;                    ///< The first bit of the texture count.
+    static constexpr ShaderVariantKey TextureCountMask = 0x7u << TextureCountShift; ///< The bits of the texture count.
+    static constexpr ui32 MaxTextures = 7;                          ///< The highest texture count.
+} // Namespace ShaderFeature
+
+/// @brief  Will build a variant key at compile time.
+/// @param  features     The feature bits without the texture count.
+/// @param  numTextures  The number of textures, clamped to ShaderFeature::MaxTextures.
+/// @return The variant key.
+constexpr ShaderVariantKey makeShaderVariantKey(ShaderVariantKey features, ui32 numTextures) {
+    return (features & ~ShaderFeature::TextureCountMask) |
+           ((numTextures > ShaderFeature::MaxTextures ? ShaderFeature::MaxTextures : numTextures) << ShaderFeature::TextureCountShift);
+}
+
+/// @brief  Returns the texture count of a variant key.
+constexpr ui32 getShaderTextureCount(ShaderVariantKey key) {
+    return (key & ShaderFeature::TextureCountMask) >> ShaderFeature::TextureCountShift;
+}
+
+/// @brief  One variant of a shader permutation.
+struct ShaderVariant {
+    ShaderVariantKey mKey;          ///< The variant key.
+    ui32 mId;                       ///< The small id, unique over all permutations, usable in sort keys.
+    String mProgramName;            ///< The program name, variants are compiled once per program name.
+    ShaderSourceArray mSources;     ///< The sources with the feature defines.
+
+    ShaderVariant() : mKey(0), mId(0), mProgramName(), mSources() {}
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class builds the variants of a shader from one source with feature defines.
+///
+/// The shader declares the features it supports, the bits of other features are masked out of
+/// the requested key. So keys which only differ in unsupported features share one variant.
+/// For each enabled feature a define like OSRE_LIGHTING will be added behind the version line,
+/// the texture count is always defined as OSRE_TEXTURE_COUNT. Variants are built when they are
+/// requested the first time or up front with precompile.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT ShaderPermutation {
+public:
+    /// @brief  The class constructor.
+    /// @param  name        The shader name.
+    /// @param  features    The supported feature bits.
+    ShaderPermutation(const String &name, ShaderVariantKey features);
+
+    /// @brief  The class destructor.
+    ~ShaderPermutation();
+
+    /// @brief  Will set the source template for a shader type.
+    /// @param  type    The shader type.
+    /// @param  src     The source, the version line must be the first one.
+    void setSource(ShaderType type, const String &src);
+
+    /// @brief  Returns the variant for a key, it will be built on the first request.
+    /// @param  key     The variant key.
+    /// @return The variant.
+    const ShaderVariant *getVariant(ShaderVariantKey key);
+
+    /// @brief  Will build the variants for a list of keys.
+    /// @param  keys        The keys.
+    /// @param  numKeys     The number of keys.
+    void precompile(const ShaderVariantKey *keys, size_t numKeys);
+
+    /// @brief  Returns the number of built variants.
+    size_t getNumVariants() const;
+
+    /// @brief  Returns the supported feature bits.
+    ShaderVariantKey getFeatures() const;
+
+    /// @brief  Returns the shader name.
+    const String &getName() const;
+
+    /// @brief  Will return the feature defines for a key.
+    /// @param  key     The variant key.
+    /// @return The defines, one per line.
+    static String getDefines(ShaderVariantKey key);
+
+    // No copying
+    OSRE_NON_COPYABLE(ShaderPermutation)
+
+private:
+    using VariantMap = std::map<ShaderVariantKey, ShaderVariant*>;
+
+    String mName;
+    ShaderVariantKey mFeatures;
+    ShaderSourceArray mSources;
+    VariantMap mVariants;
+};
+
+inline size_t ShaderPermutation::getNumVariants() const {
+    return mVariants.size();
+}
+
+inline ShaderVariantKey ShaderPermutation::getFeatures() const {
+    return mFeatures;
+}
+
+inline const String &ShaderPermutation::getName() const {
+    return mName;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,99 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/RenderBackend/RenderCommon.h>
+#include <cppcore/Container/TArray.h>
+#include <cppcore/Container/THashMap.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+/// @brief  A named region of a sprite atlas.
+struct SpriteRegion {
+    String mName;           ///< The sprite name.
+    glm::vec2 mUv0;         ///< The lower left texture coordinate.
+    glm::vec2 mUv1;         ///< The upper right texture coordinate.
+    glm::vec2 mSize;        ///< The size in pixels.
+    ui32 mNext;             ///< The next region with the same name hash.
+
+    SpriteRegion() : mName(), mUv0(0.0f), mUv1(0.0f), mSize(0.0f), mNext(0) {}
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class maps sprite names to regions of one texture.
+///
+/// The lookup uses a hash index of the sprite names, so drawing thousands of sprites by name
+/// stays cheap. Regions are given in image pixels with the origin in the upper left corner like
+/// in the common sprite sheet tools.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT SpriteAtlas {
+public:
+    /// @brief  The class constructor.
+    /// @param  texture     [in] The atlas texture, width and height must be valid.
+    explicit SpriteAtlas(Texture *texture);
+
+    /// @brief  The class destructor.
+    ~SpriteAtlas() = default;
+
+    /// @brief  Will add a named region.
+    /// @param  name        [in] The sprite name.
+    /// @param  rect        [in] The region in image pixels.
+    /// @return false if the name is already in use or the region is outside of the texture.
+    bool addRegion(const String &name, const Rect2ui &rect);
+
+    /// @brief  Will add the cells of a regular grid, named prefix followed by the cell index.
+    /// @param  prefix      [in] The name prefix.
+    /// @param  columns     [in] The number of columns.
+    /// @param  rows        [in] The number of rows.
+    void addGrid(const String &prefix, ui32 columns, ui32 rows);
+
+    /// @brief  Returns the region of a sprite or nullptr, if there is none.
+    const SpriteRegion *findRegion(const String &name) const;
+
+    /// @brief  Returns the number of regions.
+    size_t getNumRegions() const;
+
+    /// @brief  Returns the atlas texture.
+    Texture *getTexture() const;
+
+private:
+    using NameIndex = cppcore::THashMap<HashId, ui32>;
+
+    Texture *mTexture;
+    cppcore::TArray<SpriteRegion> mRegions;
+    NameIndex mNameIndex;
+};
+
+inline size_t SpriteAtlas::getNumRegions() const {
+    return mRegions.size();
+}
+
+inline Texture *SpriteAtlas::getTexture() const {
+    return mTexture;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
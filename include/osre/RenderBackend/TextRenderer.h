@@ -0,0 +1,158 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/RenderBackend/RenderCommon.h>
+#include <osre/Common/TSlotMap.h>
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+class FontAtlas;
+class Mesh;
+class RenderBackendService;
+
+/// @brief  The handle of a text label.
+using TextHandle = Common::SlotHandle;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class renders retained text labels like HUD elements with one draw call.
+///
+/// All labels share one streaming vertex buffer. Each label owns a run of glyph slots in it, the
+/// vertices of a label will only be written when its text, position or color has changed. A
+/// changed label reuses its run if the new text fits, otherwise a new run will be appended and
+/// the old one collapsed. Only the glyph slots up to the end of the last run will be drawn. When
+/// the buffer is full the live runs will be compacted.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT TextRenderer {
+public:
+    /// @brief  The default number of glyphs of the shared vertex buffer.
+    static constexpr ui32 DefaultGlyphCapacity = 8192;
+
+    /// @brief  Runs are allocated in multiples of this glyph count, so small edits fit in place.
+    static constexpr ui32 RunGranularity = 8;
+
+    /// @brief  The class constructor.
+    /// @param  font            [in] The font, must outlive the renderer.
+    /// @param  glyphCapacity   [in] The number of glyphs of the shared vertex buffer.
+    explicit TextRenderer(FontAtlas *font, ui32 glyphCapacity = DefaultGlyphCapacity);
+
+    /// @brief  The class destructor.
+    ~TextRenderer();
+
+    /// @brief  Will add a new label.
+    /// @param  position    [in] The pen position on the base line in pixels.
+    /// @param  text        [in] The text, line breaks are supported.
+    /// @param  size        [in] The glyph height in pixels.
+    /// @param  color       [in] The text color.
+    /// @return The handle of the label, invalid if no handle is left.
+    TextHandle addText(const glm::vec2 &position, const String &text, f32 size, const glm::vec3 &color = glm::vec3(1.0f));
+
+    /// @brief  Will change the text of a label, an unchanged text will not be written again.
+    /// @return false if the handle is invalid.
+    bool setText(TextHandle handle, const String &text);
+
+    /// @brief  Will move a label.
+    /// @return false if the handle is invalid.
+    bool setPosition(TextHandle handle, const glm::vec2 &position);
+
+    /// @brief  Will change the color of a label.
+    /// @return false if the handle is invalid.
+    bool setColor(TextHandle handle, const glm::vec3 &color);
+
+    /// @brief  Will remove a label.
+    /// @return false if the handle is invalid.
+    bool removeText(TextHandle handle);
+
+    /// @brief  Will write the changed labels into the vertex buffer.
+    void update();
+
+    /// @brief  Will update and draw all labels in the ui pass.
+    /// @param  rbSrv       [in] The render backend service.
+    void render(RenderBackendService *rbSrv);
+
+    /// @brief  Returns the number of labels.
+    size_t getNumTexts() const;
+
+    /// @brief  Returns the number of glyphs written by the last update.
+    ui32 getNumGlyphsWritten() const;
+
+    /// @brief  Returns the shared mesh, nullptr before the first update.
+    Mesh *getMesh() const;
+
+    /// @brief  Returns the name of the render batch.
+    static const c8 *getTextRenderBatchName();
+
+private:
+    struct Label {
+        String mText;
+        glm::vec2 mPosition;
+        glm::vec3 mColor;
+        f32 mSize;
+        ui32 mOffset;
+        ui32 mCapacity;
+        ui32 mNumGlyphs;
+        ui32 mLiveIndex;
+        bool mDirty;
+
+        Label() :
+                mText(), mPosition(0.0f), mColor(1.0f), mSize(0.0f), mOffset(0), mCapacity(0), mNumGlyphs(0), mLiveIndex(0), mDirty(false) {}
+    };
+
+    void markDirty(TextHandle handle, Label &label);
+    void writeLabel(Label &label, bool canCompact);
+    void writeGlyphs(ui32 offset, ui32 numGlyphs);
+    void hideGlyphs(ui32 begin, ui32 end);
+    void compact();
+
+private:
+    FontAtlas *mFont;
+    ui32 mGlyphCapacity;
+    Common::TSlotMap<Label> mLabels;
+    cppcore::TArray<TextHandle> mLive;
+    cppcore::TArray<TextHandle> mDirtyLabels;
+    cppcore::TArray<RenderVert> mScratch;
+    Mesh *mMesh;
+    ui32 mEnd;
+    ui32 mNumGlyphsWritten;
+    bool mMeshDirty;
+    bool mMeshAdded;
+};
+
+inline size_t TextRenderer::getNumTexts() const {
+    return mLabels.size();
+}
+
+inline ui32 TextRenderer::getNumGlyphsWritten() const {
+    return mNumGlyphsWritten;
+}
+
+inline Mesh *TextRenderer::getMesh() const {
+    return mMesh;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
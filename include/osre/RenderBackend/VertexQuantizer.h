@@ -0,0 +1,102 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/RenderBackend/RenderCommon.h>
+#include <osre/Common/TAABB.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  Helper functions to convert full float vertices into compressed vertex formats.
+///
+/// Positions will be mapped into the unit cube by a uniform scale and an offset, so the
+/// dequantization transform does not change the direction of the normals.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT VertexQuantizer {
+public:
+    /// @brief  Converts a float into a half float.
+    /// @param  value   [in] The float value.
+    /// @return The half float bits.
+    static ui16 toHalf(f32 value);
+
+    /// @brief  Converts a half float back into a float.
+    /// @param  value   [in] The half float bits.
+    /// @return The float value.
+    static f32 fromHalf(ui16 value);
+
+    /// @brief  Maps a float in -1..1 to a normalized short.
+    /// @param  value   [in] The value, will be clamped.
+    /// @return The normalized short.
+    static i16 toSnorm16(f32 value);
+
+    /// @brief  Maps a normalized short back to -1..1.
+    /// @param  value   [in] The normalized short.
+    /// @return The float value.
+    static f32 fromSnorm16(i16 value);
+
+    /// @brief  Encodes a unit vector into octahedral coordinates.
+    /// @param  n       [in] The unit vector. A zero vector will be encoded as +z.
+    /// @param  out     [out] The two normalized shorts.
+    static void encodeOctahedral(const glm::vec3 &n, i16 out[2]);
+
+    /// @brief  Decodes octahedral coordinates back into a unit vector.
+    /// @param  in      [in] The two normalized shorts.
+    /// @return The unit vector.
+    static glm::vec3 decodeOctahedral(const i16 in[2]);
+
+    /// @brief  Computes the quantization transform for a bounding box.
+    /// @param  aabb    [in] The bounding box of all positions.
+    /// @param  offset  [out] The center of the box.
+    /// @param  scale   [out] The uniform scale, the largest half extent.
+    static void computeTransform(const Common::AABB &aabb, glm::vec3 &offset, f32 &scale);
+
+    /// @brief  Returns the matrix to get from quantized positions back to object space.
+    /// @param  offset  [in] The offset.
+    /// @param  scale   [in] The uniform scale.
+    /// @return The dequantization matrix.
+    static glm::mat4 getDequantizationMatrix(const glm::vec3 &offset, f32 scale);
+
+    /// @brief  Will quantize an array of render vertices.
+    /// @param  src         [in] The source vertices.
+    /// @param  tangents    [in] Optional tangents, one per vertex, can be nullptr.
+    /// @param  numVertices [in] The number of vertices.
+    /// @param  offset      [in] The quantization offset.
+    /// @param  scale       [in] The quantization scale.
+    /// @param  dst         [out] The quantized vertices.
+    static void quantize(const RenderVert *src, const glm::vec3 *tangents, size_t numVertices,
+            const glm::vec3 &offset, f32 scale, QuantizedRenderVert *dst);
+
+    /// @brief  Returns the dequantized position of a quantized vertex.
+    /// @param  v       [in] The quantized vertex.
+    /// @param  offset  [in] The quantization offset.
+    /// @param  scale   [in] The quantization scale.
+    /// @return The position in object space.
+    static glm::vec3 getPosition(const QuantizedRenderVert &v, const glm::vec3 &offset, f32 scale);
+};
+
+} // Namespace RenderBackend
+} // Namespace OSRE
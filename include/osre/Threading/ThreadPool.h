@@ -0,0 +1,101 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/Common/osre_common.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OSRE {
+namespace Threading {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a simple pool of worker threads for data-parallel work.
+///
+/// Threads waiting for their jobs will help to work on the queue, so nested parallel loops will
+/// not dead-lock.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT ThreadPool {
+public:
+    /// @brief  A job.
+    using Job = std::function<void()>;
+
+    /// @brief  A job working on the index range [begin, end).
+    using RangeJob = std::function<void(size_t begin, size_t end)>;
+
+    /// @brief  The class constructor.
+    /// @param  numWorkers  [in] The number of worker threads, 0 to use one thread less than cores.
+    explicit ThreadPool(size_t numWorkers = 0);
+
+    /// @brief  The class destructor, will join all workers.
+    ~ThreadPool();
+
+    /// @brief  Returns the number of worker threads.
+    /// @return The number of worker threads.
+    size_t getNumWorkers() const;
+
+    /// @brief  Will enqueue a new job.
+    /// @param  job         [in] The job to run.
+    void enqueue(const Job &job);
+
+    /// @brief  Will split the range [0, count) into batches and runs them in parallel. The calling
+    ///         thread will work on batches as well and returns when all batches are done.
+    /// @param  count       [in] The number of items.
+    /// @param  minBatchSize[in] The minimal number of items per batch.
+    /// @param  job         [in] The job to run per batch.
+    void parallelFor(size_t count, size_t minBatchSize, const RangeJob &job);
+
+    /// @brief  Will run one pending job in the calling thread.
+    /// @return true, if a job was run, false if the queue was empty.
+    bool runPendingJob();
+
+    /// @brief  Returns the shared pool instance, will be created on the first call.
+    /// @return The shared pool.
+    static ThreadPool &getDefault();
+
+    OSRE_NON_COPYABLE(ThreadPool)
+
+private:
+    void workerLoop();
+
+private:
+    std::vector<std::thread> mWorkers;
+    std::deque<Job> mJobs;
+    std::mutex mLock;
+    std::condition_variable mJobAvailable;
+    bool mRunning;
+};
+
+inline size_t ThreadPool::getNumWorkers() const {
+    return mWorkers.size();
+}
+
+} // Namespace Threading
+} // Namespace OSRE
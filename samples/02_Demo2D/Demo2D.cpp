@@ -22,8 +22,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include <osre/App/AppBase.h>
 #include <osre/App/AssetRegistry.h>
+#include <osre/App/ServiceProvider.h>
 #include <osre/Properties/Settings.h>
 #include <osre/Common/Logger.h>
+#include <osre/RenderBackend/CanvasRenderer.h>
+#include <osre/RenderBackend/RenderBackendService.h>
 #include <osre/RenderBackend/RenderCommon.h>
 #include <osre/RenderBackend/TransformMatrixBlock.h>
 
@@ -37,15 +40,19 @@ static const c8 Tag[] = "ModelLoadingApp";
 // The example application, will create the render environment and render a simple triangle onto it
 class Demo2DApp : public App::AppBase {
     TransformMatrixBlock mTransformMatrix;
+    CanvasRenderer *mCanvas;
 
 public:
     Demo2DApp(int argc, char *argv[]) :
             AppBase(argc, (const char **)argv),
-            mTransformMatrix() {
+            mTransformMatrix(),
+            mCanvas(nullptr) {
         // empty
     }
 
-    ~Demo2DApp() override = default;
+    ~Demo2DApp() override {
+        delete mCanvas;
+    }
 
     void quitCallback(ui32, void *) {
         AppBase::requestShutdown();
@@ -63,8 +70,34 @@ protected:
             return false;
         }
 
+        mCanvas = new CanvasRenderer(ServiceProvider::getService<RenderBackendService>(ServiceType::RenderService));
+
         return true;
     }
+
+    void onUpdate() override {
+        // A grid of tiles with a framed panel on top, all rects end up in one draw call per layer
+        static constexpr i32 TileSize = 16;
+        for (i32 y = 0; y < 32; ++y) {
+            for (i32 x = 0; x < 48; ++x) {
+                mCanvas->setColor(glm::vec3(x / 48.0f, y / 32.0f, 0.5f));
+                mCanvas->drawRect(x * TileSize, y * TileSize, TileSize - 1, TileSize - 1);
+            }
+        }
+
+        mCanvas->setLayer(1);
+        mCanvas->setColor(glm::vec3(0.1f));
+        mCanvas->drawRect(100, 100, 300, 200);
+        mCanvas->setColor(glm::vec3(1.0f));
+        mCanvas->drawRect(100, 100, 300, 200, false);
+        mCanvas->setClipRect(100, 100, 300, 200);
+        mCanvas->drawLine(50, 50, 450, 350, 2.0f);
+        mCanvas->resetClipRect();
+        mCanvas->setLayer(0);
+        mCanvas->render();
+
+        AppBase::onUpdate();
+    }
 };
 
 OSRE_MAIN(Demo2DApp)
@@ -5,6 +5,7 @@
 #include "Actions/ImportAction.h"
 
 #include <osre/RenderBackend/MeshBuilder.h>
+#include <osre/RenderBackend/DbgRenderer.h>
 #include <osre/App/Stage.h>
 #include <osre/App/TransformController.h>
 #include <osre/App/ServiceProvider.h>
@@ -34,7 +35,7 @@ static Project *createProject(const String &name) {
 }
 
 OsreEdApp::OsreEdApp(int argc, char *argv[]) :
-        AppBase(argc, (const char **)argv, "api", "The render API"), mProject(nullptr) {
+        AppBase(argc, (const char **)argv, "api", "The render API"), mProject(nullptr), mShowRenderStats(false), mStatsKeyDown(false) {
 
 }
 
@@ -154,9 +155,21 @@ bool OsreEdApp::onCreate() {
 }
 
 void OsreEdApp::onUpdate() {
-    Platform::Key key = AppBase::getKeyboardEventListener()->getLastKey();
+    KeyboardEventListener *keyboardListener = AppBase::getKeyboardEventListener();
+    Platform::Key key = keyboardListener->getLastKey();
     mKeyboardTransCtrl->update(TransformController::getKeyBinding(key));
 
+    // F2 toggles the render statistics overlay
+    const bool statsKeyDown = keyboardListener->isKeyPressed(Platform::KEY_F2);
+    if (statsKeyDown && !mStatsKeyDown) {
+        mShowRenderStats = !mShowRenderStats;
+    }
+    mStatsKeyDown = statsKeyDown;
+    DbgRenderer *dbgRenderer = DbgRenderer::getInstance();
+    if (mShowRenderStats && nullptr != dbgRenderer) {
+        dbgRenderer->renderStats(10, 10);
+    }
+
     RenderBackendService *rbSrv = ServiceProvider::getService<RenderBackendService>(ServiceType::RenderService);
     rbSrv->beginPass(RenderPass::getPassNameById(RenderPassId));
     {
@@ -29,6 +29,8 @@ private:
     App::Entity *mEntity;
     Animation::AnimationControllerBase *mKeyboardTransCtrl;
     SceneData mSceneData;
+    bool mShowRenderStats;
+    bool mStatsKeyDown;
 };
 
 } // namespace Editor
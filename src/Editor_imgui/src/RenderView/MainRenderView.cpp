@@ -203,7 +203,7 @@ void MainRenderView::createBonesFromSkeleton(Skeleton *skeleton) {
         return;
     }
     for (ui32 i = 0; i < skeleton->mBones.size(); ++i) {
-        Bone *currentBone = skeleton->mBones[i];
+        Bone *currentBone = &skeleton->mBones[i];
         drawJoint(currentBone);
         drawBone(currentBone);
     }
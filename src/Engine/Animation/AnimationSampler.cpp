@@ -0,0 +1,261 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Animation/AnimationSampler.h>
+#include <osre/Animation/CompressedClip.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include <glm/gtx/matrix_decompose.hpp>
+
+namespace OSRE {
+namespace Animation {
+
+// Assimp uses 25 ticks per second, when the file does not define it
+static constexpr d32 DefaultTicksPerSecond = 25.0;
+
+static d32 getTicksPerSecond(const AnimationTrack &track) {
+    return track.mTicksPerSecond > 0.0 ? track.mTicksPerSecond : DefaultTicksPerSecond;
+}
+
+static glm::quat toQuat(const glm::vec4 &v) {
+    return glm::quat(v.w, v.x, v.y, v.z);
+}
+
+// Starts the search at the cached key, so forward playback needs one step in general
+template<class TKey>
+static ui32 findKey(const cppcore::TArray<TKey> &keys, ui32 &cached, d32 time) {
+    ui32 i = cached;
+    if (i >= keys.size()) {
+        i = 0;
+    }
+    while (i + 1 < keys.size() && keys[i + 1].mTime <= time) {
+        ++i;
+    }
+    cached = i;
+
+    return i;
+}
+
+template<class TKey>
+static f32 getFactor(const cppcore::TArray<TKey> &keys, ui32 i, d32 time) {
+    if (i + 1 >= keys.size()) {
+        return 0.0f;
+    }
+
+    const d32 delta = keys[i + 1].mTime - keys[i].mTime;
+    if (delta <= 0.0) {
+        return 0.0f;
+    }
+
+    const d32 factor = (time - keys[i].mTime) / delta;
+    return static_cast<f32>(glm::clamp(factor, 0.0, 1.0));
+}
+
+static glm::vec3 sampleVector(const VectorKeyArray &keys, ui32 &cached, d32 time) {
+    const ui32 i = findKey(keys, cached, time);
+    const f32 factor = getFactor(keys, i, time);
+    if (0.0f == factor) {
+        return keys[i].mVector;
+    }
+
+    return glm::mix(keys[i].mVector, keys[i + 1].mVector, factor);
+}
+
+static glm::quat sampleRotation(const RotationKeyArray &keys, ui32 &cached, d32 time) {
+    const ui32 i = findKey(keys, cached, time);
+    const f32 factor = getFactor(keys, i, time);
+    if (0.0f == factor) {
+        return toQuat(keys[i].mQuad);
+    }
+
+    return glm::slerp(toQuat(keys[i].mQuad), toQuat(keys[i + 1].mQuad), factor);
+}
+
+glm::mat4 BoneTransform::toMatrix() const {
+    glm::mat4 m = glm::mat4_cast(mRotation);
+    m[0] *= mScale.x;
+    m[1] *= mScale.y;
+    m[2] *= mScale.z;
+    m[3] = glm::vec4(mTranslation, 1.0f);
+
+    return m;
+}
+
+AnimationSampler::AnimationSampler() :
+        mTrack(nullptr),
+        mClip(nullptr),
+        mChannelToBone(),
+        mKeyCache(),
+        mBindPose(),
+        mLastTime(0.0) {
+    // empty
+}
+
+void AnimationSampler::bind(const AnimationTrack *track, const Skeleton &skeleton) {
+    mTrack = track;
+    mClip = nullptr;
+    getBindPose(skeleton, mBindPose);
+    mChannelToBone.clear();
+    mKeyCache.clear();
+    if (nullptr == track) {
+        return;
+    }
+
+    const size_t numChannels = track->mNodeAnimations.size();
+    mChannelToBone.resize(numChannels);
+    mKeyCache.resize(numChannels);
+    for (size_t i = 0; i < numChannels; ++i) {
+        mChannelToBone[i] = skeleton.findBone(track->mNodeAnimations[i].mName);
+    }
+    reset();
+}
+
+void AnimationSampler::bind(const CompressedClip *clip, const Skeleton &skeleton) {
+    mTrack = nullptr;
+    mClip = clip;
+    getBindPose(skeleton, mBindPose);
+    mChannelToBone.clear();
+    mKeyCache.clear();
+    if (nullptr == clip) {
+        return;
+    }
+
+    const size_t numChannels = clip->getNumChannels();
+    mChannelToBone.resize(numChannels);
+    for (size_t i = 0; i < numChannels; ++i) {
+        mChannelToBone[i] = skeleton.findBone(clip->getChannelName(i));
+    }
+    reset();
+}
+
+void AnimationSampler::sample(d32 timeInSeconds, bool loop, Pose &pose) {
+    const size_t numBones = mBindPose.size();
+    pose.resize(numBones);
+    for (size_t i = 0; i < numBones; ++i) {
+        pose[i] = mBindPose[i];
+    }
+
+    if (nullptr != mClip) {
+        mClip->sample(timeInSeconds, loop, mChannelToBone, pose);
+        return;
+    }
+
+    if (nullptr == mTrack) {
+        return;
+    }
+
+    d32 time = timeInSeconds * getTicksPerSecond(*mTrack);
+    const d32 duration = mTrack->mDuration;
+    if (duration > 0.0) {
+        if (loop) {
+            time = std::fmod(time, duration);
+            if (time < 0.0) {
+                time += duration;
+            }
+        } else {
+            time = glm::clamp(time, 0.0, duration);
+        }
+    }
+
+    if (time < mLastTime) {
+        reset();
+    }
+    mLastTime = time;
+
+    for (size_t i = 0; i < mChannelToBone.size(); ++i) {
+        const i32 bone = mChannelToBone[i];
+        if (bone < 0) {
+            continue;
+        }
+
+        const NodeAnimation &channel = mTrack->mNodeAnimations[i];
+        KeyCache &cache = mKeyCache[i];
+        BoneTransform &transform = pose[bone];
+        if (!channel.mPositions.isEmpty()) {
+            transform.mTranslation = sampleVector(channel.mPositions, cache.mPosition, time);
+        }
+        if (!channel.mRotations.isEmpty()) {
+            transform.mRotation = sampleRotation(channel.mRotations, cache.mRotation, time);
+        }
+        if (!channel.mScalings.isEmpty()) {
+            transform.mScale = sampleVector(channel.mScalings, cache.mScaling, time);
+        }
+    }
+}
+
+void AnimationSampler::reset() {
+    for (size_t i = 0; i < mKeyCache.size(); ++i) {
+        mKeyCache[i].mPosition = 0;
+        mKeyCache[i].mRotation = 0;
+        mKeyCache[i].mScaling = 0;
+    }
+    mLastTime = 0.0;
+}
+
+d32 AnimationSampler::getDurationInSeconds() const {
+    if (nullptr != mClip) {
+        return mClip->getDurationInSeconds();
+    }
+
+    if (nullptr == mTrack) {
+        return 0.0;
+    }
+
+    return mTrack->mDuration / getTicksPerSecond(*mTrack);
+}
+
+void AnimationSampler::getBindPose(const Skeleton &skeleton, Pose &pose) {
+    pose.resize(skeleton.mBones.size());
+    for (size_t i = 0; i < skeleton.mBones.size(); ++i) {
+        BoneTransform &transform = pose[i];
+        glm::vec3 skew;
+        glm::vec4 perspective;
+        glm::mat4 m = skeleton.mBones[i].mLocalTransform;
+        if (!glm::decompose(m, transform.mScale, transform.mRotation, transform.mTranslation, skew, perspective)) {
+            transform = BoneTransform();
+        }
+    }
+}
+
+void AnimationSampler::blend(const Pose &a, const Pose &b, f32 weight, Pose &out) {
+    osre_assert(a.size() == b.size());
+
+    const size_t numBones = a.size();
+    out.resize(numBones);
+    for (size_t i = 0; i < numBones; ++i) {
+        const BoneTransform &ta = a[i];
+        const BoneTransform &tb = b[i];
+        glm::quat rotation = tb.mRotation;
+        if (glm::dot(ta.mRotation, rotation) < 0.0f) {
+            rotation = -rotation;
+        }
+
+        BoneTransform result;
+        result.mTranslation = glm::mix(ta.mTranslation, tb.mTranslation, weight);
+        result.mScale = glm::mix(ta.mScale, tb.mScale, weight);
+        result.mRotation = glm::normalize(ta.mRotation * (1.0f - weight) + rotation * weight);
+        out[i] = result;
+    }
+}
+
+} // Namespace Animation
+} // Namespace OSRE
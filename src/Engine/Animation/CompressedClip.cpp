@@ -0,0 +1,433 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Animation/CompressedClip.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include <cmath>
+
+namespace OSRE {
+namespace Animation {
+
+static constexpr c8 Tag[] = "CompressedClip";
+
+// The smallest three components of a unit quaternion are inside of +-1/sqrt(2)
+static constexpr f32 SmallestThreeRange = 0.70710678f;
+static constexpr ui32 SmallestThreeMax = 0x7fff;
+static constexpr f32 QuantizeMax = 65535.0f;
+
+// The largest key step first, so the first one inside of the tolerance wins
+static constexpr ui32 Strides[] = { 16, 8, 4, 2, 1 };
+
+static void encodeQuat(const glm::quat &q, ui16 *out) {
+    f32 c[4] = { q.x, q.y, q.z, q.w };
+    ui32 largest = 0;
+    for (ui32 i = 1; i < 4; ++i) {
+        if (std::fabs(c[i]) > std::fabs(c[largest])) {
+            largest = i;
+        }
+    }
+
+    // q and -q are the same rotation, so the dropped component is always positive
+    const f32 sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+    ui64 bits = static_cast<ui64>(largest) << 45;
+    ui32 shift = 30;
+    for (ui32 i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        const f32 v = glm::clamp(c[i] * sign / SmallestThreeRange, -1.0f, 1.0f);
+        const ui64 quantized = static_cast<ui64>((v * 0.5f + 0.5f) * SmallestThreeMax + 0.5f);
+        bits |= quantized << shift;
+        shift -= 15;
+    }
+
+    out[0] = static_cast<ui16>(bits & 0xffff);
+    out[1] = static_cast<ui16>((bits >> 16) & 0xffff);
+    out[2] = static_cast<ui16>((bits >> 32) & 0xffff);
+}
+
+static glm::quat decodeQuat(const ui16 *in) {
+    const ui64 bits = static_cast<ui64>(in[0]) | (static_cast<ui64>(in[1]) << 16) | (static_cast<ui64>(in[2]) << 32);
+    const ui32 largest = static_cast<ui32>(bits >> 45) & 0x3;
+
+    f32 c[4];
+    f32 sum = 0.0f;
+    ui32 shift = 30;
+    for (ui32 i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        const ui32 quantized = static_cast<ui32>(bits >> shift) & SmallestThreeMax;
+        c[i] = (static_cast<f32>(quantized) / SmallestThreeMax * 2.0f - 1.0f) * SmallestThreeRange;
+        sum += c[i] * c[i];
+        shift -= 15;
+    }
+    c[largest] = std::sqrt(glm::max(0.0f, 1.0f - sum));
+
+    return glm::quat(c[3], c[0], c[1], c[2]);
+}
+
+static void encodeVector(const glm::vec3 &v, const glm::vec3 &min, const glm::vec3 &extent, ui16 *out) {
+    for (glm::length_t i = 0; i < 3; ++i) {
+        const f32 t = extent[i] > 0.0f ? (v[i] - min[i]) / extent[i] : 0.0f;
+        out[i] = static_cast<ui16>(glm::clamp(t, 0.0f, 1.0f) * QuantizeMax + 0.5f);
+    }
+}
+
+static glm::vec3 decodeVector(const ui16 *in, const glm::vec3 &min, const glm::vec3 &extent) {
+    return min + glm::vec3(in[0], in[1], in[2]) * (extent / QuantizeMax);
+}
+
+static glm::quat nlerp(const glm::quat &a, glm::quat b, f32 factor) {
+    if (glm::dot(a, b) < 0.0f) {
+        b = -b;
+    }
+
+    return glm::normalize(a * (1.0f - factor) + b * factor);
+}
+
+static f32 getError(const glm::vec4 &a, const glm::vec4 &b) {
+    const glm::vec4 d = glm::abs(a - b);
+    return glm::max(glm::max(d.x, d.y), glm::max(d.z, d.w));
+}
+
+static glm::vec4 toVec4(const glm::quat &q) {
+    return glm::vec4(q.x, q.y, q.z, q.w);
+}
+
+static glm::vec4 getFrameValue(const BoneTransform &transform, ui32 type) {
+    switch (type) {
+        case CompressedClip::PositionCurve:
+            return glm::vec4(transform.mTranslation, 0.0f);
+        case CompressedClip::RotationCurve:
+            return toVec4(transform.mRotation);
+        default:
+            break;
+    }
+
+    return glm::vec4(transform.mScale, 0.0f);
+}
+
+// Returns the largest error, when the frames are reconstructed from every stride-th frame
+static f32 getReductionError(const cppcore::TArray<glm::vec4> &frames, ui32 type, ui32 stride) {
+    f32 error = 0.0f;
+    for (size_t key = 0; key + stride < frames.size(); key += stride) {
+        const glm::vec4 &a = frames[key];
+        const glm::vec4 &b = frames[key + stride];
+        for (ui32 i = 1; i < stride; ++i) {
+            const f32 factor = static_cast<f32>(i) / static_cast<f32>(stride);
+            glm::vec4 value;
+            if (CompressedClip::RotationCurve == type) {
+                const glm::quat q = nlerp(glm::quat(a.w, a.x, a.y, a.z), glm::quat(b.w, b.x, b.y, b.z), factor);
+                value = toVec4(q);
+            } else {
+                value = glm::mix(a, b, factor);
+            }
+            error = glm::max(error, getError(value, frames[key + i]));
+        }
+    }
+
+    return error;
+}
+
+CompressedClip::CompressedClip() :
+        mName(),
+        mSampleRate(0.0f),
+        mNumFrames(0),
+        mNumBlocks(0),
+        mBlockSize(0),
+        mChannels(),
+        mCurves(),
+        mData() {
+    // empty
+}
+
+bool CompressedClip::compress(const AnimationTrack &track, const CompressionSettings &settings, CompressedClip &clip) {
+    if (settings.mSampleRate <= 0.0f) {
+        osre_error(Tag, "Invalid sample rate.");
+        return false;
+    }
+
+    clip = CompressedClip();
+    clip.mName = track.mName;
+    clip.mSampleRate = settings.mSampleRate;
+
+    // Resample the track with one bone per channel, so the source keys are read in one pass
+    const size_t numChannels = track.mNodeAnimations.size();
+    Skeleton skeleton;
+    skeleton.mBones.resize(numChannels);
+    for (size_t i = 0; i < numChannels; ++i) {
+        skeleton.mBones[i].mName = track.mNodeAnimations[i].mName;
+        skeleton.mBones[i].mLocalTransform = glm::mat4(1.0f);
+    }
+
+    AnimationSampler sampler;
+    sampler.bind(&track, skeleton);
+    const d32 duration = sampler.getDurationInSeconds();
+    clip.mNumFrames = static_cast<ui32>(duration * settings.mSampleRate + 0.5) + 1;
+    clip.mNumBlocks = (clip.mNumFrames + BlockFrames - 2) / BlockFrames;
+    if (0 == clip.mNumBlocks) {
+        clip.mNumBlocks = 1;
+    }
+
+    // The last block is padded with the last frame
+    const ui32 numPaddedFrames = clip.mNumBlocks * BlockFrames + 1;
+    cppcore::TArray<Pose> poses;
+    poses.resize(numPaddedFrames);
+    for (ui32 frame = 0; frame < numPaddedFrames; ++frame) {
+        const ui32 clamped = glm::min(frame, clip.mNumFrames - 1);
+        sampler.sample(static_cast<d32>(clamped) / settings.mSampleRate, false, poses[frame]);
+    }
+
+    const f32 tolerances[NumCurveTypes] = { settings.mPositionTolerance, settings.mRotationTolerance, settings.mScaleTolerance };
+    cppcore::TArray<glm::vec4> frames;
+    frames.resize(numPaddedFrames);
+    clip.mChannels.resize(numChannels);
+    for (size_t channelIndex = 0; channelIndex < numChannels; ++channelIndex) {
+        const NodeAnimation &nodeAnim = track.mNodeAnimations[channelIndex];
+        Channel &channel = clip.mChannels[channelIndex];
+        channel.mName = nodeAnim.mName;
+        channel.mHasCurve[PositionCurve] = !nodeAnim.mPositions.isEmpty();
+        channel.mHasCurve[RotationCurve] = !nodeAnim.mRotations.isEmpty();
+        channel.mHasCurve[ScalingCurve] = !nodeAnim.mScalings.isEmpty();
+        for (ui32 type = 0; type < NumCurveTypes; ++type) {
+            channel.mCurve[type] = -1;
+            channel.mConstant[type] = glm::vec4(0.0f);
+            if (!channel.mHasCurve[type]) {
+                continue;
+            }
+
+            // Keep the rotations in one hemisphere, so neighbouring keys can be interpolated
+            bool constant = true;
+            for (ui32 frame = 0; frame < numPaddedFrames; ++frame) {
+                frames[frame] = getFrameValue(poses[frame][channelIndex], type);
+                if (RotationCurve == type && frame > 0 && glm::dot(frames[frame], frames[frame - 1]) < 0.0f) {
+                    frames[frame] = -frames[frame];
+                }
+                if (getError(frames[frame], frames[0]) > tolerances[type]) {
+                    constant = false;
+                }
+            }
+
+            if (constant) {
+                channel.mConstant[type] = frames[0];
+                continue;
+            }
+
+            Curve curve;
+            curve.mChannel = static_cast<i32>(channelIndex);
+            curve.mType = static_cast<CurveType>(type);
+            curve.mStride = 1;
+            curve.mOffset = clip.mBlockSize;
+            curve.mMin = glm::vec3(frames[0]);
+            glm::vec3 max = curve.mMin;
+            for (ui32 frame = 1; frame < numPaddedFrames; ++frame) {
+                curve.mMin = glm::min(curve.mMin, glm::vec3(frames[frame]));
+                max = glm::max(max, glm::vec3(frames[frame]));
+            }
+            curve.mExtent = max - curve.mMin;
+            for (ui32 stride : Strides) {
+                if (getReductionError(frames, type, stride) <= tolerances[type]) {
+                    curve.mStride = stride;
+                    break;
+                }
+            }
+
+            channel.mCurve[type] = static_cast<i32>(clip.mCurves.size());
+            clip.mBlockSize += (BlockFrames / curve.mStride + 1) * KeySize;
+            clip.mCurves.add(curve);
+        }
+    }
+
+    // Write the keys block by block, the first key of the next block is repeated at the end
+    clip.mData.resize(clip.mNumBlocks * clip.mBlockSize);
+    for (size_t curveIndex = 0; curveIndex < clip.mCurves.size(); ++curveIndex) {
+        const Curve &curve = clip.mCurves[curveIndex];
+        const ui32 keysPerBlock = BlockFrames / curve.mStride + 1;
+        for (ui32 block = 0; block < clip.mNumBlocks; ++block) {
+            ui16 *keys = &clip.mData[block * clip.mBlockSize + curve.mOffset];
+            for (ui32 key = 0; key < keysPerBlock; ++key) {
+                const BoneTransform &transform = poses[block * BlockFrames + key * curve.mStride][curve.mChannel];
+                ui16 *out = keys + key * KeySize;
+                switch (curve.mType) {
+                    case PositionCurve:
+                        encodeVector(transform.mTranslation, curve.mMin, curve.mExtent, out);
+                        break;
+                    case RotationCurve:
+                        encodeQuat(transform.mRotation, out);
+                        break;
+                    default:
+                        encodeVector(transform.mScale, curve.mMin, curve.mExtent, out);
+                        break;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+void CompressedClip::sample(d32 timeInSeconds, bool loop, const cppcore::TArray<i32> &channelToBone, Pose &pose) const {
+    if (0 == mNumFrames) {
+        return;
+    }
+
+    const d32 duration = getDurationInSeconds();
+    d32 time = timeInSeconds;
+    if (loop && duration > 0.0) {
+        time = std::fmod(time, duration);
+        if (time < 0.0) {
+            time += duration;
+        }
+    }
+
+    const f32 frame = static_cast<f32>(glm::clamp(time * mSampleRate, 0.0, static_cast<d32>(mNumFrames - 1)));
+    const ui32 block = glm::min(static_cast<ui32>(frame) / BlockFrames, mNumBlocks - 1);
+    const f32 localFrame = frame - static_cast<f32>(block * BlockFrames);
+    const size_t numChannels = glm::min(mChannels.size(), channelToBone.size());
+    for (size_t i = 0; i < numChannels; ++i) {
+        const i32 bone = channelToBone[i];
+        if (bone < 0 || static_cast<size_t>(bone) >= pose.size()) {
+            continue;
+        }
+        sampleChannel(mChannels[i], block, localFrame, pose[bone]);
+    }
+}
+
+void CompressedClip::sampleChannel(const Channel &channel, ui32 block, f32 localFrame, BoneTransform &transform) const {
+    for (ui32 type = 0; type < NumCurveTypes; ++type) {
+        if (!channel.mHasCurve[type]) {
+            continue;
+        }
+
+        const glm::vec4 &c = channel.mConstant[type];
+        if (channel.mCurve[type] < 0) {
+            switch (type) {
+                case PositionCurve:
+                    transform.mTranslation = glm::vec3(c);
+                    break;
+                case RotationCurve:
+                    transform.mRotation = glm::quat(c.w, c.x, c.y, c.z);
+                    break;
+                default:
+                    transform.mScale = glm::vec3(c);
+                    break;
+            }
+            continue;
+        }
+
+        const Curve &curve = mCurves[channel.mCurve[type]];
+        const f32 stride = static_cast<f32>(curve.mStride);
+        const ui32 key = glm::min(static_cast<ui32>(localFrame / stride), BlockFrames / curve.mStride - 1);
+        const f32 factor = (localFrame - static_cast<f32>(key) * stride) / stride;
+        const ui16 *keys = &mData[block * mBlockSize + curve.mOffset + key * KeySize];
+        switch (type) {
+            case PositionCurve:
+                transform.mTranslation = glm::mix(decodeVector(keys, curve.mMin, curve.mExtent),
+                        decodeVector(keys + KeySize, curve.mMin, curve.mExtent), factor);
+                break;
+            case RotationCurve:
+                transform.mRotation = nlerp(decodeQuat(keys), decodeQuat(keys + KeySize), factor);
+                break;
+            default:
+                transform.mScale = glm::mix(decodeVector(keys, curve.mMin, curve.mExtent),
+                        decodeVector(keys + KeySize, curve.mMin, curve.mExtent), factor);
+                break;
+        }
+    }
+}
+
+void CompressedClip::decompress(AnimationTrack &track) const {
+    const size_t numChannels = mChannels.size();
+    track.mName = mName;
+    track.mDuration = getDurationInSeconds();
+    track.mTicksPerSecond = 1.0;
+    track.mNodeAnimations.clear();
+    track.mNodeAnimations.resize(numChannels);
+
+    cppcore::TArray<i32> channelToBone;
+    channelToBone.resize(numChannels);
+    for (size_t i = 0; i < numChannels; ++i) {
+        channelToBone[i] = static_cast<i32>(i);
+        track.mNodeAnimations[i] = NodeAnimation();
+        track.mNodeAnimations[i].mName = mChannels[i].mName;
+    }
+
+    Pose pose;
+    pose.resize(numChannels);
+    for (ui32 frame = 0; frame < mNumFrames; ++frame) {
+        const d32 time = static_cast<d32>(frame) / mSampleRate;
+        sample(time, false, channelToBone, pose);
+        for (size_t i = 0; i < numChannels; ++i) {
+            const Channel &channel = mChannels[i];
+            NodeAnimation &nodeAnim = track.mNodeAnimations[i];
+            const BoneTransform &transform = pose[i];
+            if (channel.mHasCurve[PositionCurve]) {
+                VectorKey key;
+                key.mVector = transform.mTranslation;
+                key.mTime = time;
+                nodeAnim.mPositions.add(key);
+            }
+            if (channel.mHasCurve[RotationCurve]) {
+                RotationKey key;
+                key.mQuad = toVec4(transform.mRotation);
+                key.mTime = time;
+                nodeAnim.mRotations.add(key);
+            }
+            if (channel.mHasCurve[ScalingCurve]) {
+                VectorKey key;
+                key.mVector = transform.mScale;
+                key.mTime = time;
+                nodeAnim.mScalings.add(key);
+            }
+        }
+    }
+}
+
+d32 CompressedClip::getDurationInSeconds() const {
+    if (mNumFrames < 2) {
+        return 0.0;
+    }
+
+    return static_cast<d32>(mNumFrames - 1) / mSampleRate;
+}
+
+size_t CompressedClip::getMemorySize() const {
+    return mData.size() * sizeof(ui16) + mCurves.size() * sizeof(Curve) + mChannels.size() * sizeof(Channel);
+}
+
+size_t CompressedClip::getMemorySize(const AnimationTrack &track) {
+    size_t size = 0;
+    for (size_t i = 0; i < track.mNodeAnimations.size(); ++i) {
+        const NodeAnimation &nodeAnim = track.mNodeAnimations[i];
+        size += sizeof(NodeAnimation);
+        size += nodeAnim.mPositions.size() * sizeof(VectorKey);
+        size += nodeAnim.mRotations.size() * sizeof(RotationKey);
+        size += nodeAnim.mScalings.size() * sizeof(VectorKey);
+    }
+
+    return size;
+}
+
+} // Namespace Animation
+} // Namespace OSRE
@@ -0,0 +1,169 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Animation/SkeletalAnimator.h>
+#include <osre/Animation/CompressedClip.h>
+#include <osre/RenderBackend/Mesh.h>
+#include <osre/RenderBackend/RenderBackendService.h>
+#include <osre/Common/Logger.h>
+
+namespace OSRE {
+namespace Animation {
+
+using namespace ::OSRE::RenderBackend;
+
+static constexpr c8 Tag[] = "SkeletalAnimator";
+
+static constexpr c8 PaletteName[] = "BonePalette";
+
+SkeletalAnimator::SkeletalAnimator(const Skin *skin, Mesh *mesh) :
+        mSkin(skin),
+        mMesh(mesh),
+        mMode(SkinningMode::Cpu),
+        mLayers(),
+        mActive(0),
+        mFadeTime(0.0f),
+        mFadeDuration(0.0f),
+        mPose(),
+        mFadePose(),
+        mPalette(),
+        mBindVertices(),
+        mVerticesDirty(false) {
+    osre_assert(nullptr != skin);
+    for (Layer &layer : mLayers) {
+        layer.mSampler.bind(static_cast<const AnimationTrack *>(nullptr), mSkin->mSkeleton);
+        layer.mTime = 0.0;
+        layer.mLoop = true;
+    }
+
+    // Keep the bind pose vertices, the vertex buffer will be overwritten by the skinning
+    if (nullptr != mMesh && nullptr != mMesh->getVertexBuffer() && VertexType::RenderVertex == mMesh->getVertexType()) {
+        const size_t numVertices = mMesh->getVertexBuffer()->getSize() / sizeof(RenderVert);
+        if (numVertices == mSkin->mVertices.size()) {
+            mBindVertices.resize(numVertices);
+            ::memcpy(&mBindVertices[0], mMesh->getVertexBuffer()->getData(), numVertices * sizeof(RenderVert));
+        }
+    }
+    if (mBindVertices.isEmpty()) {
+        osre_debug(Tag, "No render vertices for CPU skinning, only GPU skinning is supported.");
+        mMode = SkinningMode::Gpu;
+    }
+}
+
+void SkeletalAnimator::setSkinningMode(SkinningMode mode) {
+    if (SkinningMode::Cpu == mode && mBindVertices.isEmpty()) {
+        osre_debug(Tag, "CPU skinning not supported for this mesh.");
+        return;
+    }
+    mMode = mode;
+}
+
+void SkeletalAnimator::play(const AnimationTrack *track, bool loop) {
+    Layer &layer = mLayers[mActive];
+    layer.mSampler.bind(track, mSkin->mSkeleton);
+    layer.mTime = 0.0;
+    layer.mLoop = loop;
+    mFadeDuration = 0.0f;
+}
+
+void SkeletalAnimator::play(const CompressedClip *clip, bool loop) {
+    Layer &layer = mLayers[mActive];
+    layer.mSampler.bind(clip, mSkin->mSkeleton);
+    layer.mTime = 0.0;
+    layer.mLoop = loop;
+    mFadeDuration = 0.0f;
+}
+
+void SkeletalAnimator::crossFade(const AnimationTrack *track, f32 duration, bool loop) {
+    if (!beginFade(duration)) {
+        play(track, loop);
+        return;
+    }
+
+    play(track, loop);
+    mFadeDuration = duration;
+}
+
+void SkeletalAnimator::crossFade(const CompressedClip *clip, f32 duration, bool loop) {
+    if (!beginFade(duration)) {
+        play(clip, loop);
+        return;
+    }
+
+    play(clip, loop);
+    mFadeDuration = duration;
+}
+
+bool SkeletalAnimator::beginFade(f32 duration) {
+    const AnimationSampler &sampler = mLayers[mActive].mSampler;
+    if (duration <= 0.0f || (nullptr == sampler.getTrack() && nullptr == sampler.getClip())) {
+        return false;
+    }
+
+    mActive = 1 - mActive;
+    mFadeTime = 0.0f;
+
+    return true;
+}
+
+void SkeletalAnimator::update(Time dt) {
+    const f32 seconds = dt.asSeconds();
+    for (Layer &layer : mLayers) {
+        layer.mTime += seconds;
+    }
+
+    Layer &active = mLayers[mActive];
+    active.mSampler.sample(active.mTime, active.mLoop, mPose);
+    if (mFadeDuration > 0.0f) {
+        mFadeTime += seconds;
+        if (mFadeTime >= mFadeDuration) {
+            mFadeDuration = 0.0f;
+        } else {
+            Layer &previous = mLayers[1 - mActive];
+            previous.mSampler.sample(previous.mTime, previous.mLoop, mFadePose);
+            AnimationSampler::blend(mFadePose, mPose, mFadeTime / mFadeDuration, mPose);
+        }
+    }
+
+    Skinning::computePalette(mSkin->mSkeleton, mPose, mPalette);
+    if (SkinningMode::Cpu == mMode) {
+        RenderVert *vertices = reinterpret_cast<RenderVert*>(mMesh->getVertexBuffer()->getData());
+        Skinning::skin(*mSkin, mPalette, &mBindVertices[0], vertices, mBindVertices.size());
+        mVerticesDirty = true;
+    }
+}
+
+void SkeletalAnimator::submit(RenderBackendService *rbSrv) {
+    if (nullptr == rbSrv || mPalette.isEmpty()) {
+        return;
+    }
+
+    if (SkinningMode::Gpu == mMode) {
+        rbSrv->setMatrixArray(PaletteName, static_cast<ui32>(mPalette.size()), &mPalette[0]);
+    } else if (mVerticesDirty) {
+        rbSrv->updateMesh(mMesh);
+        mVerticesDirty = false;
+    }
+}
+
+} // Namespace Animation
+} // Namespace OSRE
@@ -0,0 +1,132 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Animation/Skinning.h>
+#include <osre/RenderBackend/RenderCommon.h>
+#include <osre/Threading/ThreadPool.h>
+#include <osre/Debugging/osre_debugging.h>
+
+namespace OSRE {
+namespace Animation {
+
+using namespace ::OSRE::RenderBackend;
+
+static inline void storeVec3(__m128 v, glm::vec3 &out) {
+    alignas(16) f32 result[4];
+    _mm_store_ps(result, v);
+    out.x = result[0];
+    out.y = result[1];
+    out.z = result[2];
+}
+
+void Skinning::computePalette(const Skeleton &skeleton, const Pose &pose, BonePalette &palette) {
+    const size_t numBones = skeleton.mBones.size();
+    osre_assert(pose.size() == numBones);
+
+    // The palette stores the global bone transforms first, the parents are already done
+    palette.resize(numBones);
+    for (size_t i = 0; i < numBones; ++i) {
+        const Bone &bone = skeleton.mBones[i];
+        const glm::mat4 local = pose[i].toMatrix();
+        if (bone.mParent < 0) {
+            palette[i] = skeleton.mRootTransform * local;
+        } else {
+            osre_assert(static_cast<size_t>(bone.mParent) < i);
+            palette[i] = palette[bone.mParent] * local;
+        }
+    }
+
+    for (size_t i = 0; i < numBones; ++i) {
+        palette[i] = skeleton.mGlobalInverse * palette[i] * skeleton.mBones[i].m_offsetMatrix;
+    }
+}
+
+void Skinning::skin(const Skin &skin, const BonePalette &palette, const RenderVert *src, RenderVert *dst, size_t numVertices) {
+    if (nullptr == src || nullptr == dst || 0 == numVertices) {
+        return;
+    }
+
+    if (numVertices < ParallelThreshold) {
+        skinRange(skin, palette, src, dst, 0, numVertices);
+        return;
+    }
+
+    Threading::ThreadPool::getDefault().parallelFor(numVertices, ParallelThreshold / 2,
+            [&skin, &palette, src, dst](size_t begin, size_t end) {
+        skinRange(skin, palette, src, dst, begin, end);
+    });
+}
+
+void Skinning::skinRange(const Skin &skin, const BonePalette &palette, const RenderVert *src, RenderVert *dst,
+        size_t begin, size_t end) {
+    osre_assert(end <= skin.mVertices.size());
+    if (palette.isEmpty()) {
+        return;
+    }
+
+    const f32 *matrices = glm::value_ptr(palette[0]);
+    for (size_t i = begin; i < end; ++i) {
+        const SkinVertex &sv = skin.mVertices[i];
+
+        // Vertices without an influence keep their bind pose
+        f32 sum = 0.0f;
+        for (ui32 j = 0; j < MaxBonesPerVertex; ++j) {
+            sum += sv.mWeights[j];
+        }
+        if (0.0f == sum) {
+            dst[i].position = src[i].position;
+            dst[i].normal = src[i].normal;
+            continue;
+        }
+
+        // Blend the columns of the influencing matrices
+        __m128 c0 = _mm_setzero_ps(), c1 = _mm_setzero_ps(), c2 = _mm_setzero_ps(), c3 = _mm_setzero_ps();
+        for (ui32 j = 0; j < MaxBonesPerVertex; ++j) {
+            if (0.0f == sv.mWeights[j]) {
+                continue;
+            }
+
+            const f32 *m = matrices + static_cast<size_t>(sv.mBones[j]) * 16;
+            const __m128 w = _mm_set1_ps(sv.mWeights[j]);
+            c0 = _mm_add_ps(c0, _mm_mul_ps(w, _mm_loadu_ps(m)));
+            c1 = _mm_add_ps(c1, _mm_mul_ps(w, _mm_loadu_ps(m + 4)));
+            c2 = _mm_add_ps(c2, _mm_mul_ps(w, _mm_loadu_ps(m + 8)));
+            c3 = _mm_add_ps(c3, _mm_mul_ps(w, _mm_loadu_ps(m + 12)));
+        }
+
+        const glm::vec3 &pos = src[i].position;
+        __m128 p = _mm_mul_ps(c0, _mm_set1_ps(pos.x));
+        p = _mm_add_ps(p, _mm_mul_ps(c1, _mm_set1_ps(pos.y)));
+        p = _mm_add_ps(p, _mm_mul_ps(c2, _mm_set1_ps(pos.z)));
+        p = _mm_add_ps(p, c3);
+        storeVec3(p, dst[i].position);
+
+        const glm::vec3 &normal = src[i].normal;
+        __m128 n = _mm_mul_ps(c0, _mm_set1_ps(normal.x));
+        n = _mm_add_ps(n, _mm_mul_ps(c1, _mm_set1_ps(normal.y)));
+        n = _mm_add_ps(n, _mm_mul_ps(c2, _mm_set1_ps(normal.z)));
+        storeVec3(n, dst[i].normal);
+    }
+}
+
+} // Namespace Animation
+} // Namespace OSRE
@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/App/World.h>
 #include <osre/Common/Ids.h>
 #include <osre/Common/Logger.h>
+#include <osre/Common/MinMaxKernel.h>
 #include <osre/Common/StringUtils.h>
 #include <osre/Common/TAABB.h>
 #include <osre/Debugging/MeshDiagnostic.h>
@@ -48,6 +49,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <assimp/vector3.h>
 #include <assimp/Importer.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 namespace OSRE {
@@ -108,6 +110,8 @@ AssimpWrapper::AssetContext::AssetContext(Common::Ids &ids, World *world) :
         mRoot(),
         mAbsPathWithFile(),
         mBone2NodeMap(),
+        mSkinArray(),
+        mAnimationTracks(),
         mNumVertices(0),
         mNumTriangles(0) {
     // empty
@@ -119,6 +123,7 @@ AssimpWrapper::AssetContext::~AssetContext() {
 
 AssimpWrapper::AssimpWrapper( Common::Ids &ids, World *world ) :
         mImporter(nullptr),
+        mQuantizeVertices(false),
         mAssetContext(ids, world) {
     // empty
 }
@@ -213,10 +218,10 @@ Entity *AssimpWrapper::convertScene() {
     }
     AnimationMap animLookup;
     if (nullptr != mAssetContext.mScene->mAnimations) {
-        cppcore::TArray<AnimationTrack> animationTracks;
-        animationTracks.resize(mAssetContext.mScene->mNumAnimations);
         for (ui32 i = 0; i < mAssetContext.mScene->mNumAnimations; ++i) {
-            importAnimation(mAssetContext.mScene->mAnimations[i], animationTracks[i], animLookup);
+            AnimationTrack *track = new AnimationTrack;
+            importAnimation(mAssetContext.mScene->mAnimations[i], *track, animLookup);
+            mAssetContext.mAnimationTracks.add(track);
         }
     }
 
@@ -232,28 +237,63 @@ Entity *AssimpWrapper::convertScene() {
     return mAssetContext.mEntity;
 }
 
+// Assimp matrices are row-major, glm stores the columns
 static void copyAiMatrix4x4(const aiMatrix4x4 &aiMat, glm::mat4 &mat) {
     mat[0].x = aiMat.a1;
-    mat[0].y = aiMat.a2;
-    mat[0].z = aiMat.a3;
-    mat[0].w = aiMat.a4;
+    mat[0].y = aiMat.b1;
+    mat[0].z = aiMat.c1;
+    mat[0].w = aiMat.d1;
 
-    mat[1].x = aiMat.b1;
+    mat[1].x = aiMat.a2;
     mat[1].y = aiMat.b2;
-    mat[1].z = aiMat.b3;
-    mat[1].w = aiMat.b4;
+    mat[1].z = aiMat.c2;
+    mat[1].w = aiMat.d2;
 
-    mat[2].x = aiMat.c1;
-    mat[2].y = aiMat.c2;
+    mat[2].x = aiMat.a3;
+    mat[2].y = aiMat.b3;
     mat[2].z = aiMat.c3;
-    mat[2].w = aiMat.c4;
+    mat[2].w = aiMat.d3;
 
-    mat[3].x = aiMat.d1;
-    mat[3].y = aiMat.d2;
-    mat[3].z = aiMat.d3;
+    mat[3].x = aiMat.a4;
+    mat[3].y = aiMat.b4;
+    mat[3].z = aiMat.c4;
     mat[3].w = aiMat.d4;
 }
 
+static glm::mat4 getGlobalTransform(const aiNode *node) {
+    glm::mat4 global(1.0f);
+    for (; nullptr != node; node = node->mParent) {
+        glm::mat4 local;
+        copyAiMatrix4x4(node->mTransformation, local);
+        global = local * global;
+    }
+
+    return global;
+}
+
+static ui32 getNodeDepth(const aiNode *node) {
+    ui32 depth = 0;
+    for (; nullptr != node; node = node->mParent) {
+        ++depth;
+    }
+
+    return depth;
+}
+
+// Keeps the strongest influences, when a vertex has more than MaxBonesPerVertex bones
+static void addBoneWeight(SkinVertex &vertex, ui16 bone, f32 weight) {
+    ui32 slot = 0;
+    for (ui32 i = 1; i < MaxBonesPerVertex; ++i) {
+        if (vertex.mWeights[i] < vertex.mWeights[slot]) {
+            slot = i;
+        }
+    }
+    if (weight > vertex.mWeights[slot]) {
+        vertex.mBones[slot] = bone;
+        vertex.mWeights[slot] = weight;
+    }
+}
+
 using MeshIdxArray = ::cppcore::TArray<size_t>;
 using Mat2MeshMap = std::map<aiMaterial *, MeshIdxArray *>;
 
@@ -304,11 +344,13 @@ void AssimpWrapper::importMeshes(aiMesh **meshes, ui32 numMeshes) {
 
     for (size_t mat2MeshIdx = 0; mat2MeshIdx < mat2MeshMap.size(); ++mat2MeshIdx) {
         mAssetContext.mMeshArray.add(new Mesh("m1", VertexType::RenderVertex, IndexType::UnsignedInt));
+        mAssetContext.mSkinArray.add(nullptr);
     }
 
     size_t i = 0;
     aiMesh *currentMesh = nullptr;
     ::cppcore::TArray<RenderVert> vertices;
+    ::cppcore::TArray<glm::vec3> tangents;
     for (auto & it : mat2MeshMap) {
         cppcore::TArray<ui32> indexArray;
         MeshIdxArray *miArray = it.second;
@@ -318,7 +360,23 @@ void AssimpWrapper::importMeshes(aiMesh **meshes, ui32 numMeshes) {
 
         const size_t numVerts = countVertices(*miArray, mAssetContext.mScene);
         vertices.resize(numVerts);
+        if (mQuantizeVertices) {
+            tangents.resize(numVerts);
+        }
         Mesh &newMesh = *mAssetContext.mMeshArray[i];
+
+        // One bone table per mesh, skinned meshes need a dynamic vertex buffer
+        BufferAccessType vbAccess = BufferAccessType::ReadOnly;
+        for (size_t meshIndex : *miArray) {
+            if (mAssetContext.mScene->mMeshes[meshIndex]->HasBones()) {
+                Skin *skin = new Skin;
+                importSkin(*miArray, numVerts, *skin);
+                mAssetContext.mSkinArray[i] = skin;
+                vbAccess = BufferAccessType::ReadWrite;
+                break;
+            }
+        }
+
         size_t vertexOffset = 0, indexOffset = 0;
         for (unsigned long long meshIndex : *miArray) {
             currentMesh = mAssetContext.mScene->mMeshes[meshIndex];
@@ -333,8 +391,6 @@ void AssimpWrapper::importMeshes(aiMesh **meshes, ui32 numMeshes) {
                     vertices[vertexOffset].position.x = vec3.x;
                     vertices[vertexOffset].position.y = vec3.y;
                     vertices[vertexOffset].position.z = vec3.z;
-
-                    aabb.merge(vec3.x, vec3.y, vec3.z);
                 }
 
                 if (currentMesh->HasNormals()) {
@@ -344,6 +400,15 @@ void AssimpWrapper::importMeshes(aiMesh **meshes, ui32 numMeshes) {
                     vertices[vertexOffset].normal.z = normal.z;
                 }
 
+                if (mQuantizeVertices) {
+                    if (currentMesh->HasTangentsAndBitangents()) {
+                        const aiVector3D &tangent = currentMesh->mTangents[k];
+                        tangents[vertexOffset] = glm::vec3(tangent.x, tangent.y, tangent.z);
+                    } else {
+                        tangents[vertexOffset] = glm::vec3(0.0f);
+                    }
+                }
+
                 if (currentMesh->HasVertexColors(0)) {
                     const aiColor4D &diffuse = currentMesh->mColors[0][k];
                     vertices[vertexOffset].color0.r = diffuse.r;
@@ -365,34 +430,6 @@ void AssimpWrapper::importMeshes(aiMesh **meshes, ui32 numMeshes) {
                     }
                 }
 
-                if (currentMesh->HasBones()) {
-                    Bone *bones = new Bone[currentMesh->mNumBones];
-                    for (ui32 l = 0; l < currentMesh->mNumBones; ++l) {
-                        aiBone *currentBone = currentMesh->mBones[l];
-                        if (nullptr == currentBone) {
-                            osre_debug(Tag, "Invalid bone instance found.");
-                            continue;
-                        }
-
-                        Bone &bone = bones[l];
-                        bone.mName = currentBone->mName.C_Str();
-                        copyAiMatrix4x4(currentBone->mOffsetMatrix, bone.m_offsetMatrix);
-                        VertexWeight *wArray = new VertexWeight[currentBone->mNumWeights];
-                        
-                        for (ui32 weightIdx = 0; weightIdx < currentBone->mNumWeights; ++weightIdx) {
-                            aiVertexWeight &aiVW = currentBone->mWeights[l];
-                            VertexWeight &w = wArray[weightIdx];
-                            w.m_vertexIdx = aiVW.mVertexId;
-                            w.m_vertexWeight = aiVW.mWeight;
-                        }
-                        bone.m_vertexWeights.add(wArray, currentBone->mNumWeights);
-                        const aiNode *node = mAssetContext.mScene->mRootNode->FindNode(bone.mName.c_str());
-                        if (nullptr != node) {
-                            mAssetContext.mBone2NodeMap[bone.mName.c_str()] = node;
-                        }
-                    }
-                }
-
                 ++vertexOffset;
             }
 
@@ -408,7 +445,7 @@ void AssimpWrapper::importMeshes(aiMesh **meshes, ui32 numMeshes) {
             indexOffset += currentMesh->mNumVertices;
 
             const size_t vbSize = sizeof(RenderVert) * numVerts;
-            newMesh.createVertexBuffer(&vertices[0], vbSize, BufferAccessType::ReadOnly);
+            newMesh.createVertexBuffer(&vertices[0], vbSize, vbAccess);
 
             const size_t ibSize = sizeof(ui32) * indexArray.size();
             newMesh.createIndexBuffer(&indexArray[0], ibSize, IndexType::UnsignedInt, BufferAccessType::ReadOnly);
@@ -418,6 +455,14 @@ void AssimpWrapper::importMeshes(aiMesh **meshes, ui32 numMeshes) {
             newMesh.setMaterial(mAssetContext.mMatArray[currentMesh->mMaterialIndex]);
         }
 
+        if (0 < numVerts) {
+            MinMaxKernel::merge(aabb, &vertices[0], numVerts, sizeof(RenderVert));
+        }
+
+        if (mQuantizeVertices) {
+            MeshProcessor::quantize(&newMesh, &tangents[0]);
+        }
+
         ++i;
     }
     mAssetContext.mEntity->setAABB(aabb);
@@ -488,43 +533,170 @@ void AssimpWrapper::importMaterial(aiMaterial *material) {
         matName = "material1";
     }
 
-    Material *osreMat = MaterialBuilder::createTexturedMaterial(matName, texResArray, VertexType::RenderVertex);
-    if (nullptr == osreMat) {
-        osre_error(Tag, "Error while creating material for " + matName);
-        return;
-    }
-
-    mAssetContext.mMatArray.add(osreMat);
-
+    // The colors are part of the material content, so equal asset materials share one instance
+    MaterialParameters params;
     const aiColor4D defaultColor(1, 1, 1, 1);
     aiColor4D diffuse = defaultColor;
     if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_DIFFUSE, &diffuse)) {
-        setColor4(diffuse, osreMat->m_color[(ui32)MaterialColorType::Mat_Diffuse]);
+        setColor4(diffuse, params.mColor[(ui32)MaterialColorType::Mat_Diffuse]);
     }
 
     aiColor4D specular = defaultColor;
     if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_SPECULAR, &specular)) {
-        setColor4(specular, osreMat->m_color[(ui32)MaterialColorType::Mat_Specular]);
+        setColor4(specular, params.mColor[(ui32)MaterialColorType::Mat_Specular]);
     }
 
     aiColor4D ambient = defaultColor;
     if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_AMBIENT, &ambient)) {
-        setColor4(ambient, osreMat->m_color[(ui32)MaterialColorType::Mat_Ambient]);
+        setColor4(ambient, params.mColor[(ui32)MaterialColorType::Mat_Ambient]);
     }
 
     aiColor4D emission = defaultColor;
     if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_EMISSIVE, &emission)) {
-        setColor4(emission, osreMat->m_color[(ui32)MaterialColorType::Mat_Emission]);
+        setColor4(emission, params.mColor[(ui32)MaterialColorType::Mat_Emission]);
     }
 
     ai_real shininess = 1.0, strength=1.0;
     unsigned int max; // changed: to unsigned
     if (AI_SUCCESS == aiGetMaterialFloatArray(material, AI_MATKEY_SHININESS, &shininess, &max)) {
-        osreMat->mShineness = shininess;
+        params.mShineness = shininess;
     }
 
     if (AI_SUCCESS == aiGetMaterialFloatArray(material, AI_MATKEY_SHININESS_STRENGTH, &strength, &max)) {
-        osreMat->mShinenessStrength = strength;
+        params.mShinenessStrength = strength;
+    }
+
+    const VertexType vertexType = mQuantizeVertices ? VertexType::QuantizedRenderVertex : VertexType::RenderVertex;
+    Material *osreMat = MaterialBuilder::createTexturedMaterial(matName, texResArray, vertexType, params);
+    if (nullptr == osreMat) {
+        osre_error(Tag, "Error while creating material for " + matName);
+        return;
+    }
+
+    mAssetContext.mMatArray.add(osreMat);
+}
+
+void AssimpWrapper::importSkin(const cppcore::TArray<size_t> &meshIndices, size_t numVertices, Skin &skin) {
+    const aiScene *scene = mAssetContext.mScene;
+    Skeleton &skeleton = skin.mSkeleton;
+
+    // Collect the bone table of all sub-meshes, each bone is stored once
+    Skeleton::BoneArray bones;
+    cppcore::TArray<const aiNode*> nodes;
+    for (size_t i = 0; i < meshIndices.size(); ++i) {
+        const aiMesh *currentMesh = scene->mMeshes[meshIndices[i]];
+        for (ui32 l = 0; l < currentMesh->mNumBones; ++l) {
+            const aiBone *currentBone = currentMesh->mBones[l];
+            if (nullptr == currentBone) {
+                osre_debug(Tag, "Invalid bone instance found.");
+                continue;
+            }
+
+            Bone bone;
+            bone.mName = currentBone->mName.C_Str();
+            bool found = false;
+            for (size_t k = 0; k < bones.size(); ++k) {
+                if (bones[k].mName == bone.mName) {
+                    found = true;
+                    break;
+                }
+            }
+            if (found) {
+                continue;
+            }
+
+            copyAiMatrix4x4(currentBone->mOffsetMatrix, bone.m_offsetMatrix);
+            const aiNode *node = scene->mRootNode->FindNode(currentBone->mName);
+            if (nullptr != node) {
+                copyAiMatrix4x4(node->mTransformation, bone.mLocalTransform);
+                mAssetContext.mBone2NodeMap[currentBone->mName.C_Str()] = node;
+            }
+            bones.add(bone);
+            nodes.add(node);
+        }
+    }
+
+    // Sort by the node depth, so parents will be stored before their children
+    cppcore::TArray<size_t> order;
+    order.resize(bones.size());
+    for (size_t k = 0; k < order.size(); ++k) {
+        order[k] = k;
+    }
+    std::stable_sort(order.begin(), order.end(), [&nodes](size_t lhs, size_t rhs) {
+        return getNodeDepth(nodes[lhs]) < getNodeDepth(nodes[rhs]);
+    });
+    skeleton.mBones.resize(bones.size());
+    cppcore::TArray<const aiNode*> sortedNodes;
+    sortedNodes.resize(bones.size());
+    for (size_t k = 0; k < order.size(); ++k) {
+        skeleton.mBones[k] = bones[order[k]];
+        sortedNodes[k] = nodes[order[k]];
+    }
+
+    // The parent is the next ancestor node, which is a bone
+    for (size_t k = 0; k < skeleton.mBones.size(); ++k) {
+        Bone &bone = skeleton.mBones[k];
+        const aiNode *node = sortedNodes[k];
+        for (const aiNode *parent = (nullptr != node) ? node->mParent : nullptr; nullptr != parent; parent = parent->mParent) {
+            bone.mParent = skeleton.findBone(parent->mName.C_Str());
+            if (-1 != bone.mParent) {
+                break;
+            }
+        }
+        if (-1 == bone.mParent && -1 == skeleton.mRootBone) {
+            skeleton.mRootBone = static_cast<i32>(k);
+            skeleton.mRootTransform = getGlobalTransform(nullptr != node ? node->mParent : nullptr);
+        }
+    }
+    glm::mat4 rootTransform;
+    copyAiMatrix4x4(scene->mRootNode->mTransformation, rootTransform);
+    skeleton.mGlobalInverse = glm::inverse(rootTransform);
+
+    // Store the weights per vertex
+    skin.mVertices.resize(numVertices);
+    for (size_t k = 0; k < numVertices; ++k) {
+        SkinVertex &vertex = skin.mVertices[k];
+        for (ui32 j = 0; j < MaxBonesPerVertex; ++j) {
+            vertex.mBones[j] = 0;
+            vertex.mWeights[j] = 0.0f;
+        }
+    }
+
+    size_t vertexOffset = 0;
+    for (size_t i = 0; i < meshIndices.size(); ++i) {
+        const aiMesh *currentMesh = scene->mMeshes[meshIndices[i]];
+        for (ui32 l = 0; l < currentMesh->mNumBones; ++l) {
+            const aiBone *currentBone = currentMesh->mBones[l];
+            if (nullptr == currentBone) {
+                continue;
+            }
+
+            // All bones of the meshes were added to the skeleton before
+            const i32 boneIndex = skeleton.findBone(currentBone->mName.C_Str());
+            osre_assert(-1 != boneIndex);
+
+            for (ui32 weightIdx = 0; weightIdx < currentBone->mNumWeights; ++weightIdx) {
+                const aiVertexWeight &aiVW = currentBone->mWeights[weightIdx];
+                const size_t vertexIdx = vertexOffset + aiVW.mVertexId;
+                if (vertexIdx < numVertices) {
+                    addBoneWeight(skin.mVertices[vertexIdx], static_cast<ui16>(boneIndex), aiVW.mWeight);
+                }
+            }
+        }
+        vertexOffset += currentMesh->mNumVertices;
+    }
+
+    for (size_t k = 0; k < numVertices; ++k) {
+        SkinVertex &vertex = skin.mVertices[k];
+        f32 sum = 0.0f;
+        for (ui32 j = 0; j < MaxBonesPerVertex; ++j) {
+            sum += vertex.mWeights[j];
+        }
+        if (sum > 0.0f) {
+            for (ui32 j = 0; j < MaxBonesPerVertex; ++j) {
+                vertex.mWeights[j] /= sum;
+            }
+        }
     }
 }
 
@@ -558,6 +730,36 @@ void AssimpWrapper::importAnimation(aiAnimation *animation, AnimationTrack &curr
     }
 
     currentAnimationTrack.mName = animation->mName.C_Str();
+    currentAnimationTrack.mDuration = animation->mDuration;
+    currentAnimationTrack.mTicksPerSecond = animation->mTicksPerSecond;
+    currentAnimationTrack.mNodeAnimations.resize(animation->mNumChannels);
+    for (ui32 i = 0; i < animation->mNumChannels; ++i) {
+        const aiNodeAnim *channel = animation->mChannels[i];
+        NodeAnimation &nodeAnimation = currentAnimationTrack.mNodeAnimations[i];
+        nodeAnimation.mName = channel->mNodeName.C_Str();
+
+        nodeAnimation.mPositions.resize(channel->mNumPositionKeys);
+        for (ui32 k = 0; k < channel->mNumPositionKeys; ++k) {
+            const aiVectorKey &key = channel->mPositionKeys[k];
+            nodeAnimation.mPositions[k].mVector = glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z);
+            nodeAnimation.mPositions[k].mTime = key.mTime;
+        }
+
+        nodeAnimation.mRotations.resize(channel->mNumRotationKeys);
+        for (ui32 k = 0; k < channel->mNumRotationKeys; ++k) {
+            const aiQuatKey &key = channel->mRotationKeys[k];
+            nodeAnimation.mRotations[k].mQuad = glm::vec4(key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w);
+            nodeAnimation.mRotations[k].mTime = key.mTime;
+        }
+
+        nodeAnimation.mScalings.resize(channel->mNumScalingKeys);
+        for (ui32 k = 0; k < channel->mNumScalingKeys; ++k) {
+            const aiVectorKey &key = channel->mScalingKeys[k];
+            nodeAnimation.mScalings[k].mVector = glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z);
+            nodeAnimation.mScalings[k].mTime = key.mTime;
+        }
+    }
+    animLookup[animation->mName.C_Str()] = &currentAnimationTrack;
 }
 
 } // namespace App
@@ -21,6 +21,7 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include <osre/App/CameraComponent.h>
+#include <osre/App/ComponentRegistry.h>
 #include <osre/Common/Logger.h>
 #include <osre/RenderBackend/RenderBackendService.h>
 #include <osre/Common/glm_common.h>
@@ -44,36 +45,42 @@ static constexpr f32 DefaultNear = 0.001f;
 static constexpr f32 DefaultFar = 1000.0f;
 static constexpr f32 DefaultAspectRatio = 1.0f;
 
+CameraState::CameraState() :
+        mCameraModel(CameraModel::Perspective),
+        mFov(60.0f),
+        mResolution(1.0f, 1.0f),
+        mNear(DefaultNear),
+        mFar(DefaultFar),
+        mAspectRatio(DefaultAspectRatio),
+        mLeft(0.0f),
+        mRight(1.0f),
+        mTop(0.0f),
+        mBottom(1.0f),
+        mEye(1, 1, 1),
+        mCenter(0, 0, 0),
+        mUp(0, 0, 1),
+        mView(1),
+        mProjection(1) {
+    // empty
+}
+
 Camera::Camera(Entity *owner) :
         Component(owner, ComponentType::CameraComponentType),
         mRecalculateRequested(true),
-        mCameraModel(CameraModel::Perspective),
-        m_fov(60.0f),
-        mResolution(1.0f, 1.0f),
-        m_near(DefaultNear),
-        m_far(DefaultFar),
-        m_aspectRatio(DefaultAspectRatio),
-        m_left(0.0f),
-        m_right(1.0f),
-        m_top(0.0f),
-        m_bottom(1.0f),
-        m_eye(1, 1, 1),
-        m_center(0, 0, 0),
-        m_up(0, 0, 1),
-        m_view(1),
-        m_projection(1) {
+        mData() {
     // empty
 }
 
 void Camera::setProjectionParameters(f32 fov, f32 w, f32 h, f32 zNear, f32 zFar) {
-    m_fov = glm::radians(fov);
-    mResolution.Width = w;
-    mResolution.Height = h;
-    m_near = zNear;
-    m_far = zFar;
-    m_aspectRatio = DefaultAspectRatio;
+    CameraState &data = getData();
+    data.mFov = glm::radians(fov);
+    data.mResolution.Width = w;
+    data.mResolution.Height = h;
+    data.mNear = zNear;
+    data.mFar = zFar;
+    data.mAspectRatio = DefaultAspectRatio;
     if (0.0f != h) {
-        m_aspectRatio = w / h;
+        data.mAspectRatio = w / h;
     }
 
     setCameraModel(CameraModel::Perspective);
@@ -93,7 +100,7 @@ void Camera::render(RenderBackendService *rbSrv) {
 
 void Camera::observeBoundingBox(const AABB &aabb) {
     f32 diam = aabb.getDiameter();
-    const f32 maxDist = m_far - m_near;
+    const f32 maxDist = getFar() - getNear();
     if (diam > maxDist) {
         diam = maxDist - 100.0f;
     }
@@ -106,16 +113,18 @@ void Camera::observeBoundingBox(const AABB &aabb) {
 }
 
 void Camera::setLookAt(const glm::vec3 &eyePosition, const glm::vec3 &center, const glm::vec3 &up) {
-    m_eye = eyePosition;
-    m_center = center;
-    m_up = up;
+    CameraState &data = getData();
+    data.mEye = eyePosition;
+    data.mCenter = center;
+    data.mUp = up;
 }
 
 void Camera::setProjectionMode(f32 fov, f32 aspectRatio, f32 nearPlane, f32 farPlane) {
-    m_fov = fov;
-    m_aspectRatio = aspectRatio;
-    m_near = nearPlane;
-    m_far = farPlane;
+    CameraState &data = getData();
+    data.mFov = fov;
+    data.mAspectRatio = aspectRatio;
+    data.mNear = nearPlane;
+    data.mFar = farPlane;
 
     setCameraModel(CameraModel::Perspective);
 }
@@ -123,38 +132,42 @@ void Camera::setProjectionMode(f32 fov, f32 aspectRatio, f32 nearPlane, f32 farP
 void Camera::setCameraModel(CameraModel cm) {
     osre_trace(Tag, "Set camera model to " + CameraModelName[static_cast<size_t>(cm)])
 
-    mCameraModel = cm;
+    getData().mCameraModel = cm;
 }
 
 void Camera::setOrthoMode(f32 left, f32 right, f32 bottom, f32 top, f32 nearPlane, f32 farPlane) {
-    mResolution.Width = right - left;
-    mResolution.Height = bottom - top;
-    m_left = left;
-    m_right = right;
-    m_bottom = bottom;
-    m_top = top;
-    m_near = nearPlane;
-    m_far = farPlane;
+    CameraState &data = getData();
+    data.mResolution.Width = right - left;
+    data.mResolution.Height = bottom - top;
+    data.mLeft = left;
+    data.mRight = right;
+    data.mBottom = bottom;
+    data.mTop = top;
+    data.mNear = nearPlane;
+    data.mFar = farPlane;
 
     setCameraModel(CameraModel::Orthogonal);
 }
 
 const glm::mat4 &Camera::getView() const {
-    return m_view;
+    return getData().mView;
 }
 
 const glm::mat4 &Camera::getProjection() const {
-    return m_projection;
+    return getData().mProjection;
 }
 
-bool Camera::onUpdate(Time) {
-    const CameraModel cm = getCameraModel();
-    if (cm == CameraModel::Perspective) {
-        m_projection = glm::perspective(m_fov, m_aspectRatio, m_near, m_far);
-    } else if (cm == CameraModel::Orthogonal) {
-        m_projection = glm::ortho(m_left, m_right, m_bottom, m_top, m_near, m_far);
+void Camera::updateMatrices(CameraState &data) {
+    if (data.mCameraModel == CameraModel::Perspective) {
+        data.mProjection = glm::perspective(data.mFov, data.mAspectRatio, data.mNear, data.mFar);
+    } else if (data.mCameraModel == CameraModel::Orthogonal) {
+        data.mProjection = glm::ortho(data.mLeft, data.mRight, data.mBottom, data.mTop, data.mNear, data.mFar);
     }
-    m_view = glm::lookAt(m_eye, m_center, m_up);
+    data.mView = glm::lookAt(data.mEye, data.mCenter, data.mUp);
+}
+
+bool Camera::onUpdate(Time) {
+    updateMatrices(getData());
 
     return true;
 }
@@ -162,11 +175,33 @@ bool Camera::onUpdate(Time) {
 bool Camera::onRender(RenderBackendService *rbSrv) {
     osre_assert(nullptr != rbSrv);
 
-    rbSrv->setMatrix(MatrixType::View, m_view);
-    rbSrv->setMatrix(MatrixType::Projection, m_projection);
+    const CameraState &data = getData();
+    rbSrv->setMatrix(MatrixType::View, data.mView);
+    rbSrv->setMatrix(MatrixType::Projection, data.mProjection);
 
     return true;
 }
 
+void Camera::onAttach(ComponentRegistry &registry, ui32 slot) {
+    registry.getCameras().add(slot, mData);
+}
+
+void Camera::onDetach(ComponentRegistry &registry, ui32 slot) {
+    mData = *registry.getCameras().find(slot);
+}
+
+CameraState &Camera::getData() {
+    ComponentRegistry *registry = getRegistry();
+    if (nullptr == registry) {
+        return mData;
+    }
+
+    return *registry->getCameras().find(getSlot());
+}
+
+const CameraState &Camera::getData() const {
+    return const_cast<Camera *>(this)->getData();
+}
+
 } // Namespace App
 } // Namespace OSRE
@@ -21,6 +21,7 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include <osre/App/Component.h>
+#include <osre/App/ComponentRegistry.h>
 #include <osre/App/Entity.h>
 #include <osre/RenderBackend/RenderBackendService.h>
 #include <osre/RenderBackend/RenderCommon.h>
@@ -35,10 +36,18 @@ static const glm::vec3 Dummy = glm::vec3(-1, -1, -1);
 
 Component::Component(Entity *owner, ComponentType type) :
         m_owner(owner),
-        mType(type) {
+        mType(type),
+        mRegistry(nullptr),
+        mSlot(ComponentRegistry::InvalidSlot) {
     osre_assert(nullptr != owner);
 }
 
+Component::~Component() {
+    if (nullptr != mRegistry) {
+        mRegistry->removeComponent(mSlot, mType);
+    }
+}
+
 void Component::update(Time dt) {
     onUpdate(dt);
 }
@@ -47,8 +56,16 @@ void Component::render(RenderBackendService *renderBackendSrv) {
     onRender(renderBackendSrv);
 }
 
+void Component::onAttach(ComponentRegistry &, ui32) {
+    // empty
+}
+
+void Component::onDetach(ComponentRegistry &, ui32) {
+    // empty
+}
+
 RenderComponent::RenderComponent(Entity *owner) :
-        Component(owner, ComponentType::RenderComponentType), m_newGeo() {
+        Component(owner, ComponentType::RenderComponentType), mData() {
     // empty
 }
 
@@ -57,7 +74,7 @@ void RenderComponent::addStaticMesh(Mesh *geo) {
         return;
     }
 
-    m_newGeo.add(geo);
+    getData().mMeshes.add(geo);
 }
 
 void RenderComponent::addStaticMeshArray(const RenderBackend::MeshArray &array) {
@@ -65,21 +82,32 @@ void RenderComponent::addStaticMeshArray(const RenderBackend::MeshArray &array)
         return;
     }
 
+    RenderData &data = getData();
     for (size_t i = 0; i < array.size(); ++i) {
-        m_newGeo.add(array[i]);
+        data.mMeshes.add(array[i]);
     }
 }
 
 size_t RenderComponent::getNumGeometry() const {
-    return m_newGeo.size();
+    return getData().mMeshes.size();
 }
 
 Mesh *RenderComponent::getMeshAt(size_t idx) const {
-    return m_newGeo[idx];
+    return getData().mMeshes[idx];
 }
 
 void RenderComponent::getMeshArray(RenderBackend::MeshArray &meshArray) {
-    meshArray = m_newGeo;
+    meshArray = getData().mMeshes;
+}
+
+void RenderComponent::submitMeshes(RenderData &data, RenderBackendService *rbSrv) {
+    osre_assert(nullptr != rbSrv);
+
+    // The meshes stay in the component, so they can be used for the bounds and occluders
+    for (size_t i = data.mNumSubmitted; i < data.mMeshes.size(); ++i) {
+        rbSrv->addMesh(data.mMeshes[i], 0);
+    }
+    data.mNumSubmitted = data.mMeshes.size();
 }
 
 bool RenderComponent::onUpdate(Time) {
@@ -87,16 +115,32 @@ bool RenderComponent::onUpdate(Time) {
 }
 
 bool RenderComponent::onRender(RenderBackendService *renderBackendSrv) {
-    if (!m_newGeo.isEmpty()) {
-        for (ui32 i = 0; i < m_newGeo.size(); i++) {
-            renderBackendSrv->addMesh(m_newGeo[i], 0);
-        }
-        m_newGeo.resize(0);
-    }
+    submitMeshes(getData(), renderBackendSrv);
 
     return true;
 }
 
+void RenderComponent::onAttach(ComponentRegistry &registry, ui32 slot) {
+    registry.getRenderPool().add(slot, mData);
+}
+
+void RenderComponent::onDetach(ComponentRegistry &registry, ui32 slot) {
+    mData = *registry.getRenderPool().find(slot);
+}
+
+RenderData &RenderComponent::getData() {
+    ComponentRegistry *registry = getRegistry();
+    if (nullptr == registry) {
+        return mData;
+    }
+
+    return *registry->getRenderPool().find(getSlot());
+}
+
+const RenderData &RenderComponent::getData() const {
+    return const_cast<RenderComponent *>(this)->getData();
+}
+
 LightComponent::LightComponent(Entity *owner) 
         : Component(owner, ComponentType::LightComponentType), mLight(nullptr) {}
 
@@ -0,0 +1,205 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/App/ComponentRegistry.h>
+
+namespace OSRE {
+namespace App {
+
+constexpr ui32 TransformPool::InvalidIndex;
+constexpr ui32 ComponentRegistry::InvalidSlot;
+
+TransformPool::TransformPool() :
+        mSlots(),
+        mTranslation(),
+        mRotation(),
+        mScale(),
+        mLocal(),
+        mWorld(),
+        mFlags(),
+        mSparse() {
+    // empty
+}
+
+ui32 TransformPool::add(ui32 slot) {
+    if (slot >= mSparse.size()) {
+        const size_t oldSize = mSparse.size();
+        mSparse.resize(slot + 1);
+        for (size_t i = oldSize; i < mSparse.size(); ++i) {
+            mSparse[i] = InvalidIndex;
+        }
+    }
+
+    if (InvalidIndex != mSparse[slot]) {
+        return mSparse[slot];
+    }
+
+    const ui32 index = static_cast<ui32>(mSlots.size());
+    mSparse[slot] = index;
+    mSlots.add(slot);
+    mTranslation.add(glm::vec3(0.0f));
+    mRotation.add(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    mScale.add(glm::vec3(1.0f));
+    mLocal.add(glm::mat4(1.0f));
+    mWorld.add(glm::mat4(1.0f));
+    mFlags.add(WorldDirty);
+
+    return index;
+}
+
+bool TransformPool::remove(ui32 slot) {
+    const ui32 index = indexOf(slot);
+    if (InvalidIndex == index) {
+        return false;
+    }
+
+    const ui32 last = static_cast<ui32>(mSlots.size() - 1);
+    if (index != last) {
+        mSlots[index] = mSlots[last];
+        mTranslation[index] = mTranslation[last];
+        mRotation[index] = mRotation[last];
+        mScale[index] = mScale[last];
+        mLocal[index] = mLocal[last];
+        mWorld[index] = mWorld[last];
+        mFlags[index] = mFlags[last];
+        mSparse[mSlots[index]] = index;
+    }
+    mSlots.removeBack();
+    mTranslation.removeBack();
+    mRotation.removeBack();
+    mScale.removeBack();
+    mLocal.removeBack();
+    mWorld.removeBack();
+    mFlags.removeBack();
+    mSparse[slot] = InvalidIndex;
+
+    return true;
+}
+
+ComponentRegistry::ComponentRegistry() :
+        mPools(),
+        mTransforms(),
+        mRenderPool(),
+        mCameras(),
+        mLocalBounds(),
+        mWorldBounds(),
+        mFreeSlots(),
+        mNextSlot(0) {
+    // empty
+}
+
+ComponentRegistry::~ComponentRegistry() {
+    // The components may live longer than the registry, so they get their data back
+    for (size_t i = 0; i < Component::getIndex(ComponentType::MaxNumComponents); ++i) {
+        while (!mPools[i].isEmpty()) {
+            removeComponent(mPools[i].getKeyAt(mPools[i].size() - 1), static_cast<ComponentType>(i));
+        }
+    }
+}
+
+ui32 ComponentRegistry::allocSlot() {
+    if (!mFreeSlots.isEmpty()) {
+        const ui32 slot = mFreeSlots.back();
+        mFreeSlots.removeBack();
+        return slot;
+    }
+
+    mLocalBounds.add(Common::AABB());
+    mWorldBounds.add(Common::AABB());
+
+    return mNextSlot++;
+}
+
+void ComponentRegistry::releaseSlot(ui32 slot) {
+    if (slot >= mNextSlot) {
+        return;
+    }
+
+    for (size_t i = 0; i < Component::getIndex(ComponentType::MaxNumComponents); ++i) {
+        removeComponent(slot, static_cast<ComponentType>(i));
+    }
+    mLocalBounds[slot] = Common::AABB();
+    mWorldBounds[slot] = Common::AABB();
+    mFreeSlots.add(slot);
+}
+
+void ComponentRegistry::addComponent(ui32 slot, Component *component) {
+    if (nullptr == component || slot >= mNextSlot || nullptr != component->mRegistry) {
+        return;
+    }
+
+    const ComponentType type = component->getType();
+    removeComponent(slot, type);
+    mPools[Component::getIndex(type)].add(slot, component);
+    component->onAttach(*this, slot);
+    component->mRegistry = this;
+    component->mSlot = slot;
+}
+
+void ComponentRegistry::removeComponent(ui32 slot, ComponentType type) {
+    if (ComponentType::InvalidComponent == type || ComponentType::MaxNumComponents == type) {
+        return;
+    }
+
+    ComponentPool &pool = mPools[Component::getIndex(type)];
+    Component **component = pool.find(slot);
+    if (nullptr == component) {
+        return;
+    }
+
+    // The component reads its data from the pool until it is detached
+    Component *detached = *component;
+    detached->onDetach(*this, slot);
+    detached->mRegistry = nullptr;
+    detached->mSlot = InvalidSlot;
+    removeData(slot, type);
+    pool.remove(slot);
+}
+
+Component *ComponentRegistry::getComponent(ui32 slot, ComponentType type) const {
+    if (ComponentType::InvalidComponent == type || ComponentType::MaxNumComponents == type) {
+        return nullptr;
+    }
+
+    Component *const *component = mPools[Component::getIndex(type)].find(slot);
+
+    return nullptr != component ? *component : nullptr;
+}
+
+void ComponentRegistry::removeData(ui32 slot, ComponentType type) {
+    switch (type) {
+        case ComponentType::TransformComponentType:
+            mTransforms.remove(slot);
+            break;
+        case ComponentType::RenderComponentType:
+            mRenderPool.remove(slot);
+            break;
+        case ComponentType::CameraComponentType:
+            mCameras.remove(slot);
+            break;
+        default:
+            break;
+    }
+}
+
+} // namespace App
+} // namespace OSRE
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/App/CameraComponent.h>
 #include <osre/App/Entity.h>
 #include <osre/App/World.h>
+#include <osre/App/ComponentRegistry.h>
 #include <osre/RenderBackend/MeshProcessor.h>
 
 namespace OSRE {
@@ -41,7 +42,10 @@ Entity::Entity(const String &name, Common::Ids &ids, World *world) :
         m_node(nullptr),
         mIds(ids),
         m_aabb(),
-        mOwner(world) {
+        mOwner(world),
+        mOccluder(false),
+        mSlot(ComponentRegistry::InvalidSlot),
+        mHandle() {
     mComponentArray.resize(Component::getIndex(ComponentType::MaxNumComponents));
     mComponentArray.set(nullptr);
     m_renderComponent = (RenderComponent*) createComponent(ComponentType::RenderComponentType);
@@ -63,16 +67,21 @@ void Entity::setBehaviourControl(AbstractBehaviour *behaviour) {
 
 void Entity::setNode(TransformComponent *node) {
     m_node = node;
+    if (nullptr != mOwner) {
+        mOwner->invalidateBounds(this);
+    }
 }
 
 TransformComponent *Entity::getNode() const {
-    return m_node;
+    if (nullptr != m_node) {
+        return m_node;
+    }
+
+    return (TransformComponent *)getComponent(ComponentType::TransformComponentType);
 }
 
 bool Entity::update(Time dt) {
-    if (nullptr != m_behaviour) {
-        m_behaviour->update(dt);
-    }
+    updateBehaviour(dt);
     for (auto &it : mComponentArray) {
         if (it != nullptr) {
             it->update(dt);
@@ -82,6 +91,12 @@ bool Entity::update(Time dt) {
     return true;
 }
 
+void Entity::updateBehaviour(Time dt) {
+    if (nullptr != m_behaviour) {
+        m_behaviour->update(dt);
+    }
+}
+
 bool Entity::render(RenderBackend::RenderBackendService *rbSrv) {
     for (auto &it : mComponentArray) {
         if (it != nullptr) {
@@ -119,6 +134,9 @@ Component *Entity::createComponent(ComponentType type) {
             break;
     }
     mComponentArray[static_cast<size_t>(type)] = component;
+    if (nullptr != mOwner && ComponentRegistry::InvalidSlot != mSlot) {
+        mOwner->getComponentRegistry().addComponent(mSlot, component);
+    }
 
     return component;
 }
@@ -128,15 +146,30 @@ Component *Entity::getComponent(ComponentType type) const {
         return nullptr;
     }
 
+    // Entities of a world resolve their components by the slot
+    if (nullptr != mOwner && ComponentRegistry::InvalidSlot != mSlot) {
+        return mOwner->getComponentRegistry().getComponent(mSlot, type);
+    }
+
     return mComponentArray[Component::getIndex(type)];
 }
 
 void Entity::setAABB(const AABB &aabb) {
-    m_aabb = aabb;
+    if (nullptr == mOwner || ComponentRegistry::InvalidSlot == mSlot) {
+        m_aabb = aabb;
+        return;
+    }
+
+    mOwner->getComponentRegistry().getLocalBounds(mSlot) = aabb;
+    mOwner->invalidateBounds(this);
 }
 
 const AABB &Entity::getAABB() const {
-    return m_aabb;
+    if (nullptr == mOwner || ComponentRegistry::InvalidSlot == mSlot) {
+        return m_aabb;
+    }
+
+    return mOwner->getComponentRegistry().getLocalBounds(mSlot);
 }
 
 void Entity::serialize( IO::Stream *stream ) {
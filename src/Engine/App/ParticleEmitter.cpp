@@ -26,93 +26,122 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/RenderBackend/Mesh.h>
 #include <osre/RenderBackend/MeshBuilder.h>
 #include <osre/RenderBackend/MaterialBuilder.h>
+#include <osre/Threading/ThreadPool.h>
 
-#include <cppcore/Random/RandomGenerator.h>
+#include <limits>
 
 namespace OSRE {
 namespace App {
 
 using namespace ::OSRE::RenderBackend;
 
+// Emitters with less alive particles will be updated by the calling thread only
+static constexpr ui32 ParallelThreshold = 16384;
+
+// The minimal number of blocks of four particles per job
+static constexpr size_t MinBlocksPerJob = 1024;
+
+static constexpr f32 DeadAge = std::numeric_limits<f32>::max();
+
+static size_t getPaddedSize(size_t numParticles) {
+    return (numParticles + 3) & ~static_cast<size_t>(3);
+}
+
 ParticleEmitter::ParticleEmitter( RenderBackendService *rbSrv ) : 
         m_rbSrv( rbSrv ), 
         m_numPoints( 0 ), 
-        m_col( nullptr ), 
-        m_pos( nullptr ), 
-        m_pt_indices( nullptr ), 
+        mNumAlive( 0 ),
+        mPosX(), mPosY(), mPosZ(),
+        mVelX(), mVelY(), mVelZ(),
+        mColR(), mColG(), mColB(),
+        mAge(), mLifetime(),
         m_ptGeo( nullptr ), 
         mUseBounds( false ), 
-        mBounds() {
+        mBounds(),
+        mSpawnRate( 0.0f ),
+        mSpawnAccumulator( 0.0f ),
+        mMinLifetime( Infinite ),
+        mMaxLifetime( Infinite ),
+        mSpawnMin( -2.0f ),
+        mSpawnMax( 2.0f ),
+        mVelocityMin( -0.5f ),
+        mVelocityMax( 0.5f ),
+        mAcceleration( 0.0f ),
+        mRandomState( 0x9e3779b9 ) {
     // empty
 }
 
 ParticleEmitter::~ParticleEmitter() {
-    delete[] m_col;
-    delete[] m_pos;
+    // empty
 }
 
 void ParticleEmitter::init( ui32 numPoints ) {
-    m_numPoints = numPoints;
-    m_col = new glm::vec3[ numPoints ];
-    m_pos = new glm::vec3[ numPoints ];
-
-    cppcore::RandomGenerator generator;
-    for ( ui32 i = 0; i < m_numPoints; i++ ) {
-        const f32 r = static_cast< f32 >( generator.get( 1, 100 ) ) / 100.0f;
-        const f32 g = static_cast< f32 >( generator.get( 1, 100 ) ) / 100.0f;
-        const f32 b = static_cast< f32 >( generator.get( 1, 100 ) ) / 100.0f;
-        m_col[ i ] = glm::vec3( r, g, b );
-
-        const f32 x = static_cast< f32 >( generator.get( 0, 400 ) - 200 ) / 100.0f;
-        const f32 y = static_cast< f32 >( generator.get( 0, 400 ) - 200 ) / 100.0f;
-        const f32 z = static_cast< f32 >( generator.get( 0, 400 ) - 200 ) / 100.0f;
-        m_pos[ i ] = glm::vec3( x, y, z );
+    if (0 == numPoints) {
+        return;
     }
 
-    m_pt_indices = new GLushort[ m_numPoints ];
-    for ( ui32 i = 0; i < m_numPoints; i++ ) {
-        m_pt_indices[ i ] = static_cast< GLushort >( i );
+    m_numPoints = numPoints;
+    mNumAlive = 0;
+    mSpawnAccumulator = 0.0f;
+
+    const size_t paddedSize = getPaddedSize(numPoints);
+    cppcore::TArray<f32> *arrays[] = { &mPosX, &mPosY, &mPosZ, &mVelX, &mVelY, &mVelZ,
+        &mColR, &mColG, &mColB, &mAge, &mLifetime };
+    for (cppcore::TArray<f32> *array : arrays) {
+        array->resize(paddedSize);
+        array->set(0.0f);
     }
 
+    // Only the alive particles will be drawn
     MeshBuilder meshBuilder;
-    meshBuilder.allocEmptyMesh("", VertexType::ColorVertex);
+    meshBuilder.allocStreamingMesh("", VertexType::ColorVertex, numPoints, PrimitiveType::PointList);
     m_ptGeo = meshBuilder.getMesh();
-    m_rbSrv->addMesh( m_ptGeo, 0 );
-    MeshBuilder::allocVertices(m_ptGeo, VertexType::ColorVertex, m_numPoints, m_pos, m_col, nullptr, BufferAccessType::ReadOnly);
-    ui32 pt_size = sizeof( GLushort ) * m_numPoints;
-    m_ptGeo->createIndexBuffer(m_pt_indices, pt_size, IndexType::UnsignedShort, BufferAccessType::ReadOnly);
-
-    // setup primitives
-    m_ptGeo->addPrimitiveGroup(m_numPoints, PrimitiveType::PointList, 0);
-    m_ptGeo->setModelMatrix(true, glm::mat4(1.0f));
 
     // setup material
     Material *mat = MaterialBuilder::createBuildinMaterial( VertexType::ColorVertex );
     m_ptGeo->setMaterial(mat);
+
+    emit(numPoints);
+    writeVertices(0, mNumAlive);
+    MeshBuilder::setNumStreamingVertices(m_ptGeo, mNumAlive);
+    if (nullptr != m_rbSrv) {
+        m_rbSrv->addMesh( m_ptGeo, 0 );
+    }
 }
 
-void ParticleEmitter::update( d32 /*tick*/ ) {
-    cppcore::RandomGenerator generator;
-    for ( ui32 i = 0; i < m_numPoints; i++ ) {
-        const f32 x = static_cast< f32 >( generator.get( -10, 10 ) ) / 100.0f;
-        const f32 y = static_cast< f32 >( generator.get( -10, 10 ) ) / 100.0f;
-        const f32 z = static_cast< f32 >( generator.get( -10, 10 ) ) / 100.0f;
-        m_pos[ i ] += glm::vec3( x, y, z );
-        if (mUseBounds) {
-            glm::vec3 pt(m_pos[i].x, m_pos[i].y, m_pos[i].z);
-            if (!mBounds.isIn(pt)) {
-                m_pos[i] -= m_pos[i];
-                m_pos[i] -= m_pos[i];
-            }
-        }
+void ParticleEmitter::update( d32 tick ) {
+    if (nullptr == m_ptGeo) {
+        return;
+    }
+
+    const f32 dt = static_cast<f32>(tick);
+    if (mSpawnRate > 0.0f) {
+        mSpawnAccumulator += mSpawnRate * dt;
+        const ui32 numToSpawn = static_cast<ui32>(mSpawnAccumulator);
+        mSpawnAccumulator -= static_cast<f32>(numToSpawn);
+        emit(numToSpawn);
     }
 
-    ui32 offset( 0 );
-    for ( ui32 i = 0; i < m_numPoints; i++ ) {
-        uc8 *ptr = ( uc8* )m_ptGeo->getVertexBuffer()->getData();
-        ::memcpy( &ptr[ offset ], &m_pos[ i ], sizeof( glm::vec3 ) );
-        offset += sizeof( ColorVert );
+    const size_t numBlocks = getPaddedSize(mNumAlive) / 4;
+    if (mNumAlive >= ParallelThreshold) {
+        Threading::ThreadPool::getDefault().parallelFor(numBlocks, MinBlocksPerJob, [this, dt](size_t begin, size_t end) {
+            integrate(begin * 4, end * 4, dt);
+        });
+    } else {
+        integrate(0, numBlocks * 4, dt);
     }
+
+    killDead();
+
+    if (mNumAlive >= ParallelThreshold) {
+        Threading::ThreadPool::getDefault().parallelFor(mNumAlive, MinBlocksPerJob * 4, [this](size_t begin, size_t end) {
+            writeVertices(begin, end);
+        });
+    } else {
+        writeVertices(0, mNumAlive);
+    }
+
+    MeshBuilder::setNumStreamingVertices(m_ptGeo, mNumAlive);
 }
 
 void ParticleEmitter::setBounds(const Common::AABB& bounds) {
@@ -120,9 +149,168 @@ void ParticleEmitter::setBounds(const Common::AABB& bounds) {
     mBounds = bounds;
 }
 
+void ParticleEmitter::setSpawnRate(f32 particlesPerSecond) {
+    mSpawnRate = particlesPerSecond;
+}
+
+void ParticleEmitter::setLifetime(f32 minLifetime, f32 maxLifetime) {
+    mMinLifetime = minLifetime;
+    mMaxLifetime = maxLifetime;
+}
+
+void ParticleEmitter::setSpawnVolume(const glm::vec3 &min, const glm::vec3 &max) {
+    mSpawnMin = min;
+    mSpawnMax = max;
+}
+
+void ParticleEmitter::setVelocity(const glm::vec3 &min, const glm::vec3 &max) {
+    mVelocityMin = min;
+    mVelocityMax = max;
+}
+
+void ParticleEmitter::setAcceleration(const glm::vec3 &acceleration) {
+    mAcceleration = acceleration;
+}
+
+void ParticleEmitter::setSeed(ui32 seed) {
+    osre_assert(0 != seed);
+    mRandomState = seed;
+}
+
+ui32 ParticleEmitter::emit(ui32 count) {
+    const ui32 numFree = m_numPoints - mNumAlive;
+    if (count > numFree) {
+        count = numFree;
+    }
+
+    for (ui32 n = 0; n < count; ++n) {
+        const ui32 i = mNumAlive++;
+        mPosX[i] = nextRandom(mSpawnMin.x, mSpawnMax.x);
+        mPosY[i] = nextRandom(mSpawnMin.y, mSpawnMax.y);
+        mPosZ[i] = nextRandom(mSpawnMin.z, mSpawnMax.z);
+        mVelX[i] = nextRandom(mVelocityMin.x, mVelocityMax.x);
+        mVelY[i] = nextRandom(mVelocityMin.y, mVelocityMax.y);
+        mVelZ[i] = nextRandom(mVelocityMin.z, mVelocityMax.z);
+        mColR[i] = nextRandom(0.01f, 1.0f);
+        mColG[i] = nextRandom(0.01f, 1.0f);
+        mColB[i] = nextRandom(0.01f, 1.0f);
+        mAge[i] = 0.0f;
+        mLifetime[i] = (mMaxLifetime <= Infinite) ? DeadAge : nextRandom(mMinLifetime, mMaxLifetime);
+    }
+
+    return count;
+}
+
 Mesh* ParticleEmitter::getMesh() const {
     return m_ptGeo;
 }
 
-} // Namespace RenderBackend
+void ParticleEmitter::integrate(size_t begin, size_t end, f32 dt) {
+    if (begin >= end) {
+        return;
+    }
+
+    f32 *posX = &mPosX[0], *posY = &mPosY[0], *posZ = &mPosZ[0];
+    f32 *velX = &mVelX[0], *velY = &mVelY[0], *velZ = &mVelZ[0];
+    f32 *age = &mAge[0];
+
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 accX = _mm_set1_ps(mAcceleration.x * dt);
+    const __m128 accY = _mm_set1_ps(mAcceleration.y * dt);
+    const __m128 accZ = _mm_set1_ps(mAcceleration.z * dt);
+    const __m128 minX = _mm_set1_ps(mBounds.getMin().x), maxX = _mm_set1_ps(mBounds.getMax().x);
+    const __m128 minY = _mm_set1_ps(mBounds.getMin().y), maxY = _mm_set1_ps(mBounds.getMax().y);
+    const __m128 minZ = _mm_set1_ps(mBounds.getMin().z), maxZ = _mm_set1_ps(mBounds.getMax().z);
+    const __m128 deadAge = _mm_set1_ps(DeadAge);
+
+    for (size_t i = begin; i < end; i += 4) {
+        const __m128 vx = _mm_add_ps(_mm_loadu_ps(&velX[i]), accX);
+        const __m128 vy = _mm_add_ps(_mm_loadu_ps(&velY[i]), accY);
+        const __m128 vz = _mm_add_ps(_mm_loadu_ps(&velZ[i]), accZ);
+        _mm_storeu_ps(&velX[i], vx);
+        _mm_storeu_ps(&velY[i], vy);
+        _mm_storeu_ps(&velZ[i], vz);
+
+        const __m128 px = _mm_add_ps(_mm_loadu_ps(&posX[i]), _mm_mul_ps(vx, vdt));
+        const __m128 py = _mm_add_ps(_mm_loadu_ps(&posY[i]), _mm_mul_ps(vy, vdt));
+        const __m128 pz = _mm_add_ps(_mm_loadu_ps(&posZ[i]), _mm_mul_ps(vz, vdt));
+        _mm_storeu_ps(&posX[i], px);
+        _mm_storeu_ps(&posY[i], py);
+        _mm_storeu_ps(&posZ[i], pz);
+
+        __m128 a = _mm_add_ps(_mm_loadu_ps(&age[i]), vdt);
+        if (mUseBounds) {
+            __m128 outside = _mm_or_ps(_mm_cmplt_ps(px, minX), _mm_cmpgt_ps(px, maxX));
+            outside = _mm_or_ps(outside, _mm_or_ps(_mm_cmplt_ps(py, minY), _mm_cmpgt_ps(py, maxY)));
+            outside = _mm_or_ps(outside, _mm_or_ps(_mm_cmplt_ps(pz, minZ), _mm_cmpgt_ps(pz, maxZ)));
+            a = _mm_or_ps(_mm_and_ps(outside, deadAge), _mm_andnot_ps(outside, a));
+        }
+        _mm_storeu_ps(&age[i], a);
+    }
+}
+
+void ParticleEmitter::killDead() {
+    ui32 i = 0;
+    while (i < mNumAlive) {
+        // Skip blocks without dead particles
+        if (0 == (i & 3) && i + 4 <= mNumAlive) {
+            const __m128 dead = _mm_cmpge_ps(_mm_loadu_ps(&mAge[i]), _mm_loadu_ps(&mLifetime[i]));
+            if (0 == _mm_movemask_ps(dead)) {
+                i += 4;
+                continue;
+            }
+        }
+
+        if (mAge[i] >= mLifetime[i]) {
+            --mNumAlive;
+            copyParticle(mNumAlive, i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void ParticleEmitter::writeVertices(size_t begin, size_t end) {
+    if (begin >= end) {
+        return;
+    }
+
+    ColorVert *verts = reinterpret_cast<ColorVert*>(m_ptGeo->getVertexBuffer()->getData());
+    for (size_t i = begin; i < end; ++i) {
+        verts[i].position = glm::vec3(mPosX[i], mPosY[i], mPosZ[i]);
+        verts[i].color0 = glm::vec3(mColR[i], mColG[i], mColB[i]);
+    }
+}
+
+void ParticleEmitter::copyParticle(ui32 from, ui32 to) {
+    if (from == to) {
+        return;
+    }
+
+    mPosX[to] = mPosX[from];
+    mPosY[to] = mPosY[from];
+    mPosZ[to] = mPosZ[from];
+    mVelX[to] = mVelX[from];
+    mVelY[to] = mVelY[from];
+    mVelZ[to] = mVelZ[from];
+    mColR[to] = mColR[from];
+    mColG[to] = mColG[from];
+    mColB[to] = mColB[from];
+    mAge[to] = mAge[from];
+    mLifetime[to] = mLifetime[from];
+}
+
+f32 ParticleEmitter::nextRandom(f32 min, f32 max) {
+    // xorshift32, the upper 24 bits are mapped to [0, 1)
+    ui32 x = mRandomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    mRandomState = x;
+
+    const f32 t = static_cast<f32>(x >> 8) * (1.0f / 16777216.0f);
+    return min + (max - min) * t;
+}
+
+} // Namespace App
 } // Namespace OSRE
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/App/Stage.h>
 #include <osre/App/World.h>
 #include <osre/Common/Logger.h>
+#include <osre/Threading/ThreadPool.h>
 
 namespace OSRE {
 namespace App {
@@ -32,7 +33,8 @@ static const c8 *Tag = "Stage";
 Stage::Stage(const String &stageName) :
         Object(stageName),
         mWorlds(),
-        mRenderWorlds() {
+        mRenderWorlds(),
+        mParallelUpdate(false) {
     // empty
 }
 
@@ -102,12 +104,30 @@ World *Stage::getActiveWorld(size_t index) const {
 }
 
 void Stage::update(Time dt) {
-    for (size_t i=0; i<mRenderWorlds.size(); ++i){
-        World *w = mRenderWorlds[i];
-        if (w != nullptr) {
-            w->update(dt);
+    if (!mParallelUpdate) {
+        for (size_t i=0; i<mRenderWorlds.size(); ++i){
+            World *w = mRenderWorlds[i];
+            if (w != nullptr) {
+                w->update(dt);
+            }
         }
+        return;
     }
+
+    // Worlds may share their camera, so the cameras are updated first
+    for (size_t i = 0; i < mRenderWorlds.size(); ++i) {
+        if (nullptr != mRenderWorlds[i]) {
+            mRenderWorlds[i]->updateActiveCamera(dt);
+        }
+    }
+
+    Threading::ThreadPool::getDefault().parallelFor(mRenderWorlds.size(), 1, [this, dt](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (nullptr != mRenderWorlds[i]) {
+                mRenderWorlds[i]->updateEntities(dt);
+            }
+        }
+    });
 }
 
 void Stage::render(RenderBackend::RenderBackendService *rbService) {
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include <osre/App/Component.h>
 #include <osre/App/TransformComponent.h>
+#include <osre/App/ComponentRegistry.h>
 #include <osre/Common/Ids.h>
 #include <osre/Common/StringUtils.h>
 #include <osre/Common/glm_common.h>
@@ -29,10 +30,19 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/RenderBackend/RenderBackendService.h>
 #include <osre/RenderBackend/RenderCommon.h>
 
+#include <glm/gtx/matrix_decompose.hpp>
+
 namespace OSRE {
 namespace App {
 
 namespace {
+    // Changes with every change of a hierarchy, so the world can cache the roots
+    static std::atomic<ui32> sHierarchyVersion(0);
+
+    static void onHierarchyChanged() {
+        sHierarchyVersion.fetch_add(1, std::memory_order_relaxed);
+    }
+
     static void releaseTransformComponent(TransformComponent *child) {
         osre_assert(child != nullptr);
 
@@ -53,14 +63,22 @@ TransformComponent::TransformComponent(const String &name, Entity *owner, Ids &i
         mMeshRefererenceArray(),
         mIsActive(true),
         mIds(&ids),
+        mTranslation(0.0f),
+        mRotation(1.0f, 0.0f, 0.0f, 0.0f),
+        mScale(1.0f),
         mLocalTransform(1.0f),
-        mWorldTransform(1.0f)  {
+        mWorldTransform(1.0f),
+        mFlags(TransformPool::WorldDirty),
+        mChildDirty(false) {
     if (nullptr != mParent) {
+        mFlags |= TransformPool::HasParent;
         mParent->addChild(this);
     }
+    onHierarchyChanged();
 }
 
 TransformComponent::~TransformComponent() {
+    onHierarchyChanged();
     if (!mChildren.isEmpty()) {
         for (size_t i = 0; i < mChildren.size(); i++) {
             releaseTransformComponent(mChildren[i]);
@@ -72,6 +90,10 @@ TransformComponent::~TransformComponent() {
 void TransformComponent::setParent(TransformComponent *parent) {
     // weak reference
     mParent = parent;
+    uc8 &flags = getState().mFlags;
+    flags = nullptr != mParent ? (flags | TransformPool::HasParent) : (flags & ~TransformPool::HasParent);
+    onHierarchyChanged();
+    setWorldDirty();
 }
 
 TransformComponent *TransformComponent::getParent() const {
@@ -79,9 +101,8 @@ TransformComponent *TransformComponent::getParent() const {
 }
 
 TransformComponent *TransformComponent::createChild(const String &name) {
+    // The constructor will register the child
     TransformComponent *child = new TransformComponent(name, getOwner(), * mIds, this);
-    mChildren.add(child);
-    child->get();
 
     return child;
 }
@@ -90,6 +111,8 @@ void TransformComponent::addChild(TransformComponent *child) {
     if (nullptr != child) {
         mChildren.add(child);
         child->get();
+        onHierarchyChanged();
+        child->setWorldDirty();
     }
 }
 
@@ -107,6 +130,7 @@ bool TransformComponent::removeChild(const String &name, TraverseMode mode) {
                 found = true;
                 mChildren.remove(i);
                 releaseTransformComponent(currentNode);
+                onHierarchyChanged();
                 break;
             }
         }
@@ -177,40 +201,154 @@ void TransformComponent::render(RenderBackendService *renderBackendSrv) {
 }
 
 void TransformComponent::translate(const glm::vec3 &pos) {
-    mLocalTransform = glm::translate(mLocalTransform, pos);
+    // Same as post-multiplying a translation to the local matrix
+    State state = getState();
+    state.mTranslation += state.mRotation * (state.mScale * pos);
+    setLocalDirty();
 }
 
 void TransformComponent::scale(const glm::vec3 &scale) {
-    mLocalTransform = glm::scale(mLocalTransform, scale);
+    getState().mScale *= scale;
+    setLocalDirty();
 }
 
 void TransformComponent::rotate(f32 angle, const glm::vec3 &axis) {
-    mLocalTransform = glm::rotate(mLocalTransform, angle, axis);
+    State state = getState();
+    state.mRotation = glm::normalize(state.mRotation * glm::angleAxis(angle, glm::normalize(axis)));
+    setLocalDirty();
+}
+
+void TransformComponent::setTranslation(const glm::vec3 &translation) {
+    getState().mTranslation = translation;
+    setLocalDirty();
+}
+
+void TransformComponent::setRotation(const glm::quat &rotation) {
+    getState().mRotation = glm::normalize(rotation);
+    setLocalDirty();
 }
 
-void TransformComponent::setRotation(glm::quat &rotation) {
-    glm::toMat4(rotation);
+void TransformComponent::setScale(const glm::vec3 &scale) {
+    getState().mScale = scale;
+    setLocalDirty();
 }
 
 void TransformComponent::setTransformationMatrix(const glm::mat4 &m) {
-    mLocalTransform = m;
+    State state = getState();
+    glm::vec3 skew;
+    glm::vec4 perspective;
+    if (!glm::decompose(m, state.mScale, state.mRotation, state.mTranslation, skew, perspective)) {
+        state.mTranslation = glm::vec3(m[3]);
+        state.mRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        state.mScale = glm::vec3(1.0f);
+    }
+
+    // Keep the exact matrix until the next change of the components
+    state.mLocalTransform = m;
+    state.mFlags &= ~TransformPool::LocalDirty;
+    setWorldDirty();
+}
+
+glm::mat4 TransformComponent::composeMatrix(const glm::vec3 &translation, const glm::quat &rotation, const glm::vec3 &scale) {
+    return glm::translate(glm::mat4(1.0f), translation) * glm::toMat4(rotation) * glm::scale(glm::mat4(1.0f), scale);
 }
 
 const glm::mat4 &TransformComponent::getTransformationMatrix() const {
-    return mLocalTransform;
+    State state = getState();
+    if (0 != (state.mFlags & TransformPool::LocalDirty)) {
+        state.mLocalTransform = composeMatrix(state.mTranslation, state.mRotation, state.mScale);
+        state.mFlags &= ~TransformPool::LocalDirty;
+    }
+
+    return state.mLocalTransform;
 }
 
-glm::mat4 TransformComponent::getWorlTransformMatrix() {
-    glm::mat4 wt(1.0);
-    for (const TransformComponent *node = this; node != nullptr; node = node->getParent()) {
-        wt *= node->getTransformationMatrix();
+const glm::mat4 &TransformComponent::getWorlTransformMatrix() {
+    State state = getState();
+    if (0 != (state.mFlags & TransformPool::WorldDirty)) {
+        if (nullptr != mParent) {
+            state.mWorldTransform = mParent->getWorlTransformMatrix() * getTransformationMatrix();
+        } else {
+            state.mWorldTransform = getTransformationMatrix();
+        }
+        state.mFlags = (state.mFlags & ~TransformPool::WorldDirty) | TransformPool::WorldMoved;
     }
 
-    return wt;
+    return state.mWorldTransform;
+}
+
+bool TransformComponent::isWorldTransformDirty() const {
+    return 0 != (getState().mFlags & TransformPool::WorldDirty);
+}
+
+bool TransformComponent::needsTransformUpdate() const {
+    return 0 != (getState().mFlags & (TransformPool::WorldDirty | TransformPool::WorldMoved)) ||
+            mChildDirty.load(std::memory_order_relaxed);
+}
+
+void TransformComponent::updateWorldTransforms(NodeArray *moved) {
+    if (!needsTransformUpdate()) {
+        return;
+    }
+
+    getWorlTransformMatrix();
+    uc8 &flags = getState().mFlags;
+    if (nullptr != moved && 0 != (flags & TransformPool::WorldMoved)) {
+        moved->add(this);
+        flags &= ~TransformPool::WorldMoved;
+    }
+
+    // Keep the path marked while children are left, which were moved but not collected
+    bool childDirty = false;
+    for (size_t i = 0; i < mChildren.size(); ++i) {
+        if (nullptr != mChildren[i]) {
+            mChildren[i]->updateWorldTransforms(moved);
+            childDirty |= mChildren[i]->needsTransformUpdate();
+        }
+    }
+    mChildDirty.store(childDirty, std::memory_order_relaxed);
+}
+
+void TransformComponent::setLocalDirty() {
+    getState().mFlags |= TransformPool::LocalDirty;
+    setWorldDirty();
+}
+
+void TransformComponent::setWorldDirty() {
+    // Mark the path to the root, so updates can skip clean subtrees
+    if (nullptr != mParent) {
+        mParent->setChildDirty();
+    }
+
+    // When a node is dirty, its whole subtree is dirty as well
+    uc8 &flags = getState().mFlags;
+    if (0 != (flags & TransformPool::WorldDirty)) {
+        return;
+    }
+
+    flags |= TransformPool::WorldDirty;
+    for (size_t i = 0; i < mChildren.size(); ++i) {
+        if (nullptr != mChildren[i]) {
+            mChildren[i]->setWorldDirty();
+        }
+    }
+}
+
+void TransformComponent::setChildDirty() {
+    // Behaviours of siblings may mark a shared parent concurrently, so the flag is atomic
+    for (TransformComponent *node = this; nullptr != node; node = node->mParent) {
+        if (node->mChildDirty.exchange(true, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+}
+
+ui32 TransformComponent::getHierarchyVersion() {
+    return sHierarchyVersion.load(std::memory_order_relaxed);
 }
 
 bool TransformComponent::onUpdate(Time) {
-    mWorldTransform = getWorlTransformMatrix();
+    updateWorldTransforms();
 
     return true;
 }
@@ -219,6 +357,44 @@ bool TransformComponent::onRender(RenderBackendService *) {
     return true;
 }
 
+void TransformComponent::onAttach(ComponentRegistry &registry, ui32 slot) {
+    TransformPool &pool = registry.getTransforms();
+    const ui32 index = pool.add(slot);
+    pool.mTranslation[index] = mTranslation;
+    pool.mRotation[index] = mRotation;
+    pool.mScale[index] = mScale;
+    pool.mLocal[index] = mLocalTransform;
+    pool.mWorld[index] = mWorldTransform;
+    pool.mFlags[index] = mFlags;
+}
+
+void TransformComponent::onDetach(ComponentRegistry &registry, ui32 slot) {
+    TransformPool &pool = registry.getTransforms();
+    const ui32 index = pool.indexOf(slot);
+    mTranslation = pool.mTranslation[index];
+    mRotation = pool.mRotation[index];
+    mScale = pool.mScale[index];
+    mLocalTransform = pool.mLocal[index];
+    mWorldTransform = pool.mWorld[index];
+    mFlags = pool.mFlags[index];
+}
+
+TransformComponent::State TransformComponent::getState() const {
+    // The local members are only used, while the node is not pooled
+    ComponentRegistry *registry = getRegistry();
+    if (nullptr == registry) {
+        TransformComponent *self = const_cast<TransformComponent *>(this);
+        return State{ self->mTranslation, self->mRotation, self->mScale, self->mLocalTransform, self->mWorldTransform, self->mFlags };
+    }
+
+    TransformPool &pool = registry->getTransforms();
+    const ui32 index = pool.indexOf(getSlot());
+    osre_assert(TransformPool::InvalidIndex != index);
+
+    return State{ pool.mTranslation[index], pool.mRotation[index], pool.mScale[index], pool.mLocal[index],
+        pool.mWorld[index], pool.mFlags[index] };
+}
+
 void TransformComponent::addMeshReference(size_t entityMeshIdx) {
     MeshReferenceArray::Iterator it = mMeshRefererenceArray.find(entityMeshIdx);
     if (mMeshRefererenceArray.end() == it) {
@@ -25,9 +25,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Common/Logger.h>
 #include <osre/Common/StringUtils.h>
 #include <osre/Debugging/osre_debugging.h>
+#include <osre/RenderBackend/DbgRenderer.h>
 #include <osre/RenderBackend/MeshProcessor.h>
 #include <osre/RenderBackend/RenderBackendService.h>
+#include <osre/Threading/ThreadPool.h>
 #include <osre/App/CameraComponent.h>
+#include <osre/Profiling/PerformanceCounterRegistry.h>
+
+#include <algorithm>
 
 namespace OSRE {
 namespace App {
@@ -37,19 +42,52 @@ using namespace ::OSRE::RenderBackend;
 
 static constexpr c8 Tag[] = "World";
 
+struct World::OccluderGeometry {
+    cppcore::TArray<glm::vec3> mPositions;
+    cppcore::TArray<ui32> mIndices;
+};
+
 World::World(const String &worldName) :
         Object(worldName),
         mEntities(),
+        mEntityRecords(),
+        mNameIndex(),
         mActiveCamera(nullptr),
         mRoot(nullptr),
         mIds(),
+        mComponentRegistry(),
+        mVisibleSlots(),
         mPipeline(nullptr),
-        mDirtry(false) {
+        mDirtry(false),
+        mUpdateMode(UpdateMode::Serial),
+        mTransformRoots(),
+        mDirtyTransformRoots(),
+        mMovedNodes(),
+        mMovedNodesLock(),
+        mTransformRootsVersion(0),
+        mTransformRootsDirty(true),
+        mFrustumCulling(true),
+        mNumVisible(0),
+        mNumCulled(0),
+        mSpatialIndex(),
+        mProxies(),
+        mRefitFlags(),
+        mRefitEntities(),
+        mSlotHandles(),
+        mNumRefit(0),
+        mVisibleEntities(),
+        mOccluderGeometry(),
+        mOcclusionBuffer(),
+        mOcclusionResult(),
+        mOcclusionCulling(false),
+        mNumOccluded(0) {
     // empty
 }
 
 World::~World() {
-    // empty
+    for (OccluderGeometry *geometry : mOccluderGeometry) {
+        delete geometry;
+    }
 }
 
 void World::addEntity(Entity *entity) {
@@ -57,42 +95,113 @@ void World::addEntity(Entity *entity) {
         osre_debug(Tag, "Pointer to entity are nullptr");
         return;
     }
+    if (getEntity(entity->mHandle) == entity) {
+        osre_debug(Tag, "Entity " + entity->getName() + " already added.");
+        return;
+    }
+
+    EntityRecord record;
+    record.mIndex = static_cast<ui32>(mEntities.size());
+    record.mNameHash = StringUtils::hashName(entity->getName());
+    entity->mHandle = mEntityRecords.add(record);
+    if (!entity->mHandle.isValid()) {
+        osre_error(Tag, "No free entity handle, cannot add " + entity->getName() + ".");
+        return;
+    }
+
     mDirtry = true;
+    mTransformRootsDirty = true;
+    addToNameIndex(entity->mHandle);
     mEntities.add(entity);
+    mProxies.add(BoundingVolumeTree::InvalidProxy);
+    mRefitFlags.add(0);
+    markForRefit(mEntities.size() - 1);
+
+    // Register the already created components in the pools
+    entity->mSlot = mComponentRegistry.allocSlot();
+    mComponentRegistry.getLocalBounds(entity->mSlot) = entity->m_aabb;
+    if (entity->mSlot >= mSlotHandles.size()) {
+        mSlotHandles.resize(entity->mSlot + 1);
+    }
+    mSlotHandles[entity->mSlot] = entity->mHandle;
+    for (size_t i = 0; i < Component::getIndex(ComponentType::MaxNumComponents); ++i) {
+        mComponentRegistry.addComponent(entity->mSlot, entity->getComponent(static_cast<ComponentType>(i)));
+    }
+    mOccluderGeometry.add(nullptr);
 }
 
 Entity *World::findEntity(const String &name) {
-    if (name.empty()) {
-        return nullptr;
+    return getEntityByName(name);
+}
+
+bool World::removeEntity(Entity *entity) {
+    if (nullptr == entity) {
+        return false;
+    }
+    
+    const EntityRecord *record = mEntityRecords.find(entity->mHandle);
+    if (nullptr == record || mEntities[record->mIndex] != entity) {
+        return false;
     }
 
-    Entity *currentEntity{ nullptr };
-    for (size_t i=0; i<mEntities.size(); ++i ) {
-        currentEntity = mEntities[i];
-        if (currentEntity != nullptr) {
-            if (currentEntity->getName() == name) {
-                return currentEntity;
-            }
-        }
+    // Move the last entity into the gap, all arrays are parallel to mEntities
+    const size_t index = record->mIndex;
+    const size_t last = mEntities.size() - 1;
+    if (BoundingVolumeTree::InvalidProxy != mProxies[index]) {
+        mSpatialIndex.destroyProxy(mProxies[index]);
     }
+    delete mOccluderGeometry[index];
+    if (index != last) {
+        mEntities[index] = mEntities[last];
+        mProxies[index] = mProxies[last];
+        mRefitFlags[index] = mRefitFlags[last];
+        mOccluderGeometry[index] = mOccluderGeometry[last];
+        mEntityRecords.find(mEntities[index]->mHandle)->mIndex = static_cast<ui32>(index);
+    }
+    mEntities.removeBack();
+    mProxies.removeBack();
+    mRefitFlags.removeBack();
+    mOccluderGeometry.removeBack();
+
+    removeFromNameIndex(entity->mHandle);
+    mEntityRecords.remove(entity->mHandle);
+    entity->mHandle = EntityHandle();
+    entity->m_aabb = mComponentRegistry.getLocalBounds(entity->mSlot);
+    mSlotHandles[entity->mSlot] = EntityHandle();
+    mComponentRegistry.releaseSlot(entity->mSlot);
+    entity->mSlot = ComponentRegistry::InvalidSlot;
+    mDirtry = true;
+    mTransformRootsDirty = true;
 
-    return nullptr;
+    return true;
 }
 
-bool World::removeEntity(Entity *entity) {
+Entity *World::getEntity(EntityHandle handle) const {
+    const EntityRecord *record = mEntityRecords.find(handle);
+    if (nullptr == record) {
+        return nullptr;
+    }
+
+    return mEntities[record->mIndex];
+}
+
+bool World::renameEntity(Entity *entity, const String &name) {
     if (nullptr == entity) {
         return false;
     }
-    
-    bool found = false;
-    cppcore::TArray<Entity*>::Iterator it = mEntities.find(entity);
-    if (mEntities.end() != it) {
-        mEntities.remove(it);
-        found = true;
-        mDirtry = true;
+
+    EntityRecord *record = mEntityRecords.find(entity->mHandle);
+    if (nullptr == record || mEntities[record->mIndex] != entity) {
+        entity->setName(name);
+        return false;
     }
 
-    return found;
+    removeFromNameIndex(entity->mHandle);
+    entity->setName(name);
+    record->mNameHash = StringUtils::hashName(name);
+    addToNameIndex(entity->mHandle);
+
+    return true;
 }
 
 bool World::setActiveCamera(Camera *camera) {
@@ -110,39 +219,113 @@ Entity *World::getEntityByName(const String &name) const {
         return nullptr;
     }
 
-    Entity *entity = nullptr;
-    for (size_t i = 0; i < mEntities.size(); ++i) {
-        if (nullptr != mEntities[i]) {
-            if (mEntities[i]->getName() == name) {
-                entity = mEntities[i];
-                break;
-            }
+    // Walk the chain of entities with the same hash, names are compared to skip collisions
+    ui32 value = 0;
+    if (!mNameIndex.getValue(StringUtils::hashName(name), value)) {
+        return nullptr;
+    }
+
+    EntityHandle handle;
+    handle.mValue = value;
+    while (handle.isValid()) {
+        const EntityRecord *record = mEntityRecords.find(handle);
+        osre_assert(nullptr != record);
+        Entity *entity = mEntities[record->mIndex];
+        if (entity->getName() == name) {
+            return entity;
         }
+        handle = record->mNextByName;
     }
 
-    return entity;
+    return nullptr;
+}
+
+void World::addToNameIndex(EntityHandle handle) {
+    EntityRecord *record = mEntityRecords.find(handle);
+    osre_assert(nullptr != record);
+    record->mNextByName = EntityHandle();
+    record->mLastByName = handle;
+
+    ui32 value = 0;
+    if (!mNameIndex.getValue(record->mNameHash, value)) {
+        mNameIndex.insert(record->mNameHash, handle.mValue);
+        return;
+    }
+
+    // Append behind the tail stored in the head to keep the first added entity in front
+    EntityHandle head;
+    head.mValue = value;
+    EntityRecord *headRecord = mEntityRecords.find(head);
+    mEntityRecords.find(headRecord->mLastByName)->mNextByName = handle;
+    headRecord->mLastByName = handle;
+}
+
+void World::removeFromNameIndex(EntityHandle handle) {
+    EntityRecord *record = mEntityRecords.find(handle);
+    osre_assert(nullptr != record);
+
+    ui32 value = 0;
+    if (!mNameIndex.getValue(record->mNameHash, value)) {
+        return;
+    }
+
+    EntityHandle head;
+    head.mValue = value;
+    if (head == handle) {
+        // The next entity becomes the head and takes over the tail
+        mNameIndex.remove(record->mNameHash);
+        if (record->mNextByName.isValid()) {
+            mEntityRecords.find(record->mNextByName)->mLastByName = record->mLastByName;
+            mNameIndex.insert(record->mNameHash, record->mNextByName.mValue);
+        }
+    } else {
+        EntityRecord *headRecord = mEntityRecords.find(head);
+        EntityHandle prev = head;
+        EntityRecord *prevRecord = headRecord;
+        while (nullptr != prevRecord && prevRecord->mNextByName != handle) {
+            prev = prevRecord->mNextByName;
+            prevRecord = mEntityRecords.find(prev);
+        }
+        if (nullptr != prevRecord) {
+            prevRecord->mNextByName = record->mNextByName;
+            if (headRecord->mLastByName == handle) {
+                headRecord->mLastByName = prev;
+            }
+        }
+    }
+    record->mNextByName = EntityHandle();
+    record->mLastByName = EntityHandle();
 }
 
 void World::setSceneRoot(TransformComponent *root ) {
     mRoot = root;
     mDirtry = true;
+    mTransformRootsDirty = true;
 }
 
 
 void World::update(Time dt) {
+    updateActiveCamera(dt);
+    updateEntities(dt);
+}
+
+void World::updateActiveCamera(Time dt) {
     if (mActiveCamera != nullptr) {
         mActiveCamera->update(dt);
     }
+}
 
+void World::updateEntities(Time dt) {
     if (mDirtry) {
         updateBoundingTrees();
     }
 
-    for (Entity *entity : mEntities) {
-        if (nullptr == entity) {
-            entity->update(dt);
-        }
-    }
+    // Behaviours are attached per entity, the systems work on the data pools of the registry.
+    // Lights and render data have nothing to update.
+    updateBehaviours(dt);
+    updateTransforms();
+    updateCameras();
+    updateSpatialIndex();
 }
 
 void World::render(RenderBackendService *rbSrv) {
@@ -153,31 +336,421 @@ void World::render(RenderBackendService *rbSrv) {
 
     if (mActiveCamera != nullptr) {
         mActiveCamera->render(rbSrv);
+        DbgRenderer *dbgRenderer = DbgRenderer::getInstance();
+        if (nullptr != dbgRenderer) {
+            dbgRenderer->setViewProjection(mActiveCamera->getView(), mActiveCamera->getProjection());
+        }
+    }
+
+    cullEntities();
+    mVisibleSlots.resize(mComponentRegistry.getSlotCapacity());
+    for (size_t i = 0; i < mVisibleSlots.size(); ++i) {
+        mVisibleSlots[i] = 0;
+    }
+    for (Entity *entity : mVisibleEntities) {
+        mVisibleSlots[entity->getSlot()] = 1;
     }
 
+    // Only the active camera sets the matrices, the meshes come from the render pool
+    renderMeshes(rbSrv);
+
+    rbSrv->endRenderBatch();
+    rbSrv->endPass();
+
+    Profiling::PerformanceCounterRegistry::setCounter("visible_entities", mNumVisible);
+    Profiling::PerformanceCounterRegistry::setCounter("culled_entities", mNumCulled);
+    Profiling::PerformanceCounterRegistry::setCounter("occluded_entities", mNumOccluded);
+}
+
+void World::updateBehaviours(Time dt) {
+    // Behaviours may touch other entities, so only the plain parallel mode runs them concurrently
+    if (UpdateMode::Parallel != mUpdateMode) {
+        for (Entity *entity : mEntities) {
+            if (nullptr != entity) {
+                entity->updateBehaviour(dt);
+            }
+        }
+        return;
+    }
+
+    Threading::ThreadPool::getDefault().parallelFor(mEntities.size(), 16, [this, dt](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (nullptr != mEntities[i]) {
+                mEntities[i]->updateBehaviour(dt);
+            }
+        }
+    });
+}
+
+void World::updateCameras() {
+    // The active camera was updated before, it may belong to another world
+    ui32 activeSlot = ComponentRegistry::InvalidSlot;
+    if (nullptr != mActiveCamera && nullptr != mActiveCamera->getOwner() && this == mActiveCamera->getOwner()->mOwner) {
+        activeSlot = mActiveCamera->getOwner()->getSlot();
+    }
+
+    ComponentRegistry::CameraPool &cameras = mComponentRegistry.getCameras();
+    for (size_t i = 0; i < cameras.size(); ++i) {
+        if (cameras.getKeyAt(i) != activeSlot) {
+            Camera::updateMatrices(cameras.getAt(i));
+        }
+    }
+}
+
+void World::updateTransformRoots() {
+    mTransformRoots.resize(0);
+    auto addRoot = [this](TransformComponent *node) {
+        if (nullptr == node) {
+            return;
+        }
+        while (nullptr != node->getParent()) {
+            node = node->getParent();
+        }
+
+        // Pooled nodes without parent and children are updated from the pool directly
+        if (node->isPooled() && 0 == node->getNumChildren()) {
+            return;
+        }
+        mTransformRoots.add(node);
+    };
+    addRoot(mRoot);
+    mComponentRegistry.forEach(ComponentType::TransformComponentType, [&addRoot](ui32, Component *component) {
+        addRoot(static_cast<TransformComponent *>(component));
+    });
     for (Entity *entity : mEntities) {
         if (nullptr != entity) {
-            entity->render(rbSrv);
+            addRoot(entity->getNode());
         }
     }
 
-    rbSrv->endRenderBatch();
-    rbSrv->endPass();
+    if (!mTransformRoots.isEmpty()) {
+        std::sort(mTransformRoots.begin(), mTransformRoots.end());
+        TransformComponent **last = std::unique(mTransformRoots.begin(), mTransformRoots.end());
+        mTransformRoots.resize(last - mTransformRoots.begin());
+    }
+    mTransformRootsVersion = TransformComponent::getHierarchyVersion();
+    mTransformRootsDirty = false;
 }
 
-void World::updateBoundingTrees() {
-    for (ui32 i = 0; i < mEntities.size(); ++i) {
-        auto *entity = mEntities[i];
-        if (entity == nullptr) {
+void World::updatePooledTransforms() {
+    TransformPool &pool = mComponentRegistry.getTransforms();
+    auto updateRange = [&pool](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            uc8 &flags = pool.mFlags[i];
+            if (0 != (flags & TransformPool::HasParent) || 0 == (flags & TransformPool::WorldDirty)) {
+                continue;
+            }
+            if (0 != (flags & TransformPool::LocalDirty)) {
+                pool.mLocal[i] = TransformComponent::composeMatrix(pool.mTranslation[i], pool.mRotation[i], pool.mScale[i]);
+            }
+            pool.mWorld[i] = pool.mLocal[i];
+            flags = (flags & ~(TransformPool::LocalDirty | TransformPool::WorldDirty)) | TransformPool::WorldMoved;
+        }
+    };
+    if (UpdateMode::Serial == mUpdateMode) {
+        updateRange(0, pool.size());
+    } else {
+        Threading::ThreadPool::getDefault().parallelFor(pool.size(), 256, updateRange);
+    }
+
+    // Children of pooled nodes are updated by the hierarchies, only the roots are collected here
+    for (size_t i = 0; i < pool.size(); ++i) {
+        uc8 &flags = pool.mFlags[i];
+        if (0 == (flags & TransformPool::HasParent) && 0 != (flags & TransformPool::WorldMoved)) {
+            flags &= ~TransformPool::WorldMoved;
+            invalidateSlot(pool.mSlots[i]);
+        }
+    }
+}
+
+void World::updateTransforms() {
+    updatePooledTransforms();
+
+    // The roots will only be searched again, when a hierarchy has changed
+    if (mTransformRootsDirty || mTransformRootsVersion != TransformComponent::getHierarchyVersion()) {
+        updateTransformRoots();
+    }
+
+    mDirtyTransformRoots.resize(0);
+    for (TransformComponent *root : mTransformRoots) {
+        if (root->needsTransformUpdate()) {
+            mDirtyTransformRoots.add(root);
+        }
+    }
+    mMovedNodes.resize(0);
+    if (mDirtyTransformRoots.isEmpty()) {
+        return;
+    }
+
+    if (UpdateMode::Serial == mUpdateMode) {
+        for (TransformComponent *root : mDirtyTransformRoots) {
+            root->updateWorldTransforms(&mMovedNodes);
+        }
+    } else {
+        // Subtrees of different roots are independent, so each root is updated by one worker
+        Threading::ThreadPool::getDefault().parallelFor(mDirtyTransformRoots.size(), 1, [this](size_t begin, size_t end) {
+            TransformComponent::NodeArray moved;
+            for (size_t i = begin; i < end; ++i) {
+                mDirtyTransformRoots[i]->updateWorldTransforms(&moved);
+            }
+            std::lock_guard<std::mutex> guard(mMovedNodesLock);
+            for (TransformComponent *node : moved) {
+                mMovedNodes.add(node);
+            }
+        });
+    }
+
+    // The owner of a moved node needs a new box in the spatial index
+    for (TransformComponent *node : mMovedNodes) {
+        Entity *owner = node->getOwner();
+        if (nullptr != owner && this == owner->mOwner) {
+            invalidateBounds(owner);
+        }
+    }
+}
+
+void World::invalidateSlot(ui32 slot) {
+    if (slot >= mSlotHandles.size()) {
+        return;
+    }
+    const EntityRecord *record = mEntityRecords.find(mSlotHandles[slot]);
+    if (nullptr != record) {
+        markForRefit(record->mIndex);
+    }
+}
+
+void World::invalidateBounds(Entity *entity) {
+    if (nullptr == entity) {
+        return;
+    }
+
+    const EntityRecord *record = mEntityRecords.find(entity->mHandle);
+    if (nullptr == record || mEntities[record->mIndex] != entity) {
+        return;
+    }
+    markForRefit(record->mIndex);
+}
+
+void World::markForRefit(size_t index) {
+    if (0 != mRefitFlags[index]) {
+        return;
+    }
+
+    mRefitFlags[index] = 1;
+    mRefitEntities.add(mEntities[index]->mHandle);
+}
+
+void World::renderMeshes(RenderBackendService *rbSrv) {
+    ComponentRegistry::RenderPool &renderPool = mComponentRegistry.getRenderPool();
+    for (size_t i = 0; i < renderPool.size(); ++i) {
+        RenderData &data = renderPool.getAt(i);
+        if (data.mNumSubmitted < data.mMeshes.size() && 0 != mVisibleSlots[renderPool.getKeyAt(i)]) {
+            RenderComponent::submitMeshes(data, rbSrv);
+        }
+    }
+}
+
+void World::cullEntities() {
+    mVisibleEntities.resize(0);
+    mNumOccluded = 0;
+    if (!mFrustumCulling || nullptr == mActiveCamera) {
+        for (Entity *entity : mEntities) {
+            if (nullptr != entity) {
+                mVisibleEntities.add(entity);
+            }
+        }
+        mNumVisible = static_cast<ui32>(mVisibleEntities.size());
+        mNumCulled = 0;
+        return;
+    }
+
+    // Entities without a valid box are not part of the index and will never be culled
+    ui32 numBounded = 0;
+    for (size_t i = 0; i < mEntities.size(); ++i) {
+        if (nullptr == mEntities[i]) {
+            continue;
+        }
+        if (BoundingVolumeTree::InvalidProxy == mProxies[i]) {
+            mVisibleEntities.add(mEntities[i]);
+        } else {
+            ++numBounded;
+        }
+    }
+    const size_t numUnbounded = mVisibleEntities.size();
+
+    const glm::mat4 viewProjection = mActiveCamera->getProjection() * mActiveCamera->getView();
+    Frustum frustum;
+    frustum.extractFrom(viewProjection);
+    queryEntities(frustum, mVisibleEntities);
+    mNumCulled = numBounded - static_cast<ui32>(mVisibleEntities.size() - numUnbounded);
+    if (mOcclusionCulling) {
+        cullOccludedEntities(frustum, viewProjection);
+    }
+    mNumVisible = static_cast<ui32>(mVisibleEntities.size());
+}
+
+void World::cullOccludedEntities(const Frustum &frustum, const glm::mat4 &viewProjection) {
+    mOcclusionBuffer.beginFrame(viewProjection);
+    bool hasOccluders = false;
+    for (size_t i = 0; i < mEntities.size(); ++i) {
+        Entity *entity = mEntities[i];
+        if (nullptr == entity || !entity->isOccluder() || BoundingVolumeTree::InvalidProxy == mProxies[i]) {
+            continue;
+        }
+        if (!frustum.isIn(mSpatialIndex.getFatAABB(mProxies[i]))) {
+            continue;
+        }
+
+        // The triangles are extracted once and kept in entity space
+        if (nullptr == mOccluderGeometry[i]) {
+            mOccluderGeometry[i] = new OccluderGeometry;
+            RenderComponent *rc = (RenderComponent *)entity->getComponent(ComponentType::RenderComponentType);
+            for (size_t j = 0; nullptr != rc && j < rc->getNumGeometry(); ++j) {
+                MeshProcessor::getTriangles(rc->getMeshAt(j), mOccluderGeometry[i]->mPositions, mOccluderGeometry[i]->mIndices);
+            }
+        }
+
+        const OccluderGeometry *geometry = mOccluderGeometry[i];
+        if (geometry->mIndices.isEmpty()) {
             continue;
         }
-        MeshProcessor processor;
-        RenderComponent *rc = (RenderComponent *)entity->getComponent(ComponentType::RenderComponentType);
-        for (ui32 j = 0; j < rc->getNumGeometry(); ++j) {
-            processor.addMesh(rc->getMeshAt(j));
+        TransformComponent *node = entity->getNode();
+        const glm::mat4 model = nullptr != node ? node->getWorlTransformMatrix() : glm::mat4(1.0f);
+        mOcclusionBuffer.addOccluder(&geometry->mPositions[0], geometry->mPositions.size(), &geometry->mIndices[0],
+                geometry->mIndices.size(), model);
+        hasOccluders = true;
+    }
+
+    if (!hasOccluders) {
+        return;
+    }
+
+    mOcclusionBuffer.rasterize();
+
+    // The buffer is read-only now, so the boxes can be tested in parallel
+    mOcclusionResult.resize(mVisibleEntities.size());
+    Threading::ThreadPool::getDefault().parallelFor(mVisibleEntities.size(), 16, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Entity *entity = mVisibleEntities[i];
+            const AABB &worldAABB = mComponentRegistry.getWorldBounds(entity->getSlot());
+            if (entity->isOccluder() || !worldAABB.isValid()) {
+                mOcclusionResult[i] = 1;
+                continue;
+            }
+            mOcclusionResult[i] = mOcclusionBuffer.isVisible(worldAABB) ? 1 : 0;
+        }
+    });
+
+    size_t numVisible = 0;
+    for (size_t i = 0; i < mVisibleEntities.size(); ++i) {
+        if (0 != mOcclusionResult[i]) {
+            mVisibleEntities[numVisible++] = mVisibleEntities[i];
+        }
+    }
+    mNumOccluded = static_cast<ui32>(mVisibleEntities.size() - numVisible);
+    mVisibleEntities.resize(numVisible);
+}
+
+void World::updateSpatialIndex() {
+    // Only entities with a moved node or a changed box are refit, removed ones are skipped
+    mNumRefit = 0;
+    for (const EntityHandle &handle : mRefitEntities) {
+        const EntityRecord *record = mEntityRecords.find(handle);
+        if (nullptr == record) {
+            continue;
+        }
+
+        const size_t i = record->mIndex;
+        Entity *entity = mEntities[i];
+        mRefitFlags[i] = 0;
+        ++mNumRefit;
+
+        i32 &proxy = mProxies[i];
+        const AABB &aabb = mComponentRegistry.getLocalBounds(entity->mSlot);
+        AABB &worldAABB = mComponentRegistry.getWorldBounds(entity->mSlot);
+        if (!aabb.isValid()) {
+            worldAABB = AABB();
+            if (BoundingVolumeTree::InvalidProxy != proxy) {
+                mSpatialIndex.destroyProxy(proxy);
+                proxy = BoundingVolumeTree::InvalidProxy;
+            }
+            continue;
+        }
+
+        TransformComponent *node = entity->getNode();
+        worldAABB = nullptr != node ? aabb.transform(node->getWorlTransformMatrix()) : aabb;
+        if (BoundingVolumeTree::InvalidProxy == proxy) {
+            proxy = mSpatialIndex.createProxy(worldAABB, entity);
+        } else {
+            mSpatialIndex.moveProxy(proxy, worldAABB);
+        }
+    }
+    mRefitEntities.resize(0);
+}
+
+void World::queryEntities(const Frustum &frustum, cppcore::TArray<Entity*> &entities) const {
+    cppcore::TArray<void*> result;
+    mSpatialIndex.query(frustum, result);
+    toEntities(result, entities);
+}
+
+void World::queryEntities(const AABB &aabb, cppcore::TArray<Entity*> &entities) const {
+    cppcore::TArray<void*> result;
+    mSpatialIndex.query(aabb, result);
+    toEntities(result, entities);
+}
+
+void World::queryEntities(const glm::vec3 &center, f32 radius, cppcore::TArray<Entity*> &entities) const {
+    cppcore::TArray<void*> result;
+    mSpatialIndex.query(center, radius, result);
+    toEntities(result, entities);
+}
+
+Entity *World::pick(const Ray &ray, f32 maxDistance) const {
+    BoundingVolumeTree::RayHit hit;
+    if (!mSpatialIndex.raycast(ray, maxDistance, hit)) {
+        return nullptr;
+    }
+
+    return static_cast<Entity*>(hit.mUserData);
+}
+
+void World::toEntities(const cppcore::TArray<void*> &data, cppcore::TArray<Entity*> &entities) {
+    for (size_t i = 0; i < data.size(); ++i) {
+        entities.add(static_cast<Entity*>(data[i]));
+    }
+}
+
+void World::updateBoundingTrees() {
+    // The entities are independent from each other, so the boxes can be computed in parallel
+    cppcore::TArray<uc8> changed;
+    changed.resize(mEntities.size());
+    Threading::ThreadPool::getDefault().parallelFor(mEntities.size(), 8, [this, &changed](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            changed[i] = 0;
+            auto *entity = mEntities[i];
+            if (entity == nullptr) {
+                continue;
+            }
+            // Entities without meshes keep the box set by the user
+            RenderComponent *rc = (RenderComponent *)entity->getComponent(ComponentType::RenderComponentType);
+            if (rc == nullptr || 0 == rc->getNumGeometry()) {
+                continue;
+            }
+            MeshProcessor processor;
+            for (ui32 j = 0; j < rc->getNumGeometry(); ++j) {
+                processor.addMesh(rc->getMeshAt(j));
+            }
+            AABB &aabb = mComponentRegistry.getLocalBounds(entity->mSlot);
+            if (processor.execute() && aabb != processor.getAABB()) {
+                aabb = processor.getAABB();
+                changed[i] = 1;
+            }
         }
-        if (processor.execute()) {
-            entity->setAABB(processor.getAABB());
+    });
+    for (size_t i = 0; i < changed.size(); ++i) {
+        if (0 != changed[i]) {
+            markForRefit(i);
         }
     }
     mDirtry = false;
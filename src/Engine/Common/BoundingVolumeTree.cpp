@@ -0,0 +1,586 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Common/BoundingVolumeTree.h>
+#include <osre/Debugging/osre_debugging.h>
+
+namespace OSRE {
+namespace Common {
+
+static constexpr c8 Tag[] = "BoundingVolumeTree";
+
+constexpr i32 BoundingVolumeTree::InvalidProxy;
+
+namespace {
+
+// Traversal stack, the inline storage covers balanced trees with billions of proxies
+class NodeStack {
+public:
+    NodeStack() :
+            mNum(0), mOverflow() {
+        // empty
+    }
+
+    void push(i32 index) {
+        if (mNum < InlineSize) {
+            mInline[mNum] = index;
+        } else {
+            mOverflow.add(index);
+        }
+        ++mNum;
+    }
+
+    i32 pop() {
+        --mNum;
+        if (mNum < InlineSize) {
+            return mInline[mNum];
+        }
+        const i32 index = mOverflow.back();
+        mOverflow.removeBack();
+
+        return index;
+    }
+
+    bool isEmpty() const {
+        return 0 == mNum;
+    }
+
+private:
+    static constexpr size_t InlineSize = 64;
+    i32 mInline[InlineSize];
+    size_t mNum;
+    cppcore::TArray<i32> mOverflow;
+};
+
+inline AABB combine(const AABB &a, const AABB &b) {
+    return AABB(glm::min(a.getMin(), b.getMin()), glm::max(a.getMax(), b.getMax()));
+}
+
+inline f32 surfaceArea(const AABB &aabb) {
+    const glm::vec3 d = aabb.getMax() - aabb.getMin();
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+inline bool contains(const AABB &outer, const AABB &inner) {
+    return glm::all(glm::lessThanEqual(outer.getMin(), inner.getMin())) &&
+           glm::all(glm::greaterThanEqual(outer.getMax(), inner.getMax()));
+}
+
+inline bool overlaps(const AABB &a, const AABB &b) {
+    return glm::all(glm::lessThanEqual(a.getMin(), b.getMax())) &&
+           glm::all(glm::greaterThanEqual(a.getMax(), b.getMin()));
+}
+
+inline bool overlaps(const AABB &aabb, const glm::vec3 &center, f32 radius) {
+    const glm::vec3 closest = glm::clamp(center, aabb.getMin(), aabb.getMax());
+    const glm::vec3 diff = closest - center;
+    return glm::dot(diff, diff) <= radius * radius;
+}
+
+// Slab test, returns the entry distance along the normalized direction
+inline bool intersect(const AABB &aabb, const glm::vec3 &origin, const glm::vec3 &invDir, f32 maxDistance, f32 &distance) {
+    const glm::vec3 t0 = (aabb.getMin() - origin) * invDir;
+    const glm::vec3 t1 = (aabb.getMax() - origin) * invDir;
+    const glm::vec3 tMin = glm::min(t0, t1), tMax = glm::max(t0, t1);
+    const f32 tEnter = glm::max(glm::max(tMin.x, tMin.y), glm::max(tMin.z, 0.0f));
+    const f32 tExit = glm::min(glm::min(tMax.x, tMax.y), glm::min(tMax.z, maxDistance));
+    if (tEnter > tExit) {
+        return false;
+    }
+    distance = tEnter;
+
+    return true;
+}
+
+enum class Containment {
+    Outside,
+    Intersecting,
+    Inside
+};
+
+inline Containment classify(const Frustum &frustum, const AABB &aabb) {
+    const glm::vec3 center = aabb.getCenter();
+    const glm::vec3 extent = (aabb.getMax() - aabb.getMin()) * 0.5f;
+    Containment result = Containment::Inside;
+    for (size_t i = 0; i < Frustum::NumPlanes; ++i) {
+        const glm::vec4 &plane = frustum.getPlane(i);
+        const f32 d = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+        const f32 r = glm::abs(plane.x) * extent.x + glm::abs(plane.y) * extent.y + glm::abs(plane.z) * extent.z;
+        if (d + r < 0.0f) {
+            return Containment::Outside;
+        }
+        if (d - r < 0.0f) {
+            result = Containment::Intersecting;
+        }
+    }
+
+    return result;
+}
+
+} // namespace
+
+BoundingVolumeTree::BoundingVolumeTree(f32 margin) :
+        mNodes(),
+        mRoot(InvalidProxy),
+        mFreeList(InvalidProxy),
+        mNumProxies(0),
+        mMargin(margin) {
+    // empty
+}
+
+i32 BoundingVolumeTree::createProxy(const AABB &aabb, void *userData) {
+    const i32 proxyId = allocateNode();
+    const glm::vec3 margin(mMargin);
+    Node &node = mNodes[proxyId];
+    node.mFat = AABB(aabb.getMin() - margin, aabb.getMax() + margin);
+    node.mTight = aabb;
+    node.mUserData = userData;
+    node.mHeight = 0;
+    insertLeaf(proxyId);
+    ++mNumProxies;
+
+    return proxyId;
+}
+
+void BoundingVolumeTree::destroyProxy(i32 proxyId) {
+    if (proxyId < 0 || static_cast<size_t>(proxyId) >= mNodes.size() || !mNodes[proxyId].isLeaf()) {
+        osre_debug(Tag, "Invalid proxy id.");
+        return;
+    }
+
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    --mNumProxies;
+}
+
+bool BoundingVolumeTree::moveProxy(i32 proxyId, const AABB &aabb) {
+    osre_assert(proxyId >= 0 && static_cast<size_t>(proxyId) < mNodes.size());
+    osre_assert(mNodes[proxyId].isLeaf());
+
+    mNodes[proxyId].mTight = aabb;
+    if (contains(mNodes[proxyId].mFat, aabb)) {
+        return false;
+    }
+
+    removeLeaf(proxyId);
+    const glm::vec3 margin(mMargin);
+    mNodes[proxyId].mFat = AABB(aabb.getMin() - margin, aabb.getMax() + margin);
+    insertLeaf(proxyId);
+
+    return true;
+}
+
+void BoundingVolumeTree::query(const AABB &aabb, cppcore::TArray<void*> &result) const {
+    if (InvalidProxy == mRoot) {
+        return;
+    }
+
+    NodeStack stack;
+    stack.push(mRoot);
+    while (!stack.isEmpty()) {
+        const Node &node = mNodes[stack.pop()];
+        if (!overlaps(node.mFat, aabb)) {
+            continue;
+        }
+        if (node.isLeaf()) {
+            if (overlaps(node.mTight, aabb)) {
+                result.add(node.mUserData);
+            }
+        } else {
+            stack.push(node.mChild1);
+            stack.push(node.mChild2);
+        }
+    }
+}
+
+void BoundingVolumeTree::query(const Frustum &frustum, cppcore::TArray<void*> &result) const {
+    if (InvalidProxy == mRoot) {
+        return;
+    }
+
+    // The leaves reached by the traversal are tested together, four boxes at a time
+    AABBBatch leafBoxes;
+    cppcore::TArray<void*> leafData;
+    NodeStack stack;
+    stack.push(mRoot);
+    while (!stack.isEmpty()) {
+        const i32 index = stack.pop();
+        const Node &node = mNodes[index];
+        if (node.isLeaf()) {
+            leafBoxes.add(node.mTight);
+            leafData.add(node.mUserData);
+            continue;
+        }
+
+        const Containment containment = classify(frustum, node.mFat);
+        if (Containment::Inside == containment) {
+            // No more plane tests needed for the whole subtree
+            collectLeaves(index, result);
+        } else if (Containment::Intersecting == containment) {
+            stack.push(node.mChild1);
+            stack.push(node.mChild2);
+        }
+    }
+
+    cppcore::TArray<uc8> visible;
+    frustum.cullBatch(leafBoxes, visible);
+    for (size_t i = 0; i < visible.size(); ++i) {
+        if (0 != visible[i]) {
+            result.add(leafData[i]);
+        }
+    }
+}
+
+void BoundingVolumeTree::query(const glm::vec3 &center, f32 radius, cppcore::TArray<void*> &result) const {
+    if (InvalidProxy == mRoot) {
+        return;
+    }
+
+    NodeStack stack;
+    stack.push(mRoot);
+    while (!stack.isEmpty()) {
+        const Node &node = mNodes[stack.pop()];
+        if (!overlaps(node.mFat, center, radius)) {
+            continue;
+        }
+        if (node.isLeaf()) {
+            if (overlaps(node.mTight, center, radius)) {
+                result.add(node.mUserData);
+            }
+        } else {
+            stack.push(node.mChild1);
+            stack.push(node.mChild2);
+        }
+    }
+}
+
+bool BoundingVolumeTree::raycast(const Ray &ray, f32 maxDistance, RayHit &hit) const {
+    const f32 len = glm::length(ray.getDirection());
+    if (InvalidProxy == mRoot || 0.0f == len) {
+        return false;
+    }
+
+    const glm::vec3 &origin = ray.getOrigin();
+    const glm::vec3 invDir = 1.0f / (ray.getDirection() / len);
+    f32 best = maxDistance;
+    void *bestData = nullptr;
+    bool found = false;
+    NodeStack stack;
+    stack.push(mRoot);
+    while (!stack.isEmpty()) {
+        const Node &node = mNodes[stack.pop()];
+        f32 distance = 0.0f;
+        if (!intersect(node.mFat, origin, invDir, best, distance)) {
+            continue;
+        }
+        if (node.isLeaf()) {
+            if (intersect(node.mTight, origin, invDir, best, distance)) {
+                best = distance;
+                bestData = node.mUserData;
+                found = true;
+            }
+        } else {
+            stack.push(node.mChild1);
+            stack.push(node.mChild2);
+        }
+    }
+
+    if (found) {
+        hit.mUserData = bestData;
+        hit.mDistance = best;
+    }
+
+    return found;
+}
+
+void BoundingVolumeTree::clear() {
+    mNodes.clear();
+    mRoot = InvalidProxy;
+    mFreeList = InvalidProxy;
+    mNumProxies = 0;
+}
+
+bool BoundingVolumeTree::validate() const {
+    if (InvalidProxy == mRoot) {
+        return 0 == mNumProxies;
+    }
+    if (InvalidProxy != mNodes[mRoot].mParent) {
+        return false;
+    }
+
+    return validate(mRoot);
+}
+
+i32 BoundingVolumeTree::allocateNode() {
+    i32 index = mFreeList;
+    if (InvalidProxy == index) {
+        index = static_cast<i32>(mNodes.size());
+        mNodes.add(Node());
+    } else {
+        mFreeList = mNodes[index].mParent;
+    }
+
+    Node &node = mNodes[index];
+    node.mFat.reset();
+    node.mTight.reset();
+    node.mUserData = nullptr;
+    node.mParent = InvalidProxy;
+    node.mChild1 = InvalidProxy;
+    node.mChild2 = InvalidProxy;
+    node.mHeight = 0;
+
+    return index;
+}
+
+void BoundingVolumeTree::freeNode(i32 index) {
+    mNodes[index].mParent = mFreeList;
+    mNodes[index].mHeight = -1;
+    mFreeList = index;
+}
+
+void BoundingVolumeTree::insertLeaf(i32 leaf) {
+    if (InvalidProxy == mRoot) {
+        mRoot = leaf;
+        mNodes[leaf].mParent = InvalidProxy;
+        return;
+    }
+
+    // Descend along the cheapest path by the surface area heuristic
+    const AABB leafBox = mNodes[leaf].mFat;
+    i32 index = mRoot;
+    while (!mNodes[index].isLeaf()) {
+        const Node &node = mNodes[index];
+        const f32 area = surfaceArea(node.mFat);
+        const f32 combinedArea = surfaceArea(combine(node.mFat, leafBox));
+        const f32 cost = 2.0f * combinedArea;
+        const f32 inheritanceCost = 2.0f * (combinedArea - area);
+
+        f32 childCost[2];
+        const i32 children[2] = { node.mChild1, node.mChild2 };
+        for (ui32 i = 0; i < 2; ++i) {
+            const Node &child = mNodes[children[i]];
+            childCost[i] = surfaceArea(combine(child.mFat, leafBox)) + inheritanceCost;
+            if (!child.isLeaf()) {
+                childCost[i] -= surfaceArea(child.mFat);
+            }
+        }
+
+        if (cost < childCost[0] && cost < childCost[1]) {
+            break;
+        }
+        index = childCost[0] < childCost[1] ? children[0] : children[1];
+    }
+
+    const i32 sibling = index;
+    const i32 oldParent = mNodes[sibling].mParent;
+    const i32 newParent = allocateNode();
+    mNodes[newParent].mParent = oldParent;
+    mNodes[newParent].mFat = combine(leafBox, mNodes[sibling].mFat);
+    mNodes[newParent].mHeight = mNodes[sibling].mHeight + 1;
+    mNodes[newParent].mChild1 = sibling;
+    mNodes[newParent].mChild2 = leaf;
+    mNodes[sibling].mParent = newParent;
+    mNodes[leaf].mParent = newParent;
+    if (InvalidProxy != oldParent) {
+        if (mNodes[oldParent].mChild1 == sibling) {
+            mNodes[oldParent].mChild1 = newParent;
+        } else {
+            mNodes[oldParent].mChild2 = newParent;
+        }
+    } else {
+        mRoot = newParent;
+    }
+
+    refit(mNodes[leaf].mParent);
+}
+
+void BoundingVolumeTree::removeLeaf(i32 leaf) {
+    if (leaf == mRoot) {
+        mRoot = InvalidProxy;
+        return;
+    }
+
+    const i32 parent = mNodes[leaf].mParent;
+    const i32 grandParent = mNodes[parent].mParent;
+    const i32 sibling = mNodes[parent].mChild1 == leaf ? mNodes[parent].mChild2 : mNodes[parent].mChild1;
+    if (InvalidProxy != grandParent) {
+        if (mNodes[grandParent].mChild1 == parent) {
+            mNodes[grandParent].mChild1 = sibling;
+        } else {
+            mNodes[grandParent].mChild2 = sibling;
+        }
+        mNodes[sibling].mParent = grandParent;
+        freeNode(parent);
+        refit(grandParent);
+    } else {
+        mRoot = sibling;
+        mNodes[sibling].mParent = InvalidProxy;
+        freeNode(parent);
+    }
+}
+
+void BoundingVolumeTree::refit(i32 index) {
+    while (InvalidProxy != index) {
+        index = balance(index);
+        Node &node = mNodes[index];
+        const Node &child1 = mNodes[node.mChild1];
+        const Node &child2 = mNodes[node.mChild2];
+        node.mHeight = 1 + glm::max(child1.mHeight, child2.mHeight);
+        node.mFat = combine(child1.mFat, child2.mFat);
+        index = node.mParent;
+    }
+}
+
+i32 BoundingVolumeTree::balance(i32 iA) {
+    Node &a = mNodes[iA];
+    if (a.isLeaf() || a.mHeight < 2) {
+        return iA;
+    }
+
+    const i32 iB = a.mChild1;
+    const i32 iC = a.mChild2;
+    Node &b = mNodes[iB];
+    Node &c = mNodes[iC];
+    const i32 diff = c.mHeight - b.mHeight;
+
+    // Rotate C up
+    if (diff > 1) {
+        const i32 iF = c.mChild1;
+        const i32 iG = c.mChild2;
+        Node &f = mNodes[iF];
+        Node &g = mNodes[iG];
+
+        c.mChild1 = iA;
+        c.mParent = a.mParent;
+        a.mParent = iC;
+        if (InvalidProxy != c.mParent) {
+            if (mNodes[c.mParent].mChild1 == iA) {
+                mNodes[c.mParent].mChild1 = iC;
+            } else {
+                mNodes[c.mParent].mChild2 = iC;
+            }
+        } else {
+            mRoot = iC;
+        }
+
+        if (f.mHeight > g.mHeight) {
+            c.mChild2 = iF;
+            a.mChild2 = iG;
+            g.mParent = iA;
+            a.mFat = combine(b.mFat, g.mFat);
+            c.mFat = combine(a.mFat, f.mFat);
+            a.mHeight = 1 + glm::max(b.mHeight, g.mHeight);
+            c.mHeight = 1 + glm::max(a.mHeight, f.mHeight);
+        } else {
+            c.mChild2 = iG;
+            a.mChild2 = iF;
+            f.mParent = iA;
+            a.mFat = combine(b.mFat, f.mFat);
+            c.mFat = combine(a.mFat, g.mFat);
+            a.mHeight = 1 + glm::max(b.mHeight, f.mHeight);
+            c.mHeight = 1 + glm::max(a.mHeight, g.mHeight);
+        }
+
+        return iC;
+    }
+
+    // Rotate B up
+    if (diff < -1) {
+        const i32 iD = b.mChild1;
+        const i32 iE = b.mChild2;
+        Node &d = mNodes[iD];
+        Node &e = mNodes[iE];
+
+        b.mChild1 = iA;
+        b.mParent = a.mParent;
+        a.mParent = iB;
+        if (InvalidProxy != b.mParent) {
+            if (mNodes[b.mParent].mChild1 == iA) {
+                mNodes[b.mParent].mChild1 = iB;
+            } else {
+                mNodes[b.mParent].mChild2 = iB;
+            }
+        } else {
+            mRoot = iB;
+        }
+
+        if (d.mHeight > e.mHeight) {
+            b.mChild2 = iD;
+            a.mChild1 = iE;
+            e.mParent = iA;
+            a.mFat = combine(c.mFat, e.mFat);
+            b.mFat = combine(a.mFat, d.mFat);
+            a.mHeight = 1 + glm::max(c.mHeight, e.mHeight);
+            b.mHeight = 1 + glm::max(a.mHeight, d.mHeight);
+        } else {
+            b.mChild2 = iE;
+            a.mChild1 = iD;
+            d.mParent = iA;
+            a.mFat = combine(c.mFat, d.mFat);
+            b.mFat = combine(a.mFat, e.mFat);
+            a.mHeight = 1 + glm::max(c.mHeight, d.mHeight);
+            b.mHeight = 1 + glm::max(a.mHeight, e.mHeight);
+        }
+
+        return iB;
+    }
+
+    return iA;
+}
+
+void BoundingVolumeTree::collectLeaves(i32 index, cppcore::TArray<void*> &result) const {
+    NodeStack stack;
+    stack.push(index);
+    while (!stack.isEmpty()) {
+        const Node &node = mNodes[stack.pop()];
+        if (node.isLeaf()) {
+            result.add(node.mUserData);
+        } else {
+            stack.push(node.mChild1);
+            stack.push(node.mChild2);
+        }
+    }
+}
+
+bool BoundingVolumeTree::validate(i32 index) const {
+    const Node &node = mNodes[index];
+    if (node.isLeaf()) {
+        return 0 == node.mHeight && InvalidProxy == node.mChild2;
+    }
+
+    const Node &child1 = mNodes[node.mChild1];
+    const Node &child2 = mNodes[node.mChild2];
+    if (child1.mParent != index || child2.mParent != index) {
+        return false;
+    }
+    if (node.mHeight != 1 + glm::max(child1.mHeight, child2.mHeight)) {
+        return false;
+    }
+    if (!contains(node.mFat, child1.mFat) || !contains(node.mFat, child2.mFat)) {
+        return false;
+    }
+
+    return validate(node.mChild1) && validate(node.mChild2);
+}
+
+} // namespace Common
+} // namespace OSRE
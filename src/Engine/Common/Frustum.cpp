@@ -0,0 +1,92 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Common/Frustum.h>
+
+namespace OSRE {
+namespace Common {
+
+void AABBBatch::add(const AABB &aabb) {
+    const glm::vec3 &min = aabb.getMin(), &max = aabb.getMax();
+    mMinX.add(min.x);
+    mMinY.add(min.y);
+    mMinZ.add(min.z);
+    mMaxX.add(max.x);
+    mMaxY.add(max.y);
+    mMaxZ.add(max.z);
+}
+
+void AABBBatch::clear() {
+    mMinX.resize(0);
+    mMinY.resize(0);
+    mMinZ.resize(0);
+    mMaxX.resize(0);
+    mMaxY.resize(0);
+    mMaxZ.resize(0);
+}
+
+static inline __m128 absPs(__m128 v) {
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+
+void Frustum::cullBatch(const AABBBatch &batch, cppcore::TArray<uc8> &visible) const {
+    const size_t numBoxes = batch.size();
+    visible.resize(numBoxes);
+    if (0 == numBoxes) {
+        return;
+    }
+
+    const __m128 half = _mm_set1_ps(0.5f);
+    size_t i = 0;
+    for (; i + 4 <= numBoxes; i += 4) {
+        const __m128 minX = _mm_loadu_ps(&batch.mMinX[i]), maxX = _mm_loadu_ps(&batch.mMaxX[i]);
+        const __m128 minY = _mm_loadu_ps(&batch.mMinY[i]), maxY = _mm_loadu_ps(&batch.mMaxY[i]);
+        const __m128 minZ = _mm_loadu_ps(&batch.mMinZ[i]), maxZ = _mm_loadu_ps(&batch.mMaxZ[i]);
+        const __m128 cx = _mm_mul_ps(_mm_add_ps(minX, maxX), half), ex = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+        const __m128 cy = _mm_mul_ps(_mm_add_ps(minY, maxY), half), ey = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+        const __m128 cz = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half), ez = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+
+        __m128 outside = _mm_setzero_ps();
+        for (const auto &plane : mPlanes) {
+            const __m128 nx = _mm_set1_ps(plane.x), ny = _mm_set1_ps(plane.y), nz = _mm_set1_ps(plane.z);
+            const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)),
+                    _mm_add_ps(_mm_mul_ps(nz, cz), _mm_set1_ps(plane.w)));
+            const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absPs(nx), ex), _mm_mul_ps(absPs(ny), ey)),
+                    _mm_mul_ps(absPs(nz), ez));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), _mm_setzero_ps()));
+        }
+
+        const i32 mask = _mm_movemask_ps(outside);
+        for (ui32 j = 0; j < 4; ++j) {
+            visible[i + j] = (mask & (1 << j)) ? 0 : 1;
+        }
+    }
+
+    for (; i < numBoxes; ++i) {
+        const AABB aabb(glm::vec3(batch.mMinX[i], batch.mMinY[i], batch.mMinZ[i]),
+                glm::vec3(batch.mMaxX[i], batch.mMaxY[i], batch.mMaxZ[i]));
+        visible[i] = isIn(aabb) ? 1 : 0;
+    }
+}
+
+} // namespace Common
+} // namespace OSRE
@@ -0,0 +1,173 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Common/MinMaxKernel.h>
+#include <osre/Threading/ThreadPool.h>
+
+#ifdef __AVX__
+#   include <immintrin.h>
+#endif
+
+namespace OSRE {
+namespace Common {
+
+using namespace ::OSRE::Threading;
+
+// Loads x, y, z of a position, the w-lane is undefined. Reads 16 bytes only when they are
+// guaranteed to be inside of the buffer.
+static inline __m128 loadPosition(const uc8 *ptr, bool canReadFour) {
+    if (canReadFour) {
+        return _mm_loadu_ps(reinterpret_cast<const f32 *>(ptr));
+    }
+    const f32 *p = reinterpret_cast<const f32 *>(ptr);
+    return _mm_setr_ps(p[0], p[1], p[2], 0.0f);
+}
+
+static inline void storeMinMax(__m128 vmin, __m128 vmax, glm::vec3 &min, glm::vec3 &max) {
+    alignas(16) f32 resMin[4], resMax[4];
+    _mm_store_ps(resMin, vmin);
+    _mm_store_ps(resMax, vmax);
+    for (ui32 i = 0; i < 3; ++i) {
+        if (resMin[i] < min[i]) {
+            min[i] = resMin[i];
+        }
+        if (resMax[i] > max[i]) {
+            max[i] = resMax[i];
+        }
+    }
+}
+
+void MinMaxKernel::computeScalar(const void *data, size_t numVertices, size_t stride, glm::vec3 &min, glm::vec3 &max) {
+    if (nullptr == data || 0 == numVertices) {
+        return;
+    }
+
+    const uc8 *ptr = static_cast<const uc8 *>(data);
+    for (size_t i = 0; i < numVertices; ++i) {
+        const f32 *pos = reinterpret_cast<const f32 *>(ptr);
+        for (ui32 j = 0; j < 3; ++j) {
+            if (pos[j] < min[j]) {
+                min[j] = pos[j];
+            }
+            if (pos[j] > max[j]) {
+                max[j] = pos[j];
+            }
+        }
+        ptr += stride;
+    }
+}
+
+void MinMaxKernel::compute(const void *data, size_t numVertices, size_t stride, glm::vec3 &min, glm::vec3 &max) {
+    if (nullptr == data || 0 == numVertices) {
+        return;
+    }
+
+    const uc8 *ptr = static_cast<const uc8 *>(data);
+    const bool wide = stride >= 4 * sizeof(f32);
+
+    // The last vertex must not be read with 16 bytes, there may be no data behind it
+    const size_t numBulk = numVertices - 1;
+    size_t i = 0;
+
+#ifdef __AVX__
+    __m256 vmin8 = _mm256_set1_ps(AABB::Invalid);
+    __m256 vmax8 = _mm256_set1_ps(-AABB::Invalid);
+    if (wide) {
+        for (; i + 2 <= numBulk; i += 2) {
+            const __m128 lo = _mm_loadu_ps(reinterpret_cast<const f32 *>(ptr));
+            const __m128 hi = _mm_loadu_ps(reinterpret_cast<const f32 *>(ptr + stride));
+            const __m256 v = _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+            vmin8 = _mm256_min_ps(vmin8, v);
+            vmax8 = _mm256_max_ps(vmax8, v);
+            ptr += 2 * stride;
+        }
+    }
+    __m128 vmin = _mm_min_ps(_mm256_castps256_ps128(vmin8), _mm256_extractf128_ps(vmin8, 1));
+    __m128 vmax = _mm_max_ps(_mm256_castps256_ps128(vmax8), _mm256_extractf128_ps(vmax8, 1));
+#else
+    __m128 vmin = _mm_set1_ps(AABB::Invalid), vmin1 = vmin;
+    __m128 vmax = _mm_set1_ps(-AABB::Invalid), vmax1 = vmax;
+    if (wide) {
+        // two independent accumulators to hide the latency of min / max
+        for (; i + 2 <= numBulk; i += 2) {
+            const __m128 v0 = _mm_loadu_ps(reinterpret_cast<const f32 *>(ptr));
+            const __m128 v1 = _mm_loadu_ps(reinterpret_cast<const f32 *>(ptr + stride));
+            vmin = _mm_min_ps(vmin, v0);
+            vmax = _mm_max_ps(vmax, v0);
+            vmin1 = _mm_min_ps(vmin1, v1);
+            vmax1 = _mm_max_ps(vmax1, v1);
+            ptr += 2 * stride;
+        }
+    }
+    vmin = _mm_min_ps(vmin, vmin1);
+    vmax = _mm_max_ps(vmax, vmax1);
+#endif
+
+    for (; i < numVertices; ++i) {
+        const __m128 v = loadPosition(ptr, wide && i < numBulk);
+        vmin = _mm_min_ps(vmin, v);
+        vmax = _mm_max_ps(vmax, v);
+        ptr += stride;
+    }
+
+    storeMinMax(vmin, vmax, min, max);
+}
+
+void MinMaxKernel::computeParallel(const void *data, size_t numVertices, size_t stride, glm::vec3 &min, glm::vec3 &max) {
+    if (numVertices < ParallelThreshold) {
+        compute(data, numVertices, stride, min, max);
+        return;
+    }
+
+    ThreadPool &pool = ThreadPool::getDefault();
+    const size_t numChunks = pool.getNumWorkers() + 1;
+    const size_t chunkSize = (numVertices + numChunks - 1) / numChunks;
+    cppcore::TArray<AABB> partial;
+    partial.resize(numChunks);
+    const uc8 *ptr = static_cast<const uc8 *>(data);
+    pool.parallelFor(numChunks, 1, [&](size_t begin, size_t end) {
+        for (size_t chunk = begin; chunk < end; ++chunk) {
+            const size_t first = chunk * chunkSize;
+            if (first >= numVertices) {
+                continue;
+            }
+            const size_t count = (first + chunkSize) < numVertices ? chunkSize : numVertices - first;
+            glm::vec3 chunkMin = partial[chunk].getMin(), chunkMax = partial[chunk].getMax();
+            compute(ptr + first * stride, count, stride, chunkMin, chunkMax);
+            partial[chunk].set(chunkMin, chunkMax);
+        }
+    });
+
+    for (size_t i = 0; i < partial.size(); ++i) {
+        min = glm::min(min, partial[i].getMin());
+        max = glm::max(max, partial[i].getMax());
+    }
+}
+
+void MinMaxKernel::merge(AABB &aabb, const void *data, size_t numVertices, size_t stride) {
+    glm::vec3 min = aabb.getMin(), max = aabb.getMax();
+    computeParallel(data, numVertices, stride, min, max);
+    aabb.set(min, max);
+}
+
+} // Namespace Common
+} // Namespace OSRE
@@ -0,0 +1,292 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Common/OcclusionBuffer.h>
+#include <osre/Threading/ThreadPool.h>
+
+#include <utility>
+
+namespace OSRE {
+namespace Common {
+
+static constexpr f32 FarDepth = 1.0f;
+static constexpr f32 MinArea = 1.0e-6f;
+static constexpr f32 MinW = 1.0e-6f;
+
+OcclusionBuffer::OcclusionBuffer(ui32 width, ui32 height) :
+        mWidth(0),
+        mHeight(0),
+        mNumTilesX(0),
+        mNumTilesY(0),
+        mViewProjection(1.0f),
+        mDepth(),
+        mTileMax(),
+        mTriangles(),
+        mClipVertices() {
+    resize(width, height);
+}
+
+void OcclusionBuffer::resize(ui32 width, ui32 height) {
+    mNumTilesX = (width + TileWidth - 1) / TileWidth;
+    mNumTilesY = (height + TileHeight - 1) / TileHeight;
+    mWidth = mNumTilesX * TileWidth;
+    mHeight = mNumTilesY * TileHeight;
+    mDepth.resize(mWidth * mHeight);
+    mTileMax.resize(mNumTilesX * mNumTilesY);
+    beginFrame(mViewProjection);
+}
+
+void OcclusionBuffer::beginFrame(const glm::mat4 &viewProjection) {
+    mViewProjection = viewProjection;
+    mTriangles.resize(0);
+    for (size_t i = 0; i < mDepth.size(); ++i) {
+        mDepth[i] = FarDepth;
+    }
+    for (size_t i = 0; i < mTileMax.size(); ++i) {
+        mTileMax[i] = FarDepth;
+    }
+}
+
+void OcclusionBuffer::addOccluder(const glm::vec3 *positions, size_t numPositions, const ui32 *indices,
+        size_t numIndices, const glm::mat4 &model) {
+    if (nullptr == positions || nullptr == indices || 0 == numPositions) {
+        return;
+    }
+
+    const glm::mat4 mvp = mViewProjection * model;
+    mClipVertices.resize(numPositions);
+    for (size_t i = 0; i < numPositions; ++i) {
+        mClipVertices[i] = mvp * glm::vec4(positions[i], 1.0f);
+    }
+
+    for (size_t i = 0; i + 2 < numIndices; i += 3) {
+        if (indices[i] >= numPositions || indices[i + 1] >= numPositions || indices[i + 2] >= numPositions) {
+            continue;
+        }
+        clipTriangle(mClipVertices[indices[i]], mClipVertices[indices[i + 1]], mClipVertices[indices[i + 2]]);
+    }
+}
+
+void OcclusionBuffer::rasterize() {
+    Threading::ThreadPool::getDefault().parallelFor(mNumTilesY, 1, [this](size_t begin, size_t end) {
+        for (size_t tileRow = begin; tileRow < end; ++tileRow) {
+            rasterizeBand(static_cast<ui32>(tileRow));
+        }
+    });
+}
+
+bool OcclusionBuffer::isVisible(const AABB &aabb) const {
+    const glm::vec3 &min = aabb.getMin(), &max = aabb.getMax();
+    glm::vec2 screenMin(mWidth, mHeight), screenMax(0.0f);
+    f32 minDepth = FarDepth;
+    for (ui32 i = 0; i < 8; ++i) {
+        const glm::vec3 corner((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z);
+        const glm::vec4 clip = mViewProjection * glm::vec4(corner, 1.0f);
+
+        // Crossing the near plane, nothing can be said about it
+        if (clip.w < MinW || clip.z < -clip.w) {
+            return true;
+        }
+        const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        const glm::vec2 screen((ndc.x * 0.5f + 0.5f) * mWidth, (ndc.y * 0.5f + 0.5f) * mHeight);
+        screenMin = glm::min(screenMin, screen);
+        screenMax = glm::max(screenMax, screen);
+        minDepth = glm::min(minDepth, ndc.z);
+    }
+
+    const i32 x0 = glm::max(0, static_cast<i32>(glm::floor(screenMin.x)));
+    const i32 y0 = glm::max(0, static_cast<i32>(glm::floor(screenMin.y)));
+    const i32 x1 = glm::min(static_cast<i32>(mWidth) - 1, static_cast<i32>(glm::ceil(screenMax.x)) - 1);
+    const i32 y1 = glm::min(static_cast<i32>(mHeight) - 1, static_cast<i32>(glm::ceil(screenMax.y)) - 1);
+    if (x0 > x1 || y0 > y1) {
+        return true;
+    }
+
+    const __m128 boxDepth = _mm_set1_ps(minDepth);
+    for (i32 ty = y0 / TileHeight; ty <= y1 / static_cast<i32>(TileHeight); ++ty) {
+        for (i32 tx = x0 / TileWidth; tx <= x1 / static_cast<i32>(TileWidth); ++tx) {
+            // The whole tile is nearer than the box
+            if (minDepth >= mTileMax[ty * mNumTilesX + tx]) {
+                continue;
+            }
+
+            const i32 px0 = glm::max(x0, tx * static_cast<i32>(TileWidth));
+            const i32 px1 = glm::min(x1, (tx + 1) * static_cast<i32>(TileWidth) - 1);
+            const i32 py0 = glm::max(y0, ty * static_cast<i32>(TileHeight));
+            const i32 py1 = glm::min(y1, (ty + 1) * static_cast<i32>(TileHeight) - 1);
+            for (i32 y = py0; y <= py1; ++y) {
+                const f32 *row = &mDepth[y * mWidth];
+                i32 x = px0;
+                for (; x + 3 <= px1; x += 4) {
+                    if (0 != _mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(row + x), boxDepth))) {
+                        return true;
+                    }
+                }
+                for (; x <= px1; ++x) {
+                    if (row[x] > minDepth) {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+void OcclusionBuffer::clipTriangle(const glm::vec4 &c0, const glm::vec4 &c1, const glm::vec4 &c2) {
+    // Trivial reject against the frustum planes
+    if ((c0.x > c0.w && c1.x > c1.w && c2.x > c2.w) || (c0.x < -c0.w && c1.x < -c1.w && c2.x < -c2.w) ||
+            (c0.y > c0.w && c1.y > c1.w && c2.y > c2.w) || (c0.y < -c0.w && c1.y < -c1.w && c2.y < -c2.w) ||
+            (c0.z > c0.w && c1.z > c1.w && c2.z > c2.w)) {
+        return;
+    }
+
+    const glm::vec4 in[3] = { c0, c1, c2 };
+    const f32 d[3] = { c0.z + c0.w, c1.z + c1.w, c2.z + c2.w };
+    if (d[0] >= 0.0f && d[1] >= 0.0f && d[2] >= 0.0f) {
+        setupTriangle(c0, c1, c2);
+        return;
+    }
+
+    // Clip against the near plane, the result is a triangle or a quad
+    glm::vec4 out[4];
+    ui32 numOut = 0;
+    for (ui32 i = 0; i < 3; ++i) {
+        const ui32 j = (i + 1) % 3;
+        if (d[i] >= 0.0f) {
+            out[numOut++] = in[i];
+        }
+        if ((d[i] >= 0.0f) != (d[j] >= 0.0f)) {
+            const f32 t = d[i] / (d[i] - d[j]);
+            out[numOut++] = in[i] + (in[j] - in[i]) * t;
+        }
+    }
+
+    for (ui32 i = 2; i < numOut; ++i) {
+        setupTriangle(out[0], out[i - 1], out[i]);
+    }
+}
+
+void OcclusionBuffer::setupTriangle(const glm::vec4 &c0, const glm::vec4 &c1, const glm::vec4 &c2) {
+    if (c0.w < MinW || c1.w < MinW || c2.w < MinW) {
+        return;
+    }
+
+    glm::vec3 v[3];
+    const glm::vec4 *clip[3] = { &c0, &c1, &c2 };
+    for (ui32 i = 0; i < 3; ++i) {
+        const f32 invW = 1.0f / clip[i]->w;
+        v[i] = glm::vec3((clip[i]->x * invW * 0.5f + 0.5f) * mWidth, (clip[i]->y * invW * 0.5f + 0.5f) * mHeight,
+                clip[i]->z * invW);
+    }
+
+    f32 area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+    if (glm::abs(area) < MinArea) {
+        return;
+    }
+    if (area < 0.0f) {
+        std::swap(v[1], v[2]);
+        area = -area;
+    }
+
+    ScreenTriangle tri;
+    const f32 minX = glm::min(v[0].x, glm::min(v[1].x, v[2].x)), maxX = glm::max(v[0].x, glm::max(v[1].x, v[2].x));
+    const f32 minY = glm::min(v[0].y, glm::min(v[1].y, v[2].y)), maxY = glm::max(v[0].y, glm::max(v[1].y, v[2].y));
+    tri.mMinX = glm::max(0, static_cast<i32>(glm::ceil(minX - 0.5f)));
+    tri.mMaxX = glm::min(static_cast<i32>(mWidth) - 1, static_cast<i32>(glm::floor(maxX - 0.5f)));
+    tri.mMinY = glm::max(0, static_cast<i32>(glm::ceil(minY - 0.5f)));
+    tri.mMaxY = glm::min(static_cast<i32>(mHeight) - 1, static_cast<i32>(glm::floor(maxY - 0.5f)));
+    if (tri.mMinX > tri.mMaxX || tri.mMinY > tri.mMaxY) {
+        return;
+    }
+
+    // Edge functions, positive inside of the counter clockwise triangle
+    for (ui32 i = 0; i < 3; ++i) {
+        const glm::vec3 &a = v[i], &b = v[(i + 1) % 3];
+        tri.mEdgeA[i] = a.y - b.y;
+        tri.mEdgeB[i] = b.x - a.x;
+        tri.mEdgeC[i] = -(tri.mEdgeA[i] * a.x + tri.mEdgeB[i] * a.y);
+    }
+
+    // Depth plane, z / w is linear in screen space
+    const glm::vec3 e1 = v[1] - v[0], e2 = v[2] - v[0];
+    tri.mZA = (e1.z * e2.y - e2.z * e1.y) / area;
+    tri.mZB = (e2.z * e1.x - e1.z * e2.x) / area;
+    tri.mZC = v[0].z - tri.mZA * v[0].x - tri.mZB * v[0].y;
+    mTriangles.add(tri);
+}
+
+void OcclusionBuffer::rasterizeBand(ui32 tileRow) {
+    const i32 bandMinY = tileRow * TileHeight;
+    const i32 bandMaxY = bandMinY + TileHeight - 1;
+    const __m128 offsetX = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 zero = _mm_setzero_ps();
+    for (size_t t = 0; t < mTriangles.size(); ++t) {
+        const ScreenTriangle &tri = mTriangles[t];
+        if (tri.mMaxY < bandMinY || tri.mMinY > bandMaxY) {
+            continue;
+        }
+
+        const i32 y0 = glm::max(tri.mMinY, bandMinY), y1 = glm::min(tri.mMaxY, bandMaxY);
+        const i32 x0 = tri.mMinX & ~3;
+        const __m128 edgeA0 = _mm_set1_ps(tri.mEdgeA[0]), edgeA1 = _mm_set1_ps(tri.mEdgeA[1]), edgeA2 = _mm_set1_ps(tri.mEdgeA[2]);
+        const __m128 step0 = _mm_set1_ps(tri.mEdgeA[0] * 4.0f), step1 = _mm_set1_ps(tri.mEdgeA[1] * 4.0f), step2 = _mm_set1_ps(tri.mEdgeA[2] * 4.0f);
+        const __m128 stepZ = _mm_set1_ps(tri.mZA * 4.0f);
+        for (i32 y = y0; y <= y1; ++y) {
+            const f32 py = static_cast<f32>(y) + 0.5f;
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<f32>(x0)), offsetX);
+            __m128 e0 = _mm_add_ps(_mm_mul_ps(edgeA0, px), _mm_set1_ps(tri.mEdgeB[0] * py + tri.mEdgeC[0]));
+            __m128 e1 = _mm_add_ps(_mm_mul_ps(edgeA1, px), _mm_set1_ps(tri.mEdgeB[1] * py + tri.mEdgeC[1]));
+            __m128 e2 = _mm_add_ps(_mm_mul_ps(edgeA2, px), _mm_set1_ps(tri.mEdgeB[2] * py + tri.mEdgeC[2]));
+            __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(tri.mZA), px), _mm_set1_ps(tri.mZB * py + tri.mZC));
+            f32 *row = &mDepth[y * mWidth];
+            for (i32 x = x0; x <= tri.mMaxX; x += 4) {
+                const __m128 mask = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+                if (0 != _mm_movemask_ps(mask)) {
+                    const __m128 depth = _mm_loadu_ps(row + x);
+                    const __m128 nearest = _mm_min_ps(depth, z);
+                    _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(mask, nearest), _mm_andnot_ps(mask, depth)));
+                }
+                e0 = _mm_add_ps(e0, step0);
+                e1 = _mm_add_ps(e1, step1);
+                e2 = _mm_add_ps(e2, step2);
+                z = _mm_add_ps(z, stepZ);
+            }
+        }
+    }
+
+    // Update the farthest depth of the tiles in this band
+    for (ui32 tx = 0; tx < mNumTilesX; ++tx) {
+        f32 maxDepth = -FarDepth;
+        for (ui32 y = 0; y < TileHeight; ++y) {
+            const f32 *row = &mDepth[(bandMinY + y) * mWidth + tx * TileWidth];
+            for (ui32 x = 0; x < TileWidth; ++x) {
+                maxDepth = glm::max(maxDepth, row[x]);
+            }
+        }
+        mTileMax[tileRow * mNumTilesX + tx] = maxDepth;
+    }
+}
+
+} // namespace Common
+} // namespace OSRE
@@ -0,0 +1,369 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/IO/AsyncIOQueue.h>
+#include <osre/IO/AbstractFileSystem.h>
+#include <osre/Common/Logger.h>
+
+#include "FileStream.h"
+
+namespace OSRE {
+namespace IO {
+
+static constexpr c8 Tag[] = "AsyncIOQueue";
+static constexpr c8 LocalScheme[] = "file";
+
+struct AsyncIOQueue::Request {
+    AsyncIORequestId mId;
+    Uri mUri;
+    AbstractFileSystem *mFileSystem;
+    AsyncIOCallback mCallback;
+    AsyncIOPriority mPriority;
+    size_t mOffset;
+    size_t mSize;
+    AsyncIOStatus mStatus;
+    bool mCancelRequested;
+    uc8 *mBuffer;
+    size_t mCapacity;
+    size_t mDataOffset;
+    size_t mReadSize;
+
+    Request(AsyncIORequestId id, const Uri &uri, AbstractFileSystem *fileSystem, const AsyncIOCallback &callback,
+            AsyncIOPriority priority, size_t offset, size_t size) :
+            mId(id),
+            mUri(uri),
+            mFileSystem(fileSystem),
+            mCallback(callback),
+            mPriority(priority),
+            mOffset(offset),
+            mSize(size),
+            mStatus(AsyncIOStatus::Pending),
+            mCancelRequested(false),
+            mBuffer(nullptr),
+            mCapacity(0),
+            mDataOffset(0),
+            mReadSize(0) {
+        // empty
+    }
+};
+
+constexpr size_t IOBufferPool::MinBufferSize;
+constexpr size_t IOBufferPool::MaxFreeBuffersPerClass;
+constexpr size_t AsyncIOQueue::DefaultNumThreads;
+
+static size_t getSizeClass(size_t size) {
+    size_t capacity = IOBufferPool::MinBufferSize;
+    while (capacity < size) {
+        capacity <<= 1;
+    }
+
+    return capacity;
+}
+
+IOBufferPool::IOBufferPool() :
+        mLock(),
+        mFreeBuffers() {
+    // empty
+}
+
+IOBufferPool::~IOBufferPool() {
+    for (auto &it : mFreeBuffers) {
+        for (uc8 *buffer : it.second) {
+            delete[] buffer;
+        }
+    }
+}
+
+uc8 *IOBufferPool::acquire(size_t size, size_t &capacity) {
+    capacity = getSizeClass(size);
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        auto it = mFreeBuffers.find(capacity);
+        if (mFreeBuffers.end() != it && !it->second.empty()) {
+            uc8 *buffer = it->second.back();
+            it->second.pop_back();
+            return buffer;
+        }
+    }
+
+    return new uc8[capacity];
+}
+
+void IOBufferPool::release(uc8 *buffer, size_t capacity) {
+    if (nullptr == buffer) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mLock);
+    std::vector<uc8 *> &freeBuffers = mFreeBuffers[capacity];
+    if (freeBuffers.size() < MaxFreeBuffersPerClass) {
+        freeBuffers.push_back(buffer);
+    } else {
+        delete[] buffer;
+    }
+}
+
+size_t IOBufferPool::getNumFreeBuffers() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    size_t numBuffers = 0;
+    for (const auto &it : mFreeBuffers) {
+        numBuffers += it.second.size();
+    }
+
+    return numBuffers;
+}
+
+AsyncIOQueue::AsyncIOQueue(size_t numThreads) :
+        mThreads(),
+        mPending(),
+        mRequests(),
+        mFinished(),
+        mLock(),
+        mRequestAvailable(),
+        mRequestFinished(),
+        mFileSystemLock(),
+        mBufferPool(),
+        mNextId(InvalidAsyncIORequestId + 1),
+        mRunning(true) {
+    if (0 == numThreads) {
+        numThreads = 1;
+    }
+    for (size_t i = 0; i < numThreads; ++i) {
+        mThreads.emplace_back(&AsyncIOQueue::workerLoop, this);
+    }
+}
+
+AsyncIOQueue::~AsyncIOQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mRunning = false;
+    }
+    mRequestAvailable.notify_all();
+    for (std::thread &thread : mThreads) {
+        thread.join();
+    }
+
+    for (auto &it : mRequests) {
+        mBufferPool.release(it.second->mBuffer, it.second->mCapacity);
+        delete it.second;
+    }
+}
+
+AsyncIORequestId AsyncIOQueue::read(const Uri &uri, AbstractFileSystem *fileSystem, const AsyncIOCallback &callback,
+        AsyncIOPriority priority, size_t offset, size_t size) {
+    if (AsyncIOPriority::NumPriorities <= priority) {
+        osre_error(Tag, "Invalid priority.");
+        return InvalidAsyncIORequestId;
+    }
+    if (nullptr == fileSystem && LocalScheme != uri.getScheme()) {
+        osre_error(Tag, "No file system for " + uri.getUri());
+        return InvalidAsyncIORequestId;
+    }
+
+    AsyncIORequestId id = InvalidAsyncIORequestId;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        id = mNextId++;
+        Request *request = new Request(id, uri, fileSystem, callback, priority, offset, size);
+        mRequests[id] = request;
+        mPending[static_cast<size_t>(priority)].push_back(request);
+    }
+    mRequestAvailable.notify_one();
+
+    return id;
+}
+
+bool AsyncIOQueue::cancel(AsyncIORequestId id) {
+    std::lock_guard<std::mutex> lock(mLock);
+    auto it = mRequests.find(id);
+    if (mRequests.end() == it) {
+        return false;
+    }
+
+    Request *request = it->second;
+    if (AsyncIOStatus::Pending == request->mStatus) {
+        std::deque<Request *> &pending = mPending[static_cast<size_t>(request->mPriority)];
+        for (auto pendingIt = pending.begin(); pendingIt != pending.end(); ++pendingIt) {
+            if (*pendingIt == request) {
+                pending.erase(pendingIt);
+                break;
+            }
+        }
+        request->mStatus = AsyncIOStatus::Cancelled;
+        mFinished.push_back(request);
+        mRequestFinished.notify_all();
+        return true;
+    }
+
+    // A running request will be cancelled when its read is done
+    if (AsyncIOStatus::Running == request->mStatus) {
+        request->mCancelRequested = true;
+        return true;
+    }
+
+    return false;
+}
+
+bool AsyncIOQueue::getStatus(AsyncIORequestId id, AsyncIOStatus &status) const {
+    std::lock_guard<std::mutex> lock(mLock);
+    auto it = mRequests.find(id);
+    if (mRequests.end() == it) {
+        return false;
+    }
+    status = it->second->mStatus;
+
+    return true;
+}
+
+void AsyncIOQueue::wait(AsyncIORequestId id) {
+    std::unique_lock<std::mutex> lock(mLock);
+    mRequestFinished.wait(lock, [this, id]() {
+        auto it = mRequests.find(id);
+        if (mRequests.end() == it) {
+            return true;
+        }
+        const AsyncIOStatus status = it->second->mStatus;
+        return AsyncIOStatus::Pending != status && AsyncIOStatus::Running != status;
+    });
+}
+
+size_t AsyncIOQueue::dispatchCompleted() {
+    std::vector<Request *> finished;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        finished.swap(mFinished);
+        for (Request *request : finished) {
+            mRequests.erase(request->mId);
+        }
+    }
+
+    for (Request *request : finished) {
+        if (request->mCallback) {
+            AsyncIOResult result;
+            result.mId = request->mId;
+            result.mStatus = request->mStatus;
+            result.mUri = request->mUri;
+            const bool hasData = AsyncIOStatus::Completed == request->mStatus && nullptr != request->mBuffer;
+            result.mData = hasData ? request->mBuffer + request->mDataOffset : nullptr;
+            result.mSize = hasData ? request->mReadSize : 0;
+            request->mCallback(result);
+        }
+        mBufferPool.release(request->mBuffer, request->mCapacity);
+        delete request;
+    }
+
+    return finished.size();
+}
+
+size_t AsyncIOQueue::getNumRequests() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mRequests.size();
+}
+
+void AsyncIOQueue::workerLoop() {
+    while (Request *request = dequeue()) {
+        execute(request);
+    }
+}
+
+AsyncIOQueue::Request *AsyncIOQueue::dequeue() {
+    std::unique_lock<std::mutex> lock(mLock);
+    for (;;) {
+        if (!mRunning) {
+            return nullptr;
+        }
+        for (size_t i = static_cast<size_t>(AsyncIOPriority::NumPriorities); i > 0; --i) {
+            std::deque<Request *> &pending = mPending[i - 1];
+            if (!pending.empty()) {
+                Request *request = pending.front();
+                pending.pop_front();
+                request->mStatus = AsyncIOStatus::Running;
+                return request;
+            }
+        }
+        mRequestAvailable.wait(lock);
+    }
+}
+
+void AsyncIOQueue::execute(Request *request) {
+    if (nullptr == request->mFileSystem || LocalScheme == request->mUri.getScheme()) {
+        // Local files are independent, so they can be read in parallel
+        FileStream stream(request->mUri, Stream::AccessMode::ReadAccessBinary);
+        if (!stream.open()) {
+            finish(request, AsyncIOStatus::Failed);
+            return;
+        }
+
+        const size_t fileSize = stream.getSize();
+        if (request->mOffset > fileSize) {
+            finish(request, AsyncIOStatus::Failed);
+            return;
+        }
+        const size_t available = fileSize - request->mOffset;
+        const size_t size = (0 == request->mSize || request->mSize > available) ? available : request->mSize;
+        request->mBuffer = mBufferPool.acquire(size, request->mCapacity);
+        if (0 != request->mOffset) {
+            stream.seek(static_cast<Stream::Offset>(request->mOffset), Stream::Origin::Begin);
+        }
+        request->mReadSize = 0 != size ? stream.read(request->mBuffer, size) : 0;
+        stream.close();
+        finish(request, request->mReadSize == size ? AsyncIOStatus::Completed : AsyncIOStatus::Failed);
+        return;
+    }
+
+    // Other file systems will be serialized unless they support concurrent reads, the whole file will be read
+    AsyncIOStatus status = AsyncIOStatus::Failed;
+    {
+        std::unique_lock<std::mutex> lock(mFileSystemLock, std::defer_lock);
+        if (!request->mFileSystem->supportsConcurrentReads()) {
+            lock.lock();
+        }
+        Stream *stream = request->mFileSystem->open(request->mUri, Stream::AccessMode::ReadAccessBinary);
+        if (nullptr != stream) {
+            const size_t fileSize = stream->getSize();
+            if (request->mOffset <= fileSize) {
+                request->mBuffer = mBufferPool.acquire(fileSize, request->mCapacity);
+                const size_t readSize = 0 != fileSize ? stream->read(request->mBuffer, fileSize) : 0;
+                if (readSize == fileSize) {
+                    const size_t available = fileSize - request->mOffset;
+                    request->mDataOffset = request->mOffset;
+                    request->mReadSize = (0 == request->mSize || request->mSize > available) ? available : request->mSize;
+                    status = AsyncIOStatus::Completed;
+                }
+            }
+            request->mFileSystem->close(&stream);
+        }
+    }
+    finish(request, status);
+}
+
+void AsyncIOQueue::finish(Request *request, AsyncIOStatus status) {
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        request->mStatus = request->mCancelRequested ? AsyncIOStatus::Cancelled : status;
+        mFinished.push_back(request);
+    }
+    mRequestFinished.notify_all();
+}
+
+} // Namespace IO
+} // Namespace OSRE
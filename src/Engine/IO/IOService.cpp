@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Common/Logger.h>
 #include <src/Engine/IO/ZipFileSystem.h>
 #include <src/Engine/IO/LocaleFileSystem.h>
+#include <src/Engine/IO/PackFileSystem.h>
 
 IMPLEMENT_SINGLETON( ::OSRE::IO::IOService )
 
@@ -35,6 +36,7 @@ using namespace OSRE::Common;
 
 static constexpr c8 Tag[]           = "IOService";
 static constexpr c8 Zip_Extension[] = "zip";
+static constexpr c8 Pack_Extension[] = "pack";
 
 static AbstractFileSystem *createFS( const Uri &file ) {
     if ( !file.isValid() ) {
@@ -45,17 +47,21 @@ static AbstractFileSystem *createFS( const Uri &file ) {
     if( Zip_Extension == schema ) {
         return new ZipFileSystem( file );
     }
+    if( Pack_Extension == schema ) {
+        return new PackFileSystem( file );
+    }
 
     return nullptr;
 }
 
-IOService::IOService() : AbstractService( "io/ioserver" ), m_mountedMap() {
+IOService::IOService() : AbstractService( "io/ioserver" ), m_mountedMap(), m_asyncQueue( nullptr ) {
     CREATE_SINGLETON( IOService );
 
     m_mountedMap["file"] = new LocaleFileSystem();
 }
 
 IOService::~IOService() {
+    delete m_asyncQueue;
     DESTROY_SINGLETON( IOService );
 }
 
@@ -69,6 +75,10 @@ bool IOService::onOpen() {
 }
 
 bool IOService::onClose() {
+    // Pending requests may still use the file systems
+    delete m_asyncQueue;
+    m_asyncQueue = nullptr;
+
     for (MountedMap::iterator it = m_mountedMap.begin(); it != m_mountedMap.end(); ++it) {
         delete it->second;
     }
@@ -76,6 +86,10 @@ bool IOService::onClose() {
 }
 
 bool IOService::onUpdate() {
+    if ( nullptr != m_asyncQueue ) {
+        m_asyncQueue->dispatchCompleted();
+    }
+
     return true;
 }
 
@@ -160,6 +174,33 @@ bool IOService::fileExists( const Uri &file ) const {
     return exists;
 }
 
+AsyncIORequestId IOService::readAsync( const Uri &file, const AsyncIOCallback &callback,
+        AsyncIOPriority priority, size_t offset, size_t size ) {
+    AbstractFileSystem *fs = getFileSystem( file.getScheme() );
+    if ( nullptr == fs ) {
+        osre_debug( Tag, "No file system mounted for " + file.getUri() );
+        return InvalidAsyncIORequestId;
+    }
+
+    return getAsyncQueue()->read( file, fs, callback, priority, offset, size );
+}
+
+bool IOService::cancelAsync( AsyncIORequestId id ) {
+    if ( nullptr == m_asyncQueue ) {
+        return false;
+    }
+
+    return m_asyncQueue->cancel( id );
+}
+
+AsyncIOQueue *IOService::getAsyncQueue() {
+    if ( nullptr == m_asyncQueue ) {
+        m_asyncQueue = new AsyncIOQueue( AsyncIOQueue::DefaultNumThreads );
+    }
+
+    return m_asyncQueue;
+}
+
 IOService *IOService::create() {
     return new IOService;
 }
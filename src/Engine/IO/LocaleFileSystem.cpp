@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "LocaleFileSystem.h"
 #include "FileStream.h"
+#include "MappedFileStream.h"
 #include <osre/IO/File.h>
 #include <osre/Common/Logger.h>
 #include <cassert>
@@ -66,7 +67,12 @@ Stream *LocaleFileSystem::open( const Uri &file, Stream::AccessMode mode ) {
     Stream *pFileStream( nullptr );
     String::size_type pos = file.getResource().rfind( "xml" );
     if ( String::npos == pos ) {
-        pFileStream = new FileStream( file, mode );
+        // Large binary reads are mapped, so they can be used without a buffered copy
+        if ( Stream::AccessMode::ReadAccessBinary == mode && FileStream( file, mode ).getSize() >= MappedStreamThreshold ) {
+            pFileStream = new MappedFileStream( file, mode );
+        } else {
+            pFileStream = new FileStream( file, mode );
+        }
     }
 
     if ( nullptr == pFileStream ) {
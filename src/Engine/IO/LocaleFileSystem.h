@@ -35,6 +35,9 @@ namespace IO {
 //-------------------------------------------------------------------------------------------------
 class LocaleFileSystem : public AbstractFileSystem {
 public:
+	///	Binary files to read with at least this size will be mapped into memory.
+	static constexpr size_t MappedStreamThreshold = 64 * 1024;
+
 	///	The default class constructor.
 	LocaleFileSystem();
 	///	The class destructor, virtual.
@@ -0,0 +1,275 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "MappedFileStream.h"
+
+#include <osre/Common/Logger.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#ifdef OSRE_WINDOWS
+#   include <osre/Platform/Windows/MinWindows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#include <cstring>
+
+namespace OSRE {
+namespace IO {
+
+static constexpr c8 Tag[] = "MappedFileStream";
+
+MappedFileStream::MappedFileStream() noexcept :
+        Stream(),
+        mData(nullptr),
+        mSize(0),
+        mPosition(0),
+        mOpen(false)
+#ifdef OSRE_WINDOWS
+        , mFileHandle(nullptr),
+        mMappingHandle(nullptr)
+#endif
+{
+    // empty
+}
+
+MappedFileStream::MappedFileStream(const Uri &uri, AccessMode requestedAccess) :
+        Stream(uri, requestedAccess),
+        mData(nullptr),
+        mSize(0),
+        mPosition(0),
+        mOpen(false)
+#ifdef OSRE_WINDOWS
+        , mFileHandle(nullptr),
+        mMappingHandle(nullptr)
+#endif
+{
+    // empty
+}
+
+MappedFileStream::~MappedFileStream() {
+    if (isOpen()) {
+        MappedFileStream::close();
+    }
+}
+
+bool MappedFileStream::canRead() const {
+    return true;
+}
+
+bool MappedFileStream::canWrite() const {
+    return false;
+}
+
+bool MappedFileStream::canSeek() const {
+    return true;
+}
+
+bool MappedFileStream::canBeMapped() const {
+    return true;
+}
+
+bool MappedFileStream::open() {
+    if (isOpen()) {
+        return false;
+    }
+
+    const AccessMode mode = getAccessMode();
+    if (AccessMode::ReadAccess != mode && AccessMode::ReadAccessBinary != mode) {
+        osre_error(Tag, "Mapped files support read access only.");
+        return false;
+    }
+
+    const String &abspath = m_Uri.getAbsPath();
+#ifdef OSRE_WINDOWS
+    HANDLE file = ::CreateFileA(abspath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (INVALID_HANDLE_VALUE == file) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(file, &fileSize)) {
+        ::CloseHandle(file);
+        return false;
+    }
+    mSize = static_cast<size_t>(fileSize.QuadPart);
+
+    // Empty files cannot be mapped, they are opened without a mapping
+    if (0 != mSize) {
+        HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (nullptr == mapping) {
+            ::CloseHandle(file);
+            return false;
+        }
+        mData = static_cast<const uc8 *>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (nullptr == mData) {
+            ::CloseHandle(mapping);
+            ::CloseHandle(file);
+            return false;
+        }
+        mMappingHandle = mapping;
+    }
+    mFileHandle = file;
+#else
+    const int fd = ::open(abspath.c_str(), O_RDONLY);
+    if (-1 == fd) {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (0 != ::fstat(fd, &fileStat)) {
+        ::close(fd);
+        return false;
+    }
+    mSize = static_cast<size_t>(fileStat.st_size);
+
+    // Empty files cannot be mapped, they are opened without a mapping
+    if (0 != mSize) {
+        void *data = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED == data) {
+            ::close(fd);
+            return false;
+        }
+        ::madvise(data, mSize, MADV_SEQUENTIAL);
+        mData = static_cast<const uc8 *>(data);
+    }
+
+    // The mapping stays valid after the descriptor was closed
+    ::close(fd);
+#endif
+    mPosition = 0;
+    mOpen = true;
+
+    return true;
+}
+
+bool MappedFileStream::close() {
+    if (!isOpen()) {
+        return false;
+    }
+
+#ifdef OSRE_WINDOWS
+    if (nullptr != mData) {
+        ::UnmapViewOfFile(mData);
+    }
+    if (nullptr != mMappingHandle) {
+        ::CloseHandle(mMappingHandle);
+        mMappingHandle = nullptr;
+    }
+    if (nullptr != mFileHandle) {
+        ::CloseHandle(mFileHandle);
+        mFileHandle = nullptr;
+    }
+#else
+    if (nullptr != mData) {
+        ::munmap(const_cast<uc8 *>(mData), mSize);
+    }
+#endif
+    mData = nullptr;
+    mSize = 0;
+    mPosition = 0;
+    mOpen = false;
+
+    return true;
+}
+
+size_t MappedFileStream::getSize() const {
+    return mSize;
+}
+
+const uc8 *MappedFileStream::getMappedData() const {
+    return mData;
+}
+
+size_t MappedFileStream::read(void *buffer, size_t size) {
+    if (nullptr == buffer || 0 == size || !isOpen()) {
+        return 0;
+    }
+
+    const size_t available = mSize - mPosition;
+    const size_t numBytes = size < available ? size : available;
+    if (0 != numBytes) {
+        ::memcpy(buffer, mData + mPosition, numBytes);
+        mPosition += numBytes;
+    }
+
+    return numBytes;
+}
+
+template <class T>
+size_t MappedFileStream::readValue(T &value) {
+    osre_assert(isOpen());
+
+    // Returns the number of read items like fread
+    if (mSize - mPosition < sizeof(T)) {
+        return 0;
+    }
+    ::memcpy(&value, mData + mPosition, sizeof(T));
+    mPosition += sizeof(T);
+
+    return 1;
+}
+
+size_t MappedFileStream::readI32(i32 &value) {
+    return readValue(value);
+}
+
+size_t MappedFileStream::readUI32(ui32 &value) {
+    return readValue(value);
+}
+
+size_t MappedFileStream::readF32(f32 &value) {
+    return readValue(value);
+}
+
+size_t MappedFileStream::readD32(d32 &value) {
+    return readValue(value);
+}
+
+MappedFileStream::Position MappedFileStream::seek(Offset offset, Origin origin) {
+    size_t position = 0;
+    if (Origin::Begin == origin) {
+        position = offset;
+    } else if (Origin::Current == origin) {
+        position = mPosition + offset;
+    } else {
+        position = offset < mSize ? mSize - offset : 0;
+    }
+    mPosition = position < mSize ? position : mSize;
+
+    return static_cast<Position>(mPosition);
+}
+
+MappedFileStream::Position MappedFileStream::tell() {
+    return static_cast<Position>(mPosition);
+}
+
+bool MappedFileStream::isOpen() const {
+    return mOpen;
+}
+
+} // Namespace IO
+} // Namespace OSRE
@@ -0,0 +1,95 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/IO/Stream.h>
+
+namespace OSRE {
+namespace IO {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Infrastructure
+///
+///	@brief	This class implements a read-only stream, which maps the whole file into memory.
+///
+/// The content can be accessed without a copy by getMappedData and getView, read will copy from
+/// the mapping. Only read access modes are supported.
+//-------------------------------------------------------------------------------------------------
+class MappedFileStream : public Stream {
+public:
+    /// The default class constructor.
+    MappedFileStream() noexcept;
+    /// The class constructor with URI and access mode.
+    MappedFileStream(const Uri &uri, AccessMode requestedAccess);
+    /// The class destructor.
+    ~MappedFileStream() override;
+    /// true for mapped files.
+    bool canRead() const override;
+    /// false, the mapping is read-only.
+    bool canWrite() const override;
+    /// true for mapped files.
+    bool canSeek() const override;
+    /// true for mapped files.
+    bool canBeMapped() const override;
+    /// Maps the file.
+    bool open() override;
+    /// Unmaps the file.
+    bool close() override;
+    /// Returns file size.
+    size_t getSize() const override;
+    /// Returns the mapped content.
+    const uc8 *getMappedData() const override;
+    /// Copies from the mapping.
+    size_t read(void *buffer, size_t size) override;
+    /// Reads a single integer value.
+    size_t readI32(i32 &value) override;
+    /// Reads a single unsigned integer value.
+    size_t readUI32(ui32 &value) override;
+    /// Reads a single float value.
+    size_t readF32(f32 &value) override;
+    /// Reads a single double value.
+    size_t readD32(d32 &value) override;
+    /// Moves to given position, End moves backwards from the end of the file.
+    Position seek(Offset offset, Origin origin) override;
+    /// Position in the file.
+    Position tell() override;
+    /// Returns true, when the file is mapped.
+    bool isOpen() const override;
+
+private:
+    template <class T>
+    size_t readValue(T &value);
+
+private:
+    const uc8 *mData;
+    size_t mSize;
+    size_t mPosition;
+    bool mOpen;
+#ifdef OSRE_WINDOWS
+    void *mFileHandle;
+    void *mMappingHandle;
+#endif
+};
+
+} // Namespace IO
+} // Namespace OSRE
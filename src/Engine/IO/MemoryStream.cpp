@@ -0,0 +1,160 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "MemoryStream.h"
+
+#include <osre/Debugging/osre_debugging.h>
+
+#include <cstring>
+
+namespace OSRE {
+namespace IO {
+
+MemoryStream::MemoryStream(const Uri &uri, const uc8 *data, size_t size, bool ownsData) :
+        Stream(uri, AccessMode::ReadAccessBinary),
+        mData(data),
+        mSize(nullptr != data ? size : 0),
+        mPosition(0),
+        mOwnsData(ownsData),
+        mOpen(true) {
+    // empty
+}
+
+MemoryStream::~MemoryStream() {
+    if (mOwnsData) {
+        delete[] mData;
+    }
+    mData = nullptr;
+}
+
+bool MemoryStream::canRead() const {
+    return true;
+}
+
+bool MemoryStream::canWrite() const {
+    return false;
+}
+
+bool MemoryStream::canSeek() const {
+    return true;
+}
+
+bool MemoryStream::canBeMapped() const {
+    return true;
+}
+
+bool MemoryStream::open() {
+    if (mOpen) {
+        return false;
+    }
+    mOpen = true;
+    mPosition = 0;
+
+    return true;
+}
+
+bool MemoryStream::close() {
+    if (!mOpen) {
+        return false;
+    }
+    mOpen = false;
+
+    return true;
+}
+
+size_t MemoryStream::getSize() const {
+    return mSize;
+}
+
+const uc8 *MemoryStream::getMappedData() const {
+    return mData;
+}
+
+size_t MemoryStream::read(void *buffer, size_t size) {
+    if (nullptr == buffer || 0 == size || !isOpen()) {
+        return 0;
+    }
+
+    const size_t available = mSize - mPosition;
+    const size_t numBytes = size < available ? size : available;
+    if (0 != numBytes) {
+        ::memcpy(buffer, mData + mPosition, numBytes);
+        mPosition += numBytes;
+    }
+
+    return numBytes;
+}
+
+template <class T>
+size_t MemoryStream::readValue(T &value) {
+    osre_assert(isOpen());
+
+    // Returns the number of read items like fread
+    if (mSize - mPosition < sizeof(T)) {
+        return 0;
+    }
+    ::memcpy(&value, mData + mPosition, sizeof(T));
+    mPosition += sizeof(T);
+
+    return 1;
+}
+
+size_t MemoryStream::readI32(i32 &value) {
+    return readValue(value);
+}
+
+size_t MemoryStream::readUI32(ui32 &value) {
+    return readValue(value);
+}
+
+size_t MemoryStream::readF32(f32 &value) {
+    return readValue(value);
+}
+
+size_t MemoryStream::readD32(d32 &value) {
+    return readValue(value);
+}
+
+MemoryStream::Position MemoryStream::seek(Offset offset, Origin origin) {
+    size_t position = 0;
+    if (Origin::Begin == origin) {
+        position = offset;
+    } else if (Origin::Current == origin) {
+        position = mPosition + offset;
+    } else {
+        position = offset < mSize ? mSize - offset : 0;
+    }
+    mPosition = position < mSize ? position : mSize;
+
+    return static_cast<Position>(mPosition);
+}
+
+MemoryStream::Position MemoryStream::tell() {
+    return static_cast<Position>(mPosition);
+}
+
+bool MemoryStream::isOpen() const {
+    return mOpen;
+}
+
+} // Namespace IO
+} // Namespace OSRE
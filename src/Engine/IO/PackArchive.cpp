@@ -0,0 +1,218 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/IO/PackArchive.h>
+#include <osre/IO/Uri.h>
+#include <osre/Common/Logger.h>
+
+#include "FileStream.h"
+#include "zlib.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace OSRE {
+namespace IO {
+
+static constexpr c8 Tag[] = "PackWriter";
+
+ui64 hashPackPath(const String &path) {
+    ui64 hash = 14695981039346656037ull;
+    for (const c8 c : path) {
+        hash ^= static_cast<uc8>(c);
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+static ui64 alignOffset(ui64 offset) {
+    return (offset + PackAlignment - 1) & ~static_cast<ui64>(PackAlignment - 1);
+}
+
+static bool writePadding(FileStream &stream, ui64 &offset, ui64 target) {
+    static const uc8 Zeros[PackAlignment] = {};
+    const size_t numBytes = static_cast<size_t>(target - offset);
+    if (0 != numBytes && stream.write(Zeros, numBytes) != numBytes) {
+        return false;
+    }
+    offset = target;
+
+    return true;
+}
+
+PackWriter::PackWriter() :
+        mFiles() {
+    // empty
+}
+
+PackWriter::~PackWriter() {
+    // empty
+}
+
+bool PackWriter::addFile(const String &path, const uc8 *data, size_t size, bool compress) {
+    if (path.empty() || path.size() > 0xffff || (nullptr == data && 0 != size)) {
+        osre_error(Tag, "Invalid file " + path);
+        return false;
+    }
+
+    String name(path);
+    std::replace(name.begin(), name.end(), '\\', '/');
+    for (const File &file : mFiles) {
+        if (file.mPath == name) {
+            osre_error(Tag, "File " + name + " was already added.");
+            return false;
+        }
+    }
+
+    File file;
+    file.mPath = name;
+    file.mUncompressedSize = size;
+    file.mCompressed = false;
+    if (compress && 0 != size) {
+        uLongf compressedSize = compressBound(static_cast<uLong>(size));
+        file.mData.resize(compressedSize);
+        if (Z_OK == compress2(&file.mData[0], &compressedSize, data, static_cast<uLong>(size), Z_BEST_COMPRESSION) &&
+                compressedSize < size) {
+            file.mData.resize(compressedSize);
+            file.mCompressed = true;
+        }
+    }
+    if (!file.mCompressed) {
+        file.mData.assign(data, data + size);
+    }
+    mFiles.push_back(std::move(file));
+
+    return true;
+}
+
+bool PackWriter::addFile(const String &path, const Uri &file, bool compress) {
+    FileStream stream(file, Stream::AccessMode::ReadAccessBinary);
+    if (!stream.open()) {
+        osre_error(Tag, "Cannot open " + file.getAbsPath());
+        return false;
+    }
+
+    std::vector<uc8> data(stream.getSize());
+    const size_t numRead = data.empty() ? 0 : stream.read(&data[0], data.size());
+    stream.close();
+    if (numRead != data.size()) {
+        osre_error(Tag, "Cannot read " + file.getAbsPath());
+        return false;
+    }
+
+    return addFile(path, data.empty() ? nullptr : &data[0], data.size(), compress);
+}
+
+size_t PackWriter::getNumFiles() const {
+    return mFiles.size();
+}
+
+bool PackWriter::write(const Uri &pack) const {
+    // The layout only depends on the paths: data sorted by path, table sorted by hash
+    std::vector<const File*> files;
+    for (const File &file : mFiles) {
+        files.push_back(&file);
+    }
+    std::sort(files.begin(), files.end(), [](const File *lhs, const File *rhs) {
+        return lhs->mPath < rhs->mPath;
+    });
+
+    PackHeader header;
+    ::memcpy(header.mMagic, PackMagic, sizeof(PackMagic));
+    header.mVersion = PackVersion;
+    header.mNumEntries = static_cast<ui32>(files.size());
+    header.mAlignment = PackAlignment;
+    header.mTableOffset = sizeof(PackHeader);
+    header.mNamesOffset = header.mTableOffset + files.size() * sizeof(PackEntry);
+
+    String names;
+    std::vector<PackEntry> entries(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        PackEntry &entry = entries[i];
+        entry.mPathHash = hashPackPath(files[i]->mPath);
+        entry.mNameOffset = static_cast<ui32>(names.size());
+        entry.mNameLength = static_cast<ui16>(files[i]->mPath.size());
+        entry.mFlags = files[i]->mCompressed ? PackEntryCompressed : 0;
+        entry.mSize = files[i]->mData.size();
+        entry.mUncompressedSize = files[i]->mUncompressedSize;
+        names += files[i]->mPath;
+        names += '\0';
+    }
+    header.mNamesSize = names.size();
+    header.mDataOffset = alignOffset(header.mNamesOffset + header.mNamesSize);
+
+    ui64 offset = header.mDataOffset;
+    for (PackEntry &entry : entries) {
+        entry.mOffset = offset;
+        offset = alignOffset(offset + entry.mSize);
+    }
+
+    std::vector<size_t> table(files.size());
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = i;
+    }
+    std::sort(table.begin(), table.end(), [&](size_t lhs, size_t rhs) {
+        if (entries[lhs].mPathHash != entries[rhs].mPathHash) {
+            return entries[lhs].mPathHash < entries[rhs].mPathHash;
+        }
+        return files[lhs]->mPath < files[rhs]->mPath;
+    });
+
+    FileStream stream(pack, Stream::AccessMode::WriteAccessBinary);
+    if (!stream.open()) {
+        osre_error(Tag, "Cannot open " + pack.getAbsPath() + " for writing.");
+        return false;
+    }
+
+    bool ok = stream.write(&header, sizeof(PackHeader)) == sizeof(PackHeader);
+    for (size_t i = 0; ok && i < table.size(); ++i) {
+        ok = stream.write(&entries[table[i]], sizeof(PackEntry)) == sizeof(PackEntry);
+    }
+    if (ok && !names.empty()) {
+        ok = stream.write(names.c_str(), names.size()) == names.size();
+    }
+
+    offset = header.mNamesOffset + header.mNamesSize;
+    for (size_t i = 0; ok && i < files.size(); ++i) {
+        const std::vector<uc8> &data = files[i]->mData;
+        ok = writePadding(stream, offset, entries[i].mOffset);
+        if (ok && !data.empty()) {
+            ok = stream.write(&data[0], data.size()) == data.size();
+            offset += data.size();
+        }
+    }
+    stream.close();
+
+    if (!ok) {
+        osre_error(Tag, "Cannot write " + pack.getAbsPath());
+    }
+
+    return ok;
+}
+
+void PackWriter::clear() {
+    mFiles.clear();
+}
+
+} // Namespace IO
+} // Namespace OSRE
@@ -0,0 +1,259 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "PackFileSystem.h"
+#include "MappedFileStream.h"
+#include "MemoryStream.h"
+
+#include <osre/Common/Logger.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include "zlib.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace OSRE {
+namespace IO {
+
+static constexpr c8 PackSchema[] = "pack";
+static constexpr c8 Tag[] = "PackFileSystem";
+
+PackFileSystem::PackFileSystem( const Uri &archive ) :
+        AbstractFileSystem(),
+        mArchive( nullptr ),
+        mData( nullptr ),
+        mSize( 0 ),
+        mHeader( nullptr ),
+        mEntries( nullptr ),
+        mNames( nullptr ),
+        mOpenStreams(),
+        mLock() {
+    if ( !mapArchive( archive ) ) {
+        osre_error( Tag, "Cannot open pack " + archive.getAbsPath() );
+    }
+}
+
+PackFileSystem::~PackFileSystem() {
+    for ( Stream *stream : mOpenStreams ) {
+        delete stream;
+    }
+    mOpenStreams.clear();
+
+    if ( nullptr != mArchive ) {
+        mArchive->close();
+        delete mArchive;
+        mArchive = nullptr;
+    }
+}
+
+Stream *PackFileSystem::open( const Uri &file, Stream::AccessMode mode ) {
+    if ( !isOpened() ) {
+        return nullptr;
+    }
+    if ( mode != Stream::AccessMode::ReadAccess && mode != Stream::AccessMode::ReadAccessBinary ) {
+        return nullptr;
+    }
+
+    const PackEntry *entry = findEntry( file );
+    if ( nullptr == entry ) {
+        return nullptr;
+    }
+
+    Stream *stream( nullptr );
+    const uc8 *data = mData + entry->mOffset;
+    if ( 0 == ( entry->mFlags & PackEntryCompressed ) ) {
+        // Zero copy, the stream is a view into the mapping
+        stream = new MemoryStream( file, data, static_cast<size_t>( entry->mSize ), false );
+    } else {
+        uc8 *buffer = new uc8[ static_cast<size_t>( entry->mUncompressedSize ) ];
+        uLongf size = static_cast<uLongf>( entry->mUncompressedSize );
+        if ( Z_OK != uncompress( buffer, &size, data, static_cast<uLong>( entry->mSize ) ) || size != entry->mUncompressedSize ) {
+            osre_error( Tag, "Cannot decompress " + file.getAbsPath() );
+            delete[] buffer;
+            return nullptr;
+        }
+        stream = new MemoryStream( file, buffer, static_cast<size_t>( size ), true );
+    }
+
+    std::lock_guard<std::mutex> lock( mLock );
+    mOpenStreams.insert( stream );
+
+    return stream;
+}
+
+void PackFileSystem::close( Stream **ppStream ) {
+    osre_assert( nullptr != ppStream );
+
+    std::lock_guard<std::mutex> lock( mLock );
+    StreamSet::iterator it = mOpenStreams.find( *ppStream );
+    if ( mOpenStreams.end() == it ) {
+        return;
+    }
+
+    mOpenStreams.erase( it );
+    delete *ppStream;
+    *ppStream = nullptr;
+}
+
+bool PackFileSystem::fileExist( const Uri &file ) {
+    if ( file.isEmpty() ) {
+        osre_debug( Tag, "Filename is empty." );
+        return false;
+    }
+
+    return nullptr != findEntry( file );
+}
+
+Stream *PackFileSystem::find( const Uri &file, Stream::AccessMode mode, StringArray *searchPaths ) {
+    if ( nullptr != searchPaths ) {
+        for ( ui32 i = 0; i < searchPaths->size(); ++i ) {
+            const String &folder = ( *searchPaths )[ i ];
+            Uri currentFile( file.getScheme() + "://" + folder + file.getResource() );
+            Stream *stream = open( currentFile, mode );
+            if ( nullptr != stream ) {
+                return stream;
+            }
+        }
+    }
+
+    return open( file, mode );
+}
+
+const c8 *PackFileSystem::getSchema() const {
+    return PackSchema;
+}
+
+String PackFileSystem::getWorkingDirectory() {
+    return String( "./" );
+}
+
+bool PackFileSystem::supportsConcurrentReads() const {
+    return true;
+}
+
+bool PackFileSystem::isOpened() const {
+    return nullptr != mHeader;
+}
+
+void PackFileSystem::getFileList( std::vector<String> &fileList ) const {
+    fileList.resize( 0 );
+    if ( !isOpened() ) {
+        return;
+    }
+
+    for ( ui32 i = 0; i < mHeader->mNumEntries; ++i ) {
+        fileList.push_back( String( mNames + mEntries[ i ].mNameOffset, mEntries[ i ].mNameLength ) );
+    }
+}
+
+const PackEntry *PackFileSystem::getEntry( const String &path ) const {
+    if ( !isOpened() ) {
+        return nullptr;
+    }
+
+    // The table is sorted by hash, entries with the same hash are compared by name
+    const ui64 hash = hashPackPath( path );
+    const PackEntry *end = mEntries + mHeader->mNumEntries;
+    const PackEntry *it = std::lower_bound( mEntries, end, hash, []( const PackEntry &entry, ui64 value ) {
+        return entry.mPathHash < value;
+    } );
+    for ( ; it != end && it->mPathHash == hash; ++it ) {
+        if ( it->mNameLength == path.size() && 0 == ::memcmp( mNames + it->mNameOffset, path.c_str(), path.size() ) ) {
+            return it;
+        }
+    }
+
+    return nullptr;
+}
+
+bool PackFileSystem::mapArchive( const Uri &archive ) {
+    mArchive = new MappedFileStream( archive, Stream::AccessMode::ReadAccessBinary );
+    if ( !mArchive->open() ) {
+        return false;
+    }
+
+    mData = mArchive->getMappedData();
+    mSize = mArchive->getSize();
+    if ( nullptr == mData || mSize < sizeof( PackHeader ) ) {
+        return false;
+    }
+
+    const PackHeader *header = reinterpret_cast<const PackHeader*>( mData );
+    if ( 0 != ::memcmp( header->mMagic, PackMagic, sizeof( PackMagic ) ) || PackVersion != header->mVersion ) {
+        osre_error( Tag, "Invalid pack header." );
+        return false;
+    }
+
+    mEntries = reinterpret_cast<const PackEntry*>( mData + header->mTableOffset );
+    mNames = reinterpret_cast<const c8*>( mData + header->mNamesOffset );
+    mHeader = header;
+    if ( !validate() ) {
+        osre_error( Tag, "Corrupt pack table." );
+        mHeader = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+bool PackFileSystem::validate() const {
+    const ui64 size = mSize;
+    if ( mHeader->mTableOffset % alignof( PackEntry ) != 0 || mHeader->mTableOffset > size ||
+            mHeader->mNumEntries > ( size - mHeader->mTableOffset ) / sizeof( PackEntry ) ) {
+        return false;
+    }
+    if ( mHeader->mNamesOffset > size || mHeader->mNamesSize > size - mHeader->mNamesOffset ) {
+        return false;
+    }
+
+    for ( ui32 i = 0; i < mHeader->mNumEntries; ++i ) {
+        const PackEntry &entry = mEntries[ i ];
+        if ( entry.mOffset > size || entry.mSize > size - entry.mOffset ) {
+            return false;
+        }
+        if ( static_cast<ui64>( entry.mNameOffset ) + entry.mNameLength > mHeader->mNamesSize ) {
+            return false;
+        }
+        if ( 0 == ( entry.mFlags & PackEntryCompressed ) && entry.mSize != entry.mUncompressedSize ) {
+            return false;
+        }
+        if ( i > 0 && mEntries[ i - 1 ].mPathHash > entry.mPathHash ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const PackEntry *PackFileSystem::findEntry( const Uri &file ) const {
+    // Files in folders are stored with their full path
+    const PackEntry *entry = getEntry( file.getAbsPath() );
+    if ( nullptr == entry ) {
+        entry = getEntry( file.getResource() );
+    }
+
+    return entry;
+}
+
+} // Namespace IO
+} // Namespace OSRE
@@ -0,0 +1,94 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <osre/IO/AbstractFileSystem.h>
+#include <osre/IO/PackArchive.h>
+
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace OSRE {
+namespace IO {
+
+class MappedFileStream;
+
+//-------------------------------------------------------------------------------------------------
+///	@class		::OSRE::IO::PackFileSystem
+///	@ingroup	Infrastructure
+///
+///	@brief	Class which implements read access for OSRE packs, see PackWriter.
+///
+/// The whole pack will be mapped once. Lookups use a binary search over the hashed entry table,
+/// uncompressed entries will be returned as views into the mapping without any copy.
+//-------------------------------------------------------------------------------------------------
+class PackFileSystem : public AbstractFileSystem {
+public:
+    ///	The class constructor with the pack name.
+    PackFileSystem( const Uri &archive );
+    ///	The class destructor.
+    ~PackFileSystem() override;
+    ///	Opens a file instance from the pack.
+    Stream *open( const Uri &filename, Stream::AccessMode mode ) override;
+    ///	Close an opened file from the pack.
+    void close( Stream **pFile ) override;
+    ///	Returns true, if file exists in this pack.
+    bool fileExist( const Uri &filename ) override;
+    /// Search for a given file.
+    Stream *find( const Uri &file, Stream::AccessMode mode, StringArray *pSearchPaths ) override;
+    ///	Returns the pack schema description.
+    const c8 *getSchema() const override;
+    ///	Returns the working directory.
+    String getWorkingDirectory() override;
+    ///	Pack streams can be read concurrently.
+    bool supportsConcurrentReads() const override;
+
+public:
+    ///	Returns true, if the pack was mapped and is valid.
+    bool isOpened() const;
+    ///	Returns the file list in the pack.
+    void getFileList( std::vector<String> &fileList ) const;
+    ///	Returns the table entry of a file, nullptr if the file is not stored in the pack.
+    const PackEntry *getEntry( const String &path ) const;
+
+private:
+    bool mapArchive( const Uri &archive );
+    bool validate() const;
+    const PackEntry *findEntry( const Uri &file ) const;
+
+private:
+    using StreamSet = std::set<Stream*>;
+
+    MappedFileStream *mArchive;
+    const uc8 *mData;
+    size_t mSize;
+    const PackHeader *mHeader;
+    const PackEntry *mEntries;
+    const c8 *mNames;
+    StreamSet mOpenStreams;
+    std::mutex mLock;
+};
+
+} // Namespace IO
+} // Namespace OSRE
@@ -63,6 +63,19 @@ bool Stream::canBeMapped() const {
     return false;
 }
 
+const uc8 *Stream::getMappedData() const {
+    return nullptr;
+}
+
+const uc8 *Stream::getView(size_t offset, size_t size) const {
+    const uc8 *data = getMappedData();
+    if (nullptr == data || offset > getSize() || size > getSize() - offset) {
+        return nullptr;
+    }
+
+    return data + offset;
+}
+
 void Stream::setAccessMode(AccessMode accessMode) {
     m_AccessMode = accessMode;
 }
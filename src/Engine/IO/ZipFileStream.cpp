@@ -22,25 +22,21 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "ZipFileStream.h"
 
-#include <algorithm>
 #include <cassert>
-#include <iostream>
 
 namespace OSRE {
 namespace IO {
 
-ZipFileStream::ZipFileStream(const Uri &uri, unzFile zipFile) :
+ZipFileStream::ZipFileStream(const Uri &uri, ZipFileSystem *fileSystem, const ZipEntry &entry) :
         Stream(uri, AccessMode::ReadAccess),
-        m_zipFile(zipFile),
-        m_bDirty(true) {
-    assert(nullptr != zipFile);
+        m_fileSystem(fileSystem),
+        m_entry(entry) {
+    assert(nullptr != fileSystem);
 }
 
 ZipFileStream::~ZipFileStream() {
-    if (nullptr != m_zipFile) {
-        unzClose(m_zipFile);
-        m_zipFile = nullptr;
-    }
+    // The archive handles are owned by the file system
+    m_fileSystem = nullptr;
 }
 
 bool ZipFileStream::canRead() const {
@@ -49,57 +45,20 @@ bool ZipFileStream::canRead() const {
 
 size_t ZipFileStream::read(void *buffer, size_t size) {
     assert(nullptr != buffer);
-    assert(nullptr != m_zipFile);
 
-    size_t filesize = 0;
-    if (0 == size) {
-        return filesize;
+    if (0 == size || nullptr == m_fileSystem) {
+        return 0;
     }
 
-    if (nullptr != m_zipFile) {
-        // get the filename
-        const String &abspath = getUri().getAbsPath();
-
-        // search file and place file pointer there
-        if (unzLocateFile(m_zipFile, abspath.c_str(), 0) == UNZ_OK) {
-            // get file size, etc.
-            unz_file_info fileInfo;
-            unzGetCurrentFileInfo(m_zipFile, &fileInfo, 0, 0, 0, 0, 0, 0);
-            assert(size <= fileInfo.uncompressed_size);
-
-            // The file has EXACTLY the size of uncompressed_size. In C
-            // you need to mark the last character with '\0', so add
-            // another character
-            unzOpenCurrentFile(m_zipFile);
-            i32 bytesRead = unzReadCurrentFile(m_zipFile, buffer, fileInfo.uncompressed_size);
-            if (bytesRead < 0 || bytesRead != (i32)fileInfo.uncompressed_size) {
-                return filesize;
-            }
-
-            filesize = fileInfo.uncompressed_size;
-            unzCloseCurrentFile(m_zipFile);
-        }
-    }
-
-    return filesize;
+    return m_fileSystem->readEntry(m_entry, buffer, size);
 }
 
 size_t ZipFileStream::getSize() const {
-    // get the filename
-    const String &abspath = getUri().getAbsPath();
-
-    // look for the file and return its size
-    if (unzLocateFile(m_zipFile, abspath.c_str(), 0) == UNZ_OK) {
-        unz_file_info fileInfo;
-        unzGetCurrentFileInfo(m_zipFile, &fileInfo, 0, 0, 0, 0, 0, 0);
-        return fileInfo.uncompressed_size;
-    }
-
-    return 0;
+    return m_entry.mSize;
 }
 
 bool ZipFileStream::isOpen() const {
-    return (nullptr != m_zipFile);
+    return (nullptr != m_fileSystem);
 }
 
 } // Namespace IO
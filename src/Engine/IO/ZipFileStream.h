@@ -24,7 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <osre/IO/Stream.h>
 
-#include "contrib/unzip/unzip.h"
+#include "ZipFileSystem.h"
 
 namespace OSRE {
 namespace IO {
@@ -36,11 +36,12 @@ namespace IO {
 ///	@brief	File instance for files stored in a zip archive. 
 ///
 /// If you requests access to data in a zip archive the zip file-system will return you a pointer to a zip file. 
+/// The stream stores the index entry of its file, every read decompresses it with a pooled archive handle.
 //--------------------------------------------------------------------------------------------------------------------
 class ZipFileStream : public Stream {
 public:
 	///	The class constructor.
-	ZipFileStream( const Uri &rURI, unzFile zipFile );
+	ZipFileStream( const Uri &rURI, ZipFileSystem *fileSystem, const ZipEntry &entry );
 	///	The class destructor.
 	~ZipFileStream() override;
 	///	Read operations are supported.
@@ -53,8 +54,8 @@ public:
 	bool isOpen() const override;
 
 private:
-	unzFile m_zipFile;
-	bool m_bDirty;
+	ZipFileSystem *m_fileSystem;
+	ZipEntry m_entry;
 };
 
 } // Namespace IO
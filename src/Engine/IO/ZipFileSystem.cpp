@@ -25,9 +25,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/IO/IOSystemInfo.h>
 #include <osre/Common/Logger.h>
 #include <osre/Debugging/osre_debugging.h>
+#include <osre/Threading/ThreadPool.h>
 
 #include <map>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 
 namespace OSRE {
@@ -39,10 +41,13 @@ static const c8 *ZipSchema = "zip";
 static const c8 *Tag = "ZipFileSystem";
 
 ZipFileSystem::ZipFileSystem( const Uri &archive ) 
-: m_FileMap()
+: m_OpenStreams()
 , m_FileList()
+, m_Entries()
 , m_ArchiveName( archive.getAbsPath() )
 , m_ZipFileHandle( nullptr )
+, m_FreeHandles()
+, m_Lock()
 , m_Dirty( true ) {
     if ( openArchive() ) {
         mapArchive();
@@ -51,6 +56,11 @@ ZipFileSystem::ZipFileSystem( const Uri &archive )
 
 ZipFileSystem::~ZipFileSystem() {
     closeAllFiles();
+    for ( unzFile handle : m_FreeHandles ) {
+        unzClose( handle );
+    }
+    m_FreeHandles.clear();
+
     if (nullptr != m_ZipFileHandle ) {
         unzClose( m_ZipFileHandle );
         m_ZipFileHandle = nullptr;
@@ -58,27 +68,26 @@ ZipFileSystem::~ZipFileSystem() {
 }
 
 Stream *ZipFileSystem::open( const Uri &file, Stream::AccessMode mode ) {
-    if ( !isOpened() || mode != Stream::AccessMode::ReadAccess ) {
+    if ( !isOpened() ) {
         return nullptr;
     }
-    
+    if ( mode != Stream::AccessMode::ReadAccess && mode != Stream::AccessMode::ReadAccessBinary ) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock( m_Lock );
+
     // ensure mapped archive
     if ( m_Dirty ) {
         mapArchive();
     }
 
-    // look if file is already open
-    StreamMap::const_iterator it( m_FileMap.find( file.getResource() ) );
-    if( m_FileMap.end() != it ) {
-        return it->second;
-    }
-
+    // Every caller gets its own stream, so streams can be closed from different threads
     Stream *pZipStream( nullptr );
-    const String tmpName = file.getResource();
-    Uri uri( tmpName );
-    if ( fileExist( Uri( uri ) ) ) {
-        pZipStream = new ZipFileStream( uri, m_ZipFileHandle );
-        m_FileMap[ tmpName ] = pZipStream;
+    const ZipEntry *entry = findEntry( file );
+    if ( nullptr != entry ) {
+        pZipStream = new ZipFileStream( file, this, *entry );
+        m_OpenStreams.insert( pZipStream );
     }
 
     return pZipStream;
@@ -87,15 +96,14 @@ Stream *ZipFileSystem::open( const Uri &file, Stream::AccessMode mode ) {
 void ZipFileSystem::close( Stream **ppZipFileStream ) {
     osre_assert( nullptr != *ppZipFileStream );
     
-    const String &name = ( *ppZipFileStream )->getUri().getResource();
-    StreamMap::iterator it = m_FileMap.find( name );
-    if ( m_FileMap.end() == it ) {
+    std::lock_guard<std::mutex> lock( m_Lock );
+    StreamSet::iterator it = m_OpenStreams.find( *ppZipFileStream );
+    if ( m_OpenStreams.end() == it ) {
         return;
     }
 
-    Stream *zipFilestream = (*it).second;
-    delete zipFilestream;
-    m_FileMap.erase( it );
+    m_OpenStreams.erase( it );
+    delete *ppZipFileStream;
     (*ppZipFileStream) = nullptr;
 }
 
@@ -105,12 +113,8 @@ bool ZipFileSystem::fileExist( const Uri &file ) {
         return false;
     }
     
-    std::vector<String>::iterator it = std::find( m_FileList.begin(), m_FileList.end(), file.getResource() );
-    if ( m_FileList.end() == it ) {
-        return false;
-    }
-    
-    return true;
+    std::lock_guard<std::mutex> lock( m_Lock );
+    return nullptr != findEntry( file );
 }
 
 Stream *ZipFileSystem::find(const Uri &file, Stream::AccessMode mode, StringArray *searchPaths) {
@@ -148,7 +152,12 @@ String ZipFileSystem::getWorkingDirectory() {
 
 }
 
+bool ZipFileSystem::supportsConcurrentReads() const {
+    return true;
+}
+
 void ZipFileSystem::getFileList( std::vector<String> &rFileList ) {
+    std::lock_guard<std::mutex> lock( m_Lock );
     if (nullptr == m_ZipFileHandle ) {
         rFileList.resize( 0 );
     } else {
@@ -156,10 +165,75 @@ void ZipFileSystem::getFileList( std::vector<String> &rFileList ) {
     }
 }
 
+const ZipEntry *ZipFileSystem::getEntry( const String &name ) const {
+    std::lock_guard<std::mutex> lock( m_Lock );
+    EntryMap::const_iterator it( m_Entries.find( name ) );
+    if ( m_Entries.end() == it ) {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+size_t ZipFileSystem::readFiles( const std::vector<String> &files, std::vector<std::vector<uc8>> &data ) {
+    data.resize( files.size() );
+    std::vector<const ZipEntry*> entries( files.size(), nullptr );
+    for ( size_t i = 0; i < files.size(); ++i ) {
+        entries[ i ] = getEntry( files[ i ] );
+    }
+
+    // Every batch decompresses with its own archive handle
+    std::atomic<size_t> numRead( 0 );
+    Threading::ThreadPool::getDefault().parallelFor( files.size(), 1, [&]( size_t begin, size_t end ) {
+        for ( size_t i = begin; i < end; ++i ) {
+            std::vector<uc8> &buffer = data[ i ];
+            buffer.clear();
+            if ( nullptr == entries[ i ] ) {
+                osre_debug( Tag, "Cannot find " + files[ i ] );
+                continue;
+            }
+            buffer.resize( entries[ i ]->mSize );
+            if ( buffer.empty() || readEntry( *entries[ i ], &buffer[ 0 ], buffer.size() ) == buffer.size() ) {
+                ++numRead;
+            } else {
+                buffer.clear();
+            }
+        }
+    } );
+
+    return numRead;
+}
+
+size_t ZipFileSystem::readEntry( const ZipEntry &entry, void *buffer, size_t size ) {
+    osre_assert( nullptr != buffer );
+
+    if ( 0 == size || 0 == entry.mSize ) {
+        return 0;
+    }
+
+    unzFile handle = acquireHandle();
+    if ( nullptr == handle ) {
+        return 0;
+    }
+
+    size_t bytesRead = 0;
+    unz_file_pos position = entry.mPosition;
+    if ( UNZ_OK == unzGoToFilePos( handle, &position ) && UNZ_OK == unzOpenCurrentFile( handle ) ) {
+        const size_t toRead = std::min( size, entry.mSize );
+        const i32 result = unzReadCurrentFile( handle, buffer, static_cast<unsigned>( toRead ) );
+        if ( result > 0 ) {
+            bytesRead = static_cast<size_t>( result );
+        }
+        unzCloseCurrentFile( handle );
+    }
+    releaseHandle( handle );
+
+    return bytesRead;
+}
+
 bool ZipFileSystem::openArchive() {
     osre_assert(nullptr == m_ZipFileHandle );
 
-    String current_dir = IOSystemInfo::getCurrentDirectory();
     if (m_ArchiveName.empty()) {
         return false;
     }
@@ -179,23 +253,23 @@ bool ZipFileSystem::isOpened() const {
 void ZipFileSystem::mapArchive() {
     osre_assert(nullptr != m_ZipFileHandle );
 
-    if (!m_FileList.empty()) {
-        m_FileList.resize(0);
-    }
+    m_FileList.resize( 0 );
+    m_Entries.clear();
 
-    //	at first ensure file is already open
-    if ( UNZ_OK == unzGoToFirstFile( m_ZipFileHandle ) )  {
-        c8 filename[ FileNameSize ];
-        unzGetCurrentFileInfo( m_ZipFileHandle, NULL, filename, FileNameSize, NULL, 0, NULL, 0 );
-        m_FileList.push_back( filename );
-        unzCloseCurrentFile( m_ZipFileHandle );
-            
-        // loop over all files
-        while ( unzGoToNextFile( m_ZipFileHandle ) != UNZ_END_OF_LIST_OF_FILE )  {
-            unzGetCurrentFileInfo( m_ZipFileHandle, NULL, filename, FileNameSize, NULL, 0, NULL, 0);
-            m_FileList.push_back( filename );
-            unzCloseCurrentFile( m_ZipFileHandle );
+    // Index the central directory once, reads will seek directly to the stored position
+    c8 filename[ FileNameSize ];
+    unz_file_info fileInfo;
+    for ( i32 result = unzGoToFirstFile( m_ZipFileHandle ); UNZ_OK == result; result = unzGoToNextFile( m_ZipFileHandle ) ) {
+        if ( UNZ_OK != unzGetCurrentFileInfo( m_ZipFileHandle, &fileInfo, filename, FileNameSize, NULL, 0, NULL, 0 ) ) {
+            continue;
         }
+
+        ZipEntry entry;
+        unzGetFilePos( m_ZipFileHandle, &entry.mPosition );
+        entry.mCompressedSize = fileInfo.compressed_size;
+        entry.mSize = fileInfo.uncompressed_size;
+        m_Entries[ filename ] = entry;
+        m_FileList.push_back( filename );
     }
     
     std::sort( m_FileList.begin(), m_FileList.end() );
@@ -203,7 +277,47 @@ void ZipFileSystem::mapArchive() {
 }
 
 void ZipFileSystem::closeAllFiles() {
-    /// TODO: implement me
+    std::lock_guard<std::mutex> lock( m_Lock );
+    for ( Stream *stream : m_OpenStreams ) {
+        delete stream;
+    }
+    m_OpenStreams.clear();
+}
+
+const ZipEntry *ZipFileSystem::findEntry( const Uri &file ) const {
+    // Files in folders are stored with their full path
+    EntryMap::const_iterator it( m_Entries.find( file.getAbsPath() ) );
+    if ( m_Entries.end() == it ) {
+        it = m_Entries.find( file.getResource() );
+    }
+    if ( m_Entries.end() == it ) {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+unzFile ZipFileSystem::acquireHandle() {
+    {
+        std::lock_guard<std::mutex> lock( m_Lock );
+        if ( !m_FreeHandles.empty() ) {
+            unzFile handle = m_FreeHandles.back();
+            m_FreeHandles.pop_back();
+            return handle;
+        }
+    }
+
+    unzFile handle = unzOpen( m_ArchiveName.c_str() );
+    if ( nullptr == handle ) {
+        osre_error( Tag, "Cannot open archive " + m_ArchiveName );
+    }
+
+    return handle;
+}
+
+void ZipFileSystem::releaseHandle( unzFile handle ) {
+    std::lock_guard<std::mutex> lock( m_Lock );
+    m_FreeHandles.push_back( handle );
 }
 
 } // Namespace IO
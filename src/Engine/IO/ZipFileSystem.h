@@ -25,18 +25,32 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/IO/AbstractFileSystem.h>
 #include "contrib/unzip/unzip.h"
 #include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 namespace OSRE {
 namespace IO {
 
+//-------------------------------------------------------------------------------------------------
+///	@brief	The index entry of a file stored in a zip archive.
+//-------------------------------------------------------------------------------------------------
+struct ZipEntry {
+    unz_file_pos mPosition;     ///< The position in the central directory.
+    size_t mCompressedSize;     ///< The compressed size in bytes.
+    size_t mSize;               ///< The uncompressed size in bytes.
+};
+
 //-------------------------------------------------------------------------------------------------
 ///	@class		::OSRE::IO::ZipFileSystem
 ///	@ingroup	Infrastructure
 ///
 ///	@brief	Class which implements access for Zip-archives. 
 ///    
-/// Currently only the read access is supported.
+/// Currently only the read access is supported. The central directory will be indexed once, 
+/// reads will use their own archive handle from a handle pool, so streams can be read from
+/// several threads at once.
 //-------------------------------------------------------------------------------------------------
 class ZipFileSystem : public AbstractFileSystem {
 public:
@@ -60,23 +74,39 @@ public:
     virtual const c8 *getSchema() const;
     ///	Returns the working directory.
     virtual String getWorkingDirectory();
+    ///	Zip streams can be read concurrently.
+    virtual bool supportsConcurrentReads() const;
 
 public:
     ///	Returns the file list in the archive.
     void getFileList( std::vector<String> &fileList );
+    ///	Returns the index entry of a file, nullptr if the file is not stored in the archive.
+    const ZipEntry *getEntry( const String &name ) const;
+    ///	Decompresses the given files in parallel, returns the number of decompressed files.
+    size_t readFiles( const std::vector<String> &files, std::vector<std::vector<uc8>> &data );
+    ///	Decompresses an entry into the buffer using a pooled archive handle.
+    size_t readEntry( const ZipEntry &entry, void *buffer, size_t size );
 
 private:
     bool openArchive();	
     bool isOpened() const;
     void mapArchive();
     void closeAllFiles();
+    const ZipEntry *findEntry( const Uri &file ) const;
+    unzFile acquireHandle();
+    void releaseHandle( unzFile handle );
 
 private:
-    StreamMap m_FileMap;
+    using EntryMap = std::unordered_map<String, ZipEntry>;
+    using StreamSet = std::set<Stream*>;
+
+    StreamSet m_OpenStreams;
     std::vector<String> m_FileList;
+    EntryMap m_Entries;
     String m_ArchiveName;
     unzFile m_ZipFileHandle;
-    ui32 m_numberOfRefs;
+    std::vector<unzFile> m_FreeHandles;
+    mutable std::mutex m_Lock;
     bool m_Dirty;
 };
 
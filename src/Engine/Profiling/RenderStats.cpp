@@ -0,0 +1,262 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Profiling/RenderStats.h>
+#include <osre/Profiling/PerformanceCounterRegistry.h>
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+
+namespace OSRE {
+namespace Profiling {
+
+namespace Details {
+
+static constexpr ui32 NoPass = MaxRenderStatsPasses;
+
+// Recorded by the render thread only, the snapshot is shared with other threads
+struct RenderStatsData {
+    RenderStatsSnapshot mCurrent;
+    ui32 mActivePass = NoPass;
+    std::chrono::steady_clock::time_point mCpuStart;
+    std::mutex mMutex;
+    RenderStatsSnapshot mPublished;
+};
+
+static RenderStatsData &getData() {
+    static RenderStatsData data;
+    return data;
+}
+
+template <class TFunc>
+static void record(TFunc func) {
+    RenderStatsData &data = getData();
+    func(data.mCurrent.mTotal);
+    if (NoPass != data.mActivePass) {
+        func(data.mCurrent.mPasses[data.mActivePass]);
+    }
+}
+
+static const c8 *CounterNames[] = {
+    "draw_calls",
+    "instances",
+    "triangles",
+    "shader_binds",
+    "texture_binds",
+    "vertex_array_binds",
+    "uniform_uploads",
+    "buffer_bytes_uploaded",
+    "submit_cmds",
+    "submit_cmd_bytes",
+    "render_thread_us"
+};
+
+static constexpr size_t NumCounters = sizeof(CounterNames) / sizeof(CounterNames[0]);
+
+// The registry stores 32 bit values only
+static ui32 clampCounter(ui64 value) {
+    return value > 0xffffffffu ? 0xffffffffu : static_cast<ui32>(value);
+}
+
+} // Namespace Details
+
+RenderCounters::RenderCounters() :
+        mDrawCalls(0),
+        mInstances(0),
+        mTriangles(0),
+        mShaderBinds(0),
+        mTextureBinds(0),
+        mVertexArrayBinds(0),
+        mUniformUploads(0),
+        mBufferBytesUploaded(0) {
+    // empty
+}
+
+void RenderCounters::add(const RenderCounters &rhs) {
+    mDrawCalls += rhs.mDrawCalls;
+    mInstances += rhs.mInstances;
+    mTriangles += rhs.mTriangles;
+    mShaderBinds += rhs.mShaderBinds;
+    mTextureBinds += rhs.mTextureBinds;
+    mVertexArrayBinds += rhs.mVertexArrayBinds;
+    mUniformUploads += rhs.mUniformUploads;
+    mBufferBytesUploaded += rhs.mBufferBytesUploaded;
+}
+
+void RenderCounters::clear() {
+    *this = RenderCounters();
+}
+
+RenderStatsSnapshot::RenderStatsSnapshot() :
+        mFrame(0),
+        mTotal(),
+        mNumPasses(0),
+        mPassIds(),
+        mPasses(),
+        mSubmitCmds(0),
+        mSubmitCmdBytes(0),
+        mRenderThreadTime(0) {
+    // empty
+}
+
+void RenderStats::registerCounters() {
+    for (size_t i = 0; i < Details::NumCounters; ++i) {
+        PerformanceCounterRegistry::registerCounter(Details::CounterNames[i]);
+    }
+}
+
+void RenderStats::beginPass(ui32 passId) {
+    Details::RenderStatsData &data = Details::getData();
+    RenderStatsSnapshot &current = data.mCurrent;
+
+    // Passes beyond the limit are accounted to the frame only
+    data.mActivePass = Details::NoPass;
+    if (current.mNumPasses < MaxRenderStatsPasses) {
+        data.mActivePass = current.mNumPasses++;
+        current.mPassIds[data.mActivePass] = passId;
+    }
+}
+
+void RenderStats::endPass() {
+    Details::getData().mActivePass = Details::NoPass;
+}
+
+void RenderStats::addDrawCall(ui32 numInstances, ui64 numTriangles) {
+    Details::record([numInstances, numTriangles](RenderCounters &counters) {
+        ++counters.mDrawCalls;
+        counters.mInstances += numInstances;
+        counters.mTriangles += numTriangles * numInstances;
+    });
+}
+
+void RenderStats::addShaderBind() {
+    Details::record([](RenderCounters &counters) { ++counters.mShaderBinds; });
+}
+
+void RenderStats::addTextureBind() {
+    Details::record([](RenderCounters &counters) { ++counters.mTextureBinds; });
+}
+
+void RenderStats::addVertexArrayBind() {
+    Details::record([](RenderCounters &counters) { ++counters.mVertexArrayBinds; });
+}
+
+void RenderStats::addUniformUpload() {
+    Details::record([](RenderCounters &counters) { ++counters.mUniformUploads; });
+}
+
+void RenderStats::addBufferUpload(size_t numBytes) {
+    Details::record([numBytes](RenderCounters &counters) { counters.mBufferBytesUploaded += numBytes; });
+}
+
+void RenderStats::addSubmitCmd(size_t numBytes) {
+    RenderStatsSnapshot &current = Details::getData().mCurrent;
+    ++current.mSubmitCmds;
+    current.mSubmitCmdBytes += numBytes;
+}
+
+void RenderStats::beginCpuTime() {
+    Details::getData().mCpuStart = std::chrono::steady_clock::now();
+}
+
+void RenderStats::endCpuTime() {
+    Details::RenderStatsData &data = Details::getData();
+    const auto elapsed = std::chrono::steady_clock::now() - data.mCpuStart;
+    data.mCurrent.mRenderThreadTime += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+void RenderStats::endFrame() {
+    Details::RenderStatsData &data = Details::getData();
+    RenderStatsSnapshot &current = data.mCurrent;
+    const RenderCounters &total = current.mTotal;
+
+    const ui64 values[Details::NumCounters] = {
+        total.mDrawCalls,
+        total.mInstances,
+        total.mTriangles,
+        total.mShaderBinds,
+        total.mTextureBinds,
+        total.mVertexArrayBinds,
+        total.mUniformUploads,
+        total.mBufferBytesUploaded,
+        current.mSubmitCmds,
+        current.mSubmitCmdBytes,
+        current.mRenderThreadTime
+    };
+    for (size_t i = 0; i < Details::NumCounters; ++i) {
+        PerformanceCounterRegistry::setCounter(Details::CounterNames[i], Details::clampCounter(values[i]));
+    }
+
+    const ui64 frame = data.mPublished.mFrame + 1;
+    {
+        std::lock_guard<std::mutex> lock(data.mMutex);
+        data.mPublished = current;
+        data.mPublished.mFrame = frame;
+    }
+    current = RenderStatsSnapshot();
+    data.mActivePass = Details::NoPass;
+}
+
+void RenderStats::getSnapshot(RenderStatsSnapshot &snapshot) {
+    Details::RenderStatsData &data = Details::getData();
+    std::lock_guard<std::mutex> lock(data.mMutex);
+    snapshot = data.mPublished;
+}
+
+void RenderStats::toString(const RenderStatsSnapshot &snapshot, String &text) {
+    const RenderCounters &total = snapshot.mTotal;
+    c8 buffer[256];
+    ::snprintf(buffer, sizeof(buffer), "Frame %llu: %.2f ms render thread\n",
+            static_cast<unsigned long long>(snapshot.mFrame), static_cast<d32>(snapshot.mRenderThreadTime) / 1000.0);
+    text = buffer;
+    ::snprintf(buffer, sizeof(buffer), "Draws %u, instances %u, triangles %llu\n",
+            total.mDrawCalls, total.mInstances, static_cast<unsigned long long>(total.mTriangles));
+    text += buffer;
+    ::snprintf(buffer, sizeof(buffer), "Binds: shader %u, texture %u, vao %u\n",
+            total.mShaderBinds, total.mTextureBinds, total.mVertexArrayBinds);
+    text += buffer;
+    ::snprintf(buffer, sizeof(buffer), "Uploads: uniforms %u, buffers %llu bytes\n",
+            total.mUniformUploads, static_cast<unsigned long long>(total.mBufferBytesUploaded));
+    text += buffer;
+    ::snprintf(buffer, sizeof(buffer), "Submit cmds %u, %llu bytes",
+            snapshot.mSubmitCmds, static_cast<unsigned long long>(snapshot.mSubmitCmdBytes));
+    text += buffer;
+    for (ui32 i = 0; i < snapshot.mNumPasses; ++i) {
+        const RenderCounters &pass = snapshot.mPasses[i];
+        ::snprintf(buffer, sizeof(buffer), "\nPass %u: draws %u, triangles %llu, binds %u/%u/%u",
+                snapshot.mPassIds[i], pass.mDrawCalls, static_cast<unsigned long long>(pass.mTriangles),
+                pass.mShaderBinds, pass.mTextureBinds, pass.mVertexArrayBinds);
+        text += buffer;
+    }
+}
+
+void RenderStats::reset() {
+    Details::RenderStatsData &data = Details::getData();
+    data.mCurrent = RenderStatsSnapshot();
+    data.mActivePass = Details::NoPass;
+    std::lock_guard<std::mutex> lock(data.mMutex);
+    data.mPublished = RenderStatsSnapshot();
+}
+
+} // Namespace Profiling
+} // Namespace OSRE
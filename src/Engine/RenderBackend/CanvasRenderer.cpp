@@ -1,25 +1,404 @@
-#include "CanvasRenderer.h"
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/RenderBackend/CanvasRenderer.h>
+#include <osre/RenderBackend/SpriteAtlas.h>
+#include <osre/RenderBackend/MaterialBuilder.h>
 #include <osre/RenderBackend/Mesh.h>
-#include <osre/RenderBackend/Shader.h>
+#include <osre/RenderBackend/MeshBuilder.h>
+#include <osre/RenderBackend/RenderBackendService.h>
+#include <osre/Common/Logger.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include <algorithm>
+#include <cstdio>
 
 namespace OSRE {
 namespace RenderBackend {
 
-CanvasRenderer::CanvasRenderer(RenderBackendService *rbSrv) : mRbSrv(rbSrv) {
+using namespace ::OSRE::Common;
+
+static constexpr c8 Tag[] = "CanvasRenderer";
+
+static constexpr ui32 NumQuadVertices = 4;
+
+// The texture of a batch mesh, which has no material yet
+static constexpr ui32 NoTexture = 0xffffffffu;
+
+// The fallback, when no viewport was set
+static constexpr f32 DefaultScreenWidth = 800.0f;
+static constexpr f32 DefaultScreenHeight = 600.0f;
 
+// Layers are sorted first, the bias keeps negative layers in front of the positive ones
+static ui64 getSortKey(i32 layer, ui32 texture) {
+    const ui32 biasedLayer = static_cast<ui32>(layer) ^ 0x80000000u;
+    return (static_cast<ui64>(biasedLayer) << 32) | texture;
+}
+
+static ui32 getTextureFromKey(ui64 key) {
+    return static_cast<ui32>(key & 0xffffffffu);
+}
+
+// Liang-Barsky clipping of a segment against a rectangle
+static bool clipLine(glm::vec2 &p0, glm::vec2 &p1, const glm::vec2 &clipMin, const glm::vec2 &clipMax) {
+    const glm::vec2 d = p1 - p0;
+    const f32 p[4] = { -d.x, d.x, -d.y, d.y };
+    const f32 q[4] = { p0.x - clipMin.x, clipMax.x - p0.x, p0.y - clipMin.y, clipMax.y - p0.y };
+    f32 t0 = 0.0f, t1 = 1.0f;
+    for (ui32 i = 0; i < 4; ++i) {
+        if (0.0f == p[i]) {
+            if (q[i] < 0.0f) {
+                return false;
+            }
+            continue;
+        }
+
+        const f32 t = q[i] / p[i];
+        if (p[i] < 0.0f) {
+            t0 = glm::max(t0, t);
+        } else {
+            t1 = glm::min(t1, t);
+        }
+        if (t0 > t1) {
+            return false;
+        }
+    }
+
+    p1 = p0 + d * t1;
+    p0 = p0 + d * t0;
+
+    return true;
+}
+
+CanvasRenderer::CanvasRenderer(RenderBackendService *rbSrv) :
+        mRbSrv(rbSrv),
+        mVertexCache(),
+        mQuads(),
+        mTextures(),
+        mMaterials(),
+        mBatchMeshes(),
+        mBatchNames(),
+        mWhiteTexture(nullptr),
+        mLastTexture(nullptr),
+        mLastTextureSlot(0),
+        mLayer(0),
+        mColor(1.0f),
+        mClipping(false),
+        mClipMin(0.0f),
+        mClipMax(0.0f),
+        mNumBatches(0) {
+    osre_assert(nullptr != mRbSrv);
+
+    // Untextured primitives use a white texture, so they can be batched like the textured ones
+    mWhiteTexture = new Texture;
+    mWhiteTexture->m_textureName = "canvas_white";
+    mWhiteTexture->m_width = 1;
+    mWhiteTexture->m_height = 1;
+    mWhiteTexture->m_channels = 3;
+    mWhiteTexture->m_size = 3;
+    mWhiteTexture->m_data = new uc8[3];
+    ::memset(mWhiteTexture->m_data, 255, 3);
+    getTextureSlot(mWhiteTexture);
 }
 
 CanvasRenderer::~CanvasRenderer() {
+    for (size_t i = 0; i < mBatchMeshes.size(); ++i) {
+        delete mBatchMeshes[i]->mMesh;
+        delete mBatchMeshes[i];
+    }
+    for (size_t i = 0; i < mMaterials.size(); ++i) {
+        MaterialBuilder::releaseMaterial(mMaterials[i]);
+    }
+    for (size_t i = 0; i < mBatchNames.size(); ++i) {
+        delete[] mBatchNames[i];
+    }
+    delete mWhiteTexture;
+}
+
+const c8 *CanvasRenderer::getCanvasRenderBatchName(ui32 slot) {
+    // The batches store the name pointer and are found by prefix, so the names have a fixed length
+    static constexpr size_t NameLen = 20;
+    while (mBatchNames.size() <= slot) {
+        c8 *name = new c8[NameLen];
+        ::snprintf(name, NameLen, "canvasBatch%06u", static_cast<ui32>(mBatchNames.size()));
+        mBatchNames.add(name);
+    }
+
+    return mBatchNames[slot];
+}
+
+void CanvasRenderer::setLayer(i32 layer) {
+    mLayer = layer;
+}
+
+void CanvasRenderer::setColor(const glm::vec3 &color) {
+    mColor = color;
+}
+
+void CanvasRenderer::setClipRect(i32 x, i32 y, i32 w, i32 h) {
+    mClipping = true;
+    mClipMin = glm::vec2(x, y);
+    mClipMax = glm::vec2(x + w, y + h);
+}
+
+void CanvasRenderer::resetClipRect() {
+    mClipping = false;
+}
+
+void CanvasRenderer::drawRect(i32 x, i32 y, i32 w, i32 h, bool filled) {
+    if (filled) {
+        addQuad(glm::vec2(x, y), glm::vec2(x + w, y + h), glm::vec2(0.0f), glm::vec2(1.0f), 0);
+        return;
+    }
+
+    // The outline as four one pixel quads, without overlapping corners
+    addQuad(glm::vec2(x, y), glm::vec2(x + w, y + 1), glm::vec2(0.0f), glm::vec2(1.0f), 0);
+    addQuad(glm::vec2(x, y + h - 1), glm::vec2(x + w, y + h), glm::vec2(0.0f), glm::vec2(1.0f), 0);
+    addQuad(glm::vec2(x, y + 1), glm::vec2(x + 1, y + h - 1), glm::vec2(0.0f), glm::vec2(1.0f), 0);
+    addQuad(glm::vec2(x + w - 1, y + 1), glm::vec2(x + w, y + h - 1), glm::vec2(0.0f), glm::vec2(1.0f), 0);
+}
+
+void CanvasRenderer::drawLine(i32 x0, i32 y0, i32 x1, i32 y1, f32 thickness) {
+    glm::vec2 p0(x0, y0), p1(x1, y1);
+    if (mClipping && !clipLine(p0, p1, mClipMin, mClipMax)) {
+        return;
+    }
+
+    const glm::vec2 d = p1 - p0;
+    const f32 len = glm::length(d);
+    if (len <= 0.0f) {
+        return;
+    }
 
+    const glm::vec2 n = glm::vec2(-d.y, d.x) * (0.5f * thickness / len);
+    const glm::vec2 corners[NumQuadVertices] = { p0 - n, p0 + n, p1 - n, p1 + n };
+    addQuad(corners, 0);
 }
 
-void CanvasRenderer::drawRect(i32 x, i32 y, i32 w, i32 h) {
+void CanvasRenderer::drawTexturedQuad(i32 x, i32 y, i32 w, i32 h, Texture *texture, const glm::vec2 &uv0, const glm::vec2 &uv1) {
+    if (nullptr == texture) {
+        osre_debug(Tag, "Texture is nullptr.");
+        return;
+    }
+
+    addQuad(glm::vec2(x, y), glm::vec2(x + w, y + h), uv0, uv1, getTextureSlot(texture));
+}
+
+bool CanvasRenderer::drawSprite(i32 x, i32 y, const SpriteAtlas &atlas, const String &name, f32 scale) {
+    const SpriteRegion *region = atlas.findRegion(name);
+    if (nullptr == region) {
+        osre_debug(Tag, "Sprite " + name + " not found.");
+        return false;
+    }
+
+    const glm::vec2 p0(x, y);
+    addQuad(p0, p0 + region->mSize * scale, region->mUv0, region->mUv1, getTextureSlot(atlas.getTexture()));
+
+    return true;
+}
 
+void CanvasRenderer::clear() {
+    mVertexCache.m_cache.resize(0);
+    mQuads.resize(0);
+}
+
+ui32 CanvasRenderer::getTextureSlot(Texture *texture) {
+    if (texture == mLastTexture) {
+        return mLastTextureSlot;
+    }
+
+    ui32 slot = 0;
+    while (slot < mTextures.size() && mTextures[slot] != texture) {
+        ++slot;
+    }
+    if (slot == mTextures.size()) {
+        mTextures.add(texture);
+        mMaterials.add(nullptr);
+    }
+    mLastTexture = texture;
+    mLastTextureSlot = slot;
+
+    return slot;
+}
+
+void CanvasRenderer::addQuad(const glm::vec2 &p0, const glm::vec2 &p1, const glm::vec2 &uv0, const glm::vec2 &uv1, ui32 texture) {
+    glm::vec2 q0(p0), q1(p1), t0(uv0), t1(uv1);
+    if (mClipping) {
+        // Cut the quad and its texture coordinates
+        const glm::vec2 extent = p1 - p0;
+        if (extent.x <= 0.0f || extent.y <= 0.0f) {
+            return;
+        }
+
+        q0 = glm::max(p0, mClipMin);
+        q1 = glm::min(p1, mClipMax);
+        if (q0.x >= q1.x || q0.y >= q1.y) {
+            return;
+        }
+
+        const glm::vec2 uvScale = (uv1 - uv0) / extent;
+        t0 = uv0 + (q0 - p0) * uvScale;
+        t1 = uv0 + (q1 - p0) * uvScale;
+    }
+
+    const glm::vec2 corners[NumQuadVertices] = { q0, glm::vec2(q0.x, q1.y), glm::vec2(q1.x, q0.y), q1 };
+    const glm::vec2 uvs[NumQuadVertices] = { t0, glm::vec2(t0.x, t1.y), glm::vec2(t1.x, t0.y), t1 };
+
+    QuadCmd cmd;
+    cmd.mKey = getSortKey(mLayer, texture);
+    cmd.mFirstVertex = static_cast<ui32>(mVertexCache.numVertices());
+    mQuads.add(cmd);
+    for (ui32 i = 0; i < NumQuadVertices; ++i) {
+        RenderVert v;
+        v.position = glm::vec3(corners[i], 0.0f);
+        v.color0 = mColor;
+        v.tex0 = uvs[i];
+        mVertexCache.add(v);
+    }
+}
+
+void CanvasRenderer::addQuad(const glm::vec2 corners[4], ui32 texture) {
+    QuadCmd cmd;
+    cmd.mKey = getSortKey(mLayer, texture);
+    cmd.mFirstVertex = static_cast<ui32>(mVertexCache.numVertices());
+    mQuads.add(cmd);
+
+    // The white texture is sampled at its center
+    for (ui32 i = 0; i < NumQuadVertices; ++i) {
+        RenderVert v;
+        v.position = glm::vec3(corners[i], 0.0f);
+        v.color0 = mColor;
+        v.tex0 = glm::vec2(0.5f);
+        mVertexCache.add(v);
+    }
+}
+
+CanvasRenderer::BatchMesh *CanvasRenderer::getBatchMesh(ui32 slot, ui32 texture) {
+    // Slots are used in order, so a new slot is always the next one
+    if (slot == mBatchMeshes.size()) {
+        MeshBuilder meshBuilder;
+        meshBuilder.allocStreamingMesh("canvas", VertexType::RenderVertex, BatchCapacity * NumQuadVertices, PrimitiveType::TriangleList);
+        BatchMesh *batch = new BatchMesh;
+        batch->mTexture = NoTexture;
+        batch->mMesh = meshBuilder.getMesh();
+        batch->mNumQuads = 0;
+        batch->mAdded = false;
+        batch->mDirty = false;
+        mBatchMeshes.add(batch);
+    }
+
+    // The mesh of a slot is reused, a changed texture rebinds its material only
+    BatchMesh *batch = mBatchMeshes[slot];
+    if (batch->mTexture != texture) {
+        if (nullptr == mMaterials[texture]) {
+            mMaterials[texture] = MaterialBuilder::createCanvasMaterial("canvas_" + mTextures[texture]->m_textureName,
+                    mTextures[texture]);
+        }
+        batch->mMesh->setMaterial(mMaterials[texture]);
+        batch->mTexture = texture;
+        batch->mDirty = true;
+    }
+
+    return batch;
+}
+
+void CanvasRenderer::writeBatch(BatchMesh *batch, const QuadCmd *cmds, ui32 numQuads) {
+    // Unchanged quads will not be written again, so a static ui causes no upload
+    const size_t quadSize = sizeof(RenderVert) * NumQuadVertices;
+    c8 *data = batch->mMesh->getVertexBuffer()->getData();
+    for (ui32 i = 0; i < numQuads; ++i) {
+        const RenderVert *src = &mVertexCache.m_cache[cmds[i].mFirstVertex];
+        c8 *dest = data + i * quadSize;
+        if (i >= batch->mNumQuads || 0 != ::memcmp(dest, src, quadSize)) {
+            ::memcpy(dest, src, quadSize);
+            batch->mDirty = true;
+        }
+    }
+    if (numQuads != batch->mNumQuads) {
+        MeshBuilder::setNumStreamingVertices(batch->mMesh, numQuads * NumQuadVertices);
+        batch->mDirty = true;
+    }
+    batch->mNumQuads = numQuads;
 }
 
 void CanvasRenderer::render() {
+    // Sort by layer and texture, quads with the same key keep their order
+    if (!mQuads.isEmpty()) {
+        std::stable_sort(&mQuads[0], &mQuads[0] + mQuads.size(), [](const QuadCmd &a, const QuadCmd &b) {
+            return a.mKey < b.mKey;
+        });
+    }
+
+    // Quads with the same texture in a row share one draw call
+    ui32 slot = 0;
+    size_t start = 0;
+    while (start < mQuads.size()) {
+        const ui32 texture = getTextureFromKey(mQuads[start].mKey);
+        size_t end = start + 1;
+        while (end < mQuads.size() && end - start < BatchCapacity && getTextureFromKey(mQuads[end].mKey) == texture) {
+            ++end;
+        }
+
+        writeBatch(getBatchMesh(slot, texture), &mQuads[start], static_cast<ui32>(end - start));
+        ++slot;
+        start = end;
+    }
+    mNumBatches = slot;
+
+    // Slots not used in this frame draw nothing
+    for (size_t i = slot; i < mBatchMeshes.size(); ++i) {
+        BatchMesh *batch = mBatchMeshes[i];
+        if (batch->mNumQuads > 0) {
+            MeshBuilder::setNumStreamingVertices(batch->mMesh, 0);
+            batch->mNumQuads = 0;
+            batch->mDirty = true;
+        }
+    }
+
+    const Viewport &viewport = mRbSrv->getViewport();
+    const f32 w = viewport.m_w > 0 ? static_cast<f32>(viewport.m_w) : DefaultScreenWidth;
+    const f32 h = viewport.m_h > 0 ? static_cast<f32>(viewport.m_h) : DefaultScreenHeight;
+
+    // One render batch per draw slot keeps the layer order between the draw calls
+    mRbSrv->beginPass(RenderPass::getPassNameById(UiPassId));
+    for (ui32 i = 0; i < mBatchMeshes.size(); ++i) {
+        mRbSrv->beginRenderBatch(getCanvasRenderBatchName(i));
+        mRbSrv->setMatrix(MatrixType::Model, glm::mat4(1.0f));
+        mRbSrv->setMatrix(MatrixType::View, glm::mat4(1.0f));
+        mRbSrv->setMatrix(MatrixType::Projection, glm::ortho(0.0f, w, 0.0f, h));
+        BatchMesh *batch = mBatchMeshes[i];
+        if (!batch->mAdded) {
+            mRbSrv->addMesh(batch->mMesh, 0);
+            batch->mAdded = true;
+        } else if (batch->mDirty) {
+            mRbSrv->updateMesh(batch->mMesh);
+        }
+        batch->mDirty = false;
+        mRbSrv->endRenderBatch();
+    }
+    mRbSrv->endPass();
 
+    clear();
 }
 
-} // namespace RenderBackend
-} // namespace OSRE
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -29,24 +29,76 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/RenderBackend/DbgRenderer.h>
 #include <osre/RenderBackend/MaterialBuilder.h>
 #include <osre/RenderBackend/MeshBuilder.h>
+#include <osre/Common/Logger.h>
+#include <osre/IO/Uri.h>
+#include <osre/Profiling/RenderStats.h>
 
 namespace OSRE {
 namespace RenderBackend {
 
 using namespace ::OSRE::Common;
 
+static constexpr c8 Tag[] = "DbgRenderer";
+
+static constexpr ui32 NumQuadVertices = 4;
+static constexpr ui32 NumBoxEdges = 12;
+
+static constexpr ui32 BoxEdges[NumBoxEdges * 2] = {
+    0, 1,
+    1, 2,
+    2, 3,
+    3, 0,
+    4, 5,
+    5, 6,
+    6, 7,
+    7, 4,
+    0, 4,
+    1, 5,
+    2, 6,
+    3, 7
+};
+
+// The fallback, when no viewport was set
+static constexpr f32 DefaultScreenWidth = 800.0f;
+static constexpr f32 DefaultScreenHeight = 600.0f;
+
+// Overwrites the queued vertices, only these will be drawn
+template<class TVert>
+static void updateStreamMesh(Mesh *mesh, const cppcore::TArray<TVert> &queued) {
+    if (!queued.isEmpty()) {
+        ::memcpy(mesh->getVertexBuffer()->getData(), &queued[0], sizeof(TVert) * queued.size());
+    }
+    MeshBuilder::setNumStreamingVertices(mesh, queued.size());
+}
+
 DbgRenderer *DbgRenderer::sInstance = nullptr;
 
 DbgRenderer::DbgRenderer(RenderBackendService *rbSrv) :
         mRbSrv(rbSrv),
-        mDebugMesh(nullptr),
-        mDebugTextMeshes(),
-        mLastIndex(0) {
+        mFont("buildin_arial"),
+        mLineVertices(),
+        mTextVertices(),
+        mLineMesh(nullptr),
+        mTextMesh(nullptr),
+        mLineCapacity(DefaultLineCapacity),
+        mGlyphCapacity(DefaultGlyphCapacity),
+        mNumLineVerticesWritten(0),
+        mNumGlyphsWritten(0),
+        mView(1.0f),
+        mProjection(1.0f),
+        mMatricesDirty(true) {
     osre_assert(nullptr != mRbSrv);
+
+    // The build-in font texture contains 16 x 16 glyphs
+    mFont.createGrid(IO::Uri("file://assets/Textures/Fonts/buildin_arial.bmp"), 16, 16, DefaultTextSize);
 }
 
 DbgRenderer::~DbgRenderer() {
-    clear();
+    if (nullptr != mLineMesh) {
+        MaterialBuilder::releaseMaterial(mLineMesh->getMaterial());
+    }
+    delete mLineMesh;
+    delete mTextMesh;
 }
 
 bool DbgRenderer::create(RenderBackendService *rbSrv) {
@@ -76,166 +128,192 @@ const c8 *DbgRenderer::getDebugRenderBatchName() {
     return name;
 }
 
-void DbgRenderer::renderDbgText(ui32 x, ui32 y, guid id, const String &text) {
-    osre_assert(mRbSrv != nullptr);
-    
+const c8 *DbgRenderer::getDebugTextRenderBatchName() {
+    static constexpr c8 name[] = "dbgTextBatch";
+    return name;
+}
+
+void DbgRenderer::renderDbgText(ui32 x, ui32 y, const String &text, f32 size) {
     if (text.empty()) {
         return;
     }
-    DebugText *foundDebugText = getInstance()->getDebugText(id);
-    mRbSrv->beginPass(RenderPass::getPassNameById(DbgPassId));
-    mRbSrv->beginRenderBatch(DbgRenderer::getDebugRenderBatchName());
-    glm::mat4 projection = glm::ortho(0.0f, 800.0f, 0.0f, 600.0f);
-    mRbSrv->setMatrix(MatrixType::Projection, projection);
-    if (foundDebugText == nullptr) {
-        MeshBuilder meshBuilder;
-        meshBuilder.allocTextBox(static_cast<f32>(x), static_cast<f32>(y), 20, text, BufferAccessType::ReadWrite);
-        DebugText *entry = new DebugText;
-        entry->mesh = meshBuilder.getMesh();
-        entry->mesh->setId(id);
-        getInstance()->mDebugTextMeshes.add(entry);
-        mRbSrv->setMatrix(MatrixType::Projection, projection);
-        mRbSrv->addMesh(entry->mesh, 0);
-    } else if (foundDebugText->text != text) {
-        MeshBuilder::updateTextBox(foundDebugText->mesh, 10, text);
-        mRbSrv->updateMesh(foundDebugText->mesh);
+
+    const size_t numVertices = mTextVertices.size();
+    const ui32 numGlyphs = mFont.layoutText(text, glm::vec2(x, y), size, glm::vec3(0.0f), mTextVertices);
+    const size_t numQueued = numVertices / NumQuadVertices + numGlyphs;
+    if (numQueued > mGlyphCapacity) {
+        osre_debug(Tag, "Glyph capacity exceeded, text clipped.");
+        mTextVertices.resize(mGlyphCapacity * NumQuadVertices);
     }
-    mRbSrv->endRenderBatch();
-    mRbSrv->endPass();
 }
 
-static constexpr size_t NumIndices = 24;
-
-static ui16 indices[NumIndices] = {
-    0, 1,
-    1, 2,
-    2, 3,
-    3, 0,
-    4, 5,
-    5, 6,
-    6, 7,
-    7, 4,
-    0, 4,
-    1, 5,
-    2, 6,
-    3, 7
-};
-
-void DbgRenderer::renderAABB(const glm::mat4 &transform, const AABB &aabb) {
-    osre_assert(mRbSrv != nullptr);
+void DbgRenderer::renderStats(ui32 x, ui32 y, f32 size) {
+    Profiling::RenderStatsSnapshot snapshot;
+    Profiling::RenderStats::getSnapshot(snapshot);
+    if (0 == snapshot.mFrame) {
+        return;
+    }
 
-    MeshBuilder meshBuilder;
-    meshBuilder.allocEmptyMesh("aabb", VertexType::ColorVertex);
-    Mesh *mesh = meshBuilder.getMesh();
+    String text;
+    Profiling::RenderStats::toString(snapshot, text);
+    renderDbgText(x, y, text, size);
+}
 
-    static const ui32 NumVertices = 8;
-    ColorVert vertices[NumVertices];
+void DbgRenderer::renderAABB(const glm::mat4 &transform, const AABB &aabb, const glm::vec3 &color) {
     const glm::vec3 &min(aabb.getMin());
     const glm::vec3 &max(aabb.getMax());
-    f32 x0(min.x), y0(min.y), z0(min.z), x1(max.x), y1(max.y), z1(max.z);
-    vertices[0].position.x = x0;
-    vertices[0].position.y = y0;
-    vertices[0].position.z = z0;
-
-    vertices[1].position.x = x1;
-    vertices[1].position.y = y0;
-    vertices[1].position.z = z0;
-
-    vertices[2].position.x = x1;
-    vertices[2].position.y = y1;
-    vertices[2].position.z = z0;
+    const glm::vec3 corners[8] = {
+        glm::vec3(min.x, min.y, min.z),
+        glm::vec3(max.x, min.y, min.z),
+        glm::vec3(max.x, max.y, min.z),
+        glm::vec3(min.x, max.y, min.z),
+        glm::vec3(min.x, min.y, max.z),
+        glm::vec3(max.x, min.y, max.z),
+        glm::vec3(max.x, max.y, max.z),
+        glm::vec3(min.x, max.y, max.z)
+    };
+
+    glm::vec3 world[8];
+    for (ui32 i = 0; i < 8; ++i) {
+        world[i] = glm::vec3(transform * glm::vec4(corners[i], 1.0f));
+    }
+    for (ui32 i = 0; i < NumBoxEdges; ++i) {
+        addLine(world[BoxEdges[i * 2]], world[BoxEdges[i * 2 + 1]], color);
+    }
+}
 
-    vertices[3].position.x = x0;
-    vertices[3].position.y = y1;
-    vertices[3].position.z = z0;
+void DbgRenderer::renderSphere(const glm::vec3 &center, f32 radius, const glm::vec3 &color) {
+    const f32 step = glm::two_pi<f32>() / NumSphereSegments;
+    for (ui32 axis = 0; axis < 3; ++axis) {
+        glm::vec3 last;
+        for (ui32 i = 0; i <= NumSphereSegments; ++i) {
+            const f32 angle = step * static_cast<f32>(i % NumSphereSegments);
+            const f32 c = std::cos(angle) * radius;
+            const f32 s = std::sin(angle) * radius;
+            glm::vec3 p(center);
+            p[(axis + 1) % 3] += c;
+            p[(axis + 2) % 3] += s;
+            if (i > 0) {
+                addLine(last, p, color);
+            }
+            last = p;
+        }
+    }
+}
 
-    vertices[4].position.x = x0;
-    vertices[4].position.y = y0;
-    vertices[4].position.z = z1;
+void DbgRenderer::addLine(const ColorVert &v0, const ColorVert &v1) {
+    if (mLineVertices.size() + 2 > mLineCapacity) {
+        osre_debug(Tag, "Line capacity exceeded, line dropped.");
+        return;
+    }
 
-    vertices[5].position.x = x1;
-    vertices[5].position.y = y0;
-    vertices[5].position.z = z1;
+    mLineVertices.add(v0);
+    mLineVertices.add(v1);
+}
 
-    vertices[6].position.x = x1;
-    vertices[6].position.y = y1;
-    vertices[6].position.z = z1;
+void DbgRenderer::addLine(const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &color) {
+    ColorVert v0, v1;
+    v0.position = p0;
+    v0.color0 = color;
+    v1.position = p1;
+    v1.color0 = color;
+    addLine(v0, v1);
+}
 
-    vertices[7].position.x = x0;
-    vertices[7].position.y = y1;
-    vertices[7].position.z = z1;
+void DbgRenderer::setViewProjection(const glm::mat4 &view, const glm::mat4 &projection) {
+    if (view == mView && projection == mProjection) {
+        return;
+    }
 
-    const size_t vertexSize(sizeof(ColorVert) * NumVertices);
-    mesh->createVertexBuffer(&vertices[0], vertexSize, BufferAccessType::ReadOnly);
-    const size_t indexSize(sizeof(ui16) * NumIndices);
-    mesh->createIndexBuffer(&indices[0], indexSize, IndexType::UnsignedShort, BufferAccessType::ReadOnly);
+    mView = view;
+    mProjection = projection;
+    mMatricesDirty = true;
+}
 
-    // setup primitives
-    mesh->setModelMatrix(false, transform);
-    
-    mesh->addPrimitiveGroup(NumIndices, PrimitiveType::LineList, 0);
+void DbgRenderer::setCapacity(ui32 numLineVertices, ui32 numGlyphs) {
+    osre_assert(numLineVertices > 0 && numGlyphs > 0);
 
-    // setup material
-    mesh->setMaterial(MaterialBuilder::createBuildinMaterial(VertexType::ColorVertex));
+    if (nullptr != mLineMesh || nullptr != mTextMesh) {
+        osre_debug(Tag, "Streaming meshes already created, capacity not changed.");
+        return;
+    }
 
-    mRbSrv->beginPass(RenderPass::getPassNameById(DbgPassId));
-    mRbSrv->beginRenderBatch(DbgRenderer::getDebugRenderBatchName());
+    mLineCapacity = numLineVertices;
+    mGlyphCapacity = numGlyphs;
+}
 
-    mRbSrv->setMatrix(MatrixType::Model, transform);
-    mRbSrv->addMesh(mesh, 0);
+void DbgRenderer::flush() {
+    osre_assert(mRbSrv != nullptr);
 
-    mRbSrv->endRenderBatch();
-    mRbSrv->endPass();
+    flushLines();
+    flushText();
+    clear();
 }
 
 void DbgRenderer::clear() {
-    delete mDebugMesh;
-    mDebugMesh = nullptr;
+    mLineVertices.resize(0);
+    mTextVertices.resize(0);
 }
 
-void DbgRenderer::addLine(const ColorVert &v0, const ColorVert &v1) {
-    if (nullptr == mDebugMesh) {
-        mDebugMesh = new Mesh("debugMesh", VertexType::ColorVertex, IndexType::UnsignedShort);
+void DbgRenderer::flushLines() {
+    if (mLineVertices.isEmpty() && 0 == mNumLineVerticesWritten) {
+        return;
     }
 
-    ColorVert vertices[2];
-    vertices[0] = v0;
-    vertices[1] = v1;
-    BufferData *vb = mDebugMesh->getVertexBuffer();
-    if (vb == nullptr) {
-        mDebugMesh->createVertexBuffer(&vertices[0], sizeof(ColorVert) * 2, RenderBackend::BufferAccessType::ReadOnly);
-    } else {
-        vb->attach(&vertices[0], sizeof(ColorVert) * 2);
-    }
-    ui16 lineIndices[2] = {};
-    lineIndices[0] = mLastIndex;
-    mLastIndex++;
-    lineIndices[1] = mLastIndex;
-    mLastIndex++;
-    BufferData *ib = mDebugMesh->getIndexBuffer();
-    if (ib == nullptr) {
-        mDebugMesh->createIndexBuffer(&lineIndices[0], sizeof(ui16) * 2, IndexType::UnsignedShort, BufferAccessType::ReadOnly);
+    mRbSrv->beginPass(RenderPass::getPassNameById(DbgPassId));
+    mRbSrv->beginRenderBatch(getDebugRenderBatchName());
+    if (mMatricesDirty) {
+        mRbSrv->setMatrix(MatrixType::Model, glm::mat4(1.0f));
+        mRbSrv->setMatrix(MatrixType::View, mView);
+        mRbSrv->setMatrix(MatrixType::Projection, mProjection);
+        mMatricesDirty = false;
+    }
+
+    if (nullptr == mLineMesh) {
+        MeshBuilder meshBuilder;
+        meshBuilder.allocStreamingMesh("dbgLines", VertexType::ColorVertex, mLineCapacity, PrimitiveType::LineList);
+        mLineMesh = meshBuilder.getMesh();
+        mLineMesh->setMaterial(MaterialBuilder::createBuildinMaterial(VertexType::ColorVertex));
+        updateStreamMesh(mLineMesh, mLineVertices);
+        mRbSrv->addMesh(mLineMesh, 0);
     } else {
-        ib->attach(&lineIndices[0], sizeof(ui16) * 2);
+        updateStreamMesh(mLineMesh, mLineVertices);
+        mRbSrv->updateMesh(mLineMesh);
     }
+    mNumLineVerticesWritten = static_cast<ui32>(mLineVertices.size());
 
-    mDebugMesh->addPrimitiveGroup(NumIndices, PrimitiveType::LineList, 0);
+    mRbSrv->endRenderBatch();
+    mRbSrv->endPass();
 }
 
-DbgRenderer::DebugText *DbgRenderer::getDebugText(guid id) const {
-    if (mDebugTextMeshes.isEmpty()) {
-        return nullptr;
+void DbgRenderer::flushText() {
+    if (mTextVertices.isEmpty() && 0 == mNumGlyphsWritten) {
+        return;
     }
 
-    DebugText *found = nullptr;
-    for (size_t i = 0; i < mDebugTextMeshes.size(); ++i) {
-        if (mDebugTextMeshes[i]->mesh->getId() == id) {
-            found = mDebugTextMeshes[i];
-            break;
-        }
+    mRbSrv->beginPass(RenderPass::getPassNameById(DbgPassId));
+    mRbSrv->beginRenderBatch(getDebugTextRenderBatchName());
+
+    const Viewport &viewport = mRbSrv->getViewport();
+    const f32 w = viewport.m_w > 0 ? static_cast<f32>(viewport.m_w) : DefaultScreenWidth;
+    const f32 h = viewport.m_h > 0 ? static_cast<f32>(viewport.m_h) : DefaultScreenHeight;
+    mRbSrv->setMatrix(MatrixType::Projection, glm::ortho(0.0f, w, 0.0f, h));
+
+    if (nullptr == mTextMesh) {
+        MeshBuilder meshBuilder;
+        meshBuilder.allocStreamingMesh("dbgText", VertexType::RenderVertex, mGlyphCapacity * NumQuadVertices, PrimitiveType::TriangleList);
+        mTextMesh = meshBuilder.getMesh();
+        mTextMesh->setMaterial(mFont.getMaterial());
+        updateStreamMesh(mTextMesh, mTextVertices);
+        mRbSrv->addMesh(mTextMesh, 0);
+    } else {
+        updateStreamMesh(mTextMesh, mTextVertices);
+        mRbSrv->updateMesh(mTextMesh);
     }
+    mNumGlyphsWritten = static_cast<ui32>(mTextVertices.size() / NumQuadVertices);
 
-    return found;
+    mRbSrv->endRenderBatch();
+    mRbSrv->endPass();
 }
 
 } // Namespace RenderBackend
@@ -0,0 +1,360 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/RenderBackend/FontAtlas.h>
+#include <osre/RenderBackend/MaterialBuilder.h>
+#include <osre/Common/Logger.h>
+#include <osre/Common/Tokenizer.h>
+#include <osre/Debugging/osre_debugging.h>
+#include <osre/IO/IOService.h>
+#include <osre/IO/Stream.h>
+#include <osre/IO/Uri.h>
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "stb_truetype.h"
+
+namespace OSRE {
+namespace RenderBackend {
+
+using namespace ::OSRE::Common;
+using namespace ::OSRE::IO;
+
+static constexpr c8 Tag[] = "FontAtlas";
+
+// One pixel between the glyphs avoids bleeding with linear filtering
+static constexpr i32 GlyphPadding = 1;
+
+FontAtlas::FontAtlas(const String &name) :
+        mName(name),
+        mFirstChar(0),
+        mGlyphs(),
+        mKerning(),
+        mPixelHeight(0.0f),
+        mLineHeight(0.0f),
+        mTexture(nullptr),
+        mTextureResource(nullptr),
+        mMaterial(nullptr) {
+    // empty
+}
+
+FontAtlas::~FontAtlas() {
+    reset();
+}
+
+void FontAtlas::reset() {
+    // The material points to the texture, so give it back first
+    MaterialBuilder::releaseMaterial(mMaterial);
+    mMaterial = nullptr;
+    delete mTexture;
+    mTexture = nullptr;
+    if (nullptr != mTextureResource) {
+        TextureLoader loader;
+        mTextureResource->unload(loader);
+        delete mTextureResource;
+        mTextureResource = nullptr;
+    }
+    mGlyphs.clear();
+    mKerning.clear();
+}
+
+bool FontAtlas::loadTrueType(const uc8 *data, size_t size, f32 pixelHeight, ui32 atlasSize) {
+    if (nullptr == data || 0 == size || pixelHeight <= 0.0f || 0 == atlasSize) {
+        osre_debug(Tag, "Invalid font data.");
+        return false;
+    }
+
+    stbtt_fontinfo info;
+    if (0 == stbtt_InitFont(&info, data, stbtt_GetFontOffsetForIndex(data, 0))) {
+        osre_error(Tag, "Cannot parse font " + mName);
+        return false;
+    }
+
+    reset();
+    const f32 scale = stbtt_ScaleForPixelHeight(&info, pixelHeight);
+    i32 ascent = 0, descent = 0, lineGap = 0;
+    stbtt_GetFontVMetrics(&info, &ascent, &descent, &lineGap);
+    mFirstChar = FirstChar;
+    mPixelHeight = pixelHeight;
+    mLineHeight = static_cast<f32>(ascent - descent + lineGap) * scale;
+
+    // The rows of the atlas are stored bottom up like the loaded textures
+    const ui32 channels = 3;
+    Texture *texture = new Texture;
+    texture->m_textureName = mName;
+    texture->m_targetType = TextureTargetType::Texture2D;
+    texture->mPixelFormat = PixelFormatType::R8G8B8;
+    texture->m_width = atlasSize;
+    texture->m_height = atlasSize;
+    texture->m_channels = channels;
+    texture->m_size = atlasSize * atlasSize * channels;
+    texture->m_data = new uc8[texture->m_size];
+    ::memset(texture->m_data, 0, texture->m_size);
+
+    // Pack the glyphs in shelves from the top left corner
+    const f32 invSize = 1.0f / static_cast<f32>(atlasSize);
+    const i32 maxSize = static_cast<i32>(atlasSize);
+    i32 penX = GlyphPadding, penY = GlyphPadding, shelfHeight = 0;
+    cppcore::TArray<uc8> bitmap;
+    mGlyphs.resize(NumChars);
+    for (ui32 i = 0; i < NumChars; ++i) {
+        const i32 ch = static_cast<i32>(FirstChar + i);
+        Glyph &glyph = mGlyphs[i];
+        glyph = Glyph();
+        i32 advance = 0, bearing = 0;
+        stbtt_GetCodepointHMetrics(&info, ch, &advance, &bearing);
+        glyph.mAdvance = static_cast<f32>(advance) * scale;
+
+        i32 x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+        stbtt_GetCodepointBitmapBox(&info, ch, scale, scale, &x0, &y0, &x1, &y1);
+        const i32 w = x1 - x0;
+        const i32 h = y1 - y0;
+        if (w <= 0 || h <= 0) {
+            continue;
+        }
+
+        if (penX + w + GlyphPadding > maxSize) {
+            penX = GlyphPadding;
+            penY += shelfHeight + GlyphPadding;
+            shelfHeight = 0;
+        }
+        if (penY + h + GlyphPadding > maxSize) {
+            osre_error(Tag, "Atlas too small for font " + mName);
+            delete texture;
+            mGlyphs.clear();
+            return false;
+        }
+
+        bitmap.resize(w * h);
+        stbtt_MakeCodepointBitmap(&info, &bitmap[0], w, h, w, scale, scale, ch);
+        for (i32 row = 0; row < h; ++row) {
+            uc8 *dest = &texture->m_data[((maxSize - 1 - (penY + row)) * maxSize + penX) * channels];
+            for (i32 col = 0; col < w; ++col) {
+                const uc8 coverage = bitmap[row * w + col];
+                dest[col * channels + 0] = coverage;
+                dest[col * channels + 1] = coverage;
+                dest[col * channels + 2] = coverage;
+            }
+        }
+
+        glyph.mUv0 = glm::vec2(penX, maxSize - penY - h) * invSize;
+        glyph.mUv1 = glm::vec2(penX + w, maxSize - penY) * invSize;
+        glyph.mOffset = glm::vec2(x0, -y1);
+        glyph.mSize = glm::vec2(w, h);
+        penX += w + GlyphPadding;
+        if (h > shelfHeight) {
+            shelfHeight = h;
+        }
+    }
+    mTexture = texture;
+
+    // Fonts without kerning need no table
+    bool hasKerning = false;
+    mKerning.resize(NumChars * NumChars);
+    for (ui32 first = 0; first < NumChars; ++first) {
+        for (ui32 second = 0; second < NumChars; ++second) {
+            const i32 kern = stbtt_GetCodepointKernAdvance(&info, FirstChar + first, FirstChar + second);
+            mKerning[first * NumChars + second] = static_cast<f32>(kern) * scale;
+            hasKerning |= (0 != kern);
+        }
+    }
+    if (!hasKerning) {
+        mKerning.clear();
+    }
+
+    return true;
+}
+
+bool FontAtlas::loadTrueType(const Uri &uri, f32 pixelHeight, ui32 atlasSize) {
+    Stream *stream = IOService::getInstance()->openStream(uri, Stream::AccessMode::ReadAccessBinary);
+    if (nullptr == stream) {
+        osre_error(Tag, "Cannot open font " + uri.getAbsPath());
+        return false;
+    }
+
+    // Mapped fonts are parsed in place, the atlas does not keep the data
+    const size_t size = stream->getSize();
+    const uc8 *mappedData = stream->getMappedData();
+    if (nullptr != mappedData) {
+        const bool ok = loadTrueType(mappedData, size, pixelHeight, atlasSize);
+        IOService::getInstance()->closeStream(&stream);
+        return ok;
+    }
+
+    cppcore::TArray<uc8> buffer;
+    buffer.resize(size);
+    const size_t readSize = size > 0 ? stream->read(&buffer[0], size) : 0;
+    IOService::getInstance()->closeStream(&stream);
+    if (0 == readSize) {
+        osre_error(Tag, "Cannot read font " + uri.getAbsPath());
+        return false;
+    }
+
+    return loadTrueType(&buffer[0], readSize, pixelHeight, atlasSize);
+}
+
+void FontAtlas::createGrid(const Uri &uri, ui32 columns, ui32 rows, f32 pixelHeight) {
+    osre_assert(columns > 0 && rows > 0);
+
+    reset();
+    mFirstChar = 0;
+    mPixelHeight = pixelHeight;
+    mLineHeight = pixelHeight;
+    mTextureResource = new TextureResource(mName, uri);
+
+    const f32 invCol = 1.0f / static_cast<f32>(columns);
+    const f32 invRow = 1.0f / static_cast<f32>(rows);
+    mGlyphs.resize(columns * rows);
+    for (ui32 i = 0; i < mGlyphs.size(); ++i) {
+        Glyph &glyph = mGlyphs[i];
+        const f32 s = static_cast<f32>(i % columns) * invCol;
+        const f32 t = 1.0f - static_cast<f32>(i / columns + 1) * invRow;
+        glyph.mUv0 = glm::vec2(s, t);
+        glyph.mUv1 = glm::vec2(s + invCol, t + invRow);
+        glyph.mOffset = glm::vec2(0.0f);
+        glyph.mSize = glm::vec2(pixelHeight);
+        glyph.mAdvance = pixelHeight;
+    }
+}
+
+const Glyph *FontAtlas::getGlyph(ui32 ch) const {
+    if (ch < mFirstChar || ch - mFirstChar >= mGlyphs.size()) {
+        return nullptr;
+    }
+
+    return &mGlyphs[ch - mFirstChar];
+}
+
+f32 FontAtlas::getKerning(ui32 first, ui32 second) const {
+    if (mKerning.isEmpty() || first < mFirstChar || second < mFirstChar) {
+        return 0.0f;
+    }
+
+    first -= mFirstChar;
+    second -= mFirstChar;
+    if (first >= NumChars || second >= NumChars) {
+        return 0.0f;
+    }
+
+    return mKerning[first * NumChars + second];
+}
+
+ui32 FontAtlas::layoutText(const String &text, const glm::vec2 &position, f32 size, const glm::vec3 &color,
+        cppcore::TArray<RenderVert> &vertices) const {
+    if (mPixelHeight <= 0.0f) {
+        return 0;
+    }
+
+    const f32 scale = size / mPixelHeight;
+    glm::vec2 pen(position);
+    ui32 last = 0, numGlyphs = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        const ui32 ch = static_cast<uc8>(text[i]);
+        if (Tokenizer::isLineBreak(static_cast<c8>(ch))) {
+            pen.x = position.x;
+            pen.y -= mLineHeight * scale;
+            last = 0;
+            continue;
+        }
+
+        const Glyph *glyph = getGlyph(ch);
+        if (nullptr == glyph) {
+            continue;
+        }
+        if (0 != last) {
+            pen.x += getKerning(last, ch) * scale;
+        }
+        last = ch;
+
+        if (' ' != ch && glyph->mSize.x > 0.0f) {
+            const glm::vec2 p0 = pen + glyph->mOffset * scale;
+            const glm::vec2 p1 = p0 + glyph->mSize * scale;
+            RenderVert quad[4];
+            quad[0].position = glm::vec3(p0.x, p0.y, 0.0f);
+            quad[0].tex0 = glyph->mUv0;
+            quad[1].position = glm::vec3(p0.x, p1.y, 0.0f);
+            quad[1].tex0 = glm::vec2(glyph->mUv0.x, glyph->mUv1.y);
+            quad[2].position = glm::vec3(p1.x, p0.y, 0.0f);
+            quad[2].tex0 = glm::vec2(glyph->mUv1.x, glyph->mUv0.y);
+            quad[3].position = glm::vec3(p1.x, p1.y, 0.0f);
+            quad[3].tex0 = glyph->mUv1;
+            for (RenderVert &v : quad) {
+                v.color0 = color;
+                vertices.add(v);
+            }
+            ++numGlyphs;
+        }
+        pen.x += glyph->mAdvance * scale;
+    }
+
+    return numGlyphs;
+}
+
+glm::vec2 FontAtlas::measureText(const String &text, f32 size) const {
+    if (mPixelHeight <= 0.0f || text.empty()) {
+        return glm::vec2(0.0f);
+    }
+
+    const f32 scale = size / mPixelHeight;
+    f32 width = 0.0f, rowWidth = 0.0f;
+    ui32 numRows = 1, last = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        const ui32 ch = static_cast<uc8>(text[i]);
+        if (Tokenizer::isLineBreak(static_cast<c8>(ch))) {
+            width = glm::max(width, rowWidth);
+            rowWidth = 0.0f;
+            last = 0;
+            ++numRows;
+            continue;
+        }
+
+        const Glyph *glyph = getGlyph(ch);
+        if (nullptr == glyph) {
+            continue;
+        }
+        if (0 != last) {
+            rowWidth += getKerning(last, ch) * scale;
+        }
+        rowWidth += glyph->mAdvance * scale;
+        last = ch;
+    }
+
+    return glm::vec2(glm::max(width, rowWidth), static_cast<f32>(numRows) * mLineHeight * scale);
+}
+
+Material *FontAtlas::getMaterial() {
+    if (nullptr != mMaterial) {
+        return mMaterial;
+    }
+
+    if (nullptr != mTexture) {
+        mMaterial = MaterialBuilder::createTexturedMaterial(mName, mTexture, VertexType::RenderVertex);
+    } else if (nullptr != mTextureResource) {
+        TextureResourceArray texResArray;
+        texResArray.add(mTextureResource);
+        mMaterial = MaterialBuilder::createTexturedMaterial(mName, texResArray, VertexType::RenderVertex);
+    }
+
+    return mMaterial;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -14,7 +14,8 @@ Material::Material(const String &name, const IO::Uri &uri) :
         m_parameters(nullptr),
         mShineness(0.0f),
         mShinenessStrength(0.0f),
-        mUri(uri) {
+        mUri(uri),
+        mPipelineState(InvalidPipelineStateId) {
     // empty
 }
 
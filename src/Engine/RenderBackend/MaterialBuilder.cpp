@@ -24,8 +24,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/IO/Uri.h>
 #include <osre/RenderBackend/Shader.h>
 #include <osre/RenderBackend/Material.h>
+#include <osre/RenderBackend/ShaderPermutation.h>
 #include <osre/Debugging/osre_debugging.h>
+#include <cstdint>
 #include <cstdio>
+#include <map>
+#include <set>
 
 namespace OSRE {
 namespace RenderBackend {
@@ -46,6 +50,23 @@ static const String GLSLRenderVertexLayout =
         "layout(location = 3) in vec2 texcoord0;  // per-vertex tex coord, stage 0\n"
         "\n";
 
+static const String GLSLQuantizedRenderVertexLayout =
+        "// QuantizedRenderVertex layout, the Model matrix contains the dequantization transform\n"
+        "layout(location = 0) in vec4 position;	  // quantized object space vertex position\n"
+        "layout(location = 1) in vec2 normal;	  // octahedral-encoded normal\n"
+        "layout(location = 2) in vec2 tangent;	  // octahedral-encoded tangent\n"
+        "layout(location = 3) in vec4 color0;     // per-vertex diffuse colour\n"
+        "layout(location = 4) in vec2 texcoord0;  // per-vertex tex coord, stage 0\n"
+        "\n"
+        "vec3 decodeOctahedral(vec2 e) {\n"
+        "    vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));\n"
+        "    if (n.z < 0.0) {\n"
+        "        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);\n"
+        "    }\n"
+        "    return normalize(n);\n"
+        "}\n"
+        "\n";
+
 static const String GLSLCombinedMVPUniformSrc =
         "// uniforms\n"
         "uniform mat4 Model;\n"
@@ -87,7 +108,9 @@ const String GLSLFsSrc =
         "    vFragColor = vSmoothColor;\n"
         "}\n";
 
-const String GLSLVertexShaderSrcRV =
+// The mesh shader for render vertices: with OSRE_LIGHTING the vertices are lit, else they are unlit
+// and tinted by the vertex color. The fragment shader is shared with the quantized render vertices.
+const String GLSLVertexShaderSrcMesh =
         GLSLVersionString_400 +
         "\n" + GLSLRenderVertexLayout +
         "\n"
@@ -96,6 +119,7 @@ const String GLSLVertexShaderSrcRV =
         "smooth out vec4 vSmoothColor;		//smooth colour to fragment shader\n"
         "smooth out vec2 vUV;\n"
         "\n"
+        "#ifdef OSRE_LIGHTING\n"
         "vec3 light_pos = vec3(0.0, 0.0, 2.0);\n"
         "vec3 Ls        = vec3(1.0, 1.0, 1.0);\n"
         "vec3 Ld        = vec3(0.7, 0.7, 0.7);\n"
@@ -106,11 +130,13 @@ const String GLSLVertexShaderSrcRV =
         "vec3 Kd = vec3(1.0, 0.5, 0.0);\n"
         "vec3 Ka = vec3(1.0, 1.0, 1.0);\n"
         "float specular_exponent = 100.0;\n"
+        "#endif\n"
         "\n" +
         GLSLCombinedMVPUniformSrc +
         "\n"
         "void main()\n"
         "{\n" 
+        "#ifdef OSRE_LIGHTING\n"
         "    position_eye = vec3(View * Model * vec4(position, 1.0));\n"
         "    normal_eye = vec3(View * Model * vec4(normal, 0.0));\n"
         "    vec3 Ia = La * Ka;\n"
@@ -135,10 +161,16 @@ const String GLSLVertexShaderSrcRV =
         "    //vertex position\n" 
         "    gl_Position = Projection * vec4(position_eye, 1.0);\n"
         "    vSmoothColor = vec4(Is + Id + Ia, 1.0) * intensity;\n"
+        "#else\n"
+        "    position_eye = vec3(View * Model * vec4(position, 1.0));\n"
+        "    normal_eye = vec3(View * Model * vec4(normal, 0.0));\n"
+        "    gl_Position = Projection * vec4(position_eye, 1.0);\n"
+        "    vSmoothColor = vec4(color0, 1.0);\n"
+        "#endif\n"
         "    vUV = texcoord0;\n"
         "}\n";
 
-const String GLSLFragmentShaderSrcRV =
+const String GLSLFragmentShaderSrcMesh =
         GLSLVersionString_400 +
         "\n"
         "in vec3 position_eye, normal_eye;\n"
@@ -147,14 +179,162 @@ const String GLSLFragmentShaderSrcRV =
         "//input form the vertex shader\n"
         "smooth in vec4 vSmoothColor;		//interpolated colour to fragment shader\n"
         "smooth in vec2 vUV;\n"
+        "#if OSRE_TEXTURE_COUNT > 0\n"
         "uniform sampler2D tex0;\n"
+        "#endif\n"
         "\n"
         "void main()\n"
         "{\n"
         "    // set the interpolated color as the shader output\n"
+        "#if OSRE_TEXTURE_COUNT > 0\n"
         "    frag_volor = texture(tex0, vUV) * vSmoothColor;\n"
+        "#else\n"
+        "    frag_volor = vSmoothColor;\n"
+        "#endif\n"
         "}\n";
 
+const String GLSLVertexShaderSrcQRV =
+        GLSLVersionString_400 +
+        "\n" + GLSLQuantizedRenderVertexLayout +
+        "out vec3 position_eye, normal_eye;\n"
+        "smooth out vec4 vSmoothColor;\n"
+        "smooth out vec2 vUV;\n"
+        "\n"
+        "vec3 light_pos = vec3(0.0, 0.0, 2.0);\n"
+        "vec3 Ld        = vec3(0.7, 0.7, 0.7);\n"
+        "vec3 La        = vec3(0.7, 0.7, 0.7);\n"
+        "\n" +
+        GLSLCombinedMVPUniformSrc +
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    vec3 n = decodeOctahedral(normal);\n"
+        "    position_eye = vec3(View * Model * vec4(position.xyz, 1.0));\n"
+        "    normal_eye = normalize(vec3(View * Model * vec4(n, 0.0)));\n"
+        "    vec3 light_position_eye = vec3(View * vec4(light_pos, 1.0));\n"
+        "    vec3 direction_to_light_eye = normalize(light_position_eye - position_eye);\n"
+        "    float dot_prod = max(dot(direction_to_light_eye, normal_eye), 0.0);\n"
+        "    gl_Position = Projection * vec4(position_eye, 1.0);\n"
+        "    vSmoothColor = vec4(La + Ld * dot_prod, 1.0) * color0;\n"
+        "    vUV = texcoord0;\n"
+        "}\n";
+
+// The content hash, FNV-1a over everything which defines a material
+class MaterialHash {
+public:
+    MaterialHash() :
+            mHash(14695981039346656037ull) {
+        // empty
+    }
+
+    MaterialHash &add(const void *data, size_t size) {
+        const uc8 *ptr = static_cast<const uc8 *>(data);
+        for (size_t i = 0; i < size; ++i) {
+            mHash ^= ptr[i];
+            mHash *= 1099511628211ull;
+        }
+        return *this;
+    }
+
+    MaterialHash &add(ui64 value) {
+        return add(&value, sizeof(ui64));
+    }
+
+    MaterialHash &add(const String &str) {
+        // The length keeps "ab"+"c" and "a"+"bc" apart
+        add(static_cast<ui64>(str.size()));
+        return add(str.c_str(), str.size());
+    }
+
+    ui64 get() const {
+        return mHash;
+    }
+
+private:
+    ui64 mHash;
+};
+
+struct MaterialBuilder::MaterialCache {
+    struct Entry {
+        Material *mMaterial;
+        ui32 mRefCount;
+    };
+
+    std::map<ui64, Entry> mEntries;
+    std::map<const Material *, ui64> mHashes;
+    std::set<Material *> mUnique;
+    MaterialCacheStats mStats;
+    ShaderPermutation mColorShader;
+    ShaderPermutation mMeshShader;
+    ShaderPermutation mQuantizedShader;
+
+    MaterialCache() :
+            mEntries(),
+            mHashes(),
+            mUnique(),
+            mStats(),
+            mColorShader("buildin.color", ShaderFeature::None),
+            mMeshShader("buildin.mesh", ShaderFeature::Lighting | ShaderFeature::TextureCountMask),
+            mQuantizedShader("buildin.quantized", ShaderFeature::TextureCountMask) {
+        mColorShader.setSource(ShaderType::SH_VertexShaderType, GLSLVsSrc);
+        mColorShader.setSource(ShaderType::SH_FragmentShaderType, GLSLFsSrc);
+        mMeshShader.setSource(ShaderType::SH_VertexShaderType, GLSLVertexShaderSrcMesh);
+        mMeshShader.setSource(ShaderType::SH_FragmentShaderType, GLSLFragmentShaderSrcMesh);
+        mQuantizedShader.setSource(ShaderType::SH_VertexShaderType, GLSLVertexShaderSrcQRV);
+        mQuantizedShader.setSource(ShaderType::SH_FragmentShaderType, GLSLFragmentShaderSrcMesh);
+
+        // The variants of the build-in materials are known, so build them up front
+        static constexpr ShaderVariantKey MeshVariants[] = {
+            makeShaderVariantKey(ShaderFeature::Lighting, 1),
+            makeShaderVariantKey(ShaderFeature::None, 1)
+        };
+        mMeshShader.precompile(MeshVariants, sizeof(MeshVariants) / sizeof(ShaderVariantKey));
+    }
+
+    ShaderPermutation *getPermutation(VertexType type) {
+        switch (type) {
+            case VertexType::ColorVertex:
+                return &mColorShader;
+            case VertexType::RenderVertex:
+                return &mMeshShader;
+            case VertexType::QuantizedRenderVertex:
+                return &mQuantizedShader;
+            default:
+                break;
+        }
+
+        return nullptr;
+    }
+
+    ~MaterialCache() {
+        for (auto &it : mEntries) {
+            delete it.second.mMaterial;
+        }
+        for (Material *mat : mUnique) {
+            delete mat;
+        }
+    }
+
+    Material *acquire(ui64 hash) {
+        auto it = mEntries.find(hash);
+        if (mEntries.end() == it) {
+            ++mStats.mMisses;
+            return nullptr;
+        }
+        ++mStats.mHits;
+        ++it->second.mRefCount;
+
+        return it->second.mMaterial;
+    }
+
+    Material *add(ui64 hash, Material *mat) {
+        mEntries[hash] = { mat, 1 };
+        mHashes[mat] = hash;
+
+        return mat;
+    }
+};
+
 void MaterialBuilder::create() {
     if (nullptr == sMaterialCache) {
         sMaterialCache = new MaterialBuilder::MaterialCache;
@@ -183,58 +363,75 @@ static void addMaterialParameter(Material *mat) {
     shader->addUniformBuffer("Projection");
 }
 
-Material *MaterialBuilder::createBuildinMaterial(VertexType type) {
-    Material *mat = sMaterialCache->find("buildinShaderMaterial");
-    if (nullptr != mat) {
-        return mat;
-    }
-
-    mat = sMaterialCache->create("buildinShaderMaterial", IO::Uri());
-    String vs, fs;
-    if (type == VertexType::ColorVertex) {
-        vs = GLSLVsSrc;
-        fs = GLSLFsSrc;
-    } else if (type == VertexType::RenderVertex) {
-        vs = GLSLVertexShaderSrcRV;
-        fs = GLSLFragmentShaderSrcRV;
-    }
-    if (vs.empty() || fs.empty()) {
-        delete mat;
-        return nullptr;
-    }
-
-    ShaderSourceArray arr;
-    arr[static_cast<size_t>(ShaderType::SH_VertexShaderType)] = vs;
-    arr[static_cast<size_t>(ShaderType::SH_FragmentShaderType)] = fs;
+static void createDefaultShader(Material *mat, VertexType type, const ShaderVariant *variant) {
+    ShaderSourceArray arr = variant->mSources;
     mat->createShader(arr);
 
     // Setup shader attributes and variables
-    Shader *shader = mat->m_shader;
-    if (shader != nullptr) {
+    if (nullptr != mat->m_shader) {
+        mat->m_shader->setProgram(variant->mProgramName, variant->mId);
         if (type == VertexType::ColorVertex) {
             mat->m_shader->addVertexAttributes(ColorVert::getAttributes(), ColorVert::getNumAttributes());
         } else if (type == VertexType::RenderVertex) {
-            mat->m_shader->addVertexAttributes(RenderVert::getAttributes(),RenderVert::getNumAttributes());
+            mat->m_shader->addVertexAttributes(RenderVert::getAttributes(), RenderVert::getNumAttributes());
+        } else if (type == VertexType::QuantizedRenderVertex) {
+            mat->m_shader->addVertexAttributes(QuantizedRenderVert::getAttributes(), QuantizedRenderVert::getNumAttributes());
         }
 
         addMaterialParameter(mat);
     }
+}
+
+// A variant is identified by its id, the sources do not need to be hashed again
+static MaterialHash hashVariant(VertexType type, const ShaderVariant *variant) {
+    MaterialHash hash;
+    hash.add(static_cast<ui64>(MaterialType::ShaderMaterial)).add(static_cast<ui64>(type)).add(static_cast<ui64>(variant->mId));
 
-    return mat;
+    return hash;
 }
 
-RenderBackend::Material *MaterialBuilder::createTexturedMaterial(const String &matName, TextureResourceArray &texResArray,
-        RenderBackend::VertexType type) {
-    if (matName.empty()) {
-        return nullptr;
+// The vertex type selects the attribute and uniform setup, custom shaders use InvalidVetexType
+static MaterialHash hashShader(VertexType type, const String &vs, const String &fs) {
+    MaterialHash hash;
+    hash.add(static_cast<ui64>(MaterialType::ShaderMaterial)).add(static_cast<ui64>(type)).add(vs).add(fs);
+
+    return hash;
+}
+
+static void hashTextures(MaterialHash &hash, const TextureResourceArray &texResArray) {
+    hash.add(static_cast<ui64>(texResArray.size()));
+    for (size_t i = 0; i < texResArray.size(); ++i) {
+        TextureResource *texRes = texResArray[i];
+        if (nullptr == texRes) {
+            hash.add(String());
+            continue;
+        }
+        hash.add(texRes->getName()).add(texRes->getUri().getUri());
     }
+}
 
-    Material *mat = sMaterialCache->find(matName);
-    if (nullptr != mat) {
-        return mat;
+static void hashParameters(MaterialHash &hash, const MaterialParameters &params) {
+    for (ui32 i = 0; i < MaxMatColorType; ++i) {
+        const Color4 &col = params.mColor[i];
+        hash.add(&col.m_r, sizeof(f32)).add(&col.m_g, sizeof(f32)).add(&col.m_b, sizeof(f32)).add(&col.m_a, sizeof(f32));
     }
+    hash.add(&params.mShineness, sizeof(f32)).add(&params.mShinenessStrength, sizeof(f32));
+}
+
+static void applyParameters(Material *mat, const MaterialParameters &params) {
+    for (ui32 i = 0; i < MaxMatColorType; ++i) {
+        mat->m_color[i] = params.mColor[i];
+    }
+    mat->mShineness = params.mShineness;
+    mat->mShinenessStrength = params.mShinenessStrength;
+}
 
-    mat = sMaterialCache->create(matName);
+static void hashTexture(MaterialHash &hash, const Texture *texture) {
+    // In-memory textures are identified by their instance
+    hash.add(static_cast<ui64>(1)).add(static_cast<ui64>(reinterpret_cast<uintptr_t>(texture)));
+}
+
+static void loadTextures(Material *mat, TextureResourceArray &texResArray) {
     mat->m_numTextures = texResArray.size();
     mat->m_textures = new Texture *[texResArray.size()];
     for (size_t i = 0; i < texResArray.size(); ++i) {
@@ -243,38 +440,86 @@ RenderBackend::Material *MaterialBuilder::createTexturedMaterial(const String &m
         texRes->load(loader);
         mat->m_textures[i] = texRes->get();
     }
+}
+
+Material *MaterialBuilder::createBuildinMaterial(VertexType type) {
+    // The build-in render vertex shaders are lit and sample the first texture stage
+    const ShaderVariant *variant = getShaderVariant(type, makeShaderVariantKey(ShaderFeature::Lighting, 1));
+    if (nullptr == variant) {
+        return nullptr;
+    }
 
-    String vs, fs;
-    if (type == VertexType::ColorVertex) {
-        vs = GLSLVsSrc;
-        fs = GLSLFsSrc;
-    } else if (type == VertexType::RenderVertex) {
-        vs = GLSLVertexShaderSrcRV;
-        fs = GLSLFragmentShaderSrcRV;
+    MaterialHash hash = hashVariant(type, variant);
+    hash.add(static_cast<ui64>(0));
+    Material *mat = sMaterialCache->acquire(hash.get());
+    if (nullptr != mat) {
+        return mat;
     }
 
-    if (vs.empty() || fs.empty()) {
-        delete mat;
+    mat = new Material("buildinShaderMaterial", IO::Uri());
+    createDefaultShader(mat, type, variant);
+
+    return sMaterialCache->add(hash.get(), mat);
+}
+
+RenderBackend::Material *MaterialBuilder::createTexturedMaterial(const String &matName, TextureResourceArray &texResArray,
+        RenderBackend::VertexType type) {
+    return createTexturedMaterial(matName, texResArray, type, MaterialParameters());
+}
+
+RenderBackend::Material *MaterialBuilder::createTexturedMaterial(const String &matName, TextureResourceArray &texResArray,
+        RenderBackend::VertexType type, const MaterialParameters &params) {
+    if (matName.empty()) {
         return nullptr;
     }
 
-    ShaderSourceArray arr;
-    arr[static_cast<ui32>(ShaderType::SH_VertexShaderType)] = vs;
-    arr[static_cast<ui32>(ShaderType::SH_FragmentShaderType)] = fs;
-    mat->createShader(arr);
+    const ShaderVariantKey key = makeShaderVariantKey(ShaderFeature::Lighting, static_cast<ui32>(texResArray.size()));
+    const ShaderVariant *variant = getShaderVariant(type, key);
+    if (nullptr == variant) {
+        return nullptr;
+    }
 
-    // Setup shader attributes and variables
-    if (nullptr != mat->m_shader) {
-        if (type == VertexType::ColorVertex) {
-            mat->m_shader->addVertexAttributes(ColorVert::getAttributes(), ColorVert::getNumAttributes());
-        } else if (type == VertexType::RenderVertex) {
-            mat->m_shader->addVertexAttributes(RenderVert::getAttributes(), RenderVert::getNumAttributes());
-        }
+    MaterialHash hash = hashVariant(type, variant);
+    hashTextures(hash, texResArray);
+    hashParameters(hash, params);
+    Material *mat = sMaterialCache->acquire(hash.get());
+    if (nullptr != mat) {
+        return mat;
+    }
 
-        addMaterialParameter(mat);
+    mat = new Material(matName, IO::Uri());
+    loadTextures(mat, texResArray);
+    createDefaultShader(mat, type, variant);
+    applyParameters(mat, params);
+
+    return sMaterialCache->add(hash.get(), mat);
+}
+
+RenderBackend::Material *MaterialBuilder::createTexturedMaterial(const String &matName, Texture *texture,
+        RenderBackend::VertexType type) {
+    if (matName.empty() || nullptr == texture) {
+        return nullptr;
+    }
+
+    const ShaderVariant *variant = getShaderVariant(type, makeShaderVariantKey(ShaderFeature::Lighting, 1));
+    if (nullptr == variant) {
+        return nullptr;
     }
 
-    return mat;
+    MaterialHash hash = hashVariant(type, variant);
+    hashTexture(hash, texture);
+    Material *mat = sMaterialCache->acquire(hash.get());
+    if (nullptr != mat) {
+        return mat;
+    }
+
+    mat = new Material(matName, IO::Uri());
+    mat->m_numTextures = 1;
+    mat->m_textures = new Texture *[1];
+    mat->m_textures[0] = texture;
+    createDefaultShader(mat, type, variant);
+
+    return sMaterialCache->add(hash.get(), mat);
 }
 
 RenderBackend::Material *MaterialBuilder::createTexturedMaterial(const String &matName, TextureResourceArray &texResArray,
@@ -287,46 +532,206 @@ RenderBackend::Material *MaterialBuilder::createTexturedMaterial(const String &m
         return nullptr;
     }
 
-    Material *mat = sMaterialCache->find(matName);
+    MaterialHash hash = hashShader(VertexType::InvalidVetexType, VsSrc, FsSrc);
+    hashTextures(hash, texResArray);
+    Material *mat = sMaterialCache->acquire(hash.get());
     if (nullptr != mat) {
         return mat;
     }
 
-    mat = sMaterialCache->create(matName);
-    mat->m_numTextures = texResArray.size();
-    mat->m_textures = new Texture *[texResArray.size()];
-    for (size_t i = 0; i < texResArray.size(); ++i) {
-        TextureResource *texRes = texResArray[i];
-        IO::Uri uri = texRes->getUri();
-        TextureLoader loader;
-        texRes->load(loader);
-        mat->m_textures[i] = texRes->get();
-    }
+    mat = new Material(matName, IO::Uri());
+    loadTextures(mat, texResArray);
 
     ShaderSourceArray shArray;
     shArray[static_cast<ui32>(ShaderType::SH_VertexShaderType)] = VsSrc;
     shArray[static_cast<ui32>(ShaderType::SH_FragmentShaderType)] = FsSrc;
     mat->createShader(shArray);
 
-    return mat;
+    return sMaterialCache->add(hash.get(), mat);
 }
 
-static constexpr c8 DefaultDebugTestMat[] = "debug_text_mat";
+RenderBackend::Material *MaterialBuilder::createCanvasMaterial(const String &matName, Texture *texture) {
+    if (matName.empty() || nullptr == texture) {
+        return nullptr;
+    }
 
-RenderBackend::Material *MaterialBuilder::createDebugRenderTextMaterial() {
-    Material *mat = sMaterialCache->find(DefaultDebugTestMat);
+    // Canvas quads are unlit
+    const ShaderVariant *variant = getShaderVariant(VertexType::RenderVertex, makeShaderVariantKey(ShaderFeature::None, 1));
+    MaterialHash hash = hashVariant(VertexType::RenderVertex, variant);
+    hashTexture(hash, texture);
+    Material *mat = sMaterialCache->acquire(hash.get());
     if (nullptr != mat) {
         return mat;
     }
-    mat = sMaterialCache->create(DefaultDebugTestMat);
+
+    mat = new Material(matName, IO::Uri());
+    mat->m_numTextures = 1;
+    mat->m_textures = new Texture *[1];
+    mat->m_textures[0] = texture;
+    createDefaultShader(mat, VertexType::RenderVertex, variant);
+
+    return sMaterialCache->add(hash.get(), mat);
+}
+
+static constexpr c8 DefaultDebugTestMat[] = "debug_text_mat";
+
+RenderBackend::Material *MaterialBuilder::createDebugRenderTextMaterial() {
     ShaderSourceArray shArray;
     shArray[static_cast<ui32>(ShaderType::SH_VertexShaderType)] = 
             "\n";
     shArray[static_cast<ui32>(ShaderType::SH_FragmentShaderType)] =
             "\n";
+
+    MaterialHash hash = hashShader(VertexType::InvalidVetexType, shArray[static_cast<ui32>(ShaderType::SH_VertexShaderType)],
+            shArray[static_cast<ui32>(ShaderType::SH_FragmentShaderType)]);
+    hash.add(String(DefaultDebugTestMat));
+    Material *mat = sMaterialCache->acquire(hash.get());
+    if (nullptr != mat) {
+        return mat;
+    }
+
+    mat = new Material(DefaultDebugTestMat, IO::Uri());
     mat->createShader(shArray);
 
-    return mat;
+    return sMaterialCache->add(hash.get(), mat);
+}
+
+static Material *cloneMaterial(const Material *mat) {
+    Material *clone = new Material(mat->m_name, mat->mUri);
+    clone->m_type = mat->m_type;
+    clone->m_numTextures = mat->m_numTextures;
+    if (0 != mat->m_numTextures) {
+        clone->m_textures = new Texture *[mat->m_numTextures];
+        for (size_t i = 0; i < mat->m_numTextures; ++i) {
+            clone->m_textures[i] = mat->m_textures[i];
+        }
+    }
+
+    // The backend looks compiled programs up by name, so the copy shares the program of the
+    // original and the backend releases it once
+    const Shader *shader = mat->m_shader;
+    if (nullptr != shader) {
+        Shader *clonedShader = new Shader;
+        for (ui32 i = 0; i < MaxShaderTypes; ++i) {
+            const ShaderType type = static_cast<ShaderType>(i);
+            if (shader->hasSource(type)) {
+                clonedShader->setSource(type, shader->getSource(type));
+            }
+        }
+        for (size_t i = 0; i < shader->getNumVertexAttributes(); ++i) {
+            clonedShader->addVertexAttribute(shader->getVertexAttributeAt(i));
+        }
+        for (size_t i = 0; i < shader->getNumUniformBuffer(); ++i) {
+            clonedShader->addUniformBuffer(shader->getUniformBufferAt(i));
+        }
+        clonedShader->setProgram(shader->getProgramName(), shader->getProgramId());
+        clone->m_shader = clonedShader;
+    }
+
+    for (ui32 i = 0; i < MaxMatColorType; ++i) {
+        clone->m_color[i] = mat->m_color[i];
+    }
+    clone->mShineness = mat->mShineness;
+    clone->mShinenessStrength = mat->mShinenessStrength;
+    clone->mPipelineState = mat->mPipelineState;
+
+    return clone;
+}
+
+RenderBackend::Material *MaterialBuilder::makeUnique(RenderBackend::Material *mat) {
+    if (nullptr == mat || nullptr == sMaterialCache) {
+        return mat;
+    }
+
+    auto hashIt = sMaterialCache->mHashes.find(mat);
+    if (sMaterialCache->mHashes.end() == hashIt) {
+        // Already unique or not built by the material builder
+        return mat;
+    }
+
+    auto it = sMaterialCache->mEntries.find(hashIt->second);
+    osre_assert(sMaterialCache->mEntries.end() != it);
+    if (1 == it->second.mRefCount) {
+        // The only user, so take it out of the cache to avoid sharing the changes
+        sMaterialCache->mEntries.erase(it);
+        sMaterialCache->mHashes.erase(hashIt);
+        sMaterialCache->mUnique.insert(mat);
+        return mat;
+    }
+
+    --it->second.mRefCount;
+    Material *clone = cloneMaterial(mat);
+    sMaterialCache->mUnique.insert(clone);
+
+    return clone;
+}
+
+void MaterialBuilder::releaseMaterial(RenderBackend::Material *mat) {
+    if (nullptr == mat || nullptr == sMaterialCache) {
+        return;
+    }
+
+    auto uniqueIt = sMaterialCache->mUnique.find(mat);
+    if (sMaterialCache->mUnique.end() != uniqueIt) {
+        sMaterialCache->mUnique.erase(uniqueIt);
+        delete mat;
+        return;
+    }
+
+    auto hashIt = sMaterialCache->mHashes.find(mat);
+    if (sMaterialCache->mHashes.end() == hashIt) {
+        return;
+    }
+
+    auto it = sMaterialCache->mEntries.find(hashIt->second);
+    osre_assert(sMaterialCache->mEntries.end() != it);
+    --it->second.mRefCount;
+    if (0 == it->second.mRefCount) {
+        delete it->second.mMaterial;
+        sMaterialCache->mEntries.erase(it);
+        sMaterialCache->mHashes.erase(hashIt);
+    }
+}
+
+ui32 MaterialBuilder::getRefCount(const RenderBackend::Material *mat) {
+    if (nullptr == mat || nullptr == sMaterialCache) {
+        return 0;
+    }
+
+    if (sMaterialCache->mUnique.end() != sMaterialCache->mUnique.find(const_cast<Material *>(mat))) {
+        return 1;
+    }
+
+    auto hashIt = sMaterialCache->mHashes.find(mat);
+    if (sMaterialCache->mHashes.end() == hashIt) {
+        return 0;
+    }
+
+    return sMaterialCache->mEntries[hashIt->second].mRefCount;
+}
+
+const ShaderVariant *MaterialBuilder::getShaderVariant(VertexType type, ShaderVariantKey key) {
+    if (nullptr == sMaterialCache) {
+        return nullptr;
+    }
+
+    ShaderPermutation *permutation = sMaterialCache->getPermutation(type);
+    if (nullptr == permutation) {
+        return nullptr;
+    }
+
+    return permutation->getVariant(key);
+}
+
+MaterialCacheStats MaterialBuilder::getCacheStats() {
+    if (nullptr == sMaterialCache) {
+        return MaterialCacheStats();
+    }
+
+    MaterialCacheStats stats = sMaterialCache->mStats;
+    stats.mNumMaterials = sMaterialCache->mEntries.size() + sMaterialCache->mUnique.size();
+
+    return stats;
 }
 
 } // Namespace RenderBackend
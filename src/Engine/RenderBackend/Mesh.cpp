@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Common/Logger.h>
 #include <osre/Debugging/osre_debugging.h>
 #include <osre/RenderBackend/Material.h>
+#include <osre/RenderBackend/VertexQuantizer.h>
 
 namespace OSRE {
 namespace RenderBackend {
@@ -41,6 +42,7 @@ Mesh::Mesh(const String &name, VertexType vertexType, IndexType indextype) :
         mName(name),
         mLocalModelMatrix(false),
         mModel(1.0f),
+        mDequantization(1.0f),
         mMaterial(nullptr),
         mVertexType(vertexType),
         mVertexBuffer(nullptr),
@@ -50,7 +52,8 @@ Mesh::Mesh(const String &name, VertexType vertexType, IndexType indextype) :
         mId(99999999),
         mVertexData(),
         mIndexData(),
-        mLastIndex(0) {
+        mLastIndex(0),
+        mNumActiveVertices(~static_cast<size_t>(0)) {
     mId = s_Ids.getUniqueId();
 }
 
@@ -105,6 +108,10 @@ size_t Mesh::getVertexSize(VertexType vertextype) {
             vertexSize = sizeof(RenderVert);
             break;
 
+        case VertexType::QuantizedRenderVertex:
+            vertexSize = sizeof(QuantizedRenderVert);
+            break;
+
         default:
             break;
     }
@@ -112,6 +119,10 @@ size_t Mesh::getVertexSize(VertexType vertextype) {
     return vertexSize;
 }
 
+void Mesh::setDequantization(const glm::vec3 &offset, f32 scale) {
+    mDequantization = VertexQuantizer::getDequantizationMatrix(offset, scale);
+}
+
 void Mesh::addPrimitiveGroups(size_t numPrimGroups, size_t *numIndices, PrimitiveType *primTypes, ui32 *startIndices) {
     if (0 == numPrimGroups || nullptr == numIndices || nullptr == primTypes || nullptr == startIndices) {
         return;
@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Common/Tokenizer.h>
 #include <osre/Debugging/osre_debugging.h>
 
+
 namespace OSRE {
 namespace RenderBackend {
 
@@ -596,6 +597,72 @@ void MeshBuilder::updateTextVertices(size_t numVerts, ::glm::vec2 *tex0, BufferD
     delete[] vert;
 }
 
+template<class TIndex>
+static void createStreamingIndices(Mesh *mesh, ui32 numVertices, PrimitiveType primType, IndexType type) {
+    const bool quads = PrimitiveType::TriangleList == primType;
+    const ui32 numIndices = quads ? numVertices / NumQuadVert * NumQuadIndices : numVertices;
+    cppcore::TArray<TIndex> indices;
+    indices.resize(numIndices);
+    if (quads) {
+        for (ui32 quad = 0; quad < numVertices / NumQuadVert; ++quad) {
+            const TIndex v = static_cast<TIndex>(quad * NumQuadVert);
+            TIndex *out = &indices[quad * NumQuadIndices];
+            out[0] = v;
+            out[1] = v + 2;
+            out[2] = v + 1;
+            out[3] = v + 1;
+            out[4] = v + 2;
+            out[5] = v + 3;
+        }
+    } else {
+        for (ui32 i = 0; i < numIndices; ++i) {
+            indices[i] = static_cast<TIndex>(i);
+        }
+    }
+    mesh->createIndexBuffer(&indices[0], sizeof(TIndex) * numIndices, type, BufferAccessType::ReadOnly);
+    mesh->addPrimitiveGroup(numIndices, primType, 0);
+}
+
+MeshBuilder &MeshBuilder::allocStreamingMesh(const String &name, VertexType type, ui32 numVertices, PrimitiveType primType) {
+    osre_assert(VertexType::ColorVertex == type || VertexType::RenderVertex == type);
+    osre_assert(numVertices > 0);
+
+    clear();
+    const IndexType indexType = numVertices <= 0xffff + 1 ? IndexType::UnsignedShort : IndexType::UnsignedInt;
+    mActiveMesh = new Mesh(name, type, indexType);
+
+    const size_t size = Mesh::getVertexSize(type) * numVertices;
+    cppcore::TArray<uc8> vertices;
+    vertices.resize(size);
+    ::memset(&vertices[0], 0, size);
+    mActiveMesh->createVertexBuffer(&vertices[0], size, BufferAccessType::ReadWrite);
+    if (IndexType::UnsignedShort == indexType) {
+        createStreamingIndices<ui16>(mActiveMesh, numVertices, primType, indexType);
+    } else {
+        createStreamingIndices<ui32>(mActiveMesh, numVertices, primType, indexType);
+    }
+    setNumStreamingVertices(mActiveMesh, 0);
+    mActiveMesh->setModelMatrix(true, glm::mat4(1.0f));
+
+    return *this;
+}
+
+void MeshBuilder::setNumStreamingVertices(Mesh *mesh, size_t numVertices) {
+    osre_assert(nullptr != mesh);
+
+    PrimitiveGroup *grp = mesh->getPrimitiveGroupAt(0);
+    if (nullptr == grp) {
+        return;
+    }
+
+    if (PrimitiveType::TriangleList == grp->m_primitive) {
+        grp->m_numIndices = numVertices / NumQuadVert * NumQuadIndices;
+    } else {
+        grp->m_numIndices = numVertices;
+    }
+    mesh->setNumActiveVertices(numVertices);
+}
+
 RenderBackend::Mesh *MeshBuilder::getMesh() {
     return mActiveMesh;
 }
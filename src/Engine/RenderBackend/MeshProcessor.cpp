@@ -20,10 +20,12 @@ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
 IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
+#include <osre/Common/MinMaxKernel.h>
 #include <osre/Debugging/osre_debugging.h>
 #include <osre/RenderBackend/Mesh.h>
 #include <osre/RenderBackend/RenderCommon.h>
 #include <osre/RenderBackend/MeshProcessor.h>
+#include <osre/RenderBackend/VertexQuantizer.h>
 
 namespace OSRE {
 namespace RenderBackend {
@@ -89,24 +91,160 @@ void MeshProcessor::handleMesh(Mesh *mesh) {
             stride = sizeof(ColorVert);
             break;
 
+        case VertexType::QuantizedRenderVertex:
+            stride = sizeof(QuantizedRenderVert);
+            break;
+
         default:
             break;
     }
 
     BufferData *data = mesh->getVertexBuffer();
-    if (nullptr == data || 0L == data->getSize()) {
+    if (nullptr == data || 0L == data->getSize() || 0 == stride) {
         return;
     }
 
-    ui32 offset = 0;
-    const ui32 numVertices = (ui32)data->getSize() / stride;
-    for (ui32 i = 0; i < numVertices; i++) {
-        glm::vec3 pos = {};
-        uc8 *ptr = (uc8*) data->getData();
-        ::memcpy(&pos.x, &ptr[offset], sizeof(glm::vec3));
-        offset += stride;
-        mAabb.merge(pos.x, pos.y, pos.z);
+    if (mesh->isQuantized()) {
+        const glm::mat4 &dequant = mesh->getDequantizationMatrix();
+        const glm::vec3 offset(dequant[3]);
+        const f32 scale = dequant[0][0];
+        const size_t numVertices = data->getSize() / stride;
+        const QuantizedRenderVert *vertices = reinterpret_cast<const QuantizedRenderVert *>(data->getData());
+        for (size_t i = 0; i < numVertices; ++i) {
+            mAabb.merge(VertexQuantizer::getPosition(vertices[i], offset, scale));
+        }
+        return;
+    }
+
+    const size_t numVertices = data->getSize() / stride;
+    MinMaxKernel::merge(mAabb, data->getData(), numVertices, stride);
+}
+
+bool MeshProcessor::quantize(Mesh *mesh, const glm::vec3 *tangents) {
+    if (nullptr == mesh) {
+        return false;
+    }
+
+    if (VertexType::RenderVertex != mesh->getVertexType()) {
+        return false;
+    }
+
+    BufferData *data = mesh->getVertexBuffer();
+    if (nullptr == data || 0L == data->getSize()) {
+        return false;
+    }
+
+    const size_t numVertices = data->getSize() / sizeof(RenderVert);
+    const RenderVert *src = reinterpret_cast<const RenderVert *>(data->getData());
+    AABB aabb;
+    MinMaxKernel::merge(aabb, src, numVertices, sizeof(RenderVert));
+
+    glm::vec3 offset;
+    f32 scale = 1.0f;
+    VertexQuantizer::computeTransform(aabb, offset, scale);
+
+    cppcore::TArray<QuantizedRenderVert> quantized;
+    quantized.resize(numVertices);
+    VertexQuantizer::quantize(src, tangents, numVertices, offset, scale, &quantized[0]);
+
+    mesh->createVertexBuffer(&quantized[0], numVertices * sizeof(QuantizedRenderVert), data->getBufferAccessType());
+    mesh->setVertexType(VertexType::QuantizedRenderVertex);
+    mesh->setDequantization(offset, scale);
+
+    return true;
+}
+
+static ui32 getIndex(const c8 *ptr, IndexType type, size_t i) {
+    switch (type) {
+        case IndexType::UnsignedByte:
+            return reinterpret_cast<const uc8 *>(ptr)[i];
+        case IndexType::UnsignedShort:
+            return reinterpret_cast<const ui16 *>(ptr)[i];
+        case IndexType::UnsignedInt:
+            return reinterpret_cast<const ui32 *>(ptr)[i];
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+bool MeshProcessor::getTriangles(Mesh *mesh, cppcore::TArray<glm::vec3> &positions, cppcore::TArray<ui32> &indices) {
+    if (nullptr == mesh) {
+        return false;
     }
+
+    BufferData *vb = mesh->getVertexBuffer();
+    BufferData *ib = mesh->getIndexBuffer();
+    const size_t stride = Mesh::getVertexSize(mesh->getVertexType());
+    if (nullptr == vb || nullptr == ib || 0 == stride) {
+        return false;
+    }
+
+    const size_t base = positions.size();
+    const size_t numVertices = vb->getSize() / stride;
+    const c8 *vertices = vb->getData();
+    if (mesh->isQuantized()) {
+        const glm::mat4 &dequant = mesh->getDequantizationMatrix();
+        const glm::vec3 offset(dequant[3]);
+        const f32 scale = dequant[0][0];
+        const QuantizedRenderVert *qv = reinterpret_cast<const QuantizedRenderVert *>(vertices);
+        for (size_t i = 0; i < numVertices; ++i) {
+            positions.add(VertexQuantizer::getPosition(qv[i], offset, scale));
+        }
+    } else {
+        // All other vertex types start with the position
+        for (size_t i = 0; i < numVertices; ++i) {
+            glm::vec3 pos;
+            ::memcpy(&pos, vertices + i * stride, sizeof(glm::vec3));
+            positions.add(pos);
+        }
+    }
+
+    const IndexType indexType = mesh->getIndexType();
+    const size_t indexSize = IndexType::UnsignedByte == indexType ? 1 : (IndexType::UnsignedShort == indexType ? 2 : 4);
+    const size_t numIndices = ib->getSize() / indexSize;
+    const size_t numIndicesBefore = indices.size();
+    const c8 *indexData = ib->getData();
+    for (size_t g = 0; g < mesh->getNumberOfPrimitiveGroups(); ++g) {
+        const PrimitiveGroup *group = mesh->getPrimitiveGroupAt(g);
+        const size_t start = group->m_startIndex;
+        const size_t end = glm::min(start + group->m_numIndices, numIndices);
+        for (size_t i = start; i + 2 < end; ) {
+            ui32 tri[3];
+            switch (group->m_primitive) {
+                case PrimitiveType::TriangleList:
+                    tri[0] = getIndex(indexData, indexType, i);
+                    tri[1] = getIndex(indexData, indexType, i + 1);
+                    tri[2] = getIndex(indexData, indexType, i + 2);
+                    i += 3;
+                    break;
+                case PrimitiveType::TriangelStrip:
+                    tri[0] = getIndex(indexData, indexType, i);
+                    tri[1] = getIndex(indexData, indexType, i + 1);
+                    tri[2] = getIndex(indexData, indexType, i + 2);
+                    ++i;
+                    break;
+                case PrimitiveType::TriangleFan:
+                    tri[0] = getIndex(indexData, indexType, start);
+                    tri[1] = getIndex(indexData, indexType, i + 1);
+                    tri[2] = getIndex(indexData, indexType, i + 2);
+                    ++i;
+                    break;
+                default:
+                    i = end;
+                    continue;
+            }
+            if (tri[0] >= numVertices || tri[1] >= numVertices || tri[2] >= numVertices) {
+                continue;
+            }
+            indices.add(static_cast<ui32>(base + tri[0]));
+            indices.add(static_cast<ui32>(base + tri[1]));
+            indices.add(static_cast<ui32>(base + tri[2]));
+        }
+    }
+
+    return indices.size() != numIndicesBefore;
 }
 
 } // namespace RenderBackend
@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <osre/RenderBackend/RenderCommon.h>
 #include <osre/RenderBackend/RenderStates.h>
+#include <osre/RenderBackend/PipelineState.h>
 
 namespace OSRE {
 namespace RenderBackend {
@@ -78,10 +79,11 @@ struct OGLVertexAttribute {
     const c8 *m_pAttributeName; ///< The attribute name.
     size_t m_size;              ///< The size for one attribute.
     GLenum m_type;              ///< The attribute type.
+    GLboolean m_normalized;     ///< GL_TRUE, if integer data shall be normalized on fetch.
     const GLvoid *m_ptr;        ///< The data pointer for the attribute.
 
     /// @brief The default class constructor.
-    OGLVertexAttribute() : m_index(999999), m_pAttributeName(nullptr), m_size(0U), m_type(), m_ptr(nullptr) {}
+    OGLVertexAttribute() : m_index(999999), m_pAttributeName(nullptr), m_size(0U), m_type(), m_normalized(GL_FALSE), m_ptr(nullptr) {}
 
     /// @brief  The class destructor, default implementation.
     ~OGLVertexAttribute() = default;
@@ -179,9 +181,10 @@ struct SetMaterialStageCmdData {
     OGLShader *m_shader;                        ///< The shader to use.
     cppcore::TArray<OGLTexture *> m_textures;   ///< All texture to set.
     OGLVertexArray *m_vertexArray;              ///< Ther vertex array.
+    PipelineStateId m_pipelineState;            ///< The pipeline state of the material, optional.
 
     /// @brief The default class constructor.
-    SetMaterialStageCmdData() : m_shader(nullptr), m_textures(), m_vertexArray(nullptr) {}
+    SetMaterialStageCmdData() : m_shader(nullptr), m_textures(), m_vertexArray(nullptr), m_pipelineState(InvalidPipelineStateId) {}
 
     /// @brief  The class destructor, default implementation.
     ~SetMaterialStageCmdData() = default;
@@ -203,11 +206,13 @@ struct SetRenderTargetCmdData {
 struct DrawInstancePrimitivesCmdData {
     OGLVertexArray *m_vertexArray;          ///< The vertex array to use.
     size_t m_numInstances;                  ///< The number of instances to render.
+    bool m_quantized;                       ///< true for quantized vertices.
+    glm::mat4 m_dequantization;             ///< The dequantization transform for quantized vertices.
     cppcore::TArray<size_t> m_primitives;   ///< The primitives to render.
     const char *m_id;                       ///< The call id.
 
     /// @brief The default class constructor.
-    DrawInstancePrimitivesCmdData() : m_vertexArray(nullptr), m_numInstances(0), m_primitives(), m_id(nullptr) {}
+    DrawInstancePrimitivesCmdData() : m_vertexArray(nullptr), m_numInstances(0), m_quantized(false), m_dequantization(1.0f), m_primitives(), m_id(nullptr) {}
 
     /// @brief  The class destructor, default implementation.
     ~DrawInstancePrimitivesCmdData() = default;
@@ -217,12 +222,14 @@ struct DrawInstancePrimitivesCmdData {
 struct DrawPrimitivesCmdData {
     bool m_localMatrix;                     ///< true for a local model matrix. TODO: Remove me
     glm::mat4 m_model;                      ///< The model matrix. TODO: Remove me
+    bool m_quantized;                       ///< true for quantized vertices.
+    glm::mat4 m_dequantization;             ///< The dequantization transform for quantized vertices.
     OGLVertexArray *m_vertexArray;          ///< The vertex array to use.
     cppcore::TArray<size_t> m_primitives;   ///< The primitives to render.
     const char *m_id;                       ///< The id.
 
     /// @brief The default class constructor.
-    DrawPrimitivesCmdData() : m_localMatrix(false), m_model(), m_vertexArray(nullptr), m_primitives(), m_id(nullptr) {}
+    DrawPrimitivesCmdData() : m_localMatrix(false), m_model(), m_quantized(false), m_dequantization(1.0f), m_vertexArray(nullptr), m_primitives(), m_id(nullptr) {}
 
     /// @brief  The class destructor, default implementation.
     ~DrawPrimitivesCmdData() = default;
@@ -262,14 +269,39 @@ struct OGLFrameBuffer {
     GLuint m_renderedTexture;       ///< The OpenGL id for the texture to rnder in.
     ui32 m_width;                   
     ui32 m_height;
+    PixelFormatType m_format;       ///< The pixel format of the color attachment.
 
     /// @brief The default class constructor.
     OGLFrameBuffer(const char *name, ui32 w, ui32 h) : m_name(name), m_bufferId(0), m_depthrenderbufferId(0), m_renderedTexture(0),
-                                                       m_width(w), m_height(h) {}
+                                                       m_width(w), m_height(h), m_format(PixelFormatType::R8G8B8) {}
 
     /// @brief  The class destructor, default implementation.
     ~OGLFrameBuffer() = default;
 };
 
+///	@brief  This struct declares the opengl-specific data of a pipeline state object.
+/// All enums are resolved once when the object is used for the first time.
+struct OGLPipelineState {
+    PipelineStateId m_id;       ///< The id of the pipeline state object.
+    bool m_cullEnabled;         ///< true, if culling is enabled.
+    GLenum m_cullFace;          ///< The face to cull.
+    GLenum m_frontFace;         ///< The winding order of the front face.
+    GLenum m_polygonMode;       ///< The polygon mode.
+    bool m_blendEnabled;        ///< true, if blending is enabled.
+
+    /// @brief The default class constructor.
+    OGLPipelineState() : m_id(InvalidPipelineStateId), m_cullEnabled(false), m_cullFace(GL_BACK),
+                         m_frontFace(GL_CCW), m_polygonMode(GL_FILL), m_blendEnabled(false) {}
+
+    /// @brief  The class destructor, default implementation.
+    ~OGLPipelineState() = default;
+
+    /// @brief  Returns true, if the cull and polygon states are equal.
+    bool isCullEqual(const OGLPipelineState &rhs) const {
+        return m_cullEnabled == rhs.m_cullEnabled && m_cullFace == rhs.m_cullFace &&
+               m_frontFace == rhs.m_frontFace && m_polygonMode == rhs.m_polygonMode;
+    }
+};
+
 } // namespace RenderBackend
 } // namespace OSRE
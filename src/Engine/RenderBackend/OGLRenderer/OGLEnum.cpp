@@ -178,7 +178,14 @@ GLenum OGLEnum::getOGLTypeForFormat( VertexFormat format ) {
             return GL_UNSIGNED_BYTE;
         case VertexFormat::Short2:
         case VertexFormat::Short4:
+        case VertexFormat::Short2N:
+        case VertexFormat::Short4N:
             return GL_SHORT;
+        case VertexFormat::UByte4N:
+            return GL_UNSIGNED_BYTE;
+        case VertexFormat::Half2:
+        case VertexFormat::Half4:
+            return GL_HALF_FLOAT;
         case VertexFormat::NumVertexFormats:
         case VertexFormat::InvalidVertexFormat:
         default:
@@ -195,6 +202,8 @@ ui32 OGLEnum::getOGLSizeForFormat( VertexFormat format ) {
             return 1;
         case VertexFormat::Float2:
         case VertexFormat::Short2:
+        case VertexFormat::Short2N:
+        case VertexFormat::Half2:
             return 2;
         case VertexFormat::Float3:
             return 3;
@@ -202,6 +211,9 @@ ui32 OGLEnum::getOGLSizeForFormat( VertexFormat format ) {
         case VertexFormat::UByte4:
         case VertexFormat::Float4:
         case VertexFormat::Short4:
+        case VertexFormat::Short4N:
+        case VertexFormat::UByte4N:
+        case VertexFormat::Half4:
             return 4;
         case VertexFormat::NumVertexFormats:
         case VertexFormat::InvalidVertexFormat:
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "OGLRenderBackend.h"
 #include "OGLCommon.h"
 #include "OGLEnum.h"
+#include "OGLScreenCapture.h"
 #include "OGLShader.h"
 
 #include <osre/Common/Logger.h>
@@ -32,6 +33,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/IO/Uri.h>
 #include <osre/Platform/AbstractOGLRenderContext.h>
 #include <osre/Profiling/PerformanceCounterRegistry.h>
+#include <osre/Profiling/RenderStats.h>
 #include <osre/RenderBackend/RenderStates.h>
 #include <osre/RenderBackend/Shader.h>
 
@@ -67,10 +69,13 @@ OGLRenderBackend::OGLRenderBackend() :
         mShaderInUse(nullptr),
         mFreeBufferSlots(),
         mPrimitives(),
-        mFpState(nullptr),
+        mPipelineStates(),
+        mActivePipelineState(nullptr),
         mFpsCounter(nullptr),
         mOglCapabilities(),
-        mFrameFuffers() {
+        mFrameFuffers(),
+        mActiveFrameBuffer(nullptr),
+        mScreenCapture(nullptr) {
     mBindedTextures.resize((size_t)TextureStageType::NumTextureStageTypes);
     for (size_t i = 0; i < (size_t)TextureStageType::NumTextureStageTypes; ++i) {
         mBindedTextures[i] = nullptr;
@@ -167,7 +172,6 @@ void OGLRenderBackend::applyMatrix() {
 bool OGLRenderBackend::create(AbstractOGLRenderContext *renderCtx) {
     setRenderContext(renderCtx);
 
-    mFpState = new RenderStates;
     enumerateGPUCaps();
     ::memset(mOpenGLVersion, 0, sizeof(i32) * 2);
 
@@ -212,8 +216,8 @@ bool OGLRenderBackend::create(AbstractOGLRenderContext *renderCtx) {
 }
 
 bool OGLRenderBackend::destroy() {
-    delete mFpState;
-    mFpState = nullptr;
+    releaseScreenCapture();
+    releaseAllPipelineStates();
 
     releaseAllShaders();
     releaseAllTextures();
@@ -221,6 +225,7 @@ bool OGLRenderBackend::destroy() {
     releaseAllBuffers();
     releaseAllParameters();
     releaseAllPrimitiveGroups();
+    releaseAllFrameBuffers();
 
     delete mFpsCounter;
     mFpsCounter = nullptr;
@@ -342,6 +347,7 @@ void OGLRenderBackend::copyDataToBuffer(OGLBuffer *buffer, void *data, size_t si
     }
     GLenum target = OGLEnum::getGLBufferType(buffer->m_type);
     glBufferData(target, size, data, OGLEnum::getGLBufferAccessType(usage));
+    Profiling::RenderStats::addBufferUpload(size);
 
     CHECKOGLERRORSTATE();
 }
@@ -398,9 +404,10 @@ bool OGLRenderBackend::createVertexCompArray(const VertexLayout *layout, OGLShad
         attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
         attribute->m_size = OGLEnum::getOGLSizeForFormat(comp.m_format);
         attribute->m_type = OGLEnum::getOGLTypeForFormat(comp.m_format);
+        attribute->m_normalized = isVertexFormatNormalized(comp.m_format) ? GL_TRUE : GL_FALSE;
         attribute->m_ptr = (GLvoid *)index;
         attributes.add(attribute);
-        index += attribute->m_size;
+        index += getVertexFormatSize(comp.m_format);
     }
 
     return true;
@@ -474,6 +481,52 @@ bool OGLRenderBackend::createVertexCompArray(VertexType type, OGLShader *shader,
             attributes.add(attribute);
             break;
 
+        case VertexType::QuantizedRenderVertex:
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::Position).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 4;
+            attribute->m_type = GL_SHORT;
+            attribute->m_normalized = GL_TRUE;
+            attribute->m_ptr = (const GLvoid *)offsetof(QuantizedRenderVert, position);
+            attributes.add(attribute);
+
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::Normal).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 2;
+            attribute->m_type = GL_SHORT;
+            attribute->m_normalized = GL_TRUE;
+            attribute->m_ptr = (const GLvoid *)offsetof(QuantizedRenderVert, normal);
+            attributes.add(attribute);
+
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::Tangent).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 2;
+            attribute->m_type = GL_SHORT;
+            attribute->m_normalized = GL_TRUE;
+            attribute->m_ptr = (const GLvoid *)offsetof(QuantizedRenderVert, tangent);
+            attributes.add(attribute);
+
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::Color0).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 4;
+            attribute->m_type = GL_UNSIGNED_BYTE;
+            attribute->m_normalized = GL_TRUE;
+            attribute->m_ptr = (const GLvoid *)offsetof(QuantizedRenderVert, color0);
+            attributes.add(attribute);
+
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::TexCoord0).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 2;
+            attribute->m_type = GL_HALF_FLOAT;
+            attribute->m_ptr = (const GLvoid *)offsetof(QuantizedRenderVert, tex0);
+            attributes.add(attribute);
+            break;
+
         default:
             break;
     }
@@ -511,7 +564,7 @@ bool OGLRenderBackend::bindVertexLayout(OGLVertexArray *va, OGLShader *shader, s
     glEnableVertexAttribArray(loc);
     glVertexAttribPointer(loc, (GLint)attrib->m_size,
             attrib->m_type,
-            GL_FALSE,
+            attrib->m_normalized,
             (GLsizei)stride,
             attrib->m_ptr);
 
@@ -535,7 +588,7 @@ bool OGLRenderBackend::bindVertexLayout(OGLVertexArray *va, OGLShader *shader, s
             glEnableVertexAttribArray(loc);
             glVertexAttribPointer(loc, (GLint)attributes[i]->m_size,
                     attributes[i]->m_type,
-                    GL_FALSE,
+                    attributes[i]->m_normalized,
                     (GLsizei)stride,
                     attributes[i]->m_ptr);
         }
@@ -571,6 +624,7 @@ void OGLRenderBackend::bindVertexArray(OGLVertexArray *vertexArray) {
     if ((mActiveVertexArray == OGLNotSetId) || (mActiveVertexArray != vertexArray->m_id)) {
         mActiveVertexArray = vertexArray->m_id;
         glBindVertexArray(mActiveVertexArray);
+        Profiling::RenderStats::addVertexArrayBind();
         CHECKOGLERRORSTATE();
     }
 }
@@ -658,6 +712,7 @@ bool OGLRenderBackend::useShader(OGLShader *shader) {
     mShaderInUse = shader;
     if (nullptr != mShaderInUse) {
         mShaderInUse->use();
+        Profiling::RenderStats::addShaderBind();
     }
 
     return true;
@@ -872,6 +927,7 @@ bool OGLRenderBackend::bindTexture(OGLTexture *oglTexture, TextureStageType stag
     glActiveTexture(glStageType);
     glBindTexture(oglTexture->m_target, oglTexture->m_textureId);
     mBindedTextures[(size_t)stageType] = oglTexture;
+    Profiling::RenderStats::addTextureBind();
 
     return true;
 }
@@ -1041,6 +1097,7 @@ void OGLRenderBackend::setParameter(OGLParameter *param) {
         default:
             break;
     }
+    Profiling::RenderStats::addUniformUpload();
     CHECKOGLERRORSTATE();
 }
 
@@ -1079,13 +1136,30 @@ size_t OGLRenderBackend::addPrimitiveGroup(PrimitiveGroup *grp) {
     return idx;
 }
 
+void OGLRenderBackend::updatePrimitiveGroups(const size_t *primIndices, const size_t *numIndices, size_t numGroups) {
+    if (nullptr == primIndices || nullptr == numIndices) {
+        return;
+    }
+
+    for (size_t i = 0; i < numGroups; ++i) {
+        if (primIndices[i] >= mPrimitives.size() || nullptr == mPrimitives[primIndices[i]]) {
+            continue;
+        }
+        mPrimitives[primIndices[i]]->m_numIndices = numIndices[i];
+    }
+}
+
 void OGLRenderBackend::releaseAllPrimitiveGroups() {
     ContainerClear(mPrimitives);
 }
 
 OGLFrameBuffer *OGLRenderBackend::createFrameBuffer(const String &name, ui32 width, ui32 height, 
         PixelFormatType pixelFormat, bool depthBuffer) {
-    OGLFrameBuffer *oglFB = new OGLFrameBuffer(name.c_str(), width, height);
+    // The framebuffer keeps its own copy of the name, the string may be a temporary one
+    c8 *fbName = new c8[name.size() + 1];
+    ::strncpy(fbName, name.c_str(), name.size() + 1);
+    OGLFrameBuffer *oglFB = new OGLFrameBuffer(fbName, width, height);
+    oglFB->m_format = pixelFormat;
     glGenFramebuffers(1, &oglFB->m_bufferId);
     glBindFramebuffer(GL_FRAMEBUFFER, oglFB->m_bufferId);
 
@@ -1094,7 +1168,7 @@ OGLFrameBuffer *OGLRenderBackend::createFrameBuffer(const String &name, ui32 wid
 
     // Give an empty image to OpenGL ( the last "0" )
     GLenum glPixelFormat = OGLEnum::getGLTextureFormat(pixelFormat);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, glPixelFormat, GL_UNSIGNED_BYTE, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, glPixelFormat, width, height, 0, glPixelFormat, GL_UNSIGNED_BYTE, 0);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 
@@ -1111,23 +1185,50 @@ OGLFrameBuffer *OGLRenderBackend::createFrameBuffer(const String &name, ui32 wid
     // Set the list of render buffers.
     GLenum DrawBuffers[1] = { GL_COLOR_ATTACHMENT0 };
     glDrawBuffers(1, DrawBuffers);
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        glDeleteFramebuffers(1, &oglFB->m_bufferId);
-        glDeleteTextures(1, &oglFB->m_renderedTexture);
-        delete oglFB;
-        oglFB = nullptr;
+    const bool complete = (glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+
+    // Restore the binding, the creation shall not change the active target
+    glBindFramebuffer(GL_FRAMEBUFFER, nullptr == mActiveFrameBuffer ? 0 : mActiveFrameBuffer->m_bufferId);
+    if (!complete) {
+        destroyFrameBuffer(oglFB);
+        return nullptr;
+    }
+
+    mFrameFuffers.add(oglFB);
+
+    return oglFB;
+}
+
+OGLFrameBuffer *OGLRenderBackend::acquireFrameBuffer(FrameBuffer *fb) {
+    if (nullptr == fb || nullptr == fb->m_name) {
+        return nullptr;
     }
 
+    // Pooled targets keep their name, so the GPU framebuffer of the last frame will be reused
+    const ui32 width = static_cast<ui32>(fb->m_width);
+    const ui32 height = static_cast<ui32>(fb->m_height);
+    OGLFrameBuffer *oglFB = getFrameBufferByName(fb->m_name);
     if (nullptr != oglFB) {
-        mFrameFuffers.add(oglFB);
+        const bool hasDepth = 0 != oglFB->m_depthrenderbufferId;
+        if (oglFB->m_width == width && oglFB->m_height == height && oglFB->m_format == fb->m_format &&
+                hasDepth == fb->m_depthBuffer) {
+            return oglFB;
+        }
+        releaseFrameBuffer(oglFB);
     }
 
-    return oglFB;
+    return createFrameBuffer(fb->m_name, width, height, fb->m_format, fb->m_depthBuffer);
 }
 
 void OGLRenderBackend::bindFrameBuffer(OGLFrameBuffer *oglFB) {
+    if (oglFB == mActiveFrameBuffer) {
+        return;
+    }
+
+    mActiveFrameBuffer = oglFB;
     if (nullptr == oglFB) {
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(mViewport.m_x, mViewport.m_y, mViewport.m_w, mViewport.m_h);
         return;
     }
 
@@ -1141,7 +1242,7 @@ OGLFrameBuffer *OGLRenderBackend::getFrameBufferByName(const String &name) const
     }
 
     for (ui32 i = 0; i < mFrameFuffers.size(); ++i) {
-        if (0 == strncmp(name.c_str(), mFrameFuffers[i]->m_name, name.size())) {
+        if (0 == strcmp(name.c_str(), mFrameFuffers[i]->m_name)) {
             return mFrameFuffers[i];
         }
     }
@@ -1156,13 +1257,49 @@ void OGLRenderBackend::releaseFrameBuffer(OGLFrameBuffer *oglFB) {
 
     for (ui32 i = 0; i < mFrameFuffers.size(); ++i) {
         if (mFrameFuffers[i] == oglFB) {
-            glDeleteFramebuffers(1, &oglFB->m_bufferId);
-            glDeleteTextures(1, &oglFB->m_renderedTexture);
             mFrameFuffers.remove(i);
+            destroyFrameBuffer(oglFB);
+            return;
         }
     }
 }
 
+void OGLRenderBackend::releaseAllFrameBuffers() {
+    bindFrameBuffer(nullptr);
+    for (ui32 i = 0; i < mFrameFuffers.size(); ++i) {
+        destroyFrameBuffer(mFrameFuffers[i]);
+    }
+    mFrameFuffers.clear();
+}
+
+void OGLRenderBackend::destroyFrameBuffer(OGLFrameBuffer *oglFB) {
+    if (oglFB == mActiveFrameBuffer) {
+        bindFrameBuffer(nullptr);
+    }
+
+    glDeleteFramebuffers(1, &oglFB->m_bufferId);
+    glDeleteTextures(1, &oglFB->m_renderedTexture);
+    if (0 != oglFB->m_depthrenderbufferId) {
+        glDeleteRenderbuffers(1, &oglFB->m_depthrenderbufferId);
+    }
+    delete [] oglFB->m_name;
+    delete oglFB;
+}
+
+static ui64 getNumTriangles(GLenum primitive, size_t numIndices) {
+    switch (primitive) {
+        case GL_TRIANGLES:
+            return numIndices / 3;
+        case GL_TRIANGLE_STRIP:
+        case GL_TRIANGLE_FAN:
+            return numIndices > 2 ? numIndices - 2 : 0;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
 #if _MSC_VER > 1920 && !defined(__clang__)
 #   pragma warning(push)
 #   pragma warning(disable : 4312)
@@ -1170,11 +1307,12 @@ void OGLRenderBackend::releaseFrameBuffer(OGLFrameBuffer *oglFB) {
 
 void OGLRenderBackend::render(size_t primpGrpIdx) {
     OGLPrimGroup *grp(mPrimitives[primpGrpIdx]);
-    if (nullptr != grp) {
+    if (nullptr != grp && 0 != grp->m_numIndices) {
         glDrawElements(grp->m_primitive,
                 (GLsizei)grp->m_numIndices,
                 grp->m_indexType,
                 (const GLvoid *)grp->m_startIndex);
+        Profiling::RenderStats::addDrawCall(1, getNumTriangles(grp->m_primitive, grp->m_numIndices));
     }
 }
 
@@ -1184,17 +1322,22 @@ void OGLRenderBackend::render(size_t primpGrpIdx) {
 
 void OGLRenderBackend::render(size_t primpGrpIdx, size_t numInstances) {
     OGLPrimGroup *grp(mPrimitives[primpGrpIdx]);
-    if (nullptr != grp) {
+    if (nullptr != grp && 0 != grp->m_numIndices) {
         glDrawArraysInstanced(grp->m_primitive,
                 grp->m_startIndex,
                 (GLsizei)grp->m_numIndices,
                 (GLsizei)numInstances);
+        Profiling::RenderStats::addDrawCall(static_cast<ui32>(numInstances), getNumTriangles(grp->m_primitive, grp->m_numIndices));
     }
 }
 
 void OGLRenderBackend::renderFrame() {
     osre_assert(nullptr != mRenderCtx);
 
+    // The capture reads the back buffer, so it must be started before the swap
+    if (nullptr != mScreenCapture) {
+        mScreenCapture->onFrameEnd(mViewport.m_w, mViewport.m_h);
+    }
     mRenderCtx->update();
     if (nullptr != mFpsCounter) {
         const ui32 fps = mFpsCounter->getFPS();
@@ -1202,38 +1345,89 @@ void OGLRenderBackend::renderFrame() {
     }
 }
 
+OGLScreenCapture *OGLRenderBackend::getScreenCapture() {
+    if (nullptr == mScreenCapture) {
+        mScreenCapture = new OGLScreenCapture;
+    }
+
+    return mScreenCapture;
+}
+
+void OGLRenderBackend::releaseScreenCapture() {
+    delete mScreenCapture;
+    mScreenCapture = nullptr;
+}
+
 void OGLRenderBackend::setFixedPipelineStates(const RenderStates &states) {
-    osre_assert(nullptr != mFpState);
+    setPipelineState(PipelineStateRegistry::create(states));
+}
 
-    if (mFpState->m_applied) {
-        if (mFpState->isEqual(states.m_clearState, states.m_depthState, states.m_transformState, states.m_polygonState,
-                    states.m_cullState, states.m_blendState, states.m_samplerState, states.m_stencilState)) {
-            return;
-        }
+OGLPipelineState *OGLRenderBackend::acquirePipelineState(PipelineStateId id) {
+    auto it = mPipelineStates.find(id);
+    if (mPipelineStates.end() != it) {
+        return it->second;
     }
 
-    mFpState->m_polygonState = states.m_polygonState;
-    mFpState->m_blendState = states.m_blendState;
-    mFpState->m_cullState = states.m_cullState;
-    mFpState->m_samplerState = states.m_samplerState;
-    mFpState->m_stencilState = states.m_stencilState;
+    const PipelineState *pipelineState = PipelineStateRegistry::get(id);
+    if (nullptr == pipelineState) {
+        osre_error(Tag, "Invalid pipeline state id.");
+        return nullptr;
+    }
 
-    if (mFpState->m_cullState.m_cullMode == CullState::CullMode::Off) {
-        glDisable(GL_CULL_FACE);
-    } else {
-        glEnable(GL_CULL_FACE);
-        glCullFace(OGLEnum::getOGLCullFace(mFpState->m_cullState.m_cullFace));
-        glPolygonMode(OGLEnum::getOGLCullFace(mFpState->m_cullState.m_cullFace),
-                OGLEnum::getOGLPolygonMode(mFpState->m_polygonState.m_polyMode));
-        glFrontFace(OGLEnum::getOGLCullState(mFpState->m_cullState.m_cullMode));
+    const RenderStates &states = pipelineState->getStates();
+    OGLPipelineState *oglPipelineState = new OGLPipelineState;
+    oglPipelineState->m_id = id;
+    oglPipelineState->m_cullEnabled = states.m_cullState.m_cullMode != CullState::CullMode::Off;
+    if (oglPipelineState->m_cullEnabled) {
+        oglPipelineState->m_cullFace = OGLEnum::getOGLCullFace(states.m_cullState.m_cullFace);
+        oglPipelineState->m_frontFace = OGLEnum::getOGLCullState(states.m_cullState.m_cullMode);
+        oglPipelineState->m_polygonMode = OGLEnum::getOGLPolygonMode(states.m_polygonState.m_polyMode);
     }
+    oglPipelineState->m_blendEnabled = states.m_blendState.m_blendFunc != BlendState::BlendFunc::Off;
+    mPipelineStates[id] = oglPipelineState;
 
-    if (mFpState->m_blendState.m_blendFunc == BlendState::BlendFunc::Off) {
-        glDisable(GL_BLEND);
-    } else {
-        glEnable(GL_BLEND);
+    return oglPipelineState;
+}
+
+void OGLRenderBackend::setPipelineState(PipelineStateId id) {
+    if (nullptr != mActivePipelineState && mActivePipelineState->m_id == id) {
+        return;
+    }
+
+    OGLPipelineState *pipelineState = acquirePipelineState(id);
+    if (nullptr == pipelineState) {
+        return;
+    }
+
+    // Only the sub-states which differ from the active pipeline state will be applied
+    const OGLPipelineState *active = mActivePipelineState;
+    if (nullptr == active || !active->isCullEqual(*pipelineState)) {
+        if (!pipelineState->m_cullEnabled) {
+            glDisable(GL_CULL_FACE);
+        } else {
+            glEnable(GL_CULL_FACE);
+            glCullFace(pipelineState->m_cullFace);
+            glPolygonMode(pipelineState->m_cullFace, pipelineState->m_polygonMode);
+            glFrontFace(pipelineState->m_frontFace);
+        }
+    }
+
+    if (nullptr == active || active->m_blendEnabled != pipelineState->m_blendEnabled) {
+        if (!pipelineState->m_blendEnabled) {
+            glDisable(GL_BLEND);
+        } else {
+            glEnable(GL_BLEND);
+        }
+    }
+    mActivePipelineState = pipelineState;
+}
+
+void OGLRenderBackend::releaseAllPipelineStates() {
+    for (auto &it : mPipelineStates) {
+        delete it.second;
     }
-    mFpState->m_applied = true;
+    mPipelineStates.clear();
+    mActivePipelineState = nullptr;
 }
 
 void OGLRenderBackend::setExtensions(const String &extensions) {
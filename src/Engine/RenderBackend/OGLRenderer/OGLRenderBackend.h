@@ -52,6 +52,7 @@ namespace Platform {
 
 namespace RenderBackend {
 
+class OGLScreenCapture;
 class OGLShader;
 class Shader;
 
@@ -141,18 +142,29 @@ public:
 	void setParameter(OGLParameter **param, size_t numParam);
 	void releaseAllParameters();
 	size_t addPrimitiveGroup(PrimitiveGroup *grp);
+	void updatePrimitiveGroups(const size_t *primIndices, const size_t *numIndices, size_t numGroups);
 	void releaseAllPrimitiveGroups();
     OGLFrameBuffer *createFrameBuffer(const String &name, ui32 width, ui32 height, PixelFormatType pixelFormat, bool depthBuffer);
+	OGLFrameBuffer *acquireFrameBuffer(FrameBuffer *fb);
 	void bindFrameBuffer(OGLFrameBuffer *oglFB);
 	OGLFrameBuffer *getFrameBufferByName(const String &name) const;
 	void releaseFrameBuffer(OGLFrameBuffer *oglFB);
+	void releaseAllFrameBuffers();
 	void render(size_t grimpGrpIdx);
 	void render(size_t primpGrpIdx, size_t numInstances);
 	void renderFrame();
+	OGLScreenCapture *getScreenCapture();
+	void releaseScreenCapture();
 	void setFixedPipelineStates(const RenderStates &states);
+	OGLPipelineState *acquirePipelineState(PipelineStateId id);
+	void setPipelineState(PipelineStateId id);
+	void releaseAllPipelineStates();
     void setExtensions(const String &extensions);
     const String &getExtensions() const;
     
+private:
+	void destroyFrameBuffer(OGLFrameBuffer *oglFB);
+
 private:
     Color4 mClearColor;
     TransformMatrixBlock mMatrixBlock;
@@ -171,13 +183,16 @@ private:
 	OGLShader *mShaderInUse;
 	cppcore::TArray<size_t> mFreeBufferSlots;
 	cppcore::TArray<OGLPrimGroup*> mPrimitives;
-	RenderStates *mFpState;
+	std::map<PipelineStateId, OGLPipelineState *> mPipelineStates;
+	OGLPipelineState *mActivePipelineState;
 	Profiling::FPSCounter *mFpsCounter;
 	OGLCapabilities mOglCapabilities;
 	cppcore::TArray<OGLFrameBuffer*> mFrameFuffers;
+	OGLFrameBuffer *mActiveFrameBuffer;
     String mExtensions;
     i32 mOpenGLVersion[2];
     Viewport mViewport;
+    OGLScreenCapture *mScreenCapture;
 };
 
 } // Namespace RenderBackend
@@ -53,21 +53,59 @@ using namespace ::OSRE::Common;
 using namespace ::OSRE::Platform;
 using namespace ::cppcore;
 
+bool writeScreenShot(const c8 *filename, ScreenshotFormat format, ui32 w, ui32 h, uc8 *pixels) {
+    if (nullptr == filename || nullptr == pixels || 0 == w || 0 == h) {
+        return false;
+    }
+
+    // OpenGL returns the rows bottom up
+    const size_t stride = w * 3;
+    cppcore::TArray<uc8> row;
+    row.resize(stride);
+    for (ui32 y = 0; y < h / 2; ++y) {
+        uc8 *top = pixels + y * stride;
+        uc8 *bottom = pixels + (h - 1 - y) * stride;
+        ::memcpy(&row[0], top, stride);
+        ::memcpy(top, bottom, stride);
+        ::memcpy(bottom, &row[0], stride);
+    }
+
+    i32 result = 0;
+    switch (format) {
+        case ScreenshotFormat::Jpg:
+            result = stbi_write_jpg(filename, w, h, 3, pixels, 90);
+            break;
+        case ScreenshotFormat::Png:
+            result = stbi_write_png(filename, w, h, 3, pixels, static_cast<i32>(stride));
+            break;
+        case ScreenshotFormat::Raw: {
+            FILE *file = ::fopen(filename, "wb");
+            if (nullptr != file) {
+                result = (::fwrite(pixels, stride, h, file) == h) ? 1 : 0;
+                ::fclose(file);
+            }
+        } break;
+        default:
+            break;
+    }
+
+    if (0 == result) {
+        osre_error(Tag, "Cannot write screenshot " + String(filename));
+        return false;
+    }
+
+    return true;
+}
+
 bool makeScreenShot(const c8 *filename, ui32 w, ui32 h) {
-    const i32 numberOfPixels = w * h * 3;
-    unsigned char *pixels = new uc8[numberOfPixels];
+    cppcore::TArray<uc8> pixels;
+    pixels.resize(w * h * 3);
 
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
     glReadBuffer(GL_FRONT);
-    glReadPixels(0, 0, w, h, GL_BGR_EXT, GL_UNSIGNED_BYTE, pixels);
-    bool result = true;
-    if (stbi_write_jpg(filename, w, h, 3, pixels, numberOfPixels) != 0){
-        result = false;
-    }
-
-    delete [] pixels;
+    glReadPixels(0, 0, w, h, GL_RGB, GL_UNSIGNED_BYTE, &pixels[0]);
 
-    return result;
+    return writeScreenShot(filename, ScreenshotFormat::Jpg, w, h, &pixels[0]);
 }
 
 bool setupTextures(Material *mat, OGLRenderBackend *rb, TArray<OGLTexture *> &textures) {
@@ -111,6 +149,7 @@ SetMaterialStageCmdData *setupMaterial(Material *material, OGLRenderBackend *rb,
     }
     
     auto *matData = new SetMaterialStageCmdData;
+    matData->m_pipelineState = material->getPipelineState();
     switch (material->m_type) {
         case MaterialType::ShaderMaterial: {
             TArray<OGLTexture *> textures;
@@ -119,8 +158,12 @@ SetMaterialStageCmdData *setupMaterial(Material *material, OGLRenderBackend *rb,
             if (!textures.isEmpty()) {
                 matData->m_textures = textures;
             }
+            // Variants of a shader permutation share their program over all materials
             String name = "mat";
             name += material->m_name;
+            if (nullptr != material->m_shader && !material->m_shader->getProgramName().empty()) {
+                name = material->m_shader->getProgramName();
+            }
             OGLShader *shader = rb->createShader(name, material->m_shader);
             if (nullptr != shader) {
                 matData->m_shader = shader;
@@ -217,7 +260,7 @@ OGLVertexArray *setupBuffers(Mesh *mesh, OGLRenderBackend *rb, OGLShader *oglSha
 
 void setupPrimDrawCmd(const char *id, bool useLocalMatrix, const glm::mat4 &model,
         const TArray<size_t> &primGroups, OGLRenderBackend *rb,
-        OGLRenderEventHandler *eh, OGLVertexArray *va) {
+        OGLRenderEventHandler *eh, OGLVertexArray *va, const glm::mat4 *dequantization) {
     osre_assert(nullptr != rb);
     osre_assert(nullptr != eh);
 
@@ -231,6 +274,10 @@ void setupPrimDrawCmd(const char *id, bool useLocalMatrix, const glm::mat4 &mode
         data->m_model = model;
         data->m_localMatrix = useLocalMatrix;
     }
+    if (nullptr != dequantization) {
+        data->m_quantized = true;
+        data->m_dequantization = *dequantization;
+    }
     data->m_id = id;
     data->m_vertexArray = va;
     data->m_primitives.reserve(primGroups.size());
@@ -243,7 +290,7 @@ void setupPrimDrawCmd(const char *id, bool useLocalMatrix, const glm::mat4 &mode
 }
 
 void setupInstancedDrawCmd(const char *id, const TArray<size_t> &ids, OGLRenderBackend *rb,
-        OGLRenderEventHandler *eh, OGLVertexArray *va, size_t numInstances) {
+        OGLRenderEventHandler *eh, OGLVertexArray *va, size_t numInstances, const glm::mat4 *dequantization) {
     osre_assert(nullptr != rb);
     osre_assert(nullptr != eh);
 
@@ -257,6 +304,10 @@ void setupInstancedDrawCmd(const char *id, const TArray<size_t> &ids, OGLRenderB
     data->m_id = id;
     data->m_vertexArray = va;
     data->m_numInstances = numInstances;
+    if (nullptr != dequantization) {
+        data->m_quantized = true;
+        data->m_dequantization = *dequantization;
+    }
     data->m_primitives.reserve(ids.size());
     for (ui32 j = 0; j < ids.size(); ++j) {
         data->m_primitives.add(ids[j]);
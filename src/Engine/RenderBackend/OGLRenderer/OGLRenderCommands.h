@@ -54,6 +54,9 @@ struct OGLParameter;
 struct UniformVar;
 struct SetMaterialStageCmdData;
 
+enum class ScreenshotFormat;
+
+bool writeScreenShot(const c8 *filename, ScreenshotFormat format, ui32 w, ui32 h, uc8 *pixels);
 bool makeScreenShot(const c8 *filename, ui32 w, ui32 h);
 bool setupTextures(Material* mat, OGLRenderBackend* rb, OGLTextureArray& textures);
 SetMaterialStageCmdData* setupMaterial(Material* material, OGLRenderBackend* rb, OGLRenderEventHandler* eh);
@@ -61,9 +64,9 @@ void setupParameter(UniformVar* param, OGLRenderBackend* rb, OGLRenderEventHandl
 OGLVertexArray* setupBuffers(Mesh* mesh, OGLRenderBackend* rb, OGLShader* oglShader);
 void setupPrimDrawCmd(const char* id, bool useLocalMatrix, const glm::mat4& model,
     const cppcore::TArray<size_t>& primGroups, OGLRenderBackend* rb,
-    OGLRenderEventHandler* eh, OGLVertexArray* va);
+    OGLRenderEventHandler* eh, OGLVertexArray* va, const glm::mat4 *dequantization = nullptr);
 void setupInstancedDrawCmd(const char* id, const cppcore::TArray<size_t>& ids, OGLRenderBackend* rb,
-    OGLRenderEventHandler* eh, OGLVertexArray* va, size_t numInstances);
+    OGLRenderEventHandler* eh, OGLVertexArray* va, size_t numInstances, const glm::mat4 *dequantization = nullptr);
 
 } // Namespace RenderBackend
 } // Namespace OSRE
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "OGLRenderBackend.h"
 #include "OGLRenderCommands.h"
 #include "OGLShader.h"
+#include "OGLScreenCapture.h"
 #include "RenderCmdBuffer.h"
 
 #include <osre/App/AssetRegistry.h>
@@ -35,12 +36,15 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/Platform/AbstractWindow.h>
 #include <osre/Platform/PlatformInterface.h>
 #include <osre/Profiling/PerformanceCounterRegistry.h>
+#include <osre/Profiling/RenderStats.h>
 #include <osre/RenderBackend/Mesh.h>
 #include <osre/RenderBackend/RenderCommon.h>
 #include <osre/RenderBackend/Shader.h>
 
 #include <cppcore/Container/TArray.h>
 
+#include <algorithm>
+
 namespace OSRE {
 namespace RenderBackend {
 
@@ -57,7 +61,9 @@ OGLRenderEventHandler::OGLRenderEventHandler() :
         m_renderCmdBuffer(nullptr),
         m_renderCtx(nullptr),
         m_vertexArray(nullptr),
-        mPipeline(nullptr) {
+        mPipeline(nullptr),
+        mMaterialBindings(),
+        mPrimGroupBindings() {
     // empty
 }
 
@@ -195,6 +201,10 @@ bool OGLRenderEventHandler::onCreateRenderer(const EventData *eventData) {
 
     mPipeline = createRendererEvData->m_pipeline;
     Profiling::PerformanceCounterRegistry::registerCounter("fps");
+    Profiling::PerformanceCounterRegistry::registerCounter("visible_entities");
+    Profiling::PerformanceCounterRegistry::registerCounter("culled_entities");
+    Profiling::PerformanceCounterRegistry::registerCounter("occluded_entities");
+    Profiling::RenderStats::registerCounters();
 
     return true;
 }
@@ -210,6 +220,9 @@ bool OGLRenderEventHandler::onDestroyRenderer(const Common::EventData *) {
         osre_error(Tag, "Error while destroying performance counters.");
     }
 
+    // Pending captures need the context
+    m_oglBackend->releaseScreenCapture();
+
     m_renderCtx->destroy();
     delete m_renderCtx;
     m_renderCtx = nullptr;
@@ -243,6 +256,8 @@ bool OGLRenderEventHandler::onClearGeo(const EventData *) {
     m_oglBackend->releaseAllPrimitiveGroups();
     m_oglBackend->releaseAllVertexArrays();
     m_renderCmdBuffer->clear();
+    mMaterialBindings.clear();
+    mPrimGroupBindings.clear();
 
     return true;
 }
@@ -252,9 +267,12 @@ bool OGLRenderEventHandler::onRenderFrame(const EventData*) {
     osre_assert(nullptr != m_renderCmdBuffer);
     osre_assert(m_renderCtx != nullptr);
 
+    Profiling::RenderStats::beginCpuTime();
     m_renderCmdBuffer->onPreRenderFrame(mPipeline);
     m_renderCmdBuffer->onRenderFrame();
     m_renderCmdBuffer->onPostRenderFrame();
+    Profiling::RenderStats::endCpuTime();
+    Profiling::RenderStats::endFrame();
 
     return true;
 }
@@ -283,14 +301,18 @@ bool OGLRenderEventHandler::addMeshes(const c8 *id, cppcore::TArray<size_t> &pri
             return false;
         }
         data->m_vertexArray = m_vertexArray;
+        mMaterialBindings[currentMesh->getId()] = { currentMesh->getMaterial(), data };
+        mPrimGroupBindings[currentMesh->getId()] = primGroups;
 
         // setup the render calls
         if (0 == currentMeshEntry->numInstances) {
             setupPrimDrawCmd(id, currentMesh->isLocal(), currentMesh->getLocalMatrix(),
-                    primGroups, m_oglBackend, this, m_vertexArray);
+                    primGroups, m_oglBackend, this, m_vertexArray,
+                    currentMesh->isQuantized() ? &currentMesh->getDequantizationMatrix() : nullptr);
         } else {
             setupInstancedDrawCmd(id, primGroups, m_oglBackend, this, m_vertexArray,
-                    currentMeshEntry->numInstances);
+                    currentMeshEntry->numInstances,
+                    currentMesh->isQuantized() ? &currentMesh->getDequantizationMatrix() : nullptr);
         }
 
         primGroups.resize(0);
@@ -370,14 +392,18 @@ bool OGLRenderEventHandler:: onInitRenderPasses(const Common::EventData *eventDa
                         return false;
                     }
                     data->m_vertexArray = m_vertexArray;
+                    mMaterialBindings[currentMesh->getId()] = { currentMesh->getMaterial(), data };
+                    mPrimGroupBindings[currentMesh->getId()] = primGroups;
 
                     // setup the render calls
                     if (0 == currentMeshEntry->numInstances) {
                         setupPrimDrawCmd(currentBatchData->m_id, currentMesh->isLocal(), currentMesh->getLocalMatrix(),
-                                primGroups, m_oglBackend, this, m_vertexArray);
+                                primGroups, m_oglBackend, this, m_vertexArray,
+                                currentMesh->isQuantized() ? &currentMesh->getDequantizationMatrix() : nullptr);
                     } else {
                         setupInstancedDrawCmd(currentBatchData->m_id, primGroups, m_oglBackend, this, m_vertexArray,
-                                currentMeshEntry->numInstances);
+                                currentMeshEntry->numInstances,
+                                currentMesh->isQuantized() ? &currentMesh->getDequantizationMatrix() : nullptr);
                     }
 
                     primGroups.resize(0);
@@ -417,10 +443,12 @@ bool OGLRenderEventHandler::onCommitNexFrame(const EventData *eventData) {
         return false;
     }
 
+    Profiling::RenderStats::beginCpuTime();
     for (FrameSubmitCmd *cmd : data->m_frame->m_submitCmds) {
         if (nullptr == cmd) {
             continue;
         }
+        Profiling::RenderStats::addSubmitCmd(cmd->m_size);
         if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateMatrixes) {
             MatrixBuffer *buffer = (MatrixBuffer *)cmd->m_data;
             m_renderCmdBuffer->setMatrixBuffer(cmd->m_batchId, buffer);
@@ -432,10 +460,18 @@ bool OGLRenderEventHandler::onCommitNexFrame(const EventData *eventData) {
             OGLParameter *oglParam = m_oglBackend->getParameter(name);
             ::memcpy(oglParam->m_data->getData(), &cmd->m_data[offset], size);
         } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateBuffer) {
-            OGLBuffer *buffer = m_oglBackend->getBufferById(cmd->m_meshId);
-            m_oglBackend->bindBuffer(buffer);
-            m_oglBackend->copyDataToBuffer(buffer, cmd->m_data, cmd->m_size, BufferAccessType::ReadWrite);
-            m_oglBackend->unbindBuffer(buffer);
+            if (0 != cmd->m_size) {
+                OGLBuffer *buffer = m_oglBackend->getBufferById(cmd->m_meshId);
+                m_oglBackend->bindBuffer(buffer);
+                m_oglBackend->copyDataToBuffer(buffer, cmd->m_data, cmd->m_size, BufferAccessType::ReadWrite);
+                m_oglBackend->unbindBuffer(buffer);
+            }
+            if (!cmd->m_numIndices.isEmpty()) {
+                updatePrimitiveGroups(cmd->m_meshId, cmd->m_numIndices);
+                cmd->m_numIndices.resize(0);
+            }
+            rebindMaterial(cmd->m_meshId, cmd->m_material);
+            cmd->m_material = nullptr;
         } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::AddRenderData) {
             for (ui32 i = 0; i < cmd->m_updatedPasses.size(); ++i) {
                 PassData *pd = cmd->m_updatedPasses[i];
@@ -451,10 +487,38 @@ bool OGLRenderEventHandler::onCommitNexFrame(const EventData *eventData) {
     }
     data->m_frame->m_submitCmds.resize(0);
     data->m_frame->m_submitCmdAllocator.release();
+    Profiling::RenderStats::endCpuTime();
 
     return true;
 }
 
+void OGLRenderEventHandler::rebindMaterial(guid meshId, Material *material) {
+    if (nullptr == material) {
+        return;
+    }
+
+    auto it = mMaterialBindings.find(meshId);
+    if (mMaterialBindings.end() == it || it->second.mMaterial == material) {
+        return;
+    }
+
+    // The shader and the vertex array stay valid, only the textures will be exchanged
+    SetMaterialStageCmdData *data = it->second.mData;
+    data->m_textures.resize(0);
+    setupTextures(material, m_oglBackend, data->m_textures);
+    it->second.mMaterial = material;
+}
+
+void OGLRenderEventHandler::updatePrimitiveGroups(guid meshId, const cppcore::TArray<size_t> &numIndices) {
+    auto it = mPrimGroupBindings.find(meshId);
+    if (mPrimGroupBindings.end() == it || it->second.isEmpty() || numIndices.isEmpty()) {
+        return;
+    }
+
+    const size_t numGroups = std::min(it->second.size(), numIndices.size());
+    m_oglBackend->updatePrimitiveGroups(&it->second[0], &numIndices[0], numGroups);
+}
+
 bool OGLRenderEventHandler::onShutdownRequest(const EventData*) {
     m_isRunning = false;
 
@@ -478,14 +542,17 @@ bool OGLRenderEventHandler::onResizeRenderTarget(const EventData *eventData) {
 
 bool OGLRenderEventHandler::onScreenshot(const EventData *eventData) {
     osre_assert(nullptr != eventData);
+    osre_assert(nullptr != m_oglBackend);
 
-    bool result = false;
-    ScreenshotEventData *data = (ScreenshotEventData*) eventData;
-    if (data != nullptr){
-        result = makeScreenShot(data->mFilename.c_str(), data->mWidth, data->mHeight);
+    const ScreenshotEventData *data = (const ScreenshotEventData*) eventData;
+    if (data == nullptr) {
+        return false;
     }
-    return result;
-    
+
+    // The readback will be started at the end of the next frame
+    m_oglBackend->getScreenCapture()->request(*data);
+
+    return true;
 }
 
 } // Namespace RenderBackend
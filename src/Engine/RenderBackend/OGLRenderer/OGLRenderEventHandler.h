@@ -29,6 +29,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <GL/glew.h>
 #include <GL/gl.h>
 
+#include <map>
+
 namespace OSRE {
 
 // Forward declarations
@@ -56,6 +58,7 @@ struct DrawPrimitivesCmdData;
 struct SetTextureStageCmdData;
 struct SetShaderStageCmdData;
 struct SetRenderTargetCmdData;
+struct SetMaterialStageCmdData;
 struct OGLParameter;
 struct OGLBuffer;
 
@@ -167,13 +170,30 @@ protected:
     /// @return true if successful.
     bool onScreenshot(const Common::EventData *data);
 
+    /// @brief  Will bind the textures of a new material to an already registered mesh.
+    /// @param  meshId      [in] The id of the mesh.
+    /// @param  material    [in] The material, must use the same shader as the one it replaces.
+    void rebindMaterial(guid meshId, Material *material);
+
+    /// @brief  Will update the number of indices to draw of the primitive groups of a mesh.
+    /// @param  meshId      [in] The id of the mesh.
+    /// @param  numIndices  [in] The number of indices, one per primitive group.
+    void updatePrimitiveGroups(guid meshId, const cppcore::TArray<size_t> &numIndices);
+
 private:
+    struct MaterialBinding {
+        Material *mMaterial;
+        SetMaterialStageCmdData *mData;
+    };
+
     bool m_isRunning;
     OGLRenderBackend *m_oglBackend;
     RenderCmdBuffer *m_renderCmdBuffer;
     Platform::AbstractOGLRenderContext *m_renderCtx;
     OGLVertexArray *m_vertexArray;
     Pipeline *mPipeline;
+    std::map<guid, MaterialBinding> mMaterialBindings;
+    std::map<guid, cppcore::TArray<size_t>> mPrimGroupBindings;
 };
 
 inline RenderCmdBuffer *OGLRenderEventHandler::getRenderCmdBuffer() const {
@@ -0,0 +1,223 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "OGLScreenCapture.h"
+#include "OGLRenderCommands.h"
+
+#include <osre/Common/Logger.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include <cstdio>
+#include <thread>
+
+namespace OSRE {
+namespace RenderBackend {
+
+static constexpr c8 Tag[] = "OGLScreenCapture";
+
+// Waiting for a readback is limited to one second
+static constexpr GLuint64 WaitTimeout = 1000000000;
+
+static const c8 *getExtension(ScreenshotFormat format) {
+    switch (format) {
+        case ScreenshotFormat::Jpg:
+            return ".jpg";
+        case ScreenshotFormat::Png:
+            return ".png";
+        case ScreenshotFormat::Raw:
+            return ".raw";
+        default:
+            break;
+    }
+
+    return "";
+}
+
+OGLScreenCapture::OGLScreenCapture() :
+        mNextSlot(0),
+        mRequests(),
+        mSequenceActive(false),
+        mSequence(),
+        mSequenceFrame(0),
+        mNumEncoding(0),
+        mEncoder(1) {
+    for (Slot &slot : mSlots) {
+        glGenBuffers(1, &slot.mPbo);
+        slot.mFence = nullptr;
+        slot.mSize = 0;
+    }
+    CHECKOGLERRORSTATE();
+}
+
+OGLScreenCapture::~OGLScreenCapture() {
+    flush();
+    for (Slot &slot : mSlots) {
+        glDeleteBuffers(1, &slot.mPbo);
+    }
+}
+
+String OGLScreenCapture::getSequenceFilename(const String &prefix, ui32 frame, ScreenshotFormat format) {
+    c8 number[16];
+    ::snprintf(number, sizeof(number), "_%06u", frame);
+
+    return prefix + number + getExtension(format);
+}
+
+void OGLScreenCapture::request(const ScreenshotEventData &data) {
+    Request request;
+    request.mFilename = data.mFilename;
+    request.mFormat = data.mFormat;
+    request.mWidth = data.mWidth;
+    request.mHeight = data.mHeight;
+
+    switch (data.mMode) {
+        case ScreenshotMode::Single:
+            mRequests.add(request);
+            break;
+        case ScreenshotMode::BeginSequence:
+            mSequenceActive = true;
+            mSequence = request;
+            mSequenceFrame = 0;
+            break;
+        case ScreenshotMode::EndSequence:
+            mSequenceActive = false;
+            break;
+        default:
+            break;
+    }
+}
+
+void OGLScreenCapture::onFrameEnd(ui32 w, ui32 h) {
+    // Finished readbacks go to the encoder without waiting
+    for (Slot &slot : mSlots) {
+        if (nullptr != slot.mFence) {
+            complete(slot, false);
+        }
+    }
+
+    for (size_t i = 0; i < mRequests.size(); ++i) {
+        Request &request = mRequests[i];
+        if (0 == request.mWidth || 0 == request.mHeight) {
+            request.mWidth = w;
+            request.mHeight = h;
+        }
+        readback(request);
+    }
+    mRequests.resize(0);
+
+    if (mSequenceActive) {
+        Request request = mSequence;
+        request.mFilename = getSequenceFilename(mSequence.mFilename, mSequenceFrame++, mSequence.mFormat);
+        if (0 == request.mWidth || 0 == request.mHeight) {
+            request.mWidth = w;
+            request.mHeight = h;
+        }
+        readback(request);
+    }
+}
+
+void OGLScreenCapture::flush() {
+    mRequests.resize(0);
+    mSequenceActive = false;
+
+    // Complete in the order of the readbacks
+    for (ui32 i = 0; i < NumBuffers; ++i) {
+        Slot &slot = mSlots[(mNextSlot + i) % NumBuffers];
+        if (nullptr != slot.mFence) {
+            complete(slot, true);
+        }
+    }
+    while (mNumEncoding.load() > 0) {
+        if (!mEncoder.runPendingJob()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void OGLScreenCapture::readback(const Request &request) {
+    if (0 == request.mWidth || 0 == request.mHeight) {
+        osre_debug(Tag, "Invalid screenshot size.");
+        return;
+    }
+
+    // All buffers are busy, wait for the oldest one
+    Slot &slot = mSlots[mNextSlot];
+    if (nullptr != slot.mFence) {
+        complete(slot, true);
+    }
+    mNextSlot = (mNextSlot + 1) % NumBuffers;
+
+    const size_t size = request.mWidth * request.mHeight * 3;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.mPbo);
+    if (slot.mSize < size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        slot.mSize = size;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadBuffer(GL_BACK);
+    glReadPixels(0, 0, request.mWidth, request.mHeight, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    slot.mFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.mRequest = request;
+    CHECKOGLERRORSTATE();
+}
+
+void OGLScreenCapture::complete(Slot &slot, bool wait) {
+    const GLenum state = glClientWaitSync(slot.mFence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? WaitTimeout : 0);
+    if (GL_TIMEOUT_EXPIRED == state && !wait) {
+        return;
+    }
+
+    glDeleteSync(slot.mFence);
+    slot.mFence = nullptr;
+    if (GL_ALREADY_SIGNALED != state && GL_CONDITION_SATISFIED != state) {
+        osre_error(Tag, "Readback of " + slot.mRequest.mFilename + " failed.");
+        return;
+    }
+
+    const Request request = slot.mRequest;
+    const size_t size = request.mWidth * request.mHeight * 3;
+    uc8 *pixels = new uc8[size];
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.mPbo);
+    const void *data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (nullptr != data) {
+        ::memcpy(pixels, data, size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    CHECKOGLERRORSTATE();
+    if (nullptr == data) {
+        osre_error(Tag, "Cannot map the readback of " + request.mFilename);
+        delete[] pixels;
+        return;
+    }
+
+    ++mNumEncoding;
+    mEncoder.enqueue([this, request, pixels]() {
+        writeScreenShot(request.mFilename.c_str(), request.mFormat, request.mWidth, request.mHeight, pixels);
+        delete[] pixels;
+        --mNumEncoding;
+    });
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
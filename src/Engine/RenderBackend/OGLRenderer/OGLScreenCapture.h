@@ -0,0 +1,113 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "OGLCommon.h"
+
+#include <osre/RenderBackend/RenderBackendService.h>
+#include <osre/Threading/ThreadPool.h>
+#include <cppcore/Container/TArray.h>
+
+#include <atomic>
+
+namespace OSRE {
+namespace RenderBackend {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements the asynchronous screenshot capture.
+///
+/// At the end of a frame the back buffer will be copied into one of a ring of pixel pack
+/// buffers, the copy runs on the GPU and a fence marks its end. The buffers will be polled in
+/// the following frames, finished ones will be mapped and handed to a worker thread, which
+/// encodes and writes the image. The render thread waits only when all buffers are still busy.
+//-------------------------------------------------------------------------------------------------
+class OGLScreenCapture {
+public:
+    /// @brief  The number of pixel pack buffers.
+    static constexpr ui32 NumBuffers = 3;
+
+    /// @brief  The class constructor.
+    OGLScreenCapture();
+
+    /// @brief  The class destructor, will finish all pending captures.
+    ~OGLScreenCapture();
+
+    /// @brief  Will handle a screenshot request.
+    /// @param  data        [in] The request.
+    void request(const ScreenshotEventData &data);
+
+    /// @brief  Will start the requested readbacks and poll the running ones, call before the swap.
+    /// @param  w           [in] The viewport width.
+    /// @param  h           [in] The viewport height.
+    void onFrameEnd(ui32 w, ui32 h);
+
+    /// @brief  Will wait for all readbacks and encodings.
+    void flush();
+
+    /// @brief  Returns true while a sequence will be captured.
+    bool isSequenceActive() const;
+
+    /// @brief  Returns the name of a sequence image.
+    /// @param  prefix      [in] The filename prefix.
+    /// @param  frame       [in] The frame number.
+    /// @param  format      [in] The image format.
+    /// @return The filename.
+    static String getSequenceFilename(const String &prefix, ui32 frame, ScreenshotFormat format);
+
+private:
+    struct Request {
+        String mFilename;
+        ScreenshotFormat mFormat;
+        ui32 mWidth;
+        ui32 mHeight;
+    };
+
+    struct Slot {
+        GLuint mPbo;
+        GLsync mFence;
+        size_t mSize;
+        Request mRequest;
+    };
+
+    void readback(const Request &request);
+    void complete(Slot &slot, bool wait);
+
+private:
+    Slot mSlots[NumBuffers];
+    ui32 mNextSlot;
+    cppcore::TArray<Request> mRequests;
+    bool mSequenceActive;
+    Request mSequence;
+    ui32 mSequenceFrame;
+    std::atomic<ui32> mNumEncoding;
+    Threading::ThreadPool mEncoder;
+};
+
+inline bool OGLScreenCapture::isSequenceActive() const {
+    return mSequenceActive;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -26,6 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "OGLRenderBackend.h"
 #include <osre/Debugging/osre_debugging.h>
 #include <osre/Platform/AbstractOGLRenderContext.h>
+#include <osre/Profiling/RenderStats.h>
 
 namespace OSRE {
 namespace RenderBackend {
@@ -43,7 +44,8 @@ RenderCmdBuffer::RenderCmdBuffer(OGLRenderBackend *renderBackend, AbstractOGLRen
         mMaterials(),
         mParamArray(),
         mMatrixBuffer(),
-        mPipeline(nullptr) {
+        mPipeline(nullptr),
+        mPassPipelineState(InvalidPipelineStateId) {
     osre_assert(nullptr != mRBService);
     osre_assert(nullptr != mRenderCtx);
 
@@ -115,13 +117,16 @@ void RenderCmdBuffer::onRenderFrame() {
             continue;
         }
 
-        RenderStates states;
-        states.m_polygonState = pass->getPolygonState();
-        states.m_cullState = pass->getCullState();
-        states.m_blendState = pass->getBlendState();
-        states.m_samplerState = pass->getSamplerState();
-        states.m_stencilState = pass->getStencilState();
-        mRBService->setFixedPipelineStates(states);
+        // Passes without a framebuffer render into the back buffer, binding the same target again will be skipped
+        FrameBuffer *fb = pass->getFrameBuffer();
+        mRBService->bindFrameBuffer(mRBService->acquireFrameBuffer(fb));
+        if (nullptr != fb) {
+            mRBService->clearRenderTarget(pass->getClearState());
+        }
+
+        Profiling::RenderStats::beginPass(static_cast<ui32>(pass->getId()));
+        mPassPipelineState = pass->getPipelineStateId();
+        mRBService->setPipelineState(mPassPipelineState);
 
         for (OGLRenderCmd *renderCmd : mCommandQueue) {
             if (nullptr == renderCmd) {
@@ -141,9 +146,11 @@ void RenderCmdBuffer::onRenderFrame() {
             }
         }
 
+        Profiling::RenderStats::endPass();
         mPipeline->endPass(passId);
     }
     mPipeline->endFrame();
+    mRBService->bindFrameBuffer(nullptr);
 
     mRBService->renderFrame();
 }
@@ -235,10 +242,24 @@ bool RenderCmdBuffer::onDrawPrimitivesCmd(DrawPrimitivesCmdData *data) {
         mRBService->setMatrix(MatrixType::Model, data->m_model*model);
         mRBService->applyMatrix();
     }
+
+    // quantized vertices are stored in the unit cube, bring them back to object space
+    glm::mat4 model;
+    if (data->m_quantized) {
+        model = mRBService->getMatrix(MatrixType::Model);
+        mRBService->setMatrix(MatrixType::Model, model * data->m_dequantization);
+        mRBService->applyMatrix();
+    }
+
     for (size_t i = 0; i < data->m_primitives.size(); ++i) {
         mRBService->render(data->m_primitives[i]);
     }
 
+    if (data->m_quantized) {
+        mRBService->setMatrix(MatrixType::Model, model);
+        mRBService->applyMatrix();
+    }
+
     return true;
 }
 
@@ -248,10 +269,24 @@ bool RenderCmdBuffer::onDrawPrimitivesInstancesCmd(DrawInstancePrimitivesCmdData
     }
 
     mRBService->bindVertexArray(data->m_vertexArray);
+
+    // quantized vertices are stored in the unit cube, bring them back to object space
+    glm::mat4 model;
+    if (data->m_quantized) {
+        model = mRBService->getMatrix(MatrixType::Model);
+        mRBService->setMatrix(MatrixType::Model, model * data->m_dequantization);
+        mRBService->applyMatrix();
+    }
+
     for (size_t i = 0; i < data->m_primitives.size(); i++) {
         mRBService->render(data->m_primitives[i], data->m_numInstances);
     }
 
+    if (data->m_quantized) {
+        mRBService->setMatrix(MatrixType::Model, model);
+        mRBService->applyMatrix();
+    }
+
     return true;
 }
 
@@ -270,6 +305,13 @@ bool RenderCmdBuffer::onSetMaterialStageCmd(SetMaterialStageCmdData *data) {
     mRBService->bindVertexArray(data->m_vertexArray);
     mRBService->useShader(data->m_shader);
 
+    // Materials without an own pipeline state will use the one of the pass
+    if (InvalidPipelineStateId != data->m_pipelineState) {
+        mRBService->setPipelineState(data->m_pipelineState);
+    } else if (InvalidPipelineStateId != mPassPipelineState) {
+        mRBService->setPipelineState(mPassPipelineState);
+    }
+
     commitParameters();
 
     for (ui32 i = 0; i < data->m_textures.size(); ++i) {
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <cppcore/Container/TArray.h>
 #include <osre/Common/BaseMath.h>
 #include <osre/RenderBackend/RenderStates.h>
+#include <osre/RenderBackend/PipelineState.h>
 
 #include <map>
 
@@ -148,6 +149,7 @@ private:
     glm::mat4 mView;
     glm::mat4 mProj;
     Pipeline *mPipeline;
+    PipelineStateId mPassPipelineState;
 };
 
 } // Namespace RenderBackend
@@ -0,0 +1,176 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/RenderBackend/PipelineState.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace OSRE {
+namespace RenderBackend {
+
+// FNV-1a, 32 bit
+class StateHash {
+public:
+    StateHash() :
+            mHash(2166136261u) {
+        // empty
+    }
+
+    StateHash &add(const void *data, size_t size) {
+        const uc8 *ptr = static_cast<const uc8 *>(data);
+        for (size_t i = 0; i < size; ++i) {
+            mHash ^= ptr[i];
+            mHash *= 16777619u;
+        }
+        return *this;
+    }
+
+    StateHash &add(ui32 value) {
+        return add(&value, sizeof(ui32));
+    }
+
+    ui32 get() const {
+        return mHash;
+    }
+
+private:
+    ui32 mHash;
+};
+
+PipelineState::PipelineState(PipelineStateId id, const RenderStates &states) :
+        mId(id),
+        mStates(states),
+        mSubStateHashes() {
+    computeSubStateHashes(mStates, mSubStateHashes);
+}
+
+void PipelineState::computeSubStateHashes(const RenderStates &states, ui32 *hashes) {
+    // Each field is hashed on its own, the padding of the structs is not initialized
+    hashes[static_cast<ui32>(PipelineSubState::Clear)] = StateHash().add(states.m_clearState.m_state).get();
+    hashes[static_cast<ui32>(PipelineSubState::Depth)] = StateHash()
+            .add(static_cast<ui32>(states.m_depthState.m_type))
+            .add(static_cast<ui32>(states.m_depthState.m_func)).get();
+
+    const TransformState &transform = states.m_transformState;
+    hashes[static_cast<ui32>(PipelineSubState::Transform)] = StateHash()
+            .add(&transform.m_translate[0], sizeof(f32) * 3)
+            .add(&transform.m_scale[0], sizeof(f32) * 3)
+            .add(&transform.m_rotation[0][0], sizeof(f32) * 16).get();
+    hashes[static_cast<ui32>(PipelineSubState::Polygon)] = StateHash()
+            .add(static_cast<ui32>(states.m_polygonState.m_polyMode)).get();
+    hashes[static_cast<ui32>(PipelineSubState::Blend)] = StateHash()
+            .add(static_cast<ui32>(states.m_blendState.m_blendFunc)).get();
+    hashes[static_cast<ui32>(PipelineSubState::Cull)] = StateHash()
+            .add(static_cast<ui32>(states.m_cullState.m_cullMode))
+            .add(static_cast<ui32>(states.m_cullState.m_cullFace)).get();
+    hashes[static_cast<ui32>(PipelineSubState::Sampler)] = StateHash()
+            .add(static_cast<ui32>(states.m_samplerState.m_targetType))
+            .add(static_cast<ui32>(states.m_samplerState.m_stageType)).get();
+
+    const StencilState &stencil = states.m_stencilState;
+    hashes[static_cast<ui32>(PipelineSubState::Stencil)] = StateHash()
+            .add(static_cast<ui32>(stencil.getStencilFunc()))
+            .add(static_cast<ui32>(stencil.getStencilFuncRef()))
+            .add(static_cast<ui32>(stencil.getStencilFuncMask()))
+            .add(static_cast<ui32>(stencil.getStencilOpSFail()))
+            .add(static_cast<ui32>(stencil.getStencilOpDPFail()))
+            .add(static_cast<ui32>(stencil.getStencilOpDPPass())).get();
+}
+
+PipelineStateId PipelineState::computeHash(const RenderStates &states) {
+    ui32 hashes[NumPipelineSubStates];
+    computeSubStateHashes(states, hashes);
+    const ui32 hash = StateHash().add(hashes, sizeof(hashes)).get();
+
+    return InvalidPipelineStateId == hash ? 1u : hash;
+}
+
+static bool isEqual(const RenderStates &lhs, const RenderStates &rhs) {
+    return lhs.isEqual(rhs.m_clearState, rhs.m_depthState, rhs.m_transformState, rhs.m_polygonState,
+            rhs.m_cullState, rhs.m_blendState, rhs.m_samplerState, rhs.m_stencilState) &&
+           lhs.m_stencilState.getStencilFunc() == rhs.m_stencilState.getStencilFunc() &&
+           lhs.m_stencilState.getStencilFuncRef() == rhs.m_stencilState.getStencilFuncRef() &&
+           lhs.m_stencilState.getStencilFuncMask() == rhs.m_stencilState.getStencilFuncMask();
+}
+
+namespace Details {
+
+struct Registry {
+    std::mutex mMutex;
+    // The objects live until exit, the ids are cached by passes and backends
+    std::map<PipelineStateId, std::unique_ptr<PipelineState>> mStates;
+};
+
+static Registry &getRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+} // Namespace Details
+
+PipelineStateId PipelineStateRegistry::create(const RenderStates &states) {
+    Details::Registry &registry = Details::getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mMutex);
+
+    // On a collision the next free id will be used
+    PipelineStateId id = PipelineState::computeHash(states);
+    for (;;) {
+        auto it = registry.mStates.find(id);
+        if (registry.mStates.end() == it) {
+            break;
+        }
+        if (isEqual(it->second->getStates(), states)) {
+            return id;
+        }
+        ++id;
+        if (InvalidPipelineStateId == id) {
+            ++id;
+        }
+    }
+
+    registry.mStates[id].reset(new PipelineState(id, states));
+
+    return id;
+}
+
+const PipelineState *PipelineStateRegistry::get(PipelineStateId id) {
+    Details::Registry &registry = Details::getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mMutex);
+    auto it = registry.mStates.find(id);
+    if (registry.mStates.end() == it) {
+        return nullptr;
+    }
+
+    return it->second.get();
+}
+
+size_t PipelineStateRegistry::getNumStates() {
+    Details::Registry &registry = Details::getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mMutex);
+
+    return registry.mStates.size();
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
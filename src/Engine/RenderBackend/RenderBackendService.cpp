@@ -167,6 +167,12 @@ bool RenderBackendService::onUpdate() {
         m_frameCreated = true;
     }
 
+    // The debug overlays of this frame will be submitted with the other batches
+    DbgRenderer *dbgRenderer = DbgRenderer::getInstance();
+    if (nullptr != dbgRenderer) {
+        dbgRenderer->flush();
+    }
+
     commitNextFrame();
 
     // Synchronizing event with render back-end
@@ -257,10 +263,18 @@ void RenderBackendService::commitNextFrame() {
                     cmd->m_updateFlags |= (ui32)FrameSubmitCmd::UpdateBuffer;
                     Mesh *currentMesh = currentBatch->m_updateMeshArray[k];
                     cmd->m_meshId = currentMesh->getId();
-                    cmd->m_size = currentMesh->getVertexBuffer()->getSize();
+                    cmd->m_material = currentMesh->getMaterial();
+                    cmd->m_size = currentMesh->getActiveVertexBufferSize();
                     cmd->m_data = new c8[cmd->m_size];
                     ::memcpy(cmd->m_data, currentMesh->getVertexBuffer()->getData(), cmd->m_size);
+
+                    // The draw ranges follow the number of active vertices
+                    cmd->m_numIndices.resize(0);
+                    for (size_t l = 0; l < currentMesh->getNumberOfPrimitiveGroups(); ++l) {
+                        cmd->m_numIndices.add(currentMesh->getPrimitiveGroupAt(l)->m_numIndices);
+                    }
                 }
+                currentBatch->m_updateMeshArray.resize(0);
             } 
             if (currentBatch->m_dirtyFlag & RenderBatchData::MeshDirty) {
                 FrameSubmitCmd *cmd = m_submitFrame->enqueue();
@@ -534,6 +548,18 @@ void RenderBackendService::syncRenderThread() {
     mRenderTaskPtr->awaitUpdate();
 }
 
+void RenderBackendService::takeScreenshot(const String &filename, ScreenshotFormat format) {
+    sendEvent(&OnScreenshotEvent, new ScreenshotEventData(filename, 0, 0, format, ScreenshotMode::Single));
+}
+
+void RenderBackendService::beginScreenshotSequence(const String &prefix, ScreenshotFormat format) {
+    sendEvent(&OnScreenshotEvent, new ScreenshotEventData(prefix, 0, 0, format, ScreenshotMode::BeginSequence));
+}
+
+void RenderBackendService::endScreenshotSequence() {
+    sendEvent(&OnScreenshotEvent, new ScreenshotEventData("", 0, 0, ScreenshotFormat::Png, ScreenshotMode::EndSequence));
+}
+
 void RenderBackendService::setViewport( ui32 x, ui32 y, ui32 w, ui32 h ) {
     mViewport.m_x = x;
     mViewport.m_y = y;
@@ -121,6 +121,33 @@ const String *RenderVert::getAttributes() {
     return RenderVertAttributes;
 }
 
+// List of attributes for quantized render vertices
+static constexpr ui32 NumQuantizedRenderVertAttributes = 5;
+
+static const String QuantizedRenderVertAttributes[NumQuantizedRenderVertAttributes] = {
+    "position",
+    "normal",
+    "tangent",
+    "color0",
+    "texcoord0"
+};
+
+QuantizedRenderVert::QuantizedRenderVert() {
+    ::memset(position, 0, sizeof(position));
+    ::memset(normal, 0, sizeof(normal));
+    ::memset(tangent, 0, sizeof(tangent));
+    ::memset(color0, 255, sizeof(color0));
+    ::memset(tex0, 0, sizeof(tex0));
+}
+
+size_t QuantizedRenderVert::getNumAttributes() {
+    return NumQuantizedRenderVertAttributes;
+}
+
+const String *QuantizedRenderVert::getAttributes() {
+    return QuantizedRenderVertAttributes;
+}
+
 const String &getVertCompName(VertexAttribute attrib) {
     if (attrib > VertexAttribute::Instance3) {
         return ErrorCmpName;
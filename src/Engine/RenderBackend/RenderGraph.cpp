@@ -0,0 +1,496 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/RenderBackend/RenderGraph.h>
+#include <osre/RenderBackend/Pipeline.h>
+#include <osre/RenderBackend/RenderPass.h>
+#include <osre/Common/Logger.h>
+#include <osre/Debugging/osre_debugging.h>
+
+#include <atomic>
+#include <cstdio>
+
+namespace OSRE {
+namespace RenderBackend {
+
+using namespace ::OSRE::Common;
+
+static constexpr c8 Tag[] = "RenderGraph";
+
+// Names of pooled framebuffers must be unique over all pools, the backend looks them up by name
+static std::atomic<ui32> NextPoolTargetId(0);
+
+static constexpr size_t PoolTargetNameLen = 32;
+
+ui64 RenderTargetDesc::getKey() const {
+    return static_cast<ui64>(mWidth) | (static_cast<ui64>(mHeight) << 20) |
+           (static_cast<ui64>(mFormat) << 40) | (static_cast<ui64>(mDepthBuffer ? 1 : 0) << 48);
+}
+
+struct RenderTargetPool::Entry {
+    ui64 mKey;
+    FrameBuffer *mFrameBuffer;
+    bool mInUse;
+    c8 mName[PoolTargetNameLen];
+
+    Entry(const RenderTargetDesc &desc) :
+            mKey(desc.getKey()), mFrameBuffer(nullptr), mInUse(true) {
+        ::snprintf(mName, PoolTargetNameLen, "rendergraph.target%06u", NextPoolTargetId++);
+        mFrameBuffer = new FrameBuffer(mName, static_cast<i32>(desc.mWidth), static_cast<i32>(desc.mHeight),
+                desc.mFormat, desc.mDepthBuffer);
+    }
+
+    ~Entry() {
+        delete mFrameBuffer;
+    }
+};
+
+RenderTargetPool::RenderTargetPool() :
+        mEntries() {
+    // empty
+}
+
+RenderTargetPool::~RenderTargetPool() {
+    clear();
+}
+
+FrameBuffer *RenderTargetPool::acquire(const RenderTargetDesc &desc) {
+    const ui64 key = desc.getKey();
+    for (size_t i = 0; i < mEntries.size(); ++i) {
+        Entry *entry = mEntries[i];
+        if (!entry->mInUse && entry->mKey == key) {
+            entry->mInUse = true;
+            return entry->mFrameBuffer;
+        }
+    }
+
+    Entry *entry = new Entry(desc);
+    mEntries.add(entry);
+
+    return entry->mFrameBuffer;
+}
+
+void RenderTargetPool::release(FrameBuffer *frameBuffer) {
+    if (nullptr == frameBuffer) {
+        return;
+    }
+
+    for (size_t i = 0; i < mEntries.size(); ++i) {
+        if (mEntries[i]->mFrameBuffer == frameBuffer) {
+            mEntries[i]->mInUse = false;
+            return;
+        }
+    }
+
+    osre_debug(Tag, "Framebuffer is not owned by the pool.");
+}
+
+size_t RenderTargetPool::getNumTargets() const {
+    return mEntries.size();
+}
+
+size_t RenderTargetPool::getNumTargetsInUse() const {
+    size_t numInUse = 0;
+    for (size_t i = 0; i < mEntries.size(); ++i) {
+        if (mEntries[i]->mInUse) {
+            ++numInUse;
+        }
+    }
+
+    return numInUse;
+}
+
+void RenderTargetPool::clear() {
+    for (size_t i = 0; i < mEntries.size(); ++i) {
+        delete mEntries[i];
+    }
+    mEntries.clear();
+}
+
+struct RenderGraph::PassNode {
+    RenderPass *mPass;
+    cppcore::TArray<RenderGraphHandle> mReads;
+    RenderGraphHandle mWrite;
+    bool mSideEffect;
+    bool mCulled;
+
+    PassNode(RenderPass *pass) :
+            mPass(pass), mReads(), mWrite(InvalidRenderGraphHandle), mSideEffect(false), mCulled(true) {}
+};
+
+struct RenderGraph::ResourceNode {
+    String mName;
+    RenderTargetDesc mDesc;
+    FrameBuffer *mFrameBuffer;
+    bool mImported;
+    RenderGraphHandle mProducer;
+    ui32 mFirstUse;
+    ui32 mLastUse;
+
+    ResourceNode(const String &name, const RenderTargetDesc &desc, FrameBuffer *frameBuffer, bool imported) :
+            mName(name),
+            mDesc(desc),
+            mFrameBuffer(frameBuffer),
+            mImported(imported),
+            mProducer(InvalidRenderGraphHandle),
+            mFirstUse(0),
+            mLastUse(0) {}
+};
+
+RenderGraph::RenderGraph(RenderTargetPool *pool) :
+        mPool(pool),
+        mPasses(),
+        mResources(),
+        mOrder(),
+        mPhysicalTargets() {
+    osre_assert(nullptr != mPool);
+}
+
+RenderGraph::~RenderGraph() {
+    reset();
+}
+
+RenderGraphHandle RenderGraph::createTarget(const String &name, const RenderTargetDesc &desc) {
+    if (0 == desc.mWidth || 0 == desc.mHeight) {
+        osre_error(Tag, "Invalid size for render target " + name + ".");
+        return InvalidRenderGraphHandle;
+    }
+
+    mResources.add(new ResourceNode(name, desc, nullptr, false));
+
+    return static_cast<RenderGraphHandle>(mResources.size() - 1);
+}
+
+RenderGraphHandle RenderGraph::importTarget(const String &name, FrameBuffer *frameBuffer) {
+    RenderTargetDesc desc(0, 0, PixelFormatType::R8G8B8, false);
+    if (nullptr != frameBuffer) {
+        desc = RenderTargetDesc(frameBuffer->m_width, frameBuffer->m_height, frameBuffer->m_format, frameBuffer->m_depthBuffer);
+    }
+    mResources.add(new ResourceNode(name, desc, frameBuffer, true));
+
+    return static_cast<RenderGraphHandle>(mResources.size() - 1);
+}
+
+RenderGraphHandle RenderGraph::addPass(RenderPass *pass) {
+    if (nullptr == pass) {
+        osre_error(Tag, "Pass is nullptr.");
+        return InvalidRenderGraphHandle;
+    }
+
+    mPasses.add(new PassNode(pass));
+
+    return static_cast<RenderGraphHandle>(mPasses.size() - 1);
+}
+
+bool RenderGraph::read(RenderGraphHandle pass, RenderGraphHandle resource) {
+    if (pass >= mPasses.size() || resource >= mResources.size()) {
+        osre_error(Tag, "Invalid handle for read.");
+        return false;
+    }
+
+    mPasses[pass]->mReads.add(resource);
+
+    return true;
+}
+
+bool RenderGraph::write(RenderGraphHandle pass, RenderGraphHandle resource) {
+    if (pass >= mPasses.size() || resource >= mResources.size()) {
+        osre_error(Tag, "Invalid handle for write.");
+        return false;
+    }
+
+    PassNode *passNode = mPasses[pass];
+    if (InvalidRenderGraphHandle != passNode->mWrite) {
+        osre_error(Tag, "Pass writes already a target.");
+        return false;
+    }
+
+    // Transient targets have one producer, outputs can be written by several passes
+    ResourceNode *resNode = mResources[resource];
+    if (!resNode->mImported && InvalidRenderGraphHandle != resNode->mProducer) {
+        osre_error(Tag, "Target " + resNode->mName + " is written already by another pass.");
+        return false;
+    }
+
+    passNode->mWrite = resource;
+    if (!resNode->mImported) {
+        resNode->mProducer = pass;
+    }
+
+    return true;
+}
+
+void RenderGraph::setSideEffect(RenderGraphHandle pass) {
+    if (pass >= mPasses.size()) {
+        return;
+    }
+
+    mPasses[pass]->mSideEffect = true;
+}
+
+bool RenderGraph::compile() {
+    for (size_t i = 0; i < mPhysicalTargets.size(); ++i) {
+        mPool->release(mPhysicalTargets[i]);
+    }
+    mPhysicalTargets.resize(0);
+    mOrder.resize(0);
+
+    cullPasses();
+    if (!sortPasses()) {
+        mOrder.resize(0);
+        return false;
+    }
+    allocateTargets();
+
+    return true;
+}
+
+void RenderGraph::cullPasses() {
+    cppcore::TArray<RenderGraphHandle> stack;
+    for (size_t i = 0; i < mPasses.size(); ++i) {
+        PassNode *passNode = mPasses[i];
+        passNode->mCulled = true;
+        const bool writesOutput = InvalidRenderGraphHandle != passNode->mWrite && mResources[passNode->mWrite]->mImported;
+        if (writesOutput || passNode->mSideEffect) {
+            passNode->mCulled = false;
+            stack.add(static_cast<RenderGraphHandle>(i));
+        }
+    }
+
+    // Everything a needed pass reads is needed as well
+    while (!stack.isEmpty()) {
+        PassNode *passNode = mPasses[stack.back()];
+        stack.removeBack();
+        for (size_t i = 0; i < passNode->mReads.size(); ++i) {
+            const RenderGraphHandle producer = mResources[passNode->mReads[i]]->mProducer;
+            if (InvalidRenderGraphHandle != producer && mPasses[producer]->mCulled) {
+                mPasses[producer]->mCulled = false;
+                stack.add(producer);
+            }
+        }
+    }
+}
+
+ui32 RenderGraph::countImportedWriters(RenderGraphHandle resource, size_t pass) const {
+    ui32 numWriters = 0;
+    for (size_t i = 0; i < pass; ++i) {
+        if (!mPasses[i]->mCulled && mPasses[i]->mWrite == resource) {
+            ++numWriters;
+        }
+    }
+
+    return numWriters;
+}
+
+bool RenderGraph::sortPasses() {
+    // Count the unresolved dependencies of each pass: the producers of the transient targets it
+    // reads and the passes declared before which write an imported target it reads or writes.
+    const size_t numPasses = mPasses.size();
+    cppcore::TArray<ui32> numDeps;
+    numDeps.resize(numPasses);
+    size_t numActive = 0;
+    for (size_t i = 0; i < numPasses; ++i) {
+        numDeps[i] = 0;
+        PassNode *passNode = mPasses[i];
+        if (passNode->mCulled) {
+            continue;
+        }
+        ++numActive;
+        for (size_t j = 0; j < passNode->mReads.size(); ++j) {
+            const RenderGraphHandle read = passNode->mReads[j];
+            if (mResources[read]->mImported) {
+                numDeps[i] += countImportedWriters(read, i);
+                continue;
+            }
+            const RenderGraphHandle producer = mResources[read]->mProducer;
+            if (InvalidRenderGraphHandle != producer && i != producer) {
+                ++numDeps[i];
+            }
+        }
+        if (InvalidRenderGraphHandle != passNode->mWrite && mResources[passNode->mWrite]->mImported) {
+            numDeps[i] += countImportedWriters(passNode->mWrite, i);
+        }
+    }
+
+    // Take the first ready pass, so independent passes keep their declaration order
+    cppcore::TArray<uc8> done;
+    done.resize(numPasses);
+    for (size_t i = 0; i < numPasses; ++i) {
+        done[i] = 0;
+    }
+    while (mOrder.size() < numActive) {
+        size_t next = numPasses;
+        for (size_t i = 0; i < numPasses; ++i) {
+            if (!mPasses[i]->mCulled && !done[i] && 0 == numDeps[i]) {
+                next = i;
+                break;
+            }
+        }
+        if (next == numPasses) {
+            osre_error(Tag, "Dependency cycle detected, cannot sort the passes.");
+            return false;
+        }
+
+        done[next] = 1;
+        mOrder.add(static_cast<ui32>(next));
+        const RenderGraphHandle written = mPasses[next]->mWrite;
+        if (InvalidRenderGraphHandle == written) {
+            continue;
+        }
+
+        const bool imported = mResources[written]->mImported;
+        for (size_t i = 0; i < numPasses; ++i) {
+            PassNode *passNode = mPasses[i];
+            if (passNode->mCulled || done[i]) {
+                continue;
+            }
+            // Imported targets only order the passes declared after the writer
+            if (imported && i < next) {
+                continue;
+            }
+            for (size_t j = 0; j < passNode->mReads.size(); ++j) {
+                if (passNode->mReads[j] == written) {
+                    --numDeps[i];
+                }
+            }
+            if (imported && passNode->mWrite == written) {
+                --numDeps[i];
+            }
+        }
+    }
+
+    return true;
+}
+
+void RenderGraph::allocateTargets() {
+    // The lifetime of a target goes from its producer to its last reader in execution order
+    for (size_t i = 0; i < mResources.size(); ++i) {
+        ResourceNode *resNode = mResources[i];
+        if (!resNode->mImported) {
+            resNode->mFrameBuffer = nullptr;
+        }
+    }
+    for (ui32 pos = 0; pos < mOrder.size(); ++pos) {
+        PassNode *passNode = mPasses[mOrder[pos]];
+        if (InvalidRenderGraphHandle != passNode->mWrite) {
+            ResourceNode *resNode = mResources[passNode->mWrite];
+            resNode->mFirstUse = pos;
+            resNode->mLastUse = pos;
+        }
+    }
+    for (ui32 pos = 0; pos < mOrder.size(); ++pos) {
+        PassNode *passNode = mPasses[mOrder[pos]];
+        for (size_t i = 0; i < passNode->mReads.size(); ++i) {
+            ResourceNode *resNode = mResources[passNode->mReads[i]];
+            if (pos > resNode->mLastUse) {
+                resNode->mLastUse = pos;
+            }
+        }
+    }
+
+    // Targets are created in execution order, a framebuffer whose last user has already run
+    // can be taken over by a target with the same description.
+    cppcore::TArray<ui32> physicalLastUse;
+    cppcore::TArray<ui64> physicalKeys;
+    for (ui32 pos = 0; pos < mOrder.size(); ++pos) {
+        PassNode *passNode = mPasses[mOrder[pos]];
+        if (InvalidRenderGraphHandle == passNode->mWrite) {
+            passNode->mPass->setFrameBuffer(nullptr);
+            continue;
+        }
+
+        ResourceNode *resNode = mResources[passNode->mWrite];
+        if (!resNode->mImported) {
+            const ui64 key = resNode->mDesc.getKey();
+            for (size_t i = 0; i < mPhysicalTargets.size(); ++i) {
+                if (physicalLastUse[i] < resNode->mFirstUse && physicalKeys[i] == key) {
+                    resNode->mFrameBuffer = mPhysicalTargets[i];
+                    physicalLastUse[i] = resNode->mLastUse;
+                    break;
+                }
+            }
+            if (nullptr == resNode->mFrameBuffer) {
+                resNode->mFrameBuffer = mPool->acquire(resNode->mDesc);
+                mPhysicalTargets.add(resNode->mFrameBuffer);
+                physicalLastUse.add(resNode->mLastUse);
+                physicalKeys.add(key);
+            }
+        }
+        passNode->mPass->setFrameBuffer(resNode->mFrameBuffer);
+    }
+}
+
+void RenderGraph::apply(Pipeline *pipeline) const {
+    if (nullptr == pipeline) {
+        osre_error(Tag, "Pipeline is nullptr.");
+        return;
+    }
+
+    for (size_t i = 0; i < mOrder.size(); ++i) {
+        pipeline->addPass(mPasses[mOrder[i]]->mPass);
+    }
+}
+
+void RenderGraph::reset() {
+    for (size_t i = 0; i < mPhysicalTargets.size(); ++i) {
+        mPool->release(mPhysicalTargets[i]);
+    }
+    mPhysicalTargets.resize(0);
+    mOrder.resize(0);
+
+    for (size_t i = 0; i < mPasses.size(); ++i) {
+        delete mPasses[i];
+    }
+    mPasses.resize(0);
+
+    for (size_t i = 0; i < mResources.size(); ++i) {
+        delete mResources[i];
+    }
+    mResources.resize(0);
+}
+
+RenderPass *RenderGraph::getActivePass(size_t index) const {
+    if (index >= mOrder.size()) {
+        return nullptr;
+    }
+
+    return mPasses[mOrder[index]]->mPass;
+}
+
+bool RenderGraph::isCulled(RenderGraphHandle pass) const {
+    if (pass >= mPasses.size()) {
+        return true;
+    }
+
+    return mPasses[pass]->mCulled;
+}
+
+FrameBuffer *RenderGraph::getFrameBuffer(RenderGraphHandle resource) const {
+    if (resource >= mResources.size()) {
+        return nullptr;
+    }
+
+    return mResources[resource]->mFrameBuffer;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -79,19 +79,23 @@ RenderPass::RenderPass(guid id, Shader *shader) :
         mId(id),
         mRenderTarget(),
         mStates(),
-        mShader(shader) {
+        mShader(shader),
+        mFrameBuffer(nullptr),
+        mPipelineStateId(InvalidPipelineStateId) {
     // empty
 }
 
 RenderPass &RenderPass::set(RenderTarget &rt, RenderStates &states) {
     mRenderTarget = rt;
     mStates = states;
+    mPipelineStateId = InvalidPipelineStateId;
 
     return *this;
 }
 
 RenderPass &RenderPass::setPolygonState(PolygonState polyState) {
     mStates.m_polygonState = polyState;
+    mPipelineStateId = InvalidPipelineStateId;
 
     return *this;
 }
@@ -102,6 +106,7 @@ PolygonState RenderPass::getPolygonState() const {
 
 RenderPass &RenderPass::setCullState(CullState &cullstate) {
     mStates.m_cullState = cullstate;
+    mPipelineStateId = InvalidPipelineStateId;
 
     return *this;
 }
@@ -112,6 +117,7 @@ CullState RenderPass::getCullState() const {
 
 RenderPass &RenderPass::setBlendState(BlendState &blendState) {
     mStates.m_blendState = blendState;
+    mPipelineStateId = InvalidPipelineStateId;
 
     return *this;
 }
@@ -122,6 +128,7 @@ const BlendState &RenderPass::getBlendState() const {
 
 RenderPass &RenderPass::setSamplerState(SamplerState &samplerState) {
     mStates.m_samplerState = samplerState;
+    mPipelineStateId = InvalidPipelineStateId;
 
     return *this;
 }
@@ -132,6 +139,7 @@ const SamplerState &RenderPass::getSamplerState() const {
 
 RenderPass &RenderPass::setClearState(ClearState &clearState) {
     mStates.m_clearState = clearState;
+    mPipelineStateId = InvalidPipelineStateId;
 
     return *this;
 }
@@ -142,6 +150,7 @@ const ClearState &RenderPass::getClearState() const {
 
 RenderPass &RenderPass::setStencilState(StencilState &stencilState) {
     mStates.m_stencilState = stencilState;
+    mPipelineStateId = InvalidPipelineStateId;
 
     return *this;
 }
@@ -160,6 +169,24 @@ Shader *RenderPass::getShader() const {
     return mShader;
 }
 
+RenderPass &RenderPass::setFrameBuffer(FrameBuffer *frameBuffer) {
+    mFrameBuffer = frameBuffer;
+
+    return *this;
+}
+
+FrameBuffer *RenderPass::getFrameBuffer() const {
+    return mFrameBuffer;
+}
+
+PipelineStateId RenderPass::getPipelineStateId() const {
+    if (InvalidPipelineStateId == mPipelineStateId) {
+        mPipelineStateId = PipelineStateRegistry::create(mStates);
+    }
+
+    return mPipelineStateId;
+}
+
 const c8 *RenderPass::getPassNameById(guid id) {
     if (id >= MaxDbgPasses) {
         return nullptr;
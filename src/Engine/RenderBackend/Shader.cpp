@@ -31,7 +31,7 @@ using namespace ::OSRE::Common;
 using namespace ::OSRE::IO;
 
 Shader::Shader() :
-        mUniformBuffer(), mVertexAttributes(), m_src{}, m_compileState{} {
+        mUniformBuffer(), mVertexAttributes(), m_src{}, m_compileState{}, mProgramName(), mProgramId(0) {
     ::memset(m_compileState, 0, sizeof(CompileState)*MaxCompileState);
 }
 
@@ -77,6 +77,11 @@ const c8 *Shader::getUniformBufferAt(size_t index) const {
     return mUniformBuffer[index].c_str();
 }
 
+void Shader::setProgram(const String &name, ui32 id) {
+    mProgramName = name;
+    mProgramId = id;
+}
+
 void Shader::setSource(ShaderType type, const String &src) {
     const size_t index = static_cast<size_t>(type);
     if (src == m_src[index]) {
@@ -0,0 +1,130 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/RenderBackend/ShaderPermutation.h>
+#include <osre/Common/Logger.h>
+
+#include <atomic>
+#include <cstdio>
+
+namespace OSRE {
+namespace RenderBackend {
+
+using namespace ::OSRE::Common;
+
+static constexpr c8 Tag[] = "ShaderPermutation";
+
+// Variant ids are unique over all permutations, zero is left for shaders without a variant
+static std::atomic<ui32> NextVariantId(1);
+
+static String insertDefines(const String &src, const String &defines) {
+    // The defines must follow the version line
+    if (0 != src.compare(0, 8, "#version")) {
+        return defines + src;
+    }
+
+    const String::size_type pos = src.find('\n');
+    if (String::npos == pos) {
+        return src + "\n" + defines;
+    }
+
+    String result = src;
+    result.insert(pos + 1, defines);
+
+    return result;
+}
+
+ShaderPermutation::ShaderPermutation(const String &name, ShaderVariantKey features) :
+        mName(name),
+        mFeatures(features),
+        mSources(),
+        mVariants() {
+    // empty
+}
+
+ShaderPermutation::~ShaderPermutation() {
+    for (auto &it : mVariants) {
+        delete it.second;
+    }
+}
+
+void ShaderPermutation::setSource(ShaderType type, const String &src) {
+    if (!mVariants.empty()) {
+        osre_warn(Tag, "Source of " + mName + " changed after variants were built.");
+    }
+
+    mSources[static_cast<ui32>(type)] = src;
+}
+
+const ShaderVariant *ShaderPermutation::getVariant(ShaderVariantKey key) {
+    key &= mFeatures;
+    VariantMap::const_iterator it = mVariants.find(key);
+    if (mVariants.end() != it) {
+        return it->second;
+    }
+
+    ShaderVariant *variant = new ShaderVariant;
+    variant->mKey = key;
+    variant->mId = NextVariantId++;
+    c8 buffer[16];
+    ::snprintf(buffer, sizeof(buffer), "#%08x", key);
+    variant->mProgramName = mName + buffer;
+
+    const String defines = getDefines(key);
+    for (ui32 i = 0; i < MaxShaderTypes; ++i) {
+        if (!mSources[i].empty()) {
+            variant->mSources[i] = insertDefines(mSources[i], defines);
+        }
+    }
+    mVariants[key] = variant;
+
+    return variant;
+}
+
+void ShaderPermutation::precompile(const ShaderVariantKey *keys, size_t numKeys) {
+    if (nullptr == keys) {
+        return;
+    }
+
+    for (size_t i = 0; i < numKeys; ++i) {
+        getVariant(keys[i]);
+    }
+}
+
+String ShaderPermutation::getDefines(ShaderVariantKey key) {
+    String defines;
+    if (key & ShaderFeature::Skinning) {
+        defines += "#define OSRE_SKINNING 1\n";
+    }
+    if (key & ShaderFeature::Instancing) {
+        defines += "#define OSRE_INSTANCING 1\n";
+    }
+    if (key & ShaderFeature::Lighting) {
+        defines += "#define OSRE_LIGHTING 1\n";
+    }
+    defines += "#define OSRE_TEXTURE_COUNT " + std::to_string(getShaderTextureCount(key)) + "\n";
+
+    return defines;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,107 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/RenderBackend/SpriteAtlas.h>
+#include <osre/Common/Logger.h>
+#include <osre/Common/StringUtils.h>
+#include <osre/Debugging/osre_debugging.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+using namespace ::OSRE::Common;
+
+static constexpr c8 Tag[] = "SpriteAtlas";
+
+// Region indices are stored one-based, so zero marks the end of a chain
+static constexpr ui32 NoRegion = 0;
+
+SpriteAtlas::SpriteAtlas(Texture *texture) :
+        mTexture(texture),
+        mRegions(),
+        mNameIndex() {
+    osre_assert(nullptr != mTexture);
+}
+
+bool SpriteAtlas::addRegion(const String &name, const Rect2ui &rect) {
+    if (nullptr != findRegion(name)) {
+        osre_debug(Tag, "Sprite " + name + " already added.");
+        return false;
+    }
+
+    if (0 == mTexture->m_width || 0 == mTexture->m_height ||
+            rect.x1 + rect.width > mTexture->m_width || rect.y1 + rect.height > mTexture->m_height) {
+        osre_error(Tag, "Sprite " + name + " is outside of the texture.");
+        return false;
+    }
+
+    // The texture rows are stored bottom up
+    const glm::vec2 invSize(1.0f / static_cast<f32>(mTexture->m_width), 1.0f / static_cast<f32>(mTexture->m_height));
+    SpriteRegion region;
+    region.mName = name;
+    region.mUv0 = glm::vec2(rect.x1, mTexture->m_height - rect.y1 - rect.height) * invSize;
+    region.mUv1 = glm::vec2(rect.x1 + rect.width, mTexture->m_height - rect.y1) * invSize;
+    region.mSize = glm::vec2(rect.width, rect.height);
+
+    const HashId hash = StringUtils::hashName(name);
+    ui32 head = NoRegion;
+    if (mNameIndex.getValue(hash, head)) {
+        mNameIndex.remove(hash);
+    }
+    region.mNext = head;
+    mRegions.add(region);
+    mNameIndex.insert(hash, static_cast<ui32>(mRegions.size()));
+
+    return true;
+}
+
+void SpriteAtlas::addGrid(const String &prefix, ui32 columns, ui32 rows) {
+    osre_assert(columns > 0 && rows > 0);
+
+    const ui32 w = mTexture->m_width / columns;
+    const ui32 h = mTexture->m_height / rows;
+    for (ui32 row = 0; row < rows; ++row) {
+        for (ui32 col = 0; col < columns; ++col) {
+            addRegion(prefix + std::to_string(row * columns + col), Rect2ui(col * w, row * h, w, h));
+        }
+    }
+}
+
+const SpriteRegion *SpriteAtlas::findRegion(const String &name) const {
+    ui32 index = NoRegion;
+    if (!mNameIndex.getValue(StringUtils::hashName(name), index)) {
+        return nullptr;
+    }
+
+    while (NoRegion != index) {
+        const SpriteRegion &region = mRegions[index - 1];
+        if (region.mName == name) {
+            return &region;
+        }
+        index = region.mNext;
+    }
+
+    return nullptr;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,295 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/RenderBackend/TextRenderer.h>
+#include <osre/RenderBackend/FontAtlas.h>
+#include <osre/RenderBackend/Mesh.h>
+#include <osre/RenderBackend/MeshBuilder.h>
+#include <osre/RenderBackend/RenderBackendService.h>
+#include <osre/Common/Logger.h>
+#include <osre/Debugging/osre_debugging.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+using namespace ::OSRE::Common;
+
+static constexpr c8 Tag[] = "TextRenderer";
+
+static constexpr ui32 NumQuadVertices = 4;
+
+// The fallback, when no viewport was set
+static constexpr f32 DefaultScreenWidth = 800.0f;
+static constexpr f32 DefaultScreenHeight = 600.0f;
+
+static ui32 getRunCapacity(ui32 numGlyphs) {
+    return ((numGlyphs + TextRenderer::RunGranularity - 1) / TextRenderer::RunGranularity) * TextRenderer::RunGranularity;
+}
+
+TextRenderer::TextRenderer(FontAtlas *font, ui32 glyphCapacity) :
+        mFont(font),
+        mGlyphCapacity(glyphCapacity),
+        mLabels(),
+        mLive(),
+        mDirtyLabels(),
+        mScratch(),
+        mMesh(nullptr),
+        mEnd(0),
+        mNumGlyphsWritten(0),
+        mMeshDirty(false),
+        mMeshAdded(false) {
+    osre_assert(nullptr != mFont);
+    osre_assert(mGlyphCapacity > 0);
+}
+
+TextRenderer::~TextRenderer() {
+    delete mMesh;
+}
+
+const c8 *TextRenderer::getTextRenderBatchName() {
+    static constexpr c8 name[] = "textBatch";
+    return name;
+}
+
+TextHandle TextRenderer::addText(const glm::vec2 &position, const String &text, f32 size, const glm::vec3 &color) {
+    Label label;
+    label.mText = text;
+    label.mPosition = position;
+    label.mColor = color;
+    label.mSize = size;
+    label.mOffset = mEnd;
+    label.mCapacity = 0;
+    label.mNumGlyphs = 0;
+    label.mLiveIndex = static_cast<ui32>(mLive.size());
+    label.mDirty = true;
+
+    const TextHandle handle = mLabels.add(label);
+    if (!handle.isValid()) {
+        osre_error(Tag, "No free text handle.");
+        return handle;
+    }
+
+    mLive.add(handle);
+    mDirtyLabels.add(handle);
+
+    return handle;
+}
+
+bool TextRenderer::setText(TextHandle handle, const String &text) {
+    Label *label = mLabels.find(handle);
+    if (nullptr == label) {
+        return false;
+    }
+
+    if (label->mText != text) {
+        label->mText = text;
+        markDirty(handle, *label);
+    }
+
+    return true;
+}
+
+bool TextRenderer::setPosition(TextHandle handle, const glm::vec2 &position) {
+    Label *label = mLabels.find(handle);
+    if (nullptr == label) {
+        return false;
+    }
+
+    if (label->mPosition != position) {
+        label->mPosition = position;
+        markDirty(handle, *label);
+    }
+
+    return true;
+}
+
+bool TextRenderer::setColor(TextHandle handle, const glm::vec3 &color) {
+    Label *label = mLabels.find(handle);
+    if (nullptr == label) {
+        return false;
+    }
+
+    if (label->mColor != color) {
+        label->mColor = color;
+        markDirty(handle, *label);
+    }
+
+    return true;
+}
+
+bool TextRenderer::removeText(TextHandle handle) {
+    Label *label = mLabels.find(handle);
+    if (nullptr == label) {
+        return false;
+    }
+
+    hideGlyphs(label->mOffset, label->mOffset + label->mNumGlyphs);
+    if (label->mOffset + label->mCapacity == mEnd) {
+        mEnd = label->mOffset;
+        mMeshDirty = true;
+    }
+
+    // Swap the last live label into the free position
+    const ui32 liveIndex = label->mLiveIndex;
+    const TextHandle last = mLive.back();
+    mLive[liveIndex] = last;
+    mLive.removeBack();
+    if (last != handle) {
+        mLabels.find(last)->mLiveIndex = liveIndex;
+    }
+    mLabels.remove(handle);
+
+    return true;
+}
+
+void TextRenderer::update() {
+    mNumGlyphsWritten = 0;
+    if (!mDirtyLabels.isEmpty()) {
+        if (nullptr == mMesh) {
+            MeshBuilder meshBuilder;
+            meshBuilder.allocStreamingMesh("textRenderer", VertexType::RenderVertex, mGlyphCapacity * NumQuadVertices,
+                    PrimitiveType::TriangleList);
+            mMesh = meshBuilder.getMesh();
+        }
+
+        // Labels removed or already written by a compaction will be skipped
+        for (size_t i = 0; i < mDirtyLabels.size(); ++i) {
+            Label *label = mLabels.find(mDirtyLabels[i]);
+            if (nullptr != label && label->mDirty) {
+                writeLabel(*label, true);
+            }
+        }
+        mDirtyLabels.resize(0);
+    }
+
+    // Only the runs up to the end will be drawn
+    if (nullptr != mMesh) {
+        MeshBuilder::setNumStreamingVertices(mMesh, mEnd * NumQuadVertices);
+    }
+}
+
+void TextRenderer::render(RenderBackendService *rbSrv) {
+    osre_assert(nullptr != rbSrv);
+
+    update();
+    if (nullptr == mMesh) {
+        return;
+    }
+
+    rbSrv->beginPass(RenderPass::getPassNameById(UiPassId));
+    rbSrv->beginRenderBatch(getTextRenderBatchName());
+
+    const Viewport &viewport = rbSrv->getViewport();
+    const f32 w = viewport.m_w > 0 ? static_cast<f32>(viewport.m_w) : DefaultScreenWidth;
+    const f32 h = viewport.m_h > 0 ? static_cast<f32>(viewport.m_h) : DefaultScreenHeight;
+    rbSrv->setMatrix(MatrixType::Projection, glm::ortho(0.0f, w, 0.0f, h));
+
+    if (!mMeshAdded) {
+        mMesh->setMaterial(mFont->getMaterial());
+        rbSrv->addMesh(mMesh, 0);
+        mMeshAdded = true;
+    } else if (mMeshDirty) {
+        rbSrv->updateMesh(mMesh);
+    }
+    mMeshDirty = false;
+
+    rbSrv->endRenderBatch();
+    rbSrv->endPass();
+}
+
+void TextRenderer::markDirty(TextHandle handle, Label &label) {
+    if (label.mDirty) {
+        return;
+    }
+
+    label.mDirty = true;
+    mDirtyLabels.add(handle);
+}
+
+void TextRenderer::writeLabel(Label &label, bool canCompact) {
+    mScratch.resize(0);
+    ui32 numGlyphs = mFont->layoutText(label.mText, label.mPosition, label.mSize, label.mColor, mScratch);
+    if (numGlyphs > label.mCapacity) {
+        const ui32 capacity = getRunCapacity(numGlyphs);
+        if (mEnd + capacity > mGlyphCapacity && canCompact) {
+            compact();
+            return;
+        }
+
+        // The run does not fit, append a new one
+        hideGlyphs(label.mOffset, label.mOffset + label.mNumGlyphs);
+        label.mOffset = mEnd;
+        label.mNumGlyphs = 0;
+        label.mCapacity = mEnd + capacity > mGlyphCapacity ? mGlyphCapacity - mEnd : capacity;
+        mEnd += label.mCapacity;
+        if (numGlyphs > label.mCapacity) {
+            osre_debug(Tag, "Glyph capacity exceeded, text clipped.");
+            numGlyphs = label.mCapacity;
+        }
+    }
+
+    writeGlyphs(label.mOffset, numGlyphs);
+    if (numGlyphs < label.mNumGlyphs) {
+        hideGlyphs(label.mOffset + numGlyphs, label.mOffset + label.mNumGlyphs);
+    }
+    label.mNumGlyphs = numGlyphs;
+    label.mDirty = false;
+}
+
+void TextRenderer::writeGlyphs(ui32 offset, ui32 numGlyphs) {
+    if (0 == numGlyphs) {
+        return;
+    }
+
+    c8 *data = mMesh->getVertexBuffer()->getData() + offset * NumQuadVertices * sizeof(RenderVert);
+    ::memcpy(data, &mScratch[0], numGlyphs * NumQuadVertices * sizeof(RenderVert));
+    mNumGlyphsWritten += numGlyphs;
+    mMeshDirty = true;
+}
+
+void TextRenderer::hideGlyphs(ui32 begin, ui32 end) {
+    if (nullptr == mMesh || begin >= end) {
+        return;
+    }
+
+    // Collapsed quads have no area and will not be rasterized
+    c8 *data = mMesh->getVertexBuffer()->getData() + begin * NumQuadVertices * sizeof(RenderVert);
+    ::memset(data, 0, (end - begin) * NumQuadVertices * sizeof(RenderVert));
+    mMeshDirty = true;
+}
+
+void TextRenderer::compact() {
+    osre_debug(Tag, "Compacting text runs.");
+
+    hideGlyphs(0, mEnd);
+    mEnd = 0;
+    for (size_t i = 0; i < mLive.size(); ++i) {
+        Label *label = mLabels.find(mLive[i]);
+        label->mOffset = mEnd;
+        label->mCapacity = 0;
+        label->mNumGlyphs = 0;
+        writeLabel(*label, false);
+    }
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,132 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/RenderBackend/VertexQuantizer.h>
+
+#include <glm/gtc/packing.hpp>
+
+namespace OSRE {
+namespace RenderBackend {
+
+using namespace ::OSRE::Common;
+
+static f32 signNotZero(f32 v) {
+    return (v >= 0.0f) ? 1.0f : -1.0f;
+}
+
+ui16 VertexQuantizer::toHalf(f32 value) {
+    return glm::packHalf1x16(value);
+}
+
+f32 VertexQuantizer::fromHalf(ui16 value) {
+    return glm::unpackHalf1x16(value);
+}
+
+i16 VertexQuantizer::toSnorm16(f32 value) {
+    return static_cast<i16>(glm::packSnorm1x16(value));
+}
+
+f32 VertexQuantizer::fromSnorm16(i16 value) {
+    return glm::unpackSnorm1x16(static_cast<ui16>(value));
+}
+
+void VertexQuantizer::encodeOctahedral(const glm::vec3 &n, i16 out[2]) {
+    const f32 l1 = glm::abs(n.x) + glm::abs(n.y) + glm::abs(n.z);
+    if (l1 <= 0.0f) {
+        out[0] = out[1] = 0;
+        return;
+    }
+
+    f32 x = n.x / l1, y = n.y / l1;
+    if (n.z < 0.0f) {
+        const f32 ox = x;
+        x = (1.0f - glm::abs(y)) * signNotZero(ox);
+        y = (1.0f - glm::abs(ox)) * signNotZero(y);
+    }
+    out[0] = toSnorm16(x);
+    out[1] = toSnorm16(y);
+}
+
+glm::vec3 VertexQuantizer::decodeOctahedral(const i16 in[2]) {
+    const f32 x = fromSnorm16(in[0]), y = fromSnorm16(in[1]);
+    glm::vec3 n(x, y, 1.0f - glm::abs(x) - glm::abs(y));
+    if (n.z < 0.0f) {
+        n.x = (1.0f - glm::abs(y)) * signNotZero(x);
+        n.y = (1.0f - glm::abs(x)) * signNotZero(y);
+    }
+
+    return glm::normalize(n);
+}
+
+void VertexQuantizer::computeTransform(const AABB &aabb, glm::vec3 &offset, f32 &scale) {
+    const glm::vec3 &min = aabb.getMin(), &max = aabb.getMax();
+    offset = (min + max) * 0.5f;
+    const glm::vec3 halfExtent = (max - min) * 0.5f;
+    scale = glm::max(halfExtent.x, glm::max(halfExtent.y, halfExtent.z));
+    if (scale <= 0.0f) {
+        scale = 1.0f;
+    }
+}
+
+glm::mat4 VertexQuantizer::getDequantizationMatrix(const glm::vec3 &offset, f32 scale) {
+    glm::mat4 m = glm::translate(glm::mat4(1.0f), offset);
+    return glm::scale(m, glm::vec3(scale));
+}
+
+void VertexQuantizer::quantize(const RenderVert *src, const glm::vec3 *tangents, size_t numVertices,
+        const glm::vec3 &offset, f32 scale, QuantizedRenderVert *dst) {
+    if (nullptr == src || nullptr == dst || 0 == numVertices) {
+        return;
+    }
+
+    const f32 invScale = 1.0f / scale;
+    for (size_t i = 0; i < numVertices; ++i) {
+        const RenderVert &v = src[i];
+        QuantizedRenderVert &q = dst[i];
+        const glm::vec3 pos = (v.position - offset) * invScale;
+        q.position[0] = toSnorm16(pos.x);
+        q.position[1] = toSnorm16(pos.y);
+        q.position[2] = toSnorm16(pos.z);
+        q.position[3] = toSnorm16(1.0f);
+        encodeOctahedral(v.normal, q.normal);
+        if (nullptr != tangents) {
+            encodeOctahedral(tangents[i], q.tangent);
+        } else {
+            q.tangent[0] = q.tangent[1] = 0;
+        }
+        const glm::vec3 col = glm::clamp(v.color0, 0.0f, 1.0f);
+        q.color0[0] = static_cast<uc8>(col.r * 255.0f + 0.5f);
+        q.color0[1] = static_cast<uc8>(col.g * 255.0f + 0.5f);
+        q.color0[2] = static_cast<uc8>(col.b * 255.0f + 0.5f);
+        q.color0[3] = 255;
+        q.tex0[0] = toHalf(v.tex0.x);
+        q.tex0[1] = toHalf(v.tex0.y);
+    }
+}
+
+glm::vec3 VertexQuantizer::getPosition(const QuantizedRenderVert &v, const glm::vec3 &offset, f32 scale) {
+    const glm::vec3 pos(fromSnorm16(v.position[0]), fromSnorm16(v.position[1]), fromSnorm16(v.position[2]));
+    return pos * scale + offset;
+}
+
+} // Namespace RenderBackend
+} // Namespace OSRE
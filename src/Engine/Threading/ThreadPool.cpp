@@ -0,0 +1,143 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/Threading/ThreadPool.h>
+
+#include <atomic>
+
+namespace OSRE {
+namespace Threading {
+
+ThreadPool::ThreadPool(size_t numWorkers) :
+        mWorkers(),
+        mJobs(),
+        mLock(),
+        mJobAvailable(),
+        mRunning(true) {
+    if (0 == numWorkers) {
+        const size_t numCores = std::thread::hardware_concurrency();
+        numWorkers = numCores > 1 ? numCores - 1 : 1;
+    }
+
+    mWorkers.reserve(numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        mWorkers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(mLock);
+        mRunning = false;
+    }
+    mJobAvailable.notify_all();
+    for (std::thread &worker : mWorkers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::enqueue(const Job &job) {
+    {
+        std::lock_guard<std::mutex> guard(mLock);
+        mJobs.push_back(job);
+    }
+    mJobAvailable.notify_one();
+}
+
+bool ThreadPool::runPendingJob() {
+    Job job;
+    {
+        std::lock_guard<std::mutex> guard(mLock);
+        if (mJobs.empty()) {
+            return false;
+        }
+        job = std::move(mJobs.front());
+        mJobs.pop_front();
+    }
+    job();
+
+    return true;
+}
+
+void ThreadPool::parallelFor(size_t count, size_t minBatchSize, const RangeJob &job) {
+    if (0 == count) {
+        return;
+    }
+
+    if (0 == minBatchSize) {
+        minBatchSize = 1;
+    }
+
+    // Split into a few batches per thread to balance uneven work
+    const size_t numThreads = mWorkers.size() + 1;
+    size_t batchSize = (count + numThreads * 4 - 1) / (numThreads * 4);
+    if (batchSize < minBatchSize) {
+        batchSize = minBatchSize;
+    }
+    const size_t numBatches = (count + batchSize - 1) / batchSize;
+    if (1 == numBatches) {
+        job(0, count);
+        return;
+    }
+
+    std::atomic<size_t> pending(numBatches - 1);
+    for (size_t batch = 1; batch < numBatches; ++batch) {
+        const size_t begin = batch * batchSize;
+        const size_t end = (begin + batchSize) < count ? (begin + batchSize) : count;
+        enqueue([&job, &pending, begin, end]() {
+            job(begin, end);
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+
+    // The caller takes the first batch and helps with the rest
+    job(0, batchSize);
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!runPendingJob()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+ThreadPool &ThreadPool::getDefault() {
+    static ThreadPool sDefaultPool;
+    return sDefaultPool;
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mLock);
+            mJobAvailable.wait(lock, [this]() { return !mRunning || !mJobs.empty(); });
+            if (!mRunning && mJobs.empty()) {
+                return;
+            }
+            job = std::move(mJobs.front());
+            mJobs.pop_front();
+        }
+        job();
+    }
+}
+
+} // Namespace Threading
+} // Namespace OSRE
@@ -0,0 +1,84 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <osre/IO/PackArchive.h>
+#include <osre/IO/Uri.h>
+#include <osre/Common/Logger.h>
+
+#include <cstring>
+#include <iostream>
+
+using namespace ::OSRE;
+using namespace ::OSRE::IO;
+
+static constexpr c8 Tag[] = "osre_packer";
+
+static void showUsage() {
+    std::cout << "Usage: osre_packer [--compress] [--root <dir>] <pack> <file>..." << std::endl;
+    std::cout << "  --compress    : Compress entries with zlib, entries which do not shrink are stored." << std::endl;
+    std::cout << "  --root <dir>  : Strip the folder from the paths stored in the pack." << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    bool compress = false;
+    String root, packName;
+    std::vector<String> files;
+    for (int i = 1; i < argc; ++i) {
+        if (0 == ::strcmp(argv[i], "--compress")) {
+            compress = true;
+        } else if (0 == ::strcmp(argv[i], "--root") && i + 1 < argc) {
+            root = argv[++i];
+            if (!root.empty() && '/' != root.back() && '\\' != root.back()) {
+                root += '/';
+            }
+        } else if (packName.empty()) {
+            packName = argv[i];
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+
+    if (packName.empty() || files.empty()) {
+        showUsage();
+        return 1;
+    }
+
+    PackWriter writer;
+    for (const String &file : files) {
+        String path = file;
+        if (!root.empty() && 0 == path.compare(0, root.size(), root)) {
+            path = path.substr(root.size());
+        }
+        if (!writer.addFile(path, Uri("file://" + file), compress)) {
+            osre_error(Tag, "Cannot add " + file);
+            return 1;
+        }
+    }
+
+    if (!writer.write(Uri("file://" + packName))) {
+        osre_error(Tag, "Cannot write " + packName);
+        return 1;
+    }
+    std::cout << "Packed " << writer.getNumFiles() << " files into " << packName << std::endl;
+
+    return 0;
+}
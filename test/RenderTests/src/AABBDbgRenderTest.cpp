@@ -43,10 +43,13 @@ using namespace ::OSRE::App;
 //-------------------------------------------------------------------------------------------------
 class AABBDbgRenderTest : public AbstractRenderTest {
     TransformMatrixBlock m_transformMatrix;
+    AABB m_aabb;
 
 public:
     AABBDbgRenderTest() :
-            AbstractRenderTest("rendertest/AABBDbgRenderTest") {
+            AbstractRenderTest("rendertest/AABBDbgRenderTest"),
+            m_transformMatrix(),
+            m_aabb(glm::vec3(-1, -1, -1), glm::vec3(1, 1, 1)) {
         // empty
     }
 
@@ -55,26 +58,16 @@ public:
     bool onCreate(RenderBackendService *rbSrv) override {
         rbSrv->sendEvent(&OnAttachViewEvent, nullptr);
 
-        glm::vec3 min(-1, -1, -1), max(1, 1, 1);
-        AABB aabb(min, max);
         m_transformMatrix.m_model = glm::rotate(m_transformMatrix.m_model, 0.0f, glm::vec3(1, 1, 0));
         m_transformMatrix.m_model = glm::scale(m_transformMatrix.m_model, glm::vec3(.5, .5, .5));
-        DbgRenderer::getInstance()->renderAABB(m_transformMatrix.m_model, aabb);
 
         return true;
     }
 
-    bool onRender(RenderBackendService *rbSrv) override {
-        rbSrv->beginPass(RenderPass::getPassNameById(DbgPassId));
-        {
-            rbSrv->beginRenderBatch(DbgRenderer::getDebugRenderBatchName());
-            {
-                m_transformMatrix.m_model = glm::rotate(m_transformMatrix.m_model, 0.01f, glm::vec3(1, 1, 0));
-                rbSrv->setMatrix(MatrixType::Model, m_transformMatrix.m_model);
-            }
-            rbSrv->endRenderBatch();
-        }
-        rbSrv->endPass();
+    bool onRender(RenderBackendService *) override {
+        // The debug renderer is immediate mode, so the box is queued every frame
+        m_transformMatrix.m_model = glm::rotate(m_transformMatrix.m_model, 0.01f, glm::vec3(1, 1, 0));
+        DbgRenderer::getInstance()->renderAABB(m_transformMatrix.m_model, m_aabb);
 
         return true;
     }
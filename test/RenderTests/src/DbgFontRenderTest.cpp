@@ -56,9 +56,6 @@ public:
     bool onCreate(RenderBackendService *rbSrv) override {
         rbSrv->sendEvent(&OnAttachViewEvent, nullptr);
 
-        DbgRenderer::getInstance()->renderDbgText(1, 1, 1U, "XXX");
-        DbgRenderer::getInstance()->renderDbgText(10, 10, 2U, "and another one");
-
         return true;
     }
 
@@ -71,7 +68,9 @@ public:
         mFrameCount++;
         std::stringstream stream;
         stream << std::setfill('0') << std::setw(3) << mFrameCount;
-        DbgRenderer::getInstance()->renderDbgText(10, 10, 1, stream.str());
+        DbgRenderer::getInstance()->renderDbgText(1, 1, "XXX");
+        DbgRenderer::getInstance()->renderDbgText(10, 40, "and another one");
+        DbgRenderer::getInstance()->renderDbgText(10, 80, stream.str());
         return true;
     }
 };
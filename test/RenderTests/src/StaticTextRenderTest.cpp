@@ -53,7 +53,11 @@ public:
     bool onCreate( RenderBackendService *rbSrv ) override {
         rbSrv->sendEvent( &OnAttachViewEvent, nullptr );
 
-        DbgRenderer::getInstance()->renderDbgText( 2U, 0, 0, "This is a test-text!\nAnd another one!" );
+        return true;
+    }
+
+    bool onRender( RenderBackendService * ) override {
+        DbgRenderer::getInstance()->renderDbgText( 2U, 0, "This is a test-text!\nAnd another one!" );
 
         return true;
     }
@@ -120,7 +120,7 @@ public:
     }
 
     bool onRender( RenderBackend::RenderBackendService *rbSrv) override {
-        m_particeGen->update( NumPoints );
+        m_particeGen->update( 1.0 / 60.0 );
 
         rbSrv->beginPass(RenderPass::getPassNameById(RenderPassId));
         rbSrv->beginRenderBatch("b1");
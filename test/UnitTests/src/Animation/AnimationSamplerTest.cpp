@@ -0,0 +1,112 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Animation/AnimationSampler.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Animation;
+
+class AnimationSamplerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Bone root;
+        root.mName = "root";
+        mSkeleton.mBones.add(root);
+        Bone child;
+        child.mName = "child";
+        child.mParent = 0;
+        child.mLocalTransform = glm::translate(glm::mat4(1.0f), glm::vec3(0, 1, 0));
+        mSkeleton.mBones.add(child);
+
+        mTrack.mName = "move";
+        mTrack.mDuration = 10.0;
+        mTrack.mTicksPerSecond = 10.0;
+        NodeAnimation channel;
+        channel.mName = "root";
+        for (ui32 i = 0; i <= 10; ++i) {
+            VectorKey key;
+            key.mVector = glm::vec3(static_cast<f32>(i), 0, 0);
+            key.mTime = static_cast<d32>(i);
+            channel.mPositions.add(key);
+        }
+        mTrack.mNodeAnimations.add(channel);
+    }
+
+    Skeleton mSkeleton;
+    AnimationTrack mTrack;
+};
+
+TEST_F( AnimationSamplerTest, bindPoseTest ) {
+    Pose pose;
+    AnimationSampler::getBindPose(mSkeleton, pose);
+    ASSERT_EQ(2u, pose.size());
+    EXPECT_FLOAT_EQ(1.0f, pose[1].mTranslation.y);
+    EXPECT_FLOAT_EQ(1.0f, pose[1].mScale.x);
+}
+
+TEST_F( AnimationSamplerTest, sampleTest ) {
+    AnimationSampler sampler;
+    sampler.bind(&mTrack, mSkeleton);
+    EXPECT_DOUBLE_EQ(1.0, sampler.getDurationInSeconds());
+
+    Pose pose;
+    sampler.sample(0.25, false, pose);
+    ASSERT_EQ(2u, pose.size());
+    EXPECT_FLOAT_EQ(2.5f, pose[0].mTranslation.x);
+
+    // The child is not animated and keeps the bind transform
+    EXPECT_FLOAT_EQ(1.0f, pose[1].mTranslation.y);
+
+    sampler.sample(0.55, false, pose);
+    EXPECT_NEAR(5.5f, pose[0].mTranslation.x, 1e-4f);
+
+    // Looping wraps around and jumps backwards
+    sampler.sample(1.25, true, pose);
+    EXPECT_NEAR(2.5f, pose[0].mTranslation.x, 1e-4f);
+
+    // Clamped at the end
+    sampler.sample(2.0, false, pose);
+    EXPECT_FLOAT_EQ(10.0f, pose[0].mTranslation.x);
+}
+
+TEST_F( AnimationSamplerTest, blendTest ) {
+    Pose a, b, out;
+    a.resize(1);
+    b.resize(1);
+    b[0].mTranslation = glm::vec3(2, 0, 0);
+    b[0].mRotation = glm::angleAxis(glm::radians(90.0f), glm::vec3(0, 0, 1));
+
+    AnimationSampler::blend(a, b, 0.5f, out);
+    ASSERT_EQ(1u, out.size());
+    EXPECT_FLOAT_EQ(1.0f, out[0].mTranslation.x);
+    EXPECT_NEAR(45.0f, glm::degrees(glm::angle(out[0].mRotation)), 1e-3f);
+
+    // In place
+    AnimationSampler::blend(a, b, 1.0f, a);
+    EXPECT_FLOAT_EQ(2.0f, a[0].mTranslation.x);
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
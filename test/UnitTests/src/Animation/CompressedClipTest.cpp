@@ -0,0 +1,135 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Animation/CompressedClip.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Animation;
+
+static f32 getAngle(const glm::quat &a, const glm::quat &b) {
+    return 2.0f * std::acos(glm::min(1.0f, std::fabs(glm::dot(a, b))));
+}
+
+class CompressedClipTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Bone root;
+        root.mName = "root";
+        mSkeleton.mBones.add(root);
+        Bone child;
+        child.mName = "child";
+        child.mParent = 0;
+        mSkeleton.mBones.add(child);
+
+        // Two seconds at 30 keys per second: a linear move, a spin and a constant scaling
+        mTrack.mName = "walk";
+        mTrack.mDuration = 60.0;
+        mTrack.mTicksPerSecond = 30.0;
+        NodeAnimation root_channel;
+        root_channel.mName = "root";
+        NodeAnimation child_channel;
+        child_channel.mName = "child";
+        for (ui32 i = 0; i <= 60; ++i) {
+            const f32 t = static_cast<f32>(i);
+            VectorKey position;
+            position.mVector = glm::vec3(t * 0.1f, 0.0f, 0.0f);
+            position.mTime = t;
+            root_channel.mPositions.add(position);
+
+            const glm::quat q = glm::angleAxis(glm::radians(t * 6.0f), glm::vec3(0, 1, 0));
+            RotationKey rotation;
+            rotation.mQuad = glm::vec4(q.x, q.y, q.z, q.w);
+            rotation.mTime = t;
+            child_channel.mRotations.add(rotation);
+
+            VectorKey scaling;
+            scaling.mVector = glm::vec3(2.0f);
+            scaling.mTime = t;
+            child_channel.mScalings.add(scaling);
+        }
+        mTrack.mNodeAnimations.add(root_channel);
+        mTrack.mNodeAnimations.add(child_channel);
+    }
+
+    Skeleton mSkeleton;
+    AnimationTrack mTrack;
+};
+
+TEST_F( CompressedClipTest, compressTest ) {
+    CompressedClip clip;
+    EXPECT_TRUE(CompressedClip::compress(mTrack, CompressionSettings(), clip));
+    EXPECT_EQ(61u, clip.getNumFrames());
+    EXPECT_DOUBLE_EQ(2.0, clip.getDurationInSeconds());
+    ASSERT_EQ(2u, clip.getNumChannels());
+    EXPECT_EQ("child", clip.getChannelName(1));
+
+    // The linear move and the constant scaling are reduced
+    EXPECT_LT(clip.getMemorySize() * 4, CompressedClip::getMemorySize(mTrack));
+}
+
+TEST_F( CompressedClipTest, sampleTest ) {
+    CompressedClip clip;
+    ASSERT_TRUE(CompressedClip::compress(mTrack, CompressionSettings(), clip));
+
+    AnimationSampler reference;
+    reference.bind(&mTrack, mSkeleton);
+    AnimationSampler sampler;
+    sampler.bind(&clip, mSkeleton);
+    EXPECT_EQ(&clip, sampler.getClip());
+    EXPECT_DOUBLE_EQ(2.0, sampler.getDurationInSeconds());
+
+    Pose expected, pose;
+    for (ui32 i = 0; i <= 100; ++i) {
+        const d32 time = i * 0.02;
+        reference.sample(time, false, expected);
+        sampler.sample(time, false, pose);
+        ASSERT_EQ(2u, pose.size());
+        EXPECT_NEAR(expected[0].mTranslation.x, pose[0].mTranslation.x, 1e-3f);
+        EXPECT_FLOAT_EQ(0.0f, pose[0].mTranslation.y);
+        EXPECT_LT(getAngle(expected[1].mRotation, pose[1].mRotation), glm::radians(0.2f));
+        EXPECT_FLOAT_EQ(2.0f, pose[1].mScale.z);
+    }
+
+    // Looping wraps into the duration
+    sampler.sample(2.5, true, pose);
+    EXPECT_NEAR(1.5f, pose[0].mTranslation.x, 1e-3f);
+}
+
+TEST_F( CompressedClipTest, decompressTest ) {
+    CompressedClip clip;
+    ASSERT_TRUE(CompressedClip::compress(mTrack, CompressionSettings(), clip));
+
+    AnimationTrack track;
+    clip.decompress(track);
+    ASSERT_EQ(2u, track.mNodeAnimations.size());
+    ASSERT_EQ(61u, track.mNodeAnimations[0].mPositions.size());
+    EXPECT_TRUE(track.mNodeAnimations[0].mRotations.isEmpty());
+    EXPECT_NEAR(3.0f, track.mNodeAnimations[0].mPositions[30].mVector.x, 1e-3f);
+    EXPECT_DOUBLE_EQ(1.0, track.mNodeAnimations[0].mPositions[30].mTime);
+    EXPECT_EQ(61u, track.mNodeAnimations[1].mRotations.size());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
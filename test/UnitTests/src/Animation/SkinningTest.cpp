@@ -0,0 +1,128 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Animation/Skinning.h>
+#include <osre/RenderBackend/RenderCommon.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Animation;
+using namespace ::OSRE::RenderBackend;
+
+class SkinningTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Bone root;
+        root.mName = "root";
+        mSkin.mSkeleton.mBones.add(root);
+        Bone child;
+        child.mName = "child";
+        child.mParent = 0;
+        child.mLocalTransform = glm::translate(glm::mat4(1.0f), glm::vec3(0, 1, 0));
+        child.m_offsetMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(0, -1, 0));
+        mSkin.mSkeleton.mBones.add(child);
+    }
+
+    Skin mSkin;
+};
+
+TEST_F( SkinningTest, computePaletteTest ) {
+    Pose pose;
+    AnimationSampler::getBindPose(mSkin.mSkeleton, pose);
+
+    // The bind pose results in identity matrices
+    BonePalette palette;
+    Skinning::computePalette(mSkin.mSkeleton, pose, palette);
+    ASSERT_EQ(2u, palette.size());
+    for (size_t i = 0; i < palette.size(); ++i) {
+        const glm::vec4 p = palette[i] * glm::vec4(1, 2, 3, 1);
+        EXPECT_NEAR(1.0f, p.x, 1e-5f);
+        EXPECT_NEAR(2.0f, p.y, 1e-5f);
+        EXPECT_NEAR(3.0f, p.z, 1e-5f);
+    }
+
+    // Moving the root moves the child
+    pose[0].mTranslation = glm::vec3(5, 0, 0);
+    Skinning::computePalette(mSkin.mSkeleton, pose, palette);
+    EXPECT_FLOAT_EQ(5.0f, palette[1][3].x);
+}
+
+TEST_F( SkinningTest, skinTest ) {
+    const size_t NumVertices = 10000;
+    cppcore::TArray<RenderVert> src, dst;
+    src.resize(NumVertices);
+    dst.resize(NumVertices);
+    mSkin.mVertices.resize(NumVertices);
+    for (size_t i = 0; i < NumVertices; ++i) {
+        src[i].position = glm::vec3(static_cast<f32>(i), 0, 0);
+        src[i].normal = glm::vec3(0, 0, 1);
+        SkinVertex &sv = mSkin.mVertices[i];
+        for (ui32 j = 0; j < MaxBonesPerVertex; ++j) {
+            sv.mBones[j] = 0;
+            sv.mWeights[j] = 0.0f;
+        }
+        sv.mBones[0] = 0;
+        sv.mBones[1] = 1;
+        sv.mWeights[0] = 0.5f;
+        sv.mWeights[1] = 0.5f;
+    }
+
+    BonePalette palette;
+    palette.add(glm::translate(glm::mat4(1.0f), glm::vec3(0, 2, 0)));
+    palette.add(glm::rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0, 1, 0)));
+    Skinning::skin(mSkin, palette, &src[0], &dst[0], NumVertices);
+
+    for (size_t i = 0; i < NumVertices; i += 997) {
+        const glm::vec3 expected = glm::vec3(0.5f * (palette[0] * glm::vec4(src[i].position, 1.0f)) +
+                0.5f * (palette[1] * glm::vec4(src[i].position, 1.0f)));
+        EXPECT_NEAR(expected.x, dst[i].position.x, 1e-3f);
+        EXPECT_NEAR(expected.y, dst[i].position.y, 1e-3f);
+        EXPECT_NEAR(expected.z, dst[i].position.z, 1e-3f);
+        EXPECT_NEAR(0.5f, dst[i].normal.x, 1e-5f);
+        EXPECT_NEAR(0.5f, dst[i].normal.z, 1e-5f);
+    }
+}
+
+TEST_F( SkinningTest, unweightedTest ) {
+    cppcore::TArray<RenderVert> src, dst;
+    src.resize(1);
+    dst.resize(1);
+    src[0].position = glm::vec3(1, 2, 3);
+    src[0].normal = glm::vec3(0, 1, 0);
+    mSkin.mVertices.resize(1);
+    for (ui32 j = 0; j < MaxBonesPerVertex; ++j) {
+        mSkin.mVertices[0].mBones[j] = 0;
+        mSkin.mVertices[0].mWeights[j] = 0.0f;
+    }
+
+    // A vertex without weights keeps its bind pose
+    BonePalette palette;
+    palette.add(glm::translate(glm::mat4(1.0f), glm::vec3(0, 2, 0)));
+    Skinning::skin(mSkin, palette, &src[0], &dst[0], 1);
+    EXPECT_EQ(src[0].position, dst[0].position);
+    EXPECT_EQ(src[0].normal, dst[0].normal);
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,111 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/App/ComponentRegistry.h>
+#include <osre/App/Entity.h>
+#include <osre/App/TransformComponent.h>
+#include <osre/Common/Ids.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::App;
+
+class ComponentRegistryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mIds = new Common::Ids(0);
+        mEntity = new Entity("test", *mIds, nullptr);
+    }
+
+    void TearDown() override {
+        delete mEntity;
+        mEntity = nullptr;
+        delete mIds;
+        mIds = nullptr;
+    }
+
+    Common::Ids *mIds;
+    Entity *mEntity;
+};
+
+TEST_F( ComponentRegistryTest, allocSlotTest ) {
+    ComponentRegistry registry;
+    const ui32 slot0 = registry.allocSlot();
+    const ui32 slot1 = registry.allocSlot();
+    EXPECT_NE(slot0, slot1);
+    EXPECT_EQ(2u, registry.getSlotCapacity());
+
+    // Released slots will be reused
+    registry.releaseSlot(slot0);
+    EXPECT_EQ(slot0, registry.allocSlot());
+    EXPECT_EQ(2u, registry.getSlotCapacity());
+}
+
+TEST_F( ComponentRegistryTest, addComponentTest ) {
+    ComponentRegistry registry;
+    const ui32 slot = registry.allocSlot();
+    Component *rc = mEntity->getComponent(ComponentType::RenderComponentType);
+    registry.addComponent(slot, rc);
+    EXPECT_EQ(1u, registry.getNumComponents(ComponentType::RenderComponentType));
+    EXPECT_EQ(0u, registry.getNumComponents(ComponentType::LightComponentType));
+    EXPECT_EQ(rc, registry.getComponent(slot, ComponentType::RenderComponentType));
+    EXPECT_EQ(nullptr, registry.getComponent(slot, ComponentType::LightComponentType));
+
+    size_t count = 0;
+    registry.forEach(ComponentType::RenderComponentType, [&count, slot, rc](ui32 key, Component *component) {
+        EXPECT_EQ(slot, key);
+        EXPECT_EQ(rc, component);
+        ++count;
+    });
+    EXPECT_EQ(1u, count);
+
+    registry.releaseSlot(slot);
+    EXPECT_EQ(0u, registry.getNumComponents(ComponentType::RenderComponentType));
+}
+
+TEST_F( ComponentRegistryTest, valuePoolTest ) {
+    ComponentRegistry registry;
+    const ui32 slot = registry.allocSlot();
+    TransformComponent *node = static_cast<TransformComponent *>(mEntity->createComponent(ComponentType::TransformComponentType));
+    node->translate(glm::vec3(1.0f, 0.0f, 0.0f));
+    registry.addComponent(slot, node);
+    EXPECT_TRUE(node->isPooled());
+
+    // The data lives in the pool, the component is only the facade
+    TransformPool &transforms = registry.getTransforms();
+    ASSERT_EQ(1u, transforms.size());
+    EXPECT_EQ(slot, transforms.mSlots[0]);
+    EXPECT_EQ(glm::vec3(1.0f, 0.0f, 0.0f), transforms.mTranslation[0]);
+    node->translate(glm::vec3(0.0f, 2.0f, 0.0f));
+    EXPECT_EQ(glm::vec3(1.0f, 2.0f, 0.0f), transforms.mTranslation[0]);
+
+    // Releasing the slot copies the data back
+    registry.releaseSlot(slot);
+    EXPECT_FALSE(node->isPooled());
+    EXPECT_EQ(0u, transforms.size());
+    EXPECT_EQ(glm::vec3(1.0f, 2.0f, 0.0f), node->getTranslation());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
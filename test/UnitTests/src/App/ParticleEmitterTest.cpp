@@ -0,0 +1,112 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/App/ParticleEmitter.h>
+#include <osre/RenderBackend/Mesh.h>
+
+#include <cmath>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::App;
+using namespace ::OSRE::RenderBackend;
+
+class ParticleEmitterTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F( ParticleEmitterTest, initTest ) {
+    ParticleEmitter emitter(nullptr);
+    emitter.init(100);
+    EXPECT_EQ(100u, emitter.getCapacity());
+    EXPECT_EQ(100u, emitter.getNumAlive());
+
+    Mesh *mesh = emitter.getMesh();
+    ASSERT_NE(nullptr, mesh);
+    EXPECT_EQ(sizeof(ColorVert) * 100, mesh->getVertexBuffer()->getSize());
+    const ColorVert *verts = reinterpret_cast<const ColorVert*>(mesh->getVertexBuffer()->getData());
+    EXPECT_FLOAT_EQ(emitter.getPosition(42).x, verts[42].position.x);
+    delete mesh;
+}
+
+TEST_F( ParticleEmitterTest, integrateTest ) {
+    ParticleEmitter emitter(nullptr);
+    emitter.setSpawnVolume(glm::vec3(0.0f), glm::vec3(0.0f));
+    emitter.setVelocity(glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    emitter.setAcceleration(glm::vec3(0.0f, -2.0f, 0.0f));
+    emitter.init(7);
+
+    emitter.update(0.5);
+    for (ui32 i = 0; i < emitter.getNumAlive(); ++i) {
+        const glm::vec3 pos = emitter.getPosition(i);
+        EXPECT_FLOAT_EQ(0.5f, pos.x);
+        EXPECT_FLOAT_EQ(-0.5f, pos.y);
+        EXPECT_FLOAT_EQ(0.0f, pos.z);
+    }
+    delete emitter.getMesh();
+}
+
+TEST_F( ParticleEmitterTest, lifetimeTest ) {
+    ParticleEmitter emitter(nullptr);
+    emitter.setLifetime(1.0f, 1.0f);
+    emitter.init(10);
+    EXPECT_EQ(10u, emitter.getNumAlive());
+
+    emitter.update(0.5);
+    EXPECT_EQ(10u, emitter.getNumAlive());
+    emitter.update(0.6);
+    EXPECT_EQ(0u, emitter.getNumAlive());
+
+    // Dead particles will not be drawn
+    EXPECT_EQ(0u, emitter.getMesh()->getPrimitiveGroupAt(0)->m_numIndices);
+
+    emitter.setSpawnRate(10.0f);
+    emitter.update(0.5);
+    EXPECT_EQ(5u, emitter.getNumAlive());
+    EXPECT_EQ(5u, emitter.getMesh()->getPrimitiveGroupAt(0)->m_numIndices);
+    delete emitter.getMesh();
+}
+
+TEST_F( ParticleEmitterTest, boundsTest ) {
+    const ui32 NumParticles = 40000;
+    ParticleEmitter emitter(nullptr);
+    emitter.setSpawnVolume(glm::vec3(-1.0f), glm::vec3(1.0f));
+    emitter.setVelocity(glm::vec3(-1.0f), glm::vec3(1.0f));
+    emitter.setBounds(Common::AABB(glm::vec3(-1.0f), glm::vec3(1.0f)));
+    emitter.init(NumParticles);
+
+    emitter.update(0.5);
+    EXPECT_LT(emitter.getNumAlive(), NumParticles);
+    EXPECT_GT(emitter.getNumAlive(), 0u);
+    for (ui32 i = 0; i < emitter.getNumAlive(); ++i) {
+        const glm::vec3 pos = emitter.getPosition(i);
+        EXPECT_LE(std::abs(pos.x), 1.0f);
+        EXPECT_LE(std::abs(pos.y), 1.0f);
+        EXPECT_LE(std::abs(pos.z), 1.0f);
+    }
+    delete emitter.getMesh();
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,170 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Common/BoundingVolumeTree.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+
+class BoundingVolumeTreeTest : public ::testing::Test {
+protected:
+    static AABB boxAt(f32 x, f32 y, f32 z) {
+        return AABB(glm::vec3(x - 0.5f, y - 0.5f, z - 0.5f), glm::vec3(x + 0.5f, y + 0.5f, z + 0.5f));
+    }
+
+    static bool contains(const cppcore::TArray<void*> &result, void *data) {
+        for (size_t i = 0; i < result.size(); ++i) {
+            if (result[i] == data) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+TEST_F( BoundingVolumeTreeTest, createProxyTest ) {
+    BoundingVolumeTree tree;
+    EXPECT_EQ(0u, tree.getNumProxies());
+    EXPECT_TRUE(tree.validate());
+
+    int data[64];
+    for (i32 i = 0; i < 64; ++i) {
+        tree.createProxy(boxAt(static_cast<f32>(i * 2), 0, 0), &data[i]);
+    }
+    EXPECT_EQ(64u, tree.getNumProxies());
+    EXPECT_TRUE(tree.validate());
+
+    // A balanced tree for 64 leaves
+    EXPECT_LE(tree.getHeight(), 12);
+}
+
+TEST_F( BoundingVolumeTreeTest, destroyProxyTest ) {
+    BoundingVolumeTree tree;
+    int data[32];
+    i32 ids[32];
+    for (i32 i = 0; i < 32; ++i) {
+        ids[i] = tree.createProxy(boxAt(static_cast<f32>(i * 2), 0, 0), &data[i]);
+    }
+    for (i32 i = 0; i < 32; i += 2) {
+        tree.destroyProxy(ids[i]);
+    }
+    EXPECT_EQ(16u, tree.getNumProxies());
+    EXPECT_TRUE(tree.validate());
+
+    cppcore::TArray<void*> result;
+    tree.query(AABB(glm::vec3(-100), glm::vec3(100)), result);
+    EXPECT_EQ(16u, result.size());
+    EXPECT_FALSE(contains(result, &data[0]));
+    EXPECT_TRUE(contains(result, &data[1]));
+}
+
+TEST_F( BoundingVolumeTreeTest, moveProxyTest ) {
+    BoundingVolumeTree tree(0.5f);
+    int data = 0;
+    const i32 id = tree.createProxy(boxAt(0, 0, 0), &data);
+
+    // Stays inside the fat box
+    EXPECT_FALSE(tree.moveProxy(id, boxAt(0.1f, 0, 0)));
+    EXPECT_TRUE(tree.moveProxy(id, boxAt(10, 0, 0)));
+    EXPECT_TRUE(tree.validate());
+
+    cppcore::TArray<void*> result;
+    tree.query(boxAt(0, 0, 0), result);
+    EXPECT_TRUE(result.isEmpty());
+    tree.query(boxAt(10, 0, 0), result);
+    EXPECT_EQ(1u, result.size());
+}
+
+TEST_F( BoundingVolumeTreeTest, querySphereTest ) {
+    BoundingVolumeTree tree;
+    int data[3];
+    tree.createProxy(boxAt(0, 0, 0), &data[0]);
+    tree.createProxy(boxAt(5, 0, 0), &data[1]);
+    tree.createProxy(boxAt(0, 5, 0), &data[2]);
+
+    cppcore::TArray<void*> result;
+    tree.query(glm::vec3(5, 1, 0), 1.0f, result);
+    EXPECT_EQ(1u, result.size());
+    EXPECT_TRUE(contains(result, &data[1]));
+}
+
+TEST_F( BoundingVolumeTreeTest, queryFrustumTest ) {
+    BoundingVolumeTree tree;
+    int data[2];
+    tree.createProxy(boxAt(0, 0, -10), &data[0]);
+    tree.createProxy(boxAt(0, 0, 10), &data[1]);
+
+    glm::mat4 v = glm::lookAt(glm::vec3(0, 0, 0), glm::vec3(0, 0, -1), glm::vec3(0, 1, 0));
+    glm::mat4 p = glm::perspective(1.0f, 1.0f, 0.1f, 100.0f);
+    Frustum f;
+    f.extractFrom(p * v);
+
+    cppcore::TArray<void*> result;
+    tree.query(f, result);
+    EXPECT_EQ(1u, result.size());
+    EXPECT_TRUE(contains(result, &data[0]));
+}
+
+TEST_F( BoundingVolumeTreeTest, queryFrustumManyTest ) {
+    // Enough boxes on both sides to test the leaves in batches of four
+    BoundingVolumeTree tree;
+    int data[22];
+    for (int i = 0; i < 11; ++i) {
+        tree.createProxy(boxAt(static_cast<f32>(i - 5), 0, -20), &data[i]);
+        tree.createProxy(boxAt(static_cast<f32>(i - 5), 0, 20), &data[i + 11]);
+    }
+
+    glm::mat4 v = glm::lookAt(glm::vec3(0, 0, 0), glm::vec3(0, 0, -1), glm::vec3(0, 1, 0));
+    glm::mat4 p = glm::perspective(1.0f, 1.0f, 0.1f, 100.0f);
+    Frustum f;
+    f.extractFrom(p * v);
+
+    cppcore::TArray<void*> result;
+    tree.query(f, result);
+    EXPECT_EQ(11u, result.size());
+    for (int i = 0; i < 11; ++i) {
+        EXPECT_TRUE(contains(result, &data[i]));
+        EXPECT_FALSE(contains(result, &data[i + 11]));
+    }
+}
+
+TEST_F( BoundingVolumeTreeTest, raycastTest ) {
+    BoundingVolumeTree tree;
+    int data[3];
+    tree.createProxy(boxAt(10, 0, 0), &data[0]);
+    tree.createProxy(boxAt(5, 0, 0), &data[1]);
+    tree.createProxy(boxAt(5, 5, 0), &data[2]);
+
+    BoundingVolumeTree::RayHit hit;
+    EXPECT_TRUE(tree.raycast(Ray(glm::vec3(0, 0, 0), glm::vec3(2, 0, 0)), 100.0f, hit));
+    EXPECT_EQ(&data[1], hit.mUserData);
+    EXPECT_NEAR(4.5f, hit.mDistance, 0.0001f);
+
+    EXPECT_FALSE(tree.raycast(Ray(glm::vec3(0, 0, 0), glm::vec3(1, 0, 0)), 4.0f, hit));
+    EXPECT_FALSE(tree.raycast(Ray(glm::vec3(0, 0, 0), glm::vec3(-1, 0, 0)), 100.0f, hit));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
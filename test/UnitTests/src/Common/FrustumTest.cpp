@@ -58,6 +58,63 @@ TEST_F( FrustumTest, extractFromTest ) {
     EXPECT_FALSE(result);
 }
 
+static Frustum createTestFrustum() {
+    glm::vec3 pos(-10, 10, 0), center(0, 0, 0), up(0, 0, 1);
+    glm::mat4 v = glm::lookAt(pos, center, up);
+    glm::mat4 p = glm::perspective(1.2f, 1.f, 0.1f, 100.0f);
+    Frustum f;
+    f.extractFrom(p * v);
+
+    return f;
+}
+
+TEST_F( FrustumTest, normalizedPlanesTest ) {
+    Frustum f = createTestFrustum();
+    for (size_t i = 0; i < Frustum::NumPlanes; ++i) {
+        EXPECT_NEAR(1.0f, glm::length(glm::vec3(f.getPlane(i))), 0.0001f);
+    }
+}
+
+TEST_F( FrustumTest, isInAABBTest ) {
+    Frustum f = createTestFrustum();
+    EXPECT_TRUE(f.isIn(AABB(glm::vec3(-1, -1, -1), glm::vec3(1, 1, 1))));
+
+    // Partially intersecting boxes are in
+    EXPECT_TRUE(f.isIn(AABB(glm::vec3(-12, 9, -1), glm::vec3(-9, 11, 1))));
+
+    // Behind the camera
+    EXPECT_FALSE(f.isIn(AABB(glm::vec3(-21, 19, -1), glm::vec3(-19, 21, 1))));
+
+    // Behind the far plane
+    EXPECT_FALSE(f.isIn(AABB(glm::vec3(200, -201, -1), glm::vec3(201, -200, 1))));
+}
+
+TEST_F( FrustumTest, isInSphereTest ) {
+    Frustum f = createTestFrustum();
+    EXPECT_TRUE(f.isIn(glm::vec3(0, 0, 0), 1.0f));
+    EXPECT_FALSE(f.isIn(glm::vec3(-20, 20, 0), 1.0f));
+    EXPECT_TRUE(f.isIn(glm::vec3(-10.5f, 10.5f, 0), 1.0f));
+}
+
+TEST_F( FrustumTest, cullBatchTest ) {
+    Frustum f = createTestFrustum();
+    AABBBatch batch;
+    cppcore::TArray<uc8> visible;
+    for (i32 i = 0; i < 11; ++i) {
+        const glm::vec3 center(i * 3.0f - 15.0f, 15.0f - i * 3.0f, 0.0f);
+        batch.add(AABB(center - glm::vec3(0.5f), center + glm::vec3(0.5f)));
+    }
+    f.cullBatch(batch, visible);
+    ASSERT_EQ(batch.size(), visible.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const AABB aabb(glm::vec3(batch.mMinX[i], batch.mMinY[i], batch.mMinZ[i]),
+                glm::vec3(batch.mMaxX[i], batch.mMaxY[i], batch.mMaxZ[i]));
+        EXPECT_EQ(f.isIn(aabb) ? 1 : 0, visible[i]);
+    }
+    EXPECT_EQ(0, visible[0]);
+    EXPECT_EQ(1, visible[10]);
+}
+
 } // namespace UnitTest
 } // namespace OSRE
 
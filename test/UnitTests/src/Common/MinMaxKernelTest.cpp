@@ -0,0 +1,87 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Common/MinMaxKernel.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+
+class MinMaxKernelTest : public ::testing::Test {
+protected:
+    struct TestVertex {
+        glm::vec3 position;
+        glm::vec3 normal;
+        glm::vec2 tex0;
+    };
+
+    static void fill(cppcore::TArray<TestVertex> &vertices, size_t numVertices) {
+        vertices.resize(numVertices);
+        for (size_t i = 0; i < numVertices; ++i) {
+            const f32 v = static_cast<f32>(i);
+            vertices[i].position = glm::vec3(v, -v * 2.0f, (i % 7) - 3.0f);
+            vertices[i].normal = glm::vec3(1000.0f, -1000.0f, 1000.0f);
+        }
+    }
+};
+
+TEST_F(MinMaxKernelTest, computeStridedTest) {
+    cppcore::TArray<TestVertex> vertices;
+    for (size_t numVertices = 1; numVertices < 12; ++numVertices) {
+        fill(vertices, numVertices);
+        glm::vec3 min(AABB::Invalid), max(-AABB::Invalid);
+        glm::vec3 refMin(AABB::Invalid), refMax(-AABB::Invalid);
+        MinMaxKernel::compute(&vertices[0], numVertices, sizeof(TestVertex), min, max);
+        MinMaxKernel::computeScalar(&vertices[0], numVertices, sizeof(TestVertex), refMin, refMax);
+        EXPECT_EQ(refMin, min);
+        EXPECT_EQ(refMax, max);
+        EXPECT_FLOAT_EQ(0.0f, min.x);
+        EXPECT_FLOAT_EQ(static_cast<f32>(numVertices - 1), max.x);
+    }
+}
+
+TEST_F(MinMaxKernelTest, computeTightlyPackedTest) {
+    glm::vec3 positions[3] = { glm::vec3(1, 2, 3), glm::vec3(-1, 5, 0), glm::vec3(4, -2, 1) };
+    glm::vec3 min(AABB::Invalid), max(-AABB::Invalid);
+    MinMaxKernel::compute(positions, 3, sizeof(glm::vec3), min, max);
+    EXPECT_EQ(glm::vec3(-1, -2, 0), min);
+    EXPECT_EQ(glm::vec3(4, 5, 3), max);
+}
+
+TEST_F(MinMaxKernelTest, mergeParallelTest) {
+    cppcore::TArray<TestVertex> vertices;
+    const size_t numVertices = MinMaxKernel::ParallelThreshold * 3 + 5;
+    fill(vertices, numVertices);
+
+    AABB aabb;
+    MinMaxKernel::merge(aabb, &vertices[0], numVertices, sizeof(TestVertex));
+    EXPECT_FLOAT_EQ(0.0f, aabb.getMin().x);
+    EXPECT_FLOAT_EQ(static_cast<f32>(numVertices - 1), aabb.getMax().x);
+    EXPECT_FLOAT_EQ(-2.0f * (numVertices - 1), aabb.getMin().y);
+    EXPECT_FLOAT_EQ(-3.0f, aabb.getMin().z);
+    EXPECT_FLOAT_EQ(3.0f, aabb.getMax().z);
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,120 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Common/OcclusionBuffer.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+
+class OcclusionBufferTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const glm::mat4 v = glm::lookAt(glm::vec3(0, 0, 0), glm::vec3(0, 0, -1), glm::vec3(0, 1, 0));
+        const glm::mat4 p = glm::perspective(1.0f, 2.0f, 0.1f, 100.0f);
+        mViewProjection = p * v;
+    }
+
+    // A wall in the xy-plane at depth z, seen by the camera looking along -z
+    static void addWall(OcclusionBuffer &buffer, f32 z, f32 halfSize) {
+        const glm::vec3 positions[4] = {
+            glm::vec3(-halfSize, -halfSize, z), glm::vec3(halfSize, -halfSize, z),
+            glm::vec3(halfSize, halfSize, z), glm::vec3(-halfSize, halfSize, z)
+        };
+        const ui32 indices[6] = { 0, 1, 2, 0, 2, 3 };
+        buffer.addOccluder(positions, 4, indices, 6, glm::mat4(1.0f));
+    }
+
+    glm::mat4 mViewProjection;
+};
+
+TEST_F( OcclusionBufferTest, createTest ) {
+    OcclusionBuffer buffer(100, 50);
+    EXPECT_EQ(104u, buffer.getWidth());
+    EXPECT_EQ(56u, buffer.getHeight());
+    EXPECT_FLOAT_EQ(1.0f, buffer.getDepth(0, 0));
+}
+
+TEST_F( OcclusionBufferTest, emptyBufferIsVisibleTest ) {
+    OcclusionBuffer buffer;
+    buffer.beginFrame(mViewProjection);
+    buffer.rasterize();
+    EXPECT_TRUE(buffer.isVisible(AABB(glm::vec3(-1, -1, -20), glm::vec3(1, 1, -18))));
+}
+
+TEST_F( OcclusionBufferTest, occludedBoxTest ) {
+    OcclusionBuffer buffer;
+    buffer.beginFrame(mViewProjection);
+    addWall(buffer, -10.0f, 20.0f);
+    buffer.rasterize();
+    EXPECT_EQ(2u, buffer.getNumTriangles());
+
+    // Behind the wall
+    EXPECT_FALSE(buffer.isVisible(AABB(glm::vec3(-1, -1, -20), glm::vec3(1, 1, -18))));
+
+    // In front of the wall
+    EXPECT_TRUE(buffer.isVisible(AABB(glm::vec3(-1, -1, -6), glm::vec3(1, 1, -4))));
+
+    // Intersecting the wall
+    EXPECT_TRUE(buffer.isVisible(AABB(glm::vec3(-1, -1, -11), glm::vec3(1, 1, -9))));
+}
+
+TEST_F( OcclusionBufferTest, partiallyCoveredTest ) {
+    OcclusionBuffer buffer;
+    buffer.beginFrame(mViewProjection);
+    addWall(buffer, -10.0f, 1.0f);
+    buffer.rasterize();
+
+    // Bigger than the wall on screen
+    EXPECT_TRUE(buffer.isVisible(AABB(glm::vec3(-5, -5, -30), glm::vec3(5, 5, -28))));
+
+    // Small and fully hidden
+    EXPECT_FALSE(buffer.isVisible(AABB(glm::vec3(-0.5f, -0.5f, -30), glm::vec3(0.5f, 0.5f, -28))));
+}
+
+TEST_F( OcclusionBufferTest, nearPlaneClippingTest ) {
+    OcclusionBuffer buffer;
+    buffer.beginFrame(mViewProjection);
+
+    // A floor reaching behind the camera
+    const glm::vec3 positions[4] = {
+        glm::vec3(-50, -1, 10), glm::vec3(50, -1, 10), glm::vec3(50, -1, -50), glm::vec3(-50, -1, -50)
+    };
+    const ui32 indices[6] = { 0, 1, 2, 0, 2, 3 };
+    buffer.addOccluder(positions, 4, indices, 6, glm::mat4(1.0f));
+    buffer.rasterize();
+    EXPECT_LT(0u, buffer.getNumTriangles());
+
+    // Below the floor
+    EXPECT_FALSE(buffer.isVisible(AABB(glm::vec3(-1, -5, -20), glm::vec3(1, -3, -18))));
+
+    // Above the floor
+    EXPECT_TRUE(buffer.isVisible(AABB(glm::vec3(-1, 0, -20), glm::vec3(1, 2, -18))));
+
+    // Crossing the near plane
+    EXPECT_TRUE(buffer.isVisible(AABB(glm::vec3(-1, -5, -1), glm::vec3(1, -3, 1))));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,114 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Common/TSlotMap.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+
+class TSlotMapTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F( TSlotMapTest, handleTest ) {
+    SlotHandle invalid;
+    EXPECT_FALSE(invalid.isValid());
+
+    SlotHandle handle(5, 3);
+    EXPECT_TRUE(handle.isValid());
+    EXPECT_EQ(5u, handle.getIndex());
+    EXPECT_EQ(3u, handle.getGeneration());
+    EXPECT_NE(handle, SlotHandle(5, 4));
+}
+
+TEST_F( TSlotMapTest, addRemoveTest ) {
+    TSlotMap<i32> map;
+    EXPECT_TRUE(map.isEmpty());
+
+    SlotHandle h1 = map.add(1);
+    SlotHandle h2 = map.add(2);
+    EXPECT_EQ(2u, map.size());
+    EXPECT_TRUE(map.contains(h1));
+    EXPECT_EQ(2, *map.find(h2));
+
+    EXPECT_TRUE(map.remove(h1));
+    EXPECT_FALSE(map.remove(h1));
+    EXPECT_EQ(1u, map.size());
+    EXPECT_EQ(nullptr, map.find(h1));
+    EXPECT_EQ(2, *map.find(h2));
+    EXPECT_FALSE(map.contains(SlotHandle()));
+}
+
+TEST_F( TSlotMapTest, staleHandleTest ) {
+    TSlotMap<i32> map;
+    SlotHandle first = map.add(0);
+    map.remove(first);
+
+    // Cycle enough values to force the reuse of the first slot
+    bool reused = false;
+    for (i32 i = 0; i < 1000 && !reused; ++i) {
+        SlotHandle handle = map.add(i);
+        if (handle.getIndex() == first.getIndex()) {
+            EXPECT_NE(first.getGeneration(), handle.getGeneration());
+            EXPECT_EQ(i, *map.find(handle));
+            reused = true;
+        }
+        map.remove(handle);
+    }
+    EXPECT_TRUE(reused);
+    EXPECT_FALSE(map.contains(first));
+    EXPECT_LE(map.getCapacity(), static_cast<size_t>(TSlotMap<i32>::MinFreeSlots + 2));
+}
+
+TEST_F( TSlotMapTest, exhaustionTest ) {
+    TSlotMap<ui32> map;
+    for (ui32 i = 0; i < SlotHandle::IndexMask; ++i) {
+        ASSERT_TRUE(map.add(i).isValid());
+    }
+
+    // All slots are in use
+    EXPECT_FALSE(map.add(0).isValid());
+    EXPECT_EQ(static_cast<size_t>(SlotHandle::IndexMask), map.size());
+
+    // A removed slot will be reused at once
+    SlotHandle handle(7, 1);
+    EXPECT_TRUE(map.remove(handle));
+    SlotHandle reused = map.add(42);
+    EXPECT_EQ(7u, reused.getIndex());
+    EXPECT_EQ(42u, *map.find(reused));
+}
+
+TEST_F( TSlotMapTest, clearTest ) {
+    TSlotMap<i32> map;
+    SlotHandle handle = map.add(1);
+    map.add(2);
+    map.clear();
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_FALSE(map.contains(handle));
+    EXPECT_EQ(nullptr, map.find(handle));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
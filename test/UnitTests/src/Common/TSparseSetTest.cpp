@@ -0,0 +1,87 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Common/TSparseSet.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+
+class TSparseSetTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F( TSparseSetTest, addTest ) {
+    TSparseSet<i32> set;
+    EXPECT_TRUE(set.isEmpty());
+
+    set.add(10, 1);
+    set.add(2, 2);
+    EXPECT_EQ(2u, set.size());
+    EXPECT_TRUE(set.contains(10));
+    EXPECT_FALSE(set.contains(3));
+    EXPECT_FALSE(set.contains(100));
+    EXPECT_EQ(2, *set.find(2));
+
+    // Replace an existing value
+    set.add(10, 3);
+    EXPECT_EQ(2u, set.size());
+    EXPECT_EQ(3, *set.find(10));
+}
+
+TEST_F( TSparseSetTest, removeTest ) {
+    TSparseSet<i32> set;
+    for (ui32 i = 0; i < 8; ++i) {
+        set.add(i, static_cast<i32>(i) * 10);
+    }
+    EXPECT_TRUE(set.remove(2));
+    EXPECT_FALSE(set.remove(2));
+    EXPECT_EQ(7u, set.size());
+    EXPECT_EQ(nullptr, set.find(2));
+
+    // The last value was moved into the gap
+    EXPECT_EQ(70, *set.find(7));
+    EXPECT_EQ(7u, set.getKeyAt(2));
+    EXPECT_EQ(70, set.getAt(2));
+}
+
+TEST_F( TSparseSetTest, iterateTest ) {
+    TSparseSet<i32> set;
+    set.add(5, 5);
+    set.add(1, 1);
+    set.add(3, 3);
+    i32 sum = 0;
+    for (size_t i = 0; i < set.size(); ++i) {
+        EXPECT_EQ(static_cast<i32>(set.getKeyAt(i)), set.getAt(i));
+        sum += set.getAt(i);
+    }
+    EXPECT_EQ(9, sum);
+
+    set.clear();
+    EXPECT_TRUE(set.isEmpty());
+    EXPECT_FALSE(set.contains(5));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
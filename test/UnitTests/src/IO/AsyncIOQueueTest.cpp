@@ -0,0 +1,210 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/IO/AsyncIOQueue.h>
+#include <osre/IO/AbstractFileSystem.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::IO;
+
+static constexpr c8 TestFile[] = "async_io_test.bin";
+
+/// A file system which blocks the IO thread until it gets released.
+class GateFileSystem : public AbstractFileSystem {
+public:
+    GateFileSystem() : mLock(), mCondition(), mOpened(false), mReleased(false) {}
+    ~GateFileSystem() override {}
+
+    Stream *open(const Uri &, Stream::AccessMode) override {
+        std::unique_lock<std::mutex> lock(mLock);
+        mOpened = true;
+        mCondition.notify_all();
+        mCondition.wait(lock, [this]() { return mReleased; });
+        return nullptr;
+    }
+
+    void close(Stream **) override {}
+    bool fileExist(const Uri &) override { return true; }
+    Stream *find(const Uri &, Stream::AccessMode, StringArray *) override { return nullptr; }
+    const c8 *getSchema() const override { return "gate"; }
+    String getWorkingDirectory() override { return String(); }
+
+    void waitForOpen() {
+        std::unique_lock<std::mutex> lock(mLock);
+        mCondition.wait(lock, [this]() { return mOpened; });
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock(mLock);
+        mReleased = true;
+        mCondition.notify_all();
+    }
+
+private:
+    std::mutex mLock;
+    std::condition_variable mCondition;
+    bool mOpened;
+    bool mReleased;
+};
+
+class AsyncIOQueueTest : public ::testing::Test {
+protected:
+    void writeTestFile(size_t size) {
+        FILE *file = ::fopen(TestFile, "wb");
+        ASSERT_NE(nullptr, file);
+        for (size_t i = 0; i < size; ++i) {
+            ::fputc(static_cast<int>(i & 0xff), file);
+        }
+        ::fclose(file);
+    }
+
+    void TearDown() override {
+        ::remove(TestFile);
+    }
+};
+
+TEST_F(AsyncIOQueueTest, readTest) {
+    writeTestFile(100);
+    AsyncIOQueue queue(2);
+
+    size_t size = 0;
+    uc8 first = 0, last = 0;
+    AsyncIOStatus status = AsyncIOStatus::Pending;
+    const AsyncIORequestId id = queue.read(Uri(String("file://") + TestFile), nullptr,
+            [&](const AsyncIOResult &result) {
+                status = result.mStatus;
+                size = result.mSize;
+                first = result.mData[0];
+                last = result.mData[result.mSize - 1];
+            });
+    EXPECT_NE(InvalidAsyncIORequestId, id);
+
+    queue.wait(id);
+    EXPECT_TRUE(queue.getStatus(id, status));
+    EXPECT_EQ(AsyncIOStatus::Completed, status);
+    EXPECT_EQ(1u, queue.dispatchCompleted());
+    EXPECT_EQ(AsyncIOStatus::Completed, status);
+    EXPECT_EQ(100u, size);
+    EXPECT_EQ(0u, first);
+    EXPECT_EQ(99u, last);
+    EXPECT_FALSE(queue.getStatus(id, status));
+    EXPECT_EQ(0u, queue.getNumRequests());
+}
+
+TEST_F(AsyncIOQueueTest, readRangeTest) {
+    writeTestFile(64);
+    AsyncIOQueue queue(1);
+
+    size_t size = 0;
+    uc8 first = 0;
+    const AsyncIORequestId id = queue.read(Uri(String("file://") + TestFile), nullptr,
+            [&](const AsyncIOResult &result) {
+                size = result.mSize;
+                first = result.mData[0];
+            }, AsyncIOPriority::Normal, 10, 100);
+    queue.wait(id);
+    queue.dispatchCompleted();
+    EXPECT_EQ(54u, size);
+    EXPECT_EQ(10u, first);
+}
+
+TEST_F(AsyncIOQueueTest, missingFileTest) {
+    AsyncIOQueue queue(1);
+
+    AsyncIOResult received;
+    const AsyncIORequestId id = queue.read(Uri("file://not_existing_file.bin"), nullptr,
+            [&](const AsyncIOResult &result) { received = result; });
+    queue.wait(id);
+    queue.dispatchCompleted();
+    EXPECT_EQ(AsyncIOStatus::Failed, received.mStatus);
+    EXPECT_EQ(nullptr, received.mData);
+    EXPECT_EQ(0u, received.mSize);
+}
+
+TEST_F(AsyncIOQueueTest, priorityAndCancelTest) {
+    writeTestFile(16);
+    GateFileSystem gate;
+    AsyncIOQueue queue(1);
+
+    std::vector<AsyncIORequestId> order;
+    const AsyncIOCallback callback = [&](const AsyncIOResult &result) { order.push_back(result.mId); };
+
+    // Block the only IO thread, so the following requests stay pending
+    const AsyncIORequestId blocked = queue.read(Uri("gate://blocked"), &gate, callback);
+    gate.waitForOpen();
+
+    const Uri file(String("file://") + TestFile);
+    const AsyncIORequestId low = queue.read(file, nullptr, callback, AsyncIOPriority::Low);
+    const AsyncIORequestId cancelled = queue.read(file, nullptr, callback, AsyncIOPriority::Normal);
+    const AsyncIORequestId high = queue.read(file, nullptr, callback, AsyncIOPriority::High);
+
+    AsyncIOStatus status = AsyncIOStatus::Completed;
+    EXPECT_TRUE(queue.getStatus(low, status));
+    EXPECT_EQ(AsyncIOStatus::Pending, status);
+    EXPECT_TRUE(queue.cancel(cancelled));
+    EXPECT_TRUE(queue.getStatus(cancelled, status));
+    EXPECT_EQ(AsyncIOStatus::Cancelled, status);
+    EXPECT_FALSE(queue.cancel(cancelled));
+
+    gate.release();
+    queue.wait(blocked);
+    queue.wait(low);
+    queue.wait(high);
+    EXPECT_EQ(4u, queue.dispatchCompleted());
+
+    ASSERT_EQ(4u, order.size());
+    EXPECT_EQ(cancelled, order[0]);
+    EXPECT_EQ(blocked, order[1]);
+    EXPECT_EQ(high, order[2]);
+    EXPECT_EQ(low, order[3]);
+}
+
+TEST_F(AsyncIOQueueTest, bufferPoolTest) {
+    IOBufferPool pool;
+    size_t capacity = 0;
+    uc8 *buffer = pool.acquire(10, capacity);
+    ASSERT_NE(nullptr, buffer);
+    EXPECT_EQ(IOBufferPool::MinBufferSize, capacity);
+    pool.release(buffer, capacity);
+    EXPECT_EQ(1u, pool.getNumFreeBuffers());
+
+    size_t reusedCapacity = 0;
+    EXPECT_EQ(buffer, pool.acquire(100, reusedCapacity));
+    EXPECT_EQ(capacity, reusedCapacity);
+    EXPECT_EQ(0u, pool.getNumFreeBuffers());
+    pool.release(buffer, reusedCapacity);
+
+    uc8 *large = pool.acquire(IOBufferPool::MinBufferSize + 1, capacity);
+    EXPECT_EQ(IOBufferPool::MinBufferSize * 2, capacity);
+    pool.release(large, capacity);
+    EXPECT_EQ(2u, pool.getNumFreeBuffers());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
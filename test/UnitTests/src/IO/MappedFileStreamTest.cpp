@@ -0,0 +1,134 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "src/Engine/IO/LocaleFileSystem.h"
+#include "src/Engine/IO/MappedFileStream.h"
+
+#include <cstdio>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::IO;
+
+static constexpr c8 TestFile[] = "mapped_stream_test.bin";
+
+class MappedFileStreamTest : public ::testing::Test {
+protected:
+    void writeTestFile(size_t size) {
+        FILE *file = ::fopen(TestFile, "wb");
+        ASSERT_NE(nullptr, file);
+        for (size_t i = 0; i < size; ++i) {
+            ::fputc(static_cast<int>(i & 0xff), file);
+        }
+        ::fclose(file);
+    }
+
+    void TearDown() override {
+        ::remove(TestFile);
+    }
+};
+
+TEST_F(MappedFileStreamTest, mapTest) {
+    writeTestFile(256);
+    MappedFileStream stream(Uri(String("file://") + TestFile), Stream::AccessMode::ReadAccessBinary);
+    EXPECT_TRUE(stream.canBeMapped());
+    EXPECT_FALSE(stream.canWrite());
+    ASSERT_TRUE(stream.open());
+    EXPECT_TRUE(stream.isOpen());
+    EXPECT_EQ(256u, stream.getSize());
+
+    const uc8 *data = stream.getMappedData();
+    ASSERT_NE(nullptr, data);
+    EXPECT_EQ(0u, data[0]);
+    EXPECT_EQ(255u, data[255]);
+
+    EXPECT_EQ(data + 16, stream.getView(16, 32));
+    EXPECT_EQ(data, stream.getView(0, 256));
+    EXPECT_EQ(nullptr, stream.getView(250, 7));
+    EXPECT_EQ(nullptr, stream.getView(257, 0));
+
+    EXPECT_TRUE(stream.close());
+    EXPECT_EQ(nullptr, stream.getMappedData());
+}
+
+TEST_F(MappedFileStreamTest, readSeekTest) {
+    writeTestFile(16);
+    MappedFileStream stream(Uri(String("file://") + TestFile), Stream::AccessMode::ReadAccessBinary);
+    ASSERT_TRUE(stream.open());
+
+    uc8 buffer[8] = {};
+    EXPECT_EQ(8u, stream.read(buffer, 8));
+    EXPECT_EQ(7u, buffer[7]);
+    EXPECT_EQ(8u, stream.tell());
+
+    ui32 value = 0;
+    EXPECT_EQ(1u, stream.readUI32(value));
+    EXPECT_EQ(12u, stream.tell());
+
+    EXPECT_EQ(2u, stream.seek(2, Stream::Origin::Begin));
+    EXPECT_EQ(5u, stream.seek(3, Stream::Origin::Current));
+    EXPECT_EQ(12u, stream.seek(4, Stream::Origin::End));
+
+    // Reads are clamped at the end of the file
+    EXPECT_EQ(4u, stream.read(buffer, 8));
+    EXPECT_EQ(15u, buffer[3]);
+    EXPECT_EQ(0u, stream.readUI32(value));
+}
+
+TEST_F(MappedFileStreamTest, emptyFileTest) {
+    writeTestFile(0);
+    MappedFileStream stream(Uri(String("file://") + TestFile), Stream::AccessMode::ReadAccessBinary);
+    ASSERT_TRUE(stream.open());
+    EXPECT_EQ(0u, stream.getSize());
+    EXPECT_EQ(nullptr, stream.getMappedData());
+    uc8 buffer[4] = {};
+    EXPECT_EQ(0u, stream.read(buffer, 4));
+}
+
+TEST_F(MappedFileStreamTest, writeAccessFailsTest) {
+    writeTestFile(16);
+    MappedFileStream stream(Uri(String("file://") + TestFile), Stream::AccessMode::WriteAccessBinary);
+    EXPECT_FALSE(stream.open());
+}
+
+TEST_F(MappedFileStreamTest, localeFileSystemTest) {
+    writeTestFile(LocaleFileSystem::MappedStreamThreshold);
+    LocaleFileSystem fileSystem;
+    const Uri uri(String("file://") + TestFile);
+
+    Stream *stream = fileSystem.open(uri, Stream::AccessMode::ReadAccessBinary);
+    ASSERT_NE(nullptr, stream);
+    EXPECT_TRUE(stream->canBeMapped());
+    EXPECT_NE(nullptr, stream->getMappedData());
+    fileSystem.close(&stream);
+
+    stream = fileSystem.open(uri, Stream::AccessMode::ReadAccess);
+    ASSERT_NE(nullptr, stream);
+    EXPECT_FALSE(stream->canBeMapped());
+    EXPECT_EQ(nullptr, stream->getMappedData());
+    fileSystem.close(&stream);
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
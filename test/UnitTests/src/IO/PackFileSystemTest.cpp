@@ -0,0 +1,183 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "src/Engine/IO/PackFileSystem.h"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::IO;
+
+static constexpr c8 TestPack[] = "pack_filesystem_test.pack";
+static constexpr c8 OtherPack[] = "pack_filesystem_test2.pack";
+
+class PackFileSystemTest : public ::testing::Test {
+protected:
+    static std::vector<uc8> makeData(size_t size, uc8 seed) {
+        std::vector<uc8> data(size);
+        ui32 state = seed;
+        for (size_t i = 0; i < size; ++i) {
+            state = state * 1664525u + 1013904223u;
+            data[i] = static_cast<uc8>(state >> 24);
+        }
+        return data;
+    }
+
+    static std::vector<uc8> readFile(const c8 *name) {
+        std::vector<uc8> content;
+        FILE *file = ::fopen(name, "rb");
+        if (nullptr != file) {
+            for (int c = ::fgetc(file); EOF != c; c = ::fgetc(file)) {
+                content.push_back(static_cast<uc8>(c));
+            }
+            ::fclose(file);
+        }
+        return content;
+    }
+
+    void SetUp() override {
+        mRandom = makeData(10000, 3);
+        mZeros.assign(20000, 0);
+        mSmall = makeData(17, 5);
+        ASSERT_TRUE(mWriter.addFile("textures/random.bin", &mRandom[0], mRandom.size(), true));
+        ASSERT_TRUE(mWriter.addFile("zeros.bin", &mZeros[0], mZeros.size(), true));
+        ASSERT_TRUE(mWriter.addFile("small.txt", &mSmall[0], mSmall.size(), false));
+        ASSERT_TRUE(mWriter.addFile("empty.txt", nullptr, 0, false));
+        ASSERT_TRUE(mWriter.write(Uri(String("file://") + TestPack)));
+    }
+
+    void TearDown() override {
+        ::remove(TestPack);
+        ::remove(OtherPack);
+    }
+
+    PackWriter mWriter;
+    std::vector<uc8> mRandom, mZeros, mSmall;
+};
+
+TEST_F(PackFileSystemTest, writerTest) {
+    EXPECT_EQ(4u, mWriter.getNumFiles());
+    EXPECT_FALSE(mWriter.addFile("zeros.bin", &mZeros[0], 10, false));
+    EXPECT_FALSE(mWriter.addFile("", &mZeros[0], 10, false));
+
+    // The layout does not depend on the order of the add calls
+    PackWriter other;
+    EXPECT_TRUE(other.addFile("empty.txt", nullptr, 0, false));
+    EXPECT_TRUE(other.addFile("small.txt", &mSmall[0], mSmall.size(), false));
+    EXPECT_TRUE(other.addFile("zeros.bin", &mZeros[0], mZeros.size(), true));
+    EXPECT_TRUE(other.addFile("textures\\random.bin", &mRandom[0], mRandom.size(), true));
+    EXPECT_TRUE(other.write(Uri(String("file://") + OtherPack)));
+    EXPECT_EQ(readFile(TestPack), readFile(OtherPack));
+}
+
+TEST_F(PackFileSystemTest, tableTest) {
+    PackFileSystem fileSystem(Uri(String("file://") + TestPack));
+    ASSERT_TRUE(fileSystem.isOpened());
+    EXPECT_STREQ("pack", fileSystem.getSchema());
+    EXPECT_TRUE(fileSystem.supportsConcurrentReads());
+
+    std::vector<String> files;
+    fileSystem.getFileList(files);
+    EXPECT_EQ(4u, files.size());
+
+    const PackEntry *zeros = fileSystem.getEntry("zeros.bin");
+    ASSERT_NE(nullptr, zeros);
+    EXPECT_EQ(PackEntryCompressed, zeros->mFlags);
+    EXPECT_LT(zeros->mSize, zeros->mUncompressedSize);
+    EXPECT_EQ(0u, zeros->mOffset % PackAlignment);
+
+    // Random data does not shrink and is stored
+    const PackEntry *random = fileSystem.getEntry("textures/random.bin");
+    ASSERT_NE(nullptr, random);
+    EXPECT_EQ(0u, random->mFlags);
+    EXPECT_EQ(mRandom.size(), random->mSize);
+    EXPECT_EQ(0u, random->mOffset % PackAlignment);
+
+    EXPECT_EQ(nullptr, fileSystem.getEntry("missing.bin"));
+    EXPECT_TRUE(fileSystem.fileExist(Uri("pack://textures/random.bin")));
+    EXPECT_TRUE(fileSystem.fileExist(Uri("pack://small.txt")));
+    EXPECT_FALSE(fileSystem.fileExist(Uri("pack://random.bin")));
+}
+
+TEST_F(PackFileSystemTest, zeroCopyTest) {
+    PackFileSystem fileSystem(Uri(String("file://") + TestPack));
+    EXPECT_EQ(nullptr, fileSystem.open(Uri("pack://small.txt"), Stream::AccessMode::WriteAccess));
+
+    Stream *stream = fileSystem.open(Uri("pack://textures/random.bin"), Stream::AccessMode::ReadAccessBinary);
+    ASSERT_NE(nullptr, stream);
+    EXPECT_EQ(mRandom.size(), stream->getSize());
+    const uc8 *data = stream->getMappedData();
+    ASSERT_NE(nullptr, data);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(data) % PackAlignment);
+    EXPECT_EQ(0, ::memcmp(&mRandom[0], data, mRandom.size()));
+
+    // A second stream of the same file shares the mapping
+    Stream *other = fileSystem.open(Uri("pack://textures/random.bin"), Stream::AccessMode::ReadAccess);
+    ASSERT_NE(nullptr, other);
+    EXPECT_NE(stream, other);
+    EXPECT_EQ(data, other->getMappedData());
+    fileSystem.close(&other);
+    EXPECT_EQ(nullptr, other);
+
+    uc8 buffer[8] = {};
+    EXPECT_EQ(8u, stream->read(buffer, 8));
+    EXPECT_EQ(mRandom[7], buffer[7]);
+    fileSystem.close(&stream);
+
+    stream = fileSystem.open(Uri("pack://empty.txt"), Stream::AccessMode::ReadAccess);
+    ASSERT_NE(nullptr, stream);
+    EXPECT_EQ(0u, stream->getSize());
+    fileSystem.close(&stream);
+}
+
+TEST_F(PackFileSystemTest, compressedTest) {
+    PackFileSystem fileSystem(Uri(String("file://") + TestPack));
+    Stream *stream = fileSystem.open(Uri("pack://zeros.bin"), Stream::AccessMode::ReadAccess);
+    ASSERT_NE(nullptr, stream);
+    ASSERT_EQ(mZeros.size(), stream->getSize());
+    std::vector<uc8> buffer(stream->getSize(), 1);
+    EXPECT_EQ(buffer.size(), stream->read(&buffer[0], buffer.size()));
+    EXPECT_EQ(mZeros, buffer);
+    fileSystem.close(&stream);
+}
+
+TEST_F(PackFileSystemTest, invalidPackTest) {
+    FILE *file = ::fopen(OtherPack, "wb");
+    ASSERT_NE(nullptr, file);
+    const std::vector<uc8> garbage = makeData(256, 9);
+    ::fwrite(&garbage[0], 1, garbage.size(), file);
+    ::fclose(file);
+
+    PackFileSystem fileSystem(Uri(String("file://") + OtherPack));
+    EXPECT_FALSE(fileSystem.isOpened());
+    EXPECT_EQ(nullptr, fileSystem.open(Uri("pack://small.txt"), Stream::AccessMode::ReadAccess));
+
+    PackFileSystem missing(Uri("file://not_existing.pack"));
+    EXPECT_FALSE(missing.isOpened());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
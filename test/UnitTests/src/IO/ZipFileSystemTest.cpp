@@ -0,0 +1,237 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "src/Engine/IO/ZipFileSystem.h"
+
+#include <cstdio>
+#include <thread>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::IO;
+
+static constexpr c8 TestArchive[] = "zip_filesystem_test.zip";
+
+class ZipFileSystemTest : public ::testing::Test {
+protected:
+    struct TestEntry {
+        String mName;
+        std::vector<uc8> mData;
+        ui32 mOffset;
+    };
+
+    static ui32 crc32(const std::vector<uc8> &data) {
+        ui32 crc = 0xffffffffu;
+        for (uc8 c : data) {
+            crc ^= c;
+            for (i32 i = 0; i < 8; ++i) {
+                crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1u)));
+            }
+        }
+        return ~crc;
+    }
+
+    static void put16(std::vector<uc8> &out, ui32 value) {
+        out.push_back(static_cast<uc8>(value & 0xff));
+        out.push_back(static_cast<uc8>((value >> 8) & 0xff));
+    }
+
+    static void put32(std::vector<uc8> &out, ui32 value) {
+        put16(out, value & 0xffff);
+        put16(out, value >> 16);
+    }
+
+    static void putHeader(std::vector<uc8> &out, const TestEntry &entry, bool central) {
+        const ui32 size = static_cast<ui32>(entry.mData.size());
+        put32(out, central ? 0x02014b50 : 0x04034b50);
+        if (central) {
+            put16(out, 20);
+        }
+        put16(out, 10);     // version needed
+        put16(out, 0);      // flags
+        put16(out, 0);      // stored
+        put16(out, 0);      // time
+        put16(out, 0x21);   // date
+        put32(out, crc32(entry.mData));
+        put32(out, size);
+        put32(out, size);
+        put16(out, static_cast<ui32>(entry.mName.size()));
+        put16(out, 0);      // extra field
+        if (central) {
+            put16(out, 0);  // comment
+            put16(out, 0);  // disk
+            put16(out, 0);  // internal attributes
+            put32(out, 0);  // external attributes
+            put32(out, entry.mOffset);
+        }
+        out.insert(out.end(), entry.mName.begin(), entry.mName.end());
+    }
+
+    /// Writes an archive with uncompressed entries.
+    void writeArchive(std::vector<TestEntry> &entries) {
+        std::vector<uc8> out;
+        for (TestEntry &entry : entries) {
+            entry.mOffset = static_cast<ui32>(out.size());
+            putHeader(out, entry, false);
+            out.insert(out.end(), entry.mData.begin(), entry.mData.end());
+        }
+        const ui32 directoryOffset = static_cast<ui32>(out.size());
+        for (const TestEntry &entry : entries) {
+            putHeader(out, entry, true);
+        }
+        const ui32 directorySize = static_cast<ui32>(out.size()) - directoryOffset;
+        put32(out, 0x06054b50);
+        put16(out, 0);
+        put16(out, 0);
+        put16(out, static_cast<ui32>(entries.size()));
+        put16(out, static_cast<ui32>(entries.size()));
+        put32(out, directorySize);
+        put32(out, directoryOffset);
+        put16(out, 0);
+
+        FILE *file = ::fopen(TestArchive, "wb");
+        ASSERT_NE(nullptr, file);
+        ::fwrite(&out[0], 1, out.size(), file);
+        ::fclose(file);
+    }
+
+    static std::vector<uc8> makeData(size_t size, uc8 seed) {
+        std::vector<uc8> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<uc8>(seed + i);
+        }
+        return data;
+    }
+
+    void SetUp() override {
+        mEntries.push_back({ "b.txt", makeData(100, 1), 0 });
+        mEntries.push_back({ "a.bin", makeData(5000, 7), 0 });
+        mEntries.push_back({ "data/c.bin", makeData(33, 3), 0 });
+        writeArchive(mEntries);
+    }
+
+    void TearDown() override {
+        ::remove(TestArchive);
+    }
+
+    std::vector<TestEntry> mEntries;
+};
+
+TEST_F(ZipFileSystemTest, indexTest) {
+    ZipFileSystem fileSystem(Uri(String("file://") + TestArchive));
+    EXPECT_TRUE(fileSystem.supportsConcurrentReads());
+
+    std::vector<String> fileList;
+    fileSystem.getFileList(fileList);
+    ASSERT_EQ(3u, fileList.size());
+    EXPECT_EQ("a.bin", fileList[0]);
+    EXPECT_EQ("b.txt", fileList[1]);
+    EXPECT_EQ("data/c.bin", fileList[2]);
+
+    EXPECT_TRUE(fileSystem.fileExist(Uri("zip://a.bin")));
+    EXPECT_TRUE(fileSystem.fileExist(Uri("zip://data/c.bin")));
+    EXPECT_FALSE(fileSystem.fileExist(Uri("zip://missing.bin")));
+
+    const ZipEntry *entry = fileSystem.getEntry("a.bin");
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(5000u, entry->mSize);
+    EXPECT_EQ(5000u, entry->mCompressedSize);
+    EXPECT_EQ(nullptr, fileSystem.getEntry("missing.bin"));
+}
+
+TEST_F(ZipFileSystemTest, readStreamTest) {
+    ZipFileSystem fileSystem(Uri(String("file://") + TestArchive));
+    EXPECT_EQ(nullptr, fileSystem.open(Uri("zip://b.txt"), Stream::AccessMode::WriteAccess));
+
+    Stream *stream = fileSystem.open(Uri("zip://b.txt"), Stream::AccessMode::ReadAccess);
+    ASSERT_NE(nullptr, stream);
+    EXPECT_EQ(100u, stream->getSize());
+
+    std::vector<uc8> buffer(stream->getSize());
+    EXPECT_EQ(100u, stream->read(&buffer[0], buffer.size()));
+    EXPECT_EQ(mEntries[0].mData, buffer);
+
+    // Partial reads will not write behind the buffer
+    uc8 small[10] = {};
+    EXPECT_EQ(10u, stream->read(small, 10));
+    EXPECT_EQ(mEntries[0].mData[9], small[9]);
+
+    // Every open returns an own stream
+    Stream *other = fileSystem.open(Uri("zip://b.txt"), Stream::AccessMode::ReadAccess);
+    ASSERT_NE(nullptr, other);
+    EXPECT_NE(stream, other);
+    fileSystem.close(&other);
+
+    fileSystem.close(&stream);
+    EXPECT_EQ(nullptr, stream);
+
+    // Closing a stream keeps the archive open
+    stream = fileSystem.open(Uri("zip://data/c.bin"), Stream::AccessMode::ReadAccessBinary);
+    ASSERT_NE(nullptr, stream);
+    std::vector<uc8> large(100);
+    EXPECT_EQ(33u, stream->read(&large[0], large.size()));
+    EXPECT_EQ(mEntries[2].mData[32], large[32]);
+    fileSystem.close(&stream);
+}
+
+TEST_F(ZipFileSystemTest, concurrentReadTest) {
+    ZipFileSystem fileSystem(Uri(String("file://") + TestArchive));
+    const ZipEntry *entry = fileSystem.getEntry("a.bin");
+    ASSERT_NE(nullptr, entry);
+
+    bool equal[4] = { false, false, false, false };
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i]() {
+            std::vector<uc8> buffer(entry->mSize);
+            bool ok = true;
+            for (i32 j = 0; j < 20; ++j) {
+                ok &= buffer.size() == fileSystem.readEntry(*entry, &buffer[0], buffer.size());
+                ok &= mEntries[1].mData == buffer;
+            }
+            equal[i] = ok;
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (bool ok : equal) {
+        EXPECT_TRUE(ok);
+    }
+}
+
+TEST_F(ZipFileSystemTest, readFilesTest) {
+    ZipFileSystem fileSystem(Uri(String("file://") + TestArchive));
+    std::vector<String> files = { "a.bin", "missing.bin", "data/c.bin", "b.txt" };
+    std::vector<std::vector<uc8>> data;
+    EXPECT_EQ(3u, fileSystem.readFiles(files, data));
+    ASSERT_EQ(4u, data.size());
+    EXPECT_EQ(mEntries[1].mData, data[0]);
+    EXPECT_TRUE(data[1].empty());
+    EXPECT_EQ(mEntries[2].mData, data[2]);
+    EXPECT_EQ(mEntries[0].mData, data[3]);
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
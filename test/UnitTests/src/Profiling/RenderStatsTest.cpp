@@ -0,0 +1,139 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/Profiling/PerformanceCounterRegistry.h>
+#include <osre/Profiling/RenderStats.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Profiling;
+
+class RenderStatsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        RenderStats::reset();
+    }
+
+    void TearDown() override {
+        RenderStats::reset();
+    }
+};
+
+TEST_F(RenderStatsTest, emptySnapshotTest) {
+    RenderStatsSnapshot snapshot;
+    RenderStats::getSnapshot(snapshot);
+    EXPECT_EQ(0u, snapshot.mFrame);
+    EXPECT_EQ(0u, snapshot.mTotal.mDrawCalls);
+    EXPECT_EQ(0u, snapshot.mNumPasses);
+}
+
+TEST_F(RenderStatsTest, frameCountersTest) {
+    RenderStats::addBufferUpload(128);
+    RenderStats::addSubmitCmd(64);
+    RenderStats::beginPass(2);
+    RenderStats::addShaderBind();
+    RenderStats::addTextureBind();
+    RenderStats::addVertexArrayBind();
+    RenderStats::addUniformUpload();
+    RenderStats::addDrawCall(1, 12);
+    RenderStats::addDrawCall(4, 2);
+    RenderStats::endPass();
+    RenderStats::endFrame();
+
+    RenderStatsSnapshot snapshot;
+    RenderStats::getSnapshot(snapshot);
+    EXPECT_EQ(1u, snapshot.mFrame);
+    EXPECT_EQ(2u, snapshot.mTotal.mDrawCalls);
+    EXPECT_EQ(5u, snapshot.mTotal.mInstances);
+    EXPECT_EQ(20u, snapshot.mTotal.mTriangles);
+    EXPECT_EQ(1u, snapshot.mTotal.mShaderBinds);
+    EXPECT_EQ(1u, snapshot.mTotal.mTextureBinds);
+    EXPECT_EQ(1u, snapshot.mTotal.mVertexArrayBinds);
+    EXPECT_EQ(1u, snapshot.mTotal.mUniformUploads);
+    EXPECT_EQ(128u, snapshot.mTotal.mBufferBytesUploaded);
+    EXPECT_EQ(1u, snapshot.mSubmitCmds);
+    EXPECT_EQ(64u, snapshot.mSubmitCmdBytes);
+
+    // The upload was done outside of the pass
+    ASSERT_EQ(1u, snapshot.mNumPasses);
+    EXPECT_EQ(2u, snapshot.mPassIds[0]);
+    EXPECT_EQ(2u, snapshot.mPasses[0].mDrawCalls);
+    EXPECT_EQ(0u, snapshot.mPasses[0].mBufferBytesUploaded);
+}
+
+TEST_F(RenderStatsTest, countersResetPerFrameTest) {
+    RenderStats::addDrawCall(1, 1);
+    RenderStats::endFrame();
+    RenderStats::endFrame();
+
+    RenderStatsSnapshot snapshot;
+    RenderStats::getSnapshot(snapshot);
+    EXPECT_EQ(2u, snapshot.mFrame);
+    EXPECT_EQ(0u, snapshot.mTotal.mDrawCalls);
+}
+
+TEST_F(RenderStatsTest, passLimitTest) {
+    for (ui32 i = 0; i < MaxRenderStatsPasses + 2; ++i) {
+        RenderStats::beginPass(i);
+        RenderStats::addDrawCall(1, 1);
+        RenderStats::endPass();
+    }
+    RenderStats::endFrame();
+
+    RenderStatsSnapshot snapshot;
+    RenderStats::getSnapshot(snapshot);
+    EXPECT_EQ(MaxRenderStatsPasses, snapshot.mNumPasses);
+    EXPECT_EQ(MaxRenderStatsPasses + 2, snapshot.mTotal.mDrawCalls);
+}
+
+TEST_F(RenderStatsTest, publishToRegistryTest) {
+    EXPECT_TRUE(PerformanceCounterRegistry::create());
+    RenderStats::registerCounters();
+    RenderStats::addDrawCall(3, 1);
+    RenderStats::endFrame();
+
+    ui32 value = 0;
+    EXPECT_TRUE(PerformanceCounterRegistry::queryCounter("draw_calls", value));
+    EXPECT_EQ(1u, value);
+    EXPECT_TRUE(PerformanceCounterRegistry::queryCounter("instances", value));
+    EXPECT_EQ(3u, value);
+    EXPECT_TRUE(PerformanceCounterRegistry::destroy());
+}
+
+TEST_F(RenderStatsTest, toStringTest) {
+    RenderStats::beginPass(0);
+    RenderStats::addDrawCall(1, 2);
+    RenderStats::endPass();
+    RenderStats::endFrame();
+
+    RenderStatsSnapshot snapshot;
+    RenderStats::getSnapshot(snapshot);
+    String text;
+    RenderStats::toString(snapshot, text);
+    EXPECT_NE(String::npos, text.find("Draws 1"));
+    EXPECT_NE(String::npos, text.find("Pass 0"));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
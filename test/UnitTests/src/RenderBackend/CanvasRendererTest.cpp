@@ -0,0 +1,155 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/RenderBackend/CanvasRenderer.h>
+#include <osre/RenderBackend/SpriteAtlas.h>
+#include <osre/RenderBackend/MaterialBuilder.h>
+#include <osre/RenderBackend/RenderBackendService.h>
+#include <osre/RenderBackend/RenderPass.h>
+#include <osre/RenderBackend/Mesh.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class CanvasRendererTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        MaterialBuilder::create();
+        mRbSrv = new RenderBackendService;
+        mTexture.m_textureName = "canvas_test";
+        mTexture.m_width = 64;
+        mTexture.m_height = 32;
+    }
+
+    void TearDown() override {
+        delete mRbSrv;
+        MaterialBuilder::destroy();
+    }
+
+    Mesh *getSlotMesh(CanvasRenderer &canvas, ui32 slot) {
+        PassData *pass = mRbSrv->getPassById(RenderPass::getPassNameById(UiPassId));
+        RenderBatchData *batch = nullptr != pass ? pass->getBatchById(canvas.getCanvasRenderBatchName(slot)) : nullptr;
+        if (nullptr == batch || batch->m_meshArray.isEmpty()) {
+            return nullptr;
+        }
+        return batch->m_meshArray[0]->mMeshArray[0];
+    }
+
+    RenderBackendService *mRbSrv = nullptr;
+    Texture mTexture;
+};
+
+TEST_F(CanvasRendererTest, spriteAtlasTest) {
+    SpriteAtlas atlas(&mTexture);
+    EXPECT_TRUE(atlas.addRegion("ship", Rect2ui(16, 0, 16, 8)));
+    EXPECT_FALSE(atlas.addRegion("ship", Rect2ui(0, 0, 16, 8)));
+    EXPECT_FALSE(atlas.addRegion("outside", Rect2ui(60, 0, 16, 8)));
+
+    // The rows of the texture are stored bottom up
+    const SpriteRegion *region = atlas.findRegion("ship");
+    ASSERT_NE(nullptr, region);
+    EXPECT_FLOAT_EQ(0.25f, region->mUv0.x);
+    EXPECT_FLOAT_EQ(0.75f, region->mUv0.y);
+    EXPECT_FLOAT_EQ(0.5f, region->mUv1.x);
+    EXPECT_FLOAT_EQ(1.0f, region->mUv1.y);
+    EXPECT_EQ(nullptr, atlas.findRegion("rock"));
+
+    atlas.addGrid("cell", 4, 2);
+    EXPECT_EQ(9u, atlas.getNumRegions());
+    EXPECT_NE(nullptr, atlas.findRegion("cell7"));
+}
+
+TEST_F(CanvasRendererTest, clipTest) {
+    CanvasRenderer canvas(mRbSrv);
+    canvas.setClipRect(0, 0, 100, 100);
+    canvas.drawRect(200, 200, 10, 10);
+    canvas.drawLine(-10, 200, 300, 200);
+    EXPECT_EQ(0u, canvas.getNumQuads());
+
+    canvas.drawRect(90, 90, 20, 20);
+    canvas.drawLine(-10, 50, 300, 50);
+    EXPECT_EQ(2u, canvas.getNumQuads());
+
+    canvas.resetClipRect();
+    canvas.drawRect(10, 10, 20, 20, false);
+    EXPECT_EQ(6u, canvas.getNumQuads());
+
+    canvas.clear();
+    EXPECT_EQ(0u, canvas.getNumQuads());
+}
+
+TEST_F(CanvasRendererTest, batchTest) {
+    SpriteAtlas atlas(&mTexture);
+    atlas.addGrid("cell", 4, 2);
+
+    CanvasRenderer canvas(mRbSrv);
+    canvas.drawRect(0, 0, 10, 10);
+    canvas.drawSprite(10, 0, atlas, "cell0");
+    canvas.drawRect(20, 0, 10, 10);
+    canvas.setLayer(1);
+    canvas.drawSprite(30, 0, atlas, "cell1", 2.0f);
+    EXPECT_FALSE(canvas.drawSprite(40, 0, atlas, "unknown"));
+    EXPECT_EQ(4u, canvas.getNumQuads());
+
+    // The rects of layer 0 and the sprites of both layers will be merged
+    canvas.render();
+    EXPECT_EQ(2u, canvas.getNumBatches());
+    EXPECT_EQ(0u, canvas.getNumQuads());
+
+    canvas.setLayer(0);
+    for (ui32 i = 0; i < CanvasRenderer::BatchCapacity + 1; ++i) {
+        canvas.drawTexturedQuad(i, 0, 1, 1, &mTexture);
+    }
+    canvas.render();
+    EXPECT_EQ(2u, canvas.getNumBatches());
+}
+
+TEST_F(CanvasRendererTest, slotReuseTest) {
+    CanvasRenderer canvas(mRbSrv);
+    canvas.drawRect(0, 0, 10, 10);
+    canvas.drawRect(20, 0, 10, 10);
+    canvas.drawTexturedQuad(40, 0, 10, 10, &mTexture);
+    canvas.render();
+    ASSERT_EQ(2u, canvas.getNumBatches());
+    Mesh *first = getSlotMesh(canvas, 0);
+    Mesh *second = getSlotMesh(canvas, 1);
+    ASSERT_NE(nullptr, first);
+    ASSERT_NE(nullptr, second);
+    EXPECT_EQ(12u, first->getPrimitiveGroupAt(0)->m_numIndices);
+    EXPECT_EQ(6u, second->getPrimitiveGroupAt(0)->m_numIndices);
+    Material *textured = second->getMaterial();
+
+    // The first slot keeps its mesh and gets the material of the new texture
+    canvas.drawTexturedQuad(0, 0, 10, 10, &mTexture);
+    canvas.render();
+    EXPECT_EQ(1u, canvas.getNumBatches());
+    EXPECT_EQ(first, getSlotMesh(canvas, 0));
+    EXPECT_EQ(textured, first->getMaterial());
+    EXPECT_EQ(6u, first->getPrimitiveGroupAt(0)->m_numIndices);
+    EXPECT_EQ(0u, second->getPrimitiveGroupAt(0)->m_numIndices);
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
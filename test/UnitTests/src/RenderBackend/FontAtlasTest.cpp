@@ -0,0 +1,73 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/RenderBackend/FontAtlas.h>
+#include <osre/IO/Uri.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class FontAtlasTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(FontAtlasTest, gridGlyphTest) {
+    FontAtlas font("test_font");
+    font.createGrid(IO::Uri("file://assets/Textures/Fonts/buildin_arial.bmp"), 16, 16, 20.0f);
+    EXPECT_FLOAT_EQ(20.0f, font.getPixelHeight());
+    EXPECT_EQ(nullptr, font.getTexture());
+
+    const Glyph *glyph = font.getGlyph('A');
+    ASSERT_NE(nullptr, glyph);
+    EXPECT_FLOAT_EQ(1.0f / 16.0f, glyph->mUv0.x);
+    EXPECT_FLOAT_EQ(1.0f - 5.0f / 16.0f, glyph->mUv0.y);
+    EXPECT_FLOAT_EQ(20.0f, glyph->mAdvance);
+    EXPECT_EQ(nullptr, font.getGlyph(256));
+    EXPECT_FLOAT_EQ(0.0f, font.getKerning('A', 'V'));
+}
+
+TEST_F(FontAtlasTest, layoutTextTest) {
+    FontAtlas font("test_font");
+    font.createGrid(IO::Uri("file://assets/Textures/Fonts/buildin_arial.bmp"), 16, 16, 20.0f);
+
+    // Blanks and line breaks need no quad
+    cppcore::TArray<RenderVert> vertices;
+    EXPECT_EQ(3u, font.layoutText("a b\nc", glm::vec2(10, 100), 10.0f, glm::vec3(1, 0, 0), vertices));
+    ASSERT_EQ(12u, vertices.size());
+    EXPECT_FLOAT_EQ(10.0f, vertices[0].position.x);
+    EXPECT_FLOAT_EQ(100.0f, vertices[0].position.y);
+    EXPECT_FLOAT_EQ(110.0f, vertices[1].position.y);
+    EXPECT_FLOAT_EQ(30.0f, vertices[4].position.x);
+    EXPECT_FLOAT_EQ(10.0f, vertices[8].position.x);
+    EXPECT_FLOAT_EQ(90.0f, vertices[8].position.y);
+    EXPECT_FLOAT_EQ(1.0f, vertices[11].color0.x);
+
+    const glm::vec2 extent = font.measureText("a b\nc", 10.0f);
+    EXPECT_FLOAT_EQ(30.0f, extent.x);
+    EXPECT_FLOAT_EQ(20.0f, extent.y);
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,146 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/RenderBackend/MaterialBuilder.h>
+#include <osre/RenderBackend/Shader.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class MaterialBuilderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        MaterialBuilder::create();
+        mTexture.m_textureName = "material_test";
+        mTexture.m_width = 4;
+        mTexture.m_height = 4;
+    }
+
+    void TearDown() override {
+        MaterialBuilder::destroy();
+    }
+
+    Texture mTexture;
+};
+
+TEST_F(MaterialBuilderTest, buildinCacheTest) {
+    Material *colorMat = MaterialBuilder::createBuildinMaterial(VertexType::ColorVertex);
+    ASSERT_NE(nullptr, colorMat);
+    EXPECT_EQ(colorMat, MaterialBuilder::createBuildinMaterial(VertexType::ColorVertex));
+
+    // Each vertex type needs its own shader setup
+    Material *renderMat = MaterialBuilder::createBuildinMaterial(VertexType::RenderVertex);
+    ASSERT_NE(nullptr, renderMat);
+    EXPECT_NE(colorMat, renderMat);
+
+    MaterialCacheStats stats = MaterialBuilder::getCacheStats();
+    EXPECT_EQ(1u, stats.mHits);
+    EXPECT_EQ(2u, stats.mMisses);
+    EXPECT_EQ(2u, stats.mNumMaterials);
+    EXPECT_EQ(2u, MaterialBuilder::getRefCount(colorMat));
+}
+
+TEST_F(MaterialBuilderTest, textureDedupTest) {
+    Material *mat1 = MaterialBuilder::createTexturedMaterial("first", &mTexture, VertexType::RenderVertex);
+    Material *mat2 = MaterialBuilder::createTexturedMaterial("second", &mTexture, VertexType::RenderVertex);
+    ASSERT_NE(nullptr, mat1);
+    EXPECT_EQ(mat1, mat2);
+    EXPECT_EQ("first", mat1->m_name);
+
+    Texture other;
+    Material *mat3 = MaterialBuilder::createTexturedMaterial("first", &other, VertexType::RenderVertex);
+    EXPECT_NE(mat1, mat3);
+
+    Material *canvasMat = MaterialBuilder::createCanvasMaterial("canvas", &mTexture);
+    EXPECT_NE(mat1, canvasMat);
+}
+
+TEST_F(MaterialBuilderTest, releaseTest) {
+    Material *mat = MaterialBuilder::createTexturedMaterial("tex", &mTexture, VertexType::RenderVertex);
+    MaterialBuilder::createTexturedMaterial("tex", &mTexture, VertexType::RenderVertex);
+    EXPECT_EQ(2u, MaterialBuilder::getRefCount(mat));
+
+    MaterialBuilder::releaseMaterial(mat);
+    EXPECT_EQ(1u, MaterialBuilder::getRefCount(mat));
+    MaterialBuilder::releaseMaterial(mat);
+    EXPECT_EQ(0u, MaterialBuilder::getCacheStats().mNumMaterials);
+
+    Material *newMat = MaterialBuilder::createTexturedMaterial("tex", &mTexture, VertexType::RenderVertex);
+    EXPECT_EQ(1u, MaterialBuilder::getRefCount(newMat));
+}
+
+TEST_F(MaterialBuilderTest, parameterHashTest) {
+    TextureResourceArray texResArray;
+    MaterialParameters red;
+    red.mColor[static_cast<ui32>(MaterialColorType::Mat_Diffuse)] = Color4(1.0f, 0.0f, 0.0f, 1.0f);
+    MaterialParameters shiny = red;
+    shiny.mShineness = 10.0f;
+
+    // Equal parameters share one material, different ones do not
+    Material *mat1 = MaterialBuilder::createTexturedMaterial("red", texResArray, VertexType::RenderVertex, red);
+    Material *mat2 = MaterialBuilder::createTexturedMaterial("red2", texResArray, VertexType::RenderVertex, red);
+    ASSERT_NE(nullptr, mat1);
+    EXPECT_EQ(mat1, mat2);
+    EXPECT_EQ(red.mColor[static_cast<ui32>(MaterialColorType::Mat_Diffuse)],
+            mat1->m_color[static_cast<ui32>(MaterialColorType::Mat_Diffuse)]);
+
+    Material *mat3 = MaterialBuilder::createTexturedMaterial("shiny", texResArray, VertexType::RenderVertex, shiny);
+    ASSERT_NE(nullptr, mat3);
+    EXPECT_NE(mat1, mat3);
+    EXPECT_FLOAT_EQ(10.0f, mat3->mShineness);
+    EXPECT_NE(mat1, MaterialBuilder::createTexturedMaterial("white", texResArray, VertexType::RenderVertex));
+}
+
+TEST_F(MaterialBuilderTest, makeUniqueTest) {
+    Material *mat1 = MaterialBuilder::createTexturedMaterial("tex", &mTexture, VertexType::RenderVertex);
+    Material *mat2 = MaterialBuilder::createTexturedMaterial("tex", &mTexture, VertexType::RenderVertex);
+    ASSERT_EQ(mat1, mat2);
+
+    // A shared material is copied, the other user keeps the cached one
+    Material *unique = MaterialBuilder::makeUnique(mat2);
+    ASSERT_NE(mat1, unique);
+    EXPECT_EQ(1u, MaterialBuilder::getRefCount(mat1));
+    EXPECT_EQ(mat1->m_numTextures, unique->m_numTextures);
+    EXPECT_EQ(&mTexture, unique->m_textures[0]);
+    ASSERT_NE(nullptr, unique->getShader());
+    EXPECT_NE(mat1->getShader(), unique->getShader());
+    EXPECT_EQ(mat1->getShader()->getProgramName(), unique->getShader()->getProgramName());
+
+    unique->m_color[0] = Color4(1.0f, 0.0f, 0.0f, 1.0f);
+    EXPECT_EQ(mat1, MaterialBuilder::createTexturedMaterial("tex", &mTexture, VertexType::RenderVertex));
+    MaterialBuilder::releaseMaterial(mat1);
+
+    // The last user takes the material out of the cache
+    EXPECT_EQ(mat1, MaterialBuilder::makeUnique(mat1));
+    EXPECT_NE(mat1, MaterialBuilder::createTexturedMaterial("tex", &mTexture, VertexType::RenderVertex));
+    EXPECT_EQ(3u, MaterialBuilder::getCacheStats().mNumMaterials);
+
+    MaterialBuilder::releaseMaterial(unique);
+    MaterialBuilder::releaseMaterial(mat1);
+    EXPECT_EQ(1u, MaterialBuilder::getCacheStats().mNumMaterials);
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -54,6 +54,14 @@ TEST_F( OGLEnumTest, access_cullFace_success ) {
     EXPECT_EQ(GL_FRONT_AND_BACK, (GLint)OGLEnum::getOGLCullFace(state.m_cullFace));
 }
 
+TEST_F(OGLEnumTest, access_vertexFormat_success) {
+    EXPECT_EQ(GL_HALF_FLOAT, (GLint)OGLEnum::getOGLTypeForFormat(VertexFormat::Half2));
+    EXPECT_EQ(GL_SHORT, (GLint)OGLEnum::getOGLTypeForFormat(VertexFormat::Short4N));
+    EXPECT_EQ(GL_UNSIGNED_BYTE, (GLint)OGLEnum::getOGLTypeForFormat(VertexFormat::UByte4N));
+    EXPECT_EQ(2u, OGLEnum::getOGLSizeForFormat(VertexFormat::Short2N));
+    EXPECT_EQ(4u, OGLEnum::getOGLSizeForFormat(VertexFormat::UByte4N));
+}
+
 } // Namespace UnitTest
 } // Namespace OSRE
 
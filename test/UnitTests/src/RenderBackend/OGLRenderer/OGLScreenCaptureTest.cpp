@@ -0,0 +1,66 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include <gtest/gtest.h>
+#include "src/Engine/RenderBackend/OGLRenderer/OGLScreenCapture.h"
+#include "src/Engine/RenderBackend/OGLRenderer/OGLRenderCommands.h"
+
+#include <cstdio>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class OGLScreenCaptureTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(OGLScreenCaptureTest, sequenceFilenameTest) {
+    EXPECT_EQ("shot_000042.png", OGLScreenCapture::getSequenceFilename("shot", 42, ScreenshotFormat::Png));
+    EXPECT_EQ("shot_000000.jpg", OGLScreenCapture::getSequenceFilename("shot", 0, ScreenshotFormat::Jpg));
+    EXPECT_EQ("shot_123456.raw", OGLScreenCapture::getSequenceFilename("shot", 123456, ScreenshotFormat::Raw));
+}
+
+TEST_F(OGLScreenCaptureTest, writeRawTest) {
+    // Two rows bottom up, the raw image stores them top down
+    uc8 pixels[12] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+    const c8 *filename = "osre_capture_test.raw";
+    EXPECT_TRUE(writeScreenShot(filename, ScreenshotFormat::Raw, 2, 2, pixels));
+
+    uc8 result[12] = {};
+    FILE *file = ::fopen(filename, "rb");
+    ASSERT_NE(nullptr, file);
+    EXPECT_EQ(12u, ::fread(result, 1, sizeof(result), file));
+    ::fclose(file);
+    ::remove(filename);
+
+    EXPECT_EQ(7, result[0]);
+    EXPECT_EQ(12, result[5]);
+    EXPECT_EQ(1, result[6]);
+    EXPECT_EQ(6, result[11]);
+
+    EXPECT_FALSE(writeScreenShot(filename, ScreenshotFormat::Raw, 0, 2, pixels));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,103 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/RenderBackend/PipelineState.h>
+#include <osre/RenderBackend/RenderPass.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class PipelineStateTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(PipelineStateTest, createSameStatesTest) {
+    RenderStates states1, states2;
+    const PipelineStateId id1 = PipelineStateRegistry::create(states1);
+    const size_t numStates = PipelineStateRegistry::getNumStates();
+    const PipelineStateId id2 = PipelineStateRegistry::create(states2);
+    EXPECT_NE(InvalidPipelineStateId, id1);
+    EXPECT_EQ(id1, id2);
+    EXPECT_EQ(numStates, PipelineStateRegistry::getNumStates());
+}
+
+TEST_F(PipelineStateTest, createDifferentStatesTest) {
+    RenderStates states1, states2;
+    states2.m_cullState = CullState(CullState::CullMode::CCW, CullState::CullFace::Front);
+    const PipelineStateId id1 = PipelineStateRegistry::create(states1);
+    const size_t numStates = PipelineStateRegistry::getNumStates();
+    const PipelineStateId id2 = PipelineStateRegistry::create(states2);
+    EXPECT_NE(id1, id2);
+    EXPECT_EQ(numStates + 1, PipelineStateRegistry::getNumStates());
+
+    const PipelineState *state = PipelineStateRegistry::get(id2);
+    ASSERT_NE(nullptr, state);
+    EXPECT_EQ(id2, state->getId());
+    EXPECT_EQ(CullState::CullFace::Front, state->getStates().m_cullState.m_cullFace);
+}
+
+TEST_F(PipelineStateTest, subStateHashTest) {
+    RenderStates states1, states2;
+    states2.m_blendState.m_blendFunc = BlendState::BlendFunc::FuncAdd;
+    const PipelineState *state1 = PipelineStateRegistry::get(PipelineStateRegistry::create(states1));
+    const PipelineState *state2 = PipelineStateRegistry::get(PipelineStateRegistry::create(states2));
+    ASSERT_NE(nullptr, state1);
+    ASSERT_NE(nullptr, state2);
+    for (ui32 i = 0; i < NumPipelineSubStates; ++i) {
+        const PipelineSubState subState = static_cast<PipelineSubState>(i);
+        if (PipelineSubState::Blend == subState) {
+            EXPECT_NE(state1->getSubStateHash(subState), state2->getSubStateHash(subState));
+        } else {
+            EXPECT_EQ(state1->getSubStateHash(subState), state2->getSubStateHash(subState));
+        }
+    }
+}
+
+TEST_F(PipelineStateTest, getInvalidTest) {
+    EXPECT_EQ(nullptr, PipelineStateRegistry::get(InvalidPipelineStateId));
+}
+
+TEST_F(PipelineStateTest, renderPassIdTest) {
+    RenderPass pass(RenderPassId, nullptr);
+    const PipelineStateId id1 = pass.getPipelineStateId();
+    EXPECT_NE(InvalidPipelineStateId, id1);
+    EXPECT_EQ(id1, pass.getPipelineStateId());
+
+    CullState cullState(CullState::CullMode::CCW, CullState::CullFace::Back);
+    pass.setCullState(cullState);
+    const PipelineStateId id2 = pass.getPipelineStateId();
+    EXPECT_NE(id1, id2);
+    EXPECT_EQ(CullState::CullMode::CCW, PipelineStateRegistry::get(id2)->getStates().m_cullState.m_cullMode);
+}
+
+TEST_F(PipelineStateTest, sortKeyTest) {
+    const ui64 key1 = makePipelineSortKey(2u, 100u);
+    const ui64 key2 = makePipelineSortKey(3u, 1u);
+    EXPECT_LT(key1, key2);
+    EXPECT_EQ(2u, getPipelineStateFromSortKey(key1));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,175 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/RenderBackend/RenderGraph.h>
+#include <osre/RenderBackend/RenderPass.h>
+#include <osre/RenderBackend/Pipeline.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class RenderGraphTest : public ::testing::Test {
+protected:
+    RenderPass *mPasses[4];
+
+    void SetUp() override {
+        for (ui32 i = 0; i < 4; ++i) {
+            mPasses[i] = new RenderPass(100 + i, nullptr);
+        }
+    }
+
+    void TearDown() override {
+        for (ui32 i = 0; i < 4; ++i) {
+            delete mPasses[i];
+        }
+    }
+};
+
+TEST_F(RenderGraphTest, cullAndSortTest) {
+    RenderTargetPool pool;
+    RenderGraph graph(&pool);
+    const RenderTargetDesc desc(256, 256, PixelFormatType::R8G8B8A8, true);
+    RenderGraphHandle unused = graph.createTarget("unused", desc);
+    RenderGraphHandle shadow = graph.createTarget("shadow", desc);
+    RenderGraphHandle backBuffer = graph.importTarget("backbuffer", nullptr);
+
+    // The consumer is declared before its producer
+    RenderGraphHandle lightPass = graph.addPass(mPasses[0]);
+    graph.read(lightPass, shadow);
+    graph.write(lightPass, backBuffer);
+    RenderGraphHandle deadPass = graph.addPass(mPasses[1]);
+    graph.write(deadPass, unused);
+    RenderGraphHandle shadowPass = graph.addPass(mPasses[2]);
+    EXPECT_TRUE(graph.write(shadowPass, shadow));
+    EXPECT_FALSE(graph.write(deadPass, backBuffer));
+    RenderGraphHandle secondProducer = graph.addPass(mPasses[3]);
+    EXPECT_FALSE(graph.write(secondProducer, shadow));
+
+    EXPECT_TRUE(graph.compile());
+    EXPECT_TRUE(graph.isCulled(deadPass));
+    EXPECT_TRUE(graph.isCulled(secondProducer));
+    EXPECT_FALSE(graph.isCulled(lightPass));
+    ASSERT_EQ(2u, graph.getNumActivePasses());
+    EXPECT_EQ(mPasses[2], graph.getActivePass(0));
+    EXPECT_EQ(mPasses[0], graph.getActivePass(1));
+    EXPECT_EQ(nullptr, mPasses[0]->getFrameBuffer());
+    EXPECT_NE(nullptr, mPasses[2]->getFrameBuffer());
+    EXPECT_EQ(nullptr, graph.getFrameBuffer(unused));
+
+    Pipeline pipeline("graph");
+    graph.apply(&pipeline);
+    EXPECT_EQ(2u, pipeline.getNumPasses());
+    pipeline.clear();
+}
+
+TEST_F(RenderGraphTest, cycleTest) {
+    RenderTargetPool pool;
+    RenderGraph graph(&pool);
+    const RenderTargetDesc desc(64, 64, PixelFormatType::R8G8B8, false);
+    RenderGraphHandle a = graph.createTarget("a", desc);
+    RenderGraphHandle b = graph.createTarget("b", desc);
+    RenderGraphHandle p0 = graph.addPass(mPasses[0]);
+    graph.read(p0, b);
+    graph.write(p0, a);
+    RenderGraphHandle p1 = graph.addPass(mPasses[1]);
+    graph.read(p1, a);
+    graph.write(p1, b);
+    graph.setSideEffect(p1);
+
+    EXPECT_FALSE(graph.compile());
+    EXPECT_EQ(0u, graph.getNumActivePasses());
+}
+
+TEST_F(RenderGraphTest, importedReadTest) {
+    RenderTargetPool pool;
+    RenderGraph graph(&pool);
+    const RenderTargetDesc desc(64, 64, PixelFormatType::R8G8B8A8, true);
+    RenderGraphHandle depth = graph.createTarget("depth", desc);
+    RenderGraphHandle shadowMap = graph.importTarget("shadowmap", nullptr);
+    RenderGraphHandle backBuffer = graph.importTarget("backbuffer", nullptr);
+
+    // The writer of the imported shadow map waits for the depth pass declared last
+    RenderGraphHandle shadowPass = graph.addPass(mPasses[0]);
+    graph.read(shadowPass, depth);
+    graph.write(shadowPass, shadowMap);
+    RenderGraphHandle lightPass = graph.addPass(mPasses[1]);
+    graph.read(lightPass, shadowMap);
+    graph.write(lightPass, backBuffer);
+    RenderGraphHandle depthPass = graph.addPass(mPasses[2]);
+    graph.write(depthPass, depth);
+
+    EXPECT_TRUE(graph.compile());
+    ASSERT_EQ(3u, graph.getNumActivePasses());
+    EXPECT_EQ(mPasses[2], graph.getActivePass(0));
+    EXPECT_EQ(mPasses[0], graph.getActivePass(1));
+    EXPECT_EQ(mPasses[1], graph.getActivePass(2));
+}
+
+TEST_F(RenderGraphTest, aliasTest) {
+    RenderTargetPool pool;
+    const RenderTargetDesc desc(128, 128, PixelFormatType::R8G8B8A8, false);
+    const RenderTargetDesc smallDesc(64, 64, PixelFormatType::R8G8B8A8, false);
+    for (ui32 frame = 0; frame < 2; ++frame) {
+        // blur ping-pong: a -> b -> c -> backbuffer, a and c do not overlap
+        RenderGraph graph(&pool);
+        RenderGraphHandle a = graph.createTarget("a", desc);
+        RenderGraphHandle b = graph.createTarget("b", desc);
+        RenderGraphHandle c = graph.createTarget("c", desc);
+        RenderGraphHandle small = graph.createTarget("small", smallDesc);
+        RenderGraphHandle backBuffer = graph.importTarget("backbuffer", nullptr);
+
+        RenderGraphHandle p0 = graph.addPass(mPasses[0]);
+        graph.write(p0, a);
+        RenderGraphHandle p1 = graph.addPass(mPasses[1]);
+        graph.read(p1, a);
+        graph.write(p1, b);
+        RenderGraphHandle p2 = graph.addPass(mPasses[2]);
+        graph.read(p2, b);
+        graph.write(p2, small);
+        RenderGraphHandle p3 = graph.addPass(mPasses[3]);
+        graph.read(p3, small);
+        graph.write(p3, c);
+        RenderGraphHandle p4 = graph.addPass(new RenderPass(200, nullptr));
+        graph.read(p4, c);
+        graph.write(p4, backBuffer);
+
+        EXPECT_TRUE(graph.compile());
+        EXPECT_EQ(5u, graph.getNumActivePasses());
+        EXPECT_EQ(graph.getFrameBuffer(a), graph.getFrameBuffer(c));
+        EXPECT_NE(graph.getFrameBuffer(a), graph.getFrameBuffer(b));
+        EXPECT_NE(graph.getFrameBuffer(b), graph.getFrameBuffer(small));
+        EXPECT_EQ(3u, graph.getNumPhysicalTargets());
+
+        // The targets of the last frame will be reused
+        EXPECT_EQ(3u, pool.getNumTargets());
+        EXPECT_EQ(3u, pool.getNumTargetsInUse());
+
+        delete graph.getActivePass(4);
+    }
+    EXPECT_EQ(0u, pool.getNumTargetsInUse());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,93 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/RenderBackend/ShaderPermutation.h>
+#include <osre/RenderBackend/MaterialBuilder.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class ShaderPermutationTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(ShaderPermutationTest, variantKeyTest) {
+    static constexpr ShaderVariantKey Key = makeShaderVariantKey(ShaderFeature::Lighting | ShaderFeature::Skinning, 2);
+    static_assert(getShaderTextureCount(Key) == 2, "Texture count is part of the key.");
+    EXPECT_EQ(ShaderFeature::MaxTextures, getShaderTextureCount(makeShaderVariantKey(ShaderFeature::None, 20)));
+
+    const String defines = ShaderPermutation::getDefines(Key);
+    EXPECT_NE(String::npos, defines.find("#define OSRE_LIGHTING 1\n"));
+    EXPECT_NE(String::npos, defines.find("#define OSRE_SKINNING 1\n"));
+    EXPECT_EQ(String::npos, defines.find("OSRE_INSTANCING"));
+    EXPECT_NE(String::npos, defines.find("#define OSRE_TEXTURE_COUNT 2\n"));
+}
+
+TEST_F(ShaderPermutationTest, variantCacheTest) {
+    ShaderPermutation permutation("test", ShaderFeature::Lighting | ShaderFeature::TextureCountMask);
+    permutation.setSource(ShaderType::SH_VertexShaderType, "#version 400 core\nvoid main() {}\n");
+
+    const ShaderVariant *lit = permutation.getVariant(makeShaderVariantKey(ShaderFeature::Lighting, 1));
+    ASSERT_NE(nullptr, lit);
+    const String &src = lit->mSources[static_cast<ui32>(ShaderType::SH_VertexShaderType)];
+    EXPECT_EQ(0u, src.find("#version 400 core\n#define OSRE_LIGHTING 1\n"));
+    EXPECT_TRUE(lit->mSources[static_cast<ui32>(ShaderType::SH_FragmentShaderType)].empty());
+
+    // Skinning is not supported, so the key maps to the same variant
+    const ShaderVariant *skinned = permutation.getVariant(makeShaderVariantKey(ShaderFeature::Lighting | ShaderFeature::Skinning, 1));
+    EXPECT_EQ(lit, skinned);
+    EXPECT_EQ(1u, permutation.getNumVariants());
+
+    static constexpr ShaderVariantKey Keys[] = {
+        makeShaderVariantKey(ShaderFeature::None, 0),
+        makeShaderVariantKey(ShaderFeature::None, 1)
+    };
+    permutation.precompile(Keys, 2);
+    EXPECT_EQ(3u, permutation.getNumVariants());
+    const ShaderVariant *unlit = permutation.getVariant(Keys[1]);
+    EXPECT_NE(lit->mId, unlit->mId);
+    EXPECT_NE(lit->mProgramName, unlit->mProgramName);
+}
+
+TEST_F(ShaderPermutationTest, buildinVariantTest) {
+    MaterialBuilder::create();
+    Texture texture;
+    Material *litMat = MaterialBuilder::createTexturedMaterial("lit", &texture, VertexType::RenderVertex);
+    Material *canvasMat = MaterialBuilder::createCanvasMaterial("canvas", &texture);
+    ASSERT_NE(nullptr, litMat);
+    ASSERT_NE(nullptr, canvasMat);
+
+    // Both use the mesh shader, but different variants with their own programs
+    const ShaderVariant *variant = MaterialBuilder::getShaderVariant(VertexType::RenderVertex, makeShaderVariantKey(ShaderFeature::Lighting, 1));
+    ASSERT_NE(nullptr, variant);
+    EXPECT_EQ(variant->mProgramName, litMat->m_shader->getProgramName());
+    EXPECT_EQ(variant->mId, litMat->m_shader->getProgramId());
+    EXPECT_NE(litMat->m_shader->getProgramName(), canvasMat->m_shader->getProgramName());
+    EXPECT_EQ(nullptr, MaterialBuilder::getShaderVariant(VertexType::InvalidVetexType, 0));
+    MaterialBuilder::destroy();
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,119 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/RenderBackend/TextRenderer.h>
+#include <osre/RenderBackend/FontAtlas.h>
+#include <osre/RenderBackend/Mesh.h>
+#include <osre/IO/Uri.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class TextRendererTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mFont = new FontAtlas("test_font");
+        mFont->createGrid(IO::Uri("file://assets/Textures/Fonts/buildin_arial.bmp"), 16, 16, 10.0f);
+    }
+
+    void TearDown() override {
+        delete mFont;
+    }
+
+    static const RenderVert *getVertices(TextRenderer &renderer) {
+        return reinterpret_cast<const RenderVert *>(renderer.getMesh()->getVertexBuffer()->getData());
+    }
+
+    static size_t getNumIndices(TextRenderer &renderer) {
+        return renderer.getMesh()->getPrimitiveGroupAt(0)->m_numIndices;
+    }
+
+    FontAtlas *mFont = nullptr;
+};
+
+TEST_F(TextRendererTest, reuseTest) {
+    TextRenderer renderer(mFont, 64);
+    TextHandle fps = renderer.addText(glm::vec2(0, 0), "fps 60", 10.0f);
+    renderer.addText(glm::vec2(0, 20), "score", 10.0f);
+    EXPECT_EQ(2u, renderer.getNumTexts());
+    EXPECT_EQ(nullptr, renderer.getMesh());
+
+    renderer.update();
+    ASSERT_NE(nullptr, renderer.getMesh());
+    EXPECT_EQ(10u, renderer.getNumGlyphsWritten());
+    EXPECT_EQ(16u * 6u, getNumIndices(renderer));
+
+    // Unchanged labels will not be written again
+    renderer.update();
+    EXPECT_EQ(0u, renderer.getNumGlyphsWritten());
+    EXPECT_TRUE(renderer.setText(fps, "fps 60"));
+    renderer.update();
+    EXPECT_EQ(0u, renderer.getNumGlyphsWritten());
+
+    // A changed label will be rewritten in place
+    EXPECT_TRUE(renderer.setText(fps, "fps 9"));
+    renderer.update();
+    EXPECT_EQ(4u, renderer.getNumGlyphsWritten());
+    const RenderVert *vertices = getVertices(renderer);
+    EXPECT_FLOAT_EQ(40.0f, vertices[3 * 4].position.x);
+    EXPECT_EQ(vertices[4 * 4].position, vertices[4 * 4 + 3].position);
+    EXPECT_FLOAT_EQ(0.0f, vertices[4 * 4 + 3].position.x);
+    EXPECT_FLOAT_EQ(20.0f, vertices[8 * 4].position.y);
+
+    EXPECT_TRUE(renderer.removeText(fps));
+    EXPECT_FALSE(renderer.removeText(fps));
+    EXPECT_FALSE(renderer.setText(fps, "fps 30"));
+    EXPECT_EQ(1u, renderer.getNumTexts());
+    EXPECT_EQ(vertices[0].position, vertices[3].position);
+
+    // Removing the last run shrinks the drawn range
+    TextHandle tail = renderer.addText(glm::vec2(0, 40), "tail", 10.0f);
+    renderer.update();
+    EXPECT_EQ(24u * 6u, getNumIndices(renderer));
+    EXPECT_TRUE(renderer.removeText(tail));
+    renderer.update();
+    EXPECT_EQ(16u * 6u, getNumIndices(renderer));
+}
+
+TEST_F(TextRendererTest, compactTest) {
+    TextRenderer renderer(mFont, 24);
+    TextHandle first = renderer.addText(glm::vec2(0, 0), "aaaaaaaa", 10.0f);
+    renderer.addText(glm::vec2(0, 50), "bbbbbbbb", 10.0f);
+    renderer.update();
+    EXPECT_EQ(16u, renderer.getNumGlyphsWritten());
+
+    // The grown label does not fit behind the others, so all runs will be compacted
+    EXPECT_TRUE(renderer.setText(first, "aaaaaaaaa"));
+    renderer.update();
+    EXPECT_EQ(17u, renderer.getNumGlyphsWritten());
+    const RenderVert *vertices = getVertices(renderer);
+    EXPECT_FLOAT_EQ(80.0f, vertices[8 * 4].position.x);
+    EXPECT_EQ(vertices[9 * 4].position, vertices[9 * 4 + 3].position);
+    EXPECT_FLOAT_EQ(50.0f, vertices[16 * 4].position.y);
+    EXPECT_EQ(24u * 6u, getNumIndices(renderer));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
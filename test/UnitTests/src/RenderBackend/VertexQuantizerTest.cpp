@@ -0,0 +1,100 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2023 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include <osre/RenderBackend/VertexQuantizer.h>
+#include <osre/RenderBackend/MeshProcessor.h>
+#include <osre/RenderBackend/Mesh.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class VertexQuantizerTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(VertexQuantizerTest, vertexSizeTest) {
+    EXPECT_EQ(24u, sizeof(QuantizedRenderVert));
+    EXPECT_EQ(sizeof(QuantizedRenderVert), Mesh::getVertexSize(VertexType::QuantizedRenderVertex));
+    EXPECT_EQ(4u, getVertexFormatSize(VertexFormat::Half2));
+    EXPECT_EQ(8u, getVertexFormatSize(VertexFormat::Short4N));
+    EXPECT_EQ(4u, getVertexFormatSize(VertexFormat::UByte4N));
+    EXPECT_TRUE(isVertexFormatNormalized(VertexFormat::Short2N));
+    EXPECT_FALSE(isVertexFormatNormalized(VertexFormat::Half4));
+}
+
+TEST_F(VertexQuantizerTest, halfRoundtripTest) {
+    EXPECT_FLOAT_EQ(0.5f, VertexQuantizer::fromHalf(VertexQuantizer::toHalf(0.5f)));
+    EXPECT_FLOAT_EQ(-2.0f, VertexQuantizer::fromHalf(VertexQuantizer::toHalf(-2.0f)));
+}
+
+TEST_F(VertexQuantizerTest, octahedralRoundtripTest) {
+    const glm::vec3 normals[] = {
+        glm::vec3(0, 0, 1), glm::vec3(0, 0, -1), glm::vec3(1, 0, 0),
+        glm::normalize(glm::vec3(1, -2, -3)), glm::normalize(glm::vec3(-1, 1, 0.5f))
+    };
+    for (const glm::vec3 &n : normals) {
+        i16 enc[2];
+        VertexQuantizer::encodeOctahedral(n, enc);
+        const glm::vec3 dec = VertexQuantizer::decodeOctahedral(enc);
+        EXPECT_NEAR(n.x, dec.x, 0.001f);
+        EXPECT_NEAR(n.y, dec.y, 0.001f);
+        EXPECT_NEAR(n.z, dec.z, 0.001f);
+    }
+}
+
+TEST_F(VertexQuantizerTest, quantizeMeshTest) {
+    RenderVert vertices[2];
+    vertices[0].position = glm::vec3(-1, 2, 3);
+    vertices[0].normal = glm::vec3(0, 1, 0);
+    vertices[1].position = glm::vec3(5, 4, 3);
+    vertices[1].normal = glm::vec3(0, 0, 1);
+    vertices[1].tex0 = glm::vec2(0.25f, 0.75f);
+
+    Mesh mesh("test", VertexType::RenderVertex, IndexType::UnsignedShort);
+    mesh.createVertexBuffer(vertices, sizeof(vertices), BufferAccessType::ReadOnly);
+    EXPECT_TRUE(MeshProcessor::quantize(&mesh));
+    EXPECT_TRUE(mesh.isQuantized());
+    EXPECT_EQ(2 * sizeof(QuantizedRenderVert), mesh.getVertexBuffer()->getSize());
+
+    const QuantizedRenderVert *q = reinterpret_cast<const QuantizedRenderVert *>(mesh.getVertexBuffer()->getData());
+    const glm::mat4 &dequant = mesh.getDequantizationMatrix();
+    for (ui32 i = 0; i < 2; ++i) {
+        const glm::vec4 pos = dequant * glm::vec4(VertexQuantizer::fromSnorm16(q[i].position[0]),
+            VertexQuantizer::fromSnorm16(q[i].position[1]), VertexQuantizer::fromSnorm16(q[i].position[2]), 1.0f);
+        EXPECT_NEAR(vertices[i].position.x, pos.x, 0.001f);
+        EXPECT_NEAR(vertices[i].position.y, pos.y, 0.001f);
+        EXPECT_NEAR(vertices[i].position.z, pos.z, 0.001f);
+    }
+    EXPECT_FLOAT_EQ(0.75f, VertexQuantizer::fromHalf(q[1].tex0[1]));
+
+    MeshProcessor processor;
+    processor.addMesh(&mesh);
+    processor.execute();
+    EXPECT_NEAR(-1.0f, processor.getAABB().getMin().x, 0.001f);
+    EXPECT_NEAR(5.0f, processor.getAABB().getMax().x, 0.001f);
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
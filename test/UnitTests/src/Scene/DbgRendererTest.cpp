@@ -25,6 +25,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <osre/RenderBackend/RenderBackendService.h>
 #include <osre/RenderBackend/MaterialBuilder.h>
 #include <osre/RenderBackend/DbgRenderer.h>
+#include <osre/RenderBackend/Mesh.h>
+#include <osre/RenderBackend/RenderPass.h>
 
 namespace OSRE {
 namespace UnitTest {
@@ -55,5 +57,80 @@ TEST_F( DbgRendererTest, create_Success ) {
     delete tstRBSrv;
 }
 
+TEST_F( DbgRendererTest, batchTest ) {
+    RenderBackend::RenderBackendService *tstRBSrv = new TestRenderBackendService;
+    DbgRenderer::create( tstRBSrv );
+    DbgRenderer *dbgRenderer = DbgRenderer::getInstance();
+    ASSERT_NE(nullptr, dbgRenderer);
+
+    dbgRenderer->addLine(glm::vec3(0), glm::vec3(1), glm::vec3(1, 0, 0));
+    EXPECT_EQ(2u, dbgRenderer->getNumLineVertices());
+
+    Common::AABB aabb(glm::vec3(-1), glm::vec3(1));
+    dbgRenderer->renderAABB(glm::mat4(1.0f), aabb);
+    EXPECT_EQ(26u, dbgRenderer->getNumLineVertices());
+
+    dbgRenderer->renderSphere(glm::vec3(0), 1.0f);
+    EXPECT_EQ(26u + 6u * DbgRenderer::NumSphereSegments, dbgRenderer->getNumLineVertices());
+
+    // Line breaks need no glyph
+    dbgRenderer->renderDbgText(10, 10, "ab\nc");
+    EXPECT_EQ(3u, dbgRenderer->getNumGlyphs());
+
+    dbgRenderer->clear();
+    EXPECT_EQ(0u, dbgRenderer->getNumLineVertices());
+    EXPECT_EQ(0u, dbgRenderer->getNumGlyphs());
+
+    DbgRenderer::destroy();
+    delete tstRBSrv;
+}
+
+TEST_F( DbgRendererTest, flushTest ) {
+    RenderBackend::RenderBackendService *tstRBSrv = new TestRenderBackendService;
+    DbgRenderer::create( tstRBSrv );
+    DbgRenderer *dbgRenderer = DbgRenderer::getInstance();
+    dbgRenderer->setCapacity(8, 1);
+    dbgRenderer->addLine(glm::vec3(0), glm::vec3(1), glm::vec3(1));
+    dbgRenderer->addLine(glm::vec3(0), glm::vec3(2), glm::vec3(1));
+    dbgRenderer->flush();
+    EXPECT_EQ(0u, dbgRenderer->getNumLineVertices());
+
+    // The second frame reuses the streaming mesh and draws its own line only
+    dbgRenderer->addLine(glm::vec3(0), glm::vec3(3), glm::vec3(1));
+    dbgRenderer->flush();
+
+    PassData *pass = tstRBSrv->getPassById(RenderPass::getPassNameById(DbgPassId));
+    ASSERT_NE(nullptr, pass);
+    RenderBatchData *batch = pass->getBatchById(DbgRenderer::getDebugRenderBatchName());
+    ASSERT_NE(nullptr, batch);
+    ASSERT_EQ(1u, batch->m_meshArray.size());
+    Mesh *mesh = batch->m_meshArray[0]->mMeshArray[0];
+    ASSERT_EQ(8u * sizeof(ColorVert), mesh->getVertexBuffer()->getSize());
+    const ColorVert *vertices = reinterpret_cast<const ColorVert*>(mesh->getVertexBuffer()->getData());
+    EXPECT_FLOAT_EQ(3.0f, vertices[1].position.x);
+    EXPECT_EQ(2u, mesh->getPrimitiveGroupAt(0)->m_numIndices);
+    EXPECT_EQ(2u * sizeof(ColorVert), mesh->getActiveVertexBufferSize());
+
+    DbgRenderer::destroy();
+    delete tstRBSrv;
+}
+
+TEST_F( DbgRendererTest, capacityTest ) {
+    RenderBackend::RenderBackendService *tstRBSrv = new TestRenderBackendService;
+    DbgRenderer::create( tstRBSrv );
+    DbgRenderer *dbgRenderer = DbgRenderer::getInstance();
+    dbgRenderer->setCapacity(4, 2);
+    for (ui32 i = 0; i < 3; ++i) {
+        dbgRenderer->addLine(glm::vec3(0), glm::vec3(1), glm::vec3(1));
+    }
+    EXPECT_EQ(4u, dbgRenderer->getNumLineVertices());
+
+    dbgRenderer->renderDbgText(0, 0, "abc");
+    EXPECT_EQ(2u, dbgRenderer->getNumGlyphs());
+
+    DbgRenderer::destroy();
+    delete tstRBSrv;
+}
+
 } // Namespace UnitTest
 } // Namespace OSRE
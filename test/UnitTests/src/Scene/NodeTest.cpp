@@ -151,5 +151,56 @@ TEST_F(TransformComponentTest, onUpdateWorldTransformTest) {
     EXPECT_FLOAT_EQ(mat_parent[3][2], 3);
 }
 
+TEST_F(TransformComponentTest, setRotationTest) {
+    TransformComponent *comp = createNode("node", mEntity, *mIds, nullptr);
+    const glm::quat rot = glm::angleAxis(glm::radians(90.0f), glm::vec3(0, 0, 1));
+    comp->setRotation(rot);
+    comp->setTranslation(glm::vec3(1, 0, 0));
+
+    const glm::vec4 pt = comp->getTransformationMatrix() * glm::vec4(1, 0, 0, 1);
+    EXPECT_NEAR(1.0f, pt.x, 0.0001f);
+    EXPECT_NEAR(1.0f, pt.y, 0.0001f);
+    EXPECT_NEAR(0.0f, pt.z, 0.0001f);
+}
+
+TEST_F(TransformComponentTest, setTransformationMatrixTest) {
+    TransformComponent *comp = createNode("node", mEntity, *mIds, nullptr);
+    glm::mat4 m = glm::translate(glm::mat4(1.0f), glm::vec3(1, 2, 3));
+    m = glm::rotate(m, 0.5f, glm::vec3(0, 1, 0));
+    m = glm::scale(m, glm::vec3(2, 2, 2));
+    comp->setTransformationMatrix(m);
+    EXPECT_NEAR(1.0f, comp->getTranslation().x, 0.0001f);
+    EXPECT_NEAR(2.0f, comp->getScale().y, 0.0001f);
+
+    // Recompose from the components after a change
+    comp->translate(glm::vec3(0, 0, 0));
+    const glm::mat4 &composed = comp->getTransformationMatrix();
+    for (i32 i = 0; i < 4; ++i) {
+        for (i32 j = 0; j < 4; ++j) {
+            EXPECT_NEAR(m[i][j], composed[i][j], 0.0001f);
+        }
+    }
+}
+
+TEST_F(TransformComponentTest, worldTransformDirtyTest) {
+    TransformComponent *parent = createNode("parent", mEntity, *mIds, nullptr);
+    TransformComponent *child = createNode("child", mEntity, *mIds, parent);
+    Time dt;
+    parent->update(dt);
+    EXPECT_FALSE(parent->isWorldTransformDirty());
+    EXPECT_FALSE(child->isWorldTransformDirty());
+
+    parent->rotate(glm::radians(90.0f), glm::vec3(0, 0, 1));
+    child->translate(glm::vec3(1, 0, 0));
+    EXPECT_TRUE(parent->isWorldTransformDirty());
+    EXPECT_TRUE(child->isWorldTransformDirty());
+
+    // The parent rotation is applied to the child translation
+    const glm::mat4 &world = child->getWorlTransformMatrix();
+    EXPECT_NEAR(0.0f, world[3][0], 0.0001f);
+    EXPECT_NEAR(1.0f, world[3][1], 0.0001f);
+    EXPECT_FALSE(parent->isWorldTransformDirty());
+}
+
 } // Namespace UnitTest
 } // Namespace OSRE
@@ -147,5 +147,24 @@ TEST_F(TAABBTest, isInTest) {
     EXPECT_FALSE(result);
 }
 
+TEST_F( TAABBTest, isValidTest ) {
+    AABB aabb;
+    EXPECT_FALSE( aabb.isValid() );
+    aabb.merge( glm::vec3( 1, 2, 3 ) );
+    EXPECT_TRUE( aabb.isValid() );
+}
+
+TEST_F( TAABBTest, transformTest ) {
+    AABB aabb( glm::vec3( -1, -2, -3 ), glm::vec3( 1, 2, 3 ) );
+    glm::mat4 m = glm::translate( glm::mat4( 1.0f ), glm::vec3( 10, 0, 0 ) );
+    m = glm::rotate( m, glm::radians( 90.0f ), glm::vec3( 0, 0, 1 ) );
+    const AABB result = aabb.transform( m );
+    EXPECT_NEAR( 8.0f, result.getMin().x, 0.0001f );
+    EXPECT_NEAR( 12.0f, result.getMax().x, 0.0001f );
+    EXPECT_NEAR( -1.0f, result.getMin().y, 0.0001f );
+    EXPECT_NEAR( 1.0f, result.getMax().y, 0.0001f );
+    EXPECT_NEAR( 3.0f, result.getMax().z, 0.0001f );
+}
+
 } // Namespace Unittest
 } // Namespace OSRE
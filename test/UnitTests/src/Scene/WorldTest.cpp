@@ -22,6 +22,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "osre_testcommon.h"
 #include <osre/App/World.h>
+#include <osre/App/Entity.h>
+#include <osre/App/AbstractBehaviour.h>
+#include <osre/App/TransformComponent.h>
+#include <osre/App/CameraComponent.h>
+
+#include <atomic>
+#include <vector>
 
 namespace OSRE {
 namespace UnitTest {
@@ -29,7 +36,34 @@ namespace UnitTest {
 using namespace ::OSRE::App;
 
 class WorldTest : public ::testing::Test {
-    // empty
+protected:
+    class CountingBehaviour : public AbstractBehaviour {
+    public:
+        CountingBehaviour(std::atomic<i32> &counter) : mCounter(counter) {}
+
+    protected:
+        bool onUpdate(Time) override {
+            ++mCounter;
+            return true;
+        }
+
+    private:
+        std::atomic<i32> &mCounter;
+    };
+
+    class MovingBehaviour : public AbstractBehaviour {
+    public:
+        MovingBehaviour(TransformComponent *node) : mNode(node) {}
+
+    protected:
+        bool onUpdate(Time) override {
+            mNode->translate(glm::vec3(1, 0, 0));
+            return true;
+        }
+
+    private:
+        TransformComponent *mNode;
+    };
 };
 
 TEST_F( WorldTest, createTest ) {
@@ -42,5 +76,245 @@ TEST_F( WorldTest, createTest ) {
     EXPECT_TRUE( ok );
 }
 
+TEST_F( WorldTest, updateModeTest ) {
+    World world("test");
+    EXPECT_EQ(World::UpdateMode::Serial, world.getUpdateMode());
+    world.setUpdateMode(World::UpdateMode::Parallel);
+    EXPECT_EQ(World::UpdateMode::Parallel, world.getUpdateMode());
+}
+
+TEST_F( WorldTest, parallelUpdateTest ) {
+    const World::UpdateMode modes[] = { World::UpdateMode::Serial, World::UpdateMode::Parallel,
+        World::UpdateMode::ParallelDeterministic };
+    for (World::UpdateMode mode : modes) {
+        World world("test");
+        world.setUpdateMode(mode);
+        std::atomic<i32> counter(0);
+        std::vector<Entity*> entities;
+        std::vector<CountingBehaviour*> behaviours;
+        for (i32 i = 0; i < 100; ++i) {
+            Entity *entity = new Entity("entity", world.getIds(), &world);
+            behaviours.push_back(new CountingBehaviour(counter));
+            entity->setBehaviourControl(behaviours.back());
+            auto *node = (TransformComponent *)entity->createComponent(ComponentType::TransformComponentType);
+            node->translate(glm::vec3(static_cast<f32>(i), 0, 0));
+            entities.push_back(entity);
+        }
+
+        Time dt;
+        world.update(dt);
+        EXPECT_EQ(100, counter.load());
+        for (size_t i = 0; i < entities.size(); ++i) {
+            auto *node = (TransformComponent *)entities[i]->getComponent(ComponentType::TransformComponentType);
+            EXPECT_FALSE(node->isWorldTransformDirty());
+            EXPECT_FLOAT_EQ(static_cast<f32>(i), node->getWorlTransformMatrix()[3][0]);
+        }
+
+        for (size_t i = 0; i < entities.size(); ++i) {
+            delete entities[i];
+            delete behaviours[i];
+        }
+    }
+}
+
+TEST_F( WorldTest, sharedParentTest ) {
+    World world("test");
+    world.setUpdateMode(World::UpdateMode::Parallel);
+    TransformComponent *root = new TransformComponent("root", nullptr, world.getIds());
+    root->translate(glm::vec3(0, 5, 0));
+    world.setSceneRoot(root);
+
+    // The behaviours mark the shared parent concurrently
+    std::vector<Entity*> entities;
+    std::vector<MovingBehaviour*> behaviours;
+    for (i32 i = 0; i < 200; ++i) {
+        Entity *entity = new Entity("entity", world.getIds(), &world);
+        auto *node = (TransformComponent *)entity->createComponent(ComponentType::TransformComponentType);
+        root->addChild(node);
+        node->setParent(root);
+        behaviours.push_back(new MovingBehaviour(node));
+        entity->setBehaviourControl(behaviours.back());
+        entities.push_back(entity);
+    }
+
+    Time dt;
+    world.update(dt);
+    world.update(dt);
+    EXPECT_FALSE(root->needsTransformUpdate());
+    for (size_t i = 0; i < entities.size(); ++i) {
+        auto *node = (TransformComponent *)entities[i]->getComponent(ComponentType::TransformComponentType);
+        EXPECT_FALSE(node->needsTransformUpdate());
+        EXPECT_FLOAT_EQ(2.0f, node->getWorlTransformMatrix()[3][0]);
+        EXPECT_FLOAT_EQ(5.0f, node->getWorlTransformMatrix()[3][1]);
+    }
+
+    delete root;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        delete entities[i];
+        delete behaviours[i];
+    }
+}
+
+TEST_F( WorldTest, spatialRefitTest ) {
+    World world("test");
+    std::vector<Entity*> entities;
+    std::vector<TransformComponent*> nodes;
+    for (i32 i = 0; i < 10; ++i) {
+        Entity *entity = new Entity("entity", world.getIds(), &world);
+        TransformComponent *node = new TransformComponent("node", entity, world.getIds());
+        node->translate(glm::vec3(static_cast<f32>(i) * 10.0f, 0, 0));
+        entity->setNode(node);
+        entity->setAABB(Common::AABB(glm::vec3(-1, -1, -1), glm::vec3(1, 1, 1)));
+        entities.push_back(entity);
+        nodes.push_back(node);
+    }
+
+    Time dt;
+    world.update(dt);
+    EXPECT_EQ(10u, world.getNumRefitEntities());
+
+    // Nothing has moved, so no proxy will be touched
+    world.update(dt);
+    EXPECT_EQ(0u, world.getNumRefitEntities());
+
+    nodes[3]->translate(glm::vec3(0, 100, 0));
+    world.update(dt);
+    EXPECT_EQ(1u, world.getNumRefitEntities());
+    cppcore::TArray<Entity*> found;
+    world.queryEntities(glm::vec3(30, 100, 0), 2.0f, found);
+    ASSERT_EQ(1u, found.size());
+    EXPECT_EQ(entities[3], found[0]);
+    found.resize(0);
+    world.queryEntities(glm::vec3(30, 0, 0), 2.0f, found);
+    EXPECT_TRUE(found.isEmpty());
+
+    // A changed box will be refit as well, also when the entity was removed before the update
+    entities[5]->setAABB(Common::AABB(glm::vec3(-3, -3, -3), glm::vec3(3, 3, 3)));
+    entities[7]->setAABB(Common::AABB(glm::vec3(-3, -3, -3), glm::vec3(3, 3, 3)));
+    delete entities[7];
+    delete nodes[7];
+    world.update(dt);
+    EXPECT_EQ(1u, world.getNumRefitEntities());
+    found.resize(0);
+    world.queryEntities(glm::vec3(50, 2.5f, 0), 0.1f, found);
+    ASSERT_EQ(1u, found.size());
+    EXPECT_EQ(entities[5], found[0]);
+
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (7 != i) {
+            delete entities[i];
+            delete nodes[i];
+        }
+    }
+}
+
+TEST_F( WorldTest, pooledTransformTest ) {
+    World world("test");
+    Entity *entity = new Entity("entity", world.getIds(), &world);
+    TransformComponent *node = static_cast<TransformComponent *>(entity->createComponent(ComponentType::TransformComponentType));
+    EXPECT_TRUE(node->isPooled());
+    EXPECT_EQ(node, entity->getNode());
+    entity->setAABB(Common::AABB(glm::vec3(-1, -1, -1), glm::vec3(1, 1, 1)));
+
+    Time dt;
+    world.update(dt);
+    world.update(dt);
+    EXPECT_EQ(0u, world.getNumRefitEntities());
+
+    // The pooled node is updated from the pool and refits its entity
+    node->translate(glm::vec3(20, 0, 0));
+    world.update(dt);
+    EXPECT_EQ(1u, world.getNumRefitEntities());
+    EXPECT_EQ(20.0f, node->getWorlTransformMatrix()[3][0]);
+    cppcore::TArray<Entity*> found;
+    world.queryEntities(glm::vec3(20, 0, 0), 0.5f, found);
+    ASSERT_EQ(1u, found.size());
+    EXPECT_EQ(entity, found[0]);
+
+    delete entity;
+}
+
+TEST_F( WorldTest, cameraUpdateTest ) {
+    World world("test");
+    Entity *entity = new Entity("camera", world.getIds(), &world);
+    Camera *camera = static_cast<Camera *>(entity->createComponent(ComponentType::CameraComponentType));
+    EXPECT_TRUE(camera->isPooled());
+    const glm::vec3 eye(0, 0, 5), center(0, 0, 0), up(0, 1, 0);
+    camera->setLookAt(eye, center, up);
+
+    // Cameras, which are not active, are updated by the world from the camera pool
+    Time dt;
+    world.update(dt);
+    EXPECT_EQ(glm::lookAt(eye, center, up), camera->getView());
+
+    delete entity;
+}
+
+TEST_F( WorldTest, findEntityTest ) {
+    World world("test");
+    Entity *e1 = new Entity("e1", world.getIds(), &world);
+    Entity *e2 = new Entity("e2", world.getIds(), &world);
+    Entity *dup = new Entity("e1", world.getIds(), &world);
+    EXPECT_EQ(3u, world.getNumEntities());
+    EXPECT_EQ(e1, world.findEntity("e1"));
+    EXPECT_EQ(e2, world.getEntityByName("e2"));
+    EXPECT_EQ(nullptr, world.findEntity("E1_"));
+    EXPECT_EQ(nullptr, world.findEntity(""));
+
+    // The duplicate will be found after the first one was removed
+    delete e1;
+    EXPECT_EQ(dup, world.findEntity("e1"));
+
+    EXPECT_TRUE(world.renameEntity(e2, "renamed"));
+    EXPECT_EQ(nullptr, world.findEntity("e2"));
+    EXPECT_EQ(e2, world.findEntity("renamed"));
+
+    delete e2;
+    delete dup;
+    EXPECT_EQ(0u, world.getNumEntities());
+}
+
+TEST_F( WorldTest, sameNameTest ) {
+    World world("test");
+    Entity *a = new Entity("n", world.getIds(), &world);
+    Entity *b = new Entity("n", world.getIds(), &world);
+    Entity *c = new Entity("n", world.getIds(), &world);
+
+    // Removing the tail and the head keeps the chain appendable
+    delete c;
+    Entity *d = new Entity("n", world.getIds(), &world);
+    delete a;
+    EXPECT_EQ(b, world.findEntity("n"));
+    Entity *e = new Entity("n", world.getIds(), &world);
+    delete b;
+    EXPECT_EQ(d, world.findEntity("n"));
+    delete d;
+    EXPECT_EQ(e, world.findEntity("n"));
+    delete e;
+    EXPECT_EQ(nullptr, world.findEntity("n"));
+}
+
+TEST_F( WorldTest, entityHandleTest ) {
+    World world("test");
+    Entity *e1 = new Entity("e1", world.getIds(), &world);
+    Entity *e2 = new Entity("e2", world.getIds(), &world);
+    const EntityHandle h1 = e1->getHandle();
+    const EntityHandle h2 = e2->getHandle();
+    EXPECT_TRUE(h1.isValid());
+    EXPECT_NE(h1, h2);
+    EXPECT_EQ(e1, world.getEntity(h1));
+    EXPECT_EQ(e2, world.getEntity(h2));
+
+    delete e1;
+    EXPECT_EQ(nullptr, world.getEntity(h1));
+    EXPECT_EQ(e2, world.getEntity(h2));
+
+    cppcore::TArray<Entity*> entities;
+    world.getEntityArray(entities);
+    ASSERT_EQ(1u, entities.size());
+    EXPECT_EQ(e2, entities[0]);
+    delete e2;
+}
+
 } // Namespace UnitTest
 } // Namespace OSRE
@@ -20,64 +20,48 @@ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
 IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
-#pragma once
+#include "osre_testcommon.h"
+#include <osre/Threading/ThreadPool.h>
 
-#include <osre/Common/osre_common.h>
+#include <atomic>
 
 namespace OSRE {
-namespace Collision {
+namespace UnitTest {
 
-//-------------------------------------------------------------------------------------------------
-///	@ingroup	Engine
-///
-///	@brief	
-//-------------------------------------------------------------------------------------------------
-template<class T>
-class TQuadTree {
-public:
-    using Rect  = Common::TRect2D<T>;
-    using Point = Common::TPoint2<T>;
+using namespace ::OSRE::Threading;
 
-    TQuadTree(const Rect& rc);
-    ~TQuadTree();
-    
-
-private:
-    struct QuadNode {
-        Rect m_rect;
-        QuadNode*m_children[4];
-        
-        QuadNode(const Rect &rc) : m_rect( rc ) {
-            m_children[0] = m_children[1] = m_children[2] = m_children[3] = nullptr;
-        }
-        
-        QuadNode *isIn(const Point& pt) const {
-            if (m_rect.isIn(pt)) {
-                for (ui32 i = 0; i < 4; ++i) {
-                    if (nullptr != m_children[i]) {
-                        return m_children[i]->isIn(pt);
-                    }
-                }
-                
-                return this;
-            }
-        }
-    };
-
-    QuadNod *m_root;
+class ThreadPoolTest : public ::testing::Test {
+    // empty
 };
 
-template<class T>
-inline TQuadTree<T>::TQuadTree(const Rect &rc) : m_root( nullptr ) {
-    m_root = new Entity(rc);
+TEST_F(ThreadPoolTest, createTest) {
+    ThreadPool pool(2);
+    EXPECT_EQ(2u, pool.getNumWorkers());
 }
 
-template<class T>
-inline TQuadTree<T>::~TQuadTree() {
-    delete m_root;
-    m_root = nullptr;
+TEST_F(ThreadPoolTest, parallelForTest) {
+    ThreadPool pool(3);
+    std::atomic<size_t> sum(0);
+    pool.parallelFor(1000, 10, [&sum](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            sum += i;
+        }
+    });
+    EXPECT_EQ(999u * 1000u / 2u, sum.load());
 }
 
-} // Namespace Collision
-} // Namespace OSRE
+TEST_F(ThreadPoolTest, nestedParallelForTest) {
+    ThreadPool pool(2);
+    std::atomic<size_t> count(0);
+    pool.parallelFor(8, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            pool.parallelFor(100, 1, [&count](size_t b, size_t e) {
+                count += e - b;
+            });
+        }
+    });
+    EXPECT_EQ(800u, count.load());
+}
 
+} // Namespace UnitTest
+} // Namespace OSRE